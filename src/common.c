@@ -66,6 +66,7 @@
  */
 const struct srplg_ds_s *sr_internal_ds_plugins[] = {
     &srpds_json,    /**< JSON DS file */
+    &srpds_lyb,     /**< LYB DS shm */
 #ifdef SR_ENABLED_DS_PLG_MONGO
     &srpds_mongo,   /**< MONGO DS */
 #endif
@@ -105,6 +106,8 @@ const sr_module_ds_t sr_module_ds_disabled_run = {{
         SR_DEFAULT_NOTIFICATION_DS /**< notification */
     }};
 
+_Thread_local uint32_t sr_ev_thread_depth;
+
 sr_error_info_t *
 sr_ptr_add(pthread_mutex_t *ptr_lock, void ***ptrs, uint32_t *ptr_count, void *add_ptr)
 {
@@ -1103,6 +1106,25 @@ sr_path_ext_shm(char **path)
     return err_info;
 }
 
+sr_error_info_t *
+sr_path_ctx_img(char **path)
+{
+    sr_error_info_t *err_info = NULL;
+    const char *prefix;
+
+    err_info = sr_shm_prefix(&prefix);
+    if (err_info) {
+        return err_info;
+    }
+
+    if (asprintf(path, "%s/%s_ctx", SR_SHM_DIR, prefix) == -1) {
+        SR_ERRINFO_MEM(&err_info);
+        *path = NULL;
+    }
+
+    return err_info;
+}
+
 sr_error_info_t *
 sr_path_sub_shm(const char *mod_name, const char *suffix1, int64_t suffix2, char **path)
 {
@@ -1510,11 +1532,93 @@ sr_shm_remap(sr_shm_t *shm, size_t new_shm_size)
     return NULL;
 }
 
+sr_error_info_t *
+sr_shm_remap_grow(sr_shm_t *shm, size_t min_shm_size, int resize, int reserve)
+{
+    sr_error_info_t *err_info = NULL;
+    size_t page_size, file_size, new_size, new_rsize;
+    char *addr;
+
+    if (min_shm_size <= shm->size) {
+        /* mapping is large enough */
+        return NULL;
+    }
+
+    if (resize) {
+        /* grow at least twice so that alternating small and large sizes do not cause repeated growing */
+        page_size = sysconf(_SC_PAGESIZE);
+        new_size = (shm->size * 2 > min_shm_size) ? shm->size * 2 : min_shm_size;
+        new_size = ((new_size + page_size - 1) / page_size) * page_size;
+
+        /* the file may have been grown by another process already */
+        if ((err_info = sr_file_get_size(shm->fd, &file_size))) {
+            return err_info;
+        }
+        if (file_size < new_size) {
+            if (ftruncate(shm->fd, new_size) == -1) {
+                sr_errinfo_new(&err_info, SR_ERR_SYS, "Failed to truncate shared memory (%s).", strerror(errno));
+                return err_info;
+            }
+        } else {
+            new_size = file_size;
+        }
+    } else {
+        new_size = min_shm_size;
+    }
+
+    if (!reserve) {
+        /* map exactly the SHM, the mapping is not kept for long */
+        if (shm->addr) {
+            munmap(shm->addr, shm->rsize ? shm->rsize : shm->size);
+        }
+        shm->rsize = 0;
+        shm->size = 0;
+        shm->addr = mmap(NULL, new_size, PROT_READ | PROT_WRITE, MAP_SHARED, shm->fd, 0);
+        if (shm->addr == MAP_FAILED) {
+            shm->addr = NULL;
+            sr_errinfo_new(&err_info, SR_ERR_NO_MEMORY, "Failed to map shared memory (%s).", strerror(errno));
+            return err_info;
+        }
+        shm->size = new_size;
+        return NULL;
+    }
+
+    if (new_size > shm->rsize) {
+        /* reserve a new address range, the previous mapping is dropped */
+        new_rsize = new_size * SR_SHM_GROW_RESERVE_FACTOR;
+        if (new_rsize - new_size > SR_SHM_GROW_RESERVE_MAX) {
+            new_rsize = new_size + SR_SHM_GROW_RESERVE_MAX;
+        }
+        addr = mmap(NULL, new_rsize, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+        if (addr == MAP_FAILED) {
+            sr_errinfo_new(&err_info, SR_ERR_NO_MEMORY, "Failed to reserve shared memory address range (%s).",
+                    strerror(errno));
+            return err_info;
+        }
+
+        if (shm->addr) {
+            munmap(shm->addr, shm->rsize ? shm->rsize : shm->size);
+        }
+        shm->addr = addr;
+        shm->rsize = new_rsize;
+        shm->size = 0;
+    }
+
+    /* map the whole SHM in place of the previous mapping */
+    if (mmap(shm->addr, new_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, shm->fd, 0) == MAP_FAILED) {
+        sr_errinfo_new(&err_info, SR_ERR_NO_MEMORY, "Failed to map shared memory (%s).", strerror(errno));
+        return err_info;
+    }
+    shm->size = new_size;
+
+    return NULL;
+}
+
 void
 sr_shm_clear(sr_shm_t *shm)
 {
     if (shm->addr) {
-        munmap(shm->addr, shm->size);
+        munmap(shm->addr, shm->rsize ? shm->rsize : shm->size);
         shm->addr = NULL;
     }
     if (shm->fd > -1) {
@@ -1522,128 +1626,173 @@ sr_shm_clear(sr_shm_t *shm)
         shm->fd = -1;
     }
     shm->size = 0;
+    shm->rsize = 0;
+}
+
+/**
+ * @brief Get the size class of an ext SHM memory hole.
+ *
+ * @param[in] size Size of the hole.
+ * @return Size class index.
+ */
+static uint32_t
+sr_ext_hole_class(uint32_t size)
+{
+    uint32_t class = 0;
+
+    size /= SR_SHM_MEM_ALIGN;
+    while ((size >>= 1) && (class < SR_EXT_HOLE_CLASS_COUNT - 1)) {
+        ++class;
+    }
+
+    return class;
 }
 
 sr_ext_hole_t *
 sr_ext_hole_next(sr_ext_hole_t *last, sr_ext_shm_t *ext_shm)
 {
+    uint32_t class;
+
     if (!last) {
-        if (!ext_shm->first_hole_off) {
-            return NULL;
-        }
-        return (sr_ext_hole_t *)(((char *)ext_shm) + ext_shm->first_hole_off);
+        class = 0;
     } else if (!last->next_hole_off) {
-        return NULL;
+        /* continue with the next size class */
+        class = sr_ext_hole_class(last->size) + 1;
+    } else {
+        return (sr_ext_hole_t *)(((char *)ext_shm) + last->next_hole_off);
+    }
+
+    for ( ; class < SR_EXT_HOLE_CLASS_COUNT; ++class) {
+        if (ext_shm->first_hole_off[class]) {
+            return (sr_ext_hole_t *)(((char *)ext_shm) + ext_shm->first_hole_off[class]);
+        }
     }
 
-    return (sr_ext_hole_t *)(((char *)ext_shm) + last->next_hole_off);
+    return NULL;
 }
 
 sr_ext_hole_t *
-sr_ext_hole_find(sr_ext_shm_t *ext_shm, uint32_t off, uint32_t min_size)
+sr_ext_hole_get(sr_ext_shm_t *ext_shm, uint32_t min_size)
 {
-    sr_ext_hole_t *hole;
+    sr_ext_hole_t *hole = NULL;
+    uint32_t class;
 
-    for (hole = sr_ext_hole_next(NULL, ext_shm); hole; hole = sr_ext_hole_next(hole, ext_shm)) {
-        if (off) {
-            if (((char *)hole - (char *)ext_shm == (int)off) && (hole->size >= min_size)) {
-                return hole;
-            }
-            if ((char *)hole - (char *)ext_shm > (int)off) {
-                /* foo large offset, it cannot be found anymore */
+    /* the first hole of the same class may be large enough, any hole of a larger class always is */
+    for (class = sr_ext_hole_class(min_size); class < SR_EXT_HOLE_CLASS_COUNT; ++class) {
+        if (ext_shm->first_hole_off[class]) {
+            hole = (sr_ext_hole_t *)(((char *)ext_shm) + ext_shm->first_hole_off[class]);
+            if (hole->size >= min_size) {
                 break;
             }
-        } else if (hole->size >= min_size) {
-            return hole;
+            hole = NULL;
         }
     }
+    if (!hole) {
+        return NULL;
+    }
 
-    return NULL;
+    /* remove it */
+    ext_shm->first_hole_off[class] = hole->next_hole_off;
+    --ext_shm->hole_count;
+    ext_shm->hole_size -= hole->size;
+
+    return hole;
 }
 
 void
-sr_ext_hole_del(sr_ext_shm_t *ext_shm, sr_ext_hole_t *hole)
+sr_ext_hole_add(sr_ext_shm_t *ext_shm, uint32_t off, uint32_t size)
 {
-    sr_ext_hole_t *h, *prev = NULL;
-
-    for (h = sr_ext_hole_next(NULL, ext_shm); h; h = sr_ext_hole_next(h, ext_shm)) {
-        if (h == hole) {
-            /* found the hole */
-            break;
-        }
+    sr_ext_hole_t *hole;
+    uint32_t class;
 
-        prev = h;
+    if (!size) {
+        /* nothing to do */
+        return;
     }
-    assert(h);
 
-    /* fíx offsets */
-    if (prev) {
-        prev->next_hole_off = hole->next_hole_off;
-    } else {
-        ext_shm->first_hole_off = hole->next_hole_off;
+    /* prepend the hole to its size class, adjacent holes are merged only by defragmentation */
+    class = sr_ext_hole_class(size);
+    hole = (sr_ext_hole_t *)((char *)ext_shm + off);
+    hole->size = size;
+    hole->next_hole_off = ext_shm->first_hole_off[class];
+    ext_shm->first_hole_off[class] = off;
+
+    ++ext_shm->hole_count;
+    ext_shm->hole_size += size;
+}
+
+/**
+ * @brief Comparator for ext SHM memory holes qsort, by their offset.
+ *
+ * @param[in] ptr1 First value pointer.
+ * @param[in] ptr2 Second value pointer.
+ * @return Less than, equal to, or greater than 0 if the first value is found
+ * to be less than, equal to, or greater to the second value.
+ */
+static int
+sr_ext_hole_defrag_cmp(const void *ptr1, const void *ptr2)
+{
+    const sr_ext_hole_t *hole1 = *(const sr_ext_hole_t **)ptr1, *hole2 = *(const sr_ext_hole_t **)ptr2;
+
+    if (hole1 < hole2) {
+        return -1;
+    } else if (hole1 > hole2) {
+        return 1;
     }
+    return 0;
 }
 
-void
-sr_ext_hole_add(sr_ext_shm_t *ext_shm, uint32_t off, uint32_t size)
+sr_error_info_t *
+sr_ext_hole_defrag(sr_shm_t *shm_ext)
 {
-    sr_ext_hole_t *next, *prev = NULL, *hole;
-    int con_prev = 0, con_next = 0;
+    sr_error_info_t *err_info = NULL;
+    sr_ext_shm_t *ext_shm = (sr_ext_shm_t *)shm_ext->addr;
+    sr_ext_hole_t **holes = NULL, *hole;
+    uint32_t i, hole_count, off, size;
 
-    if (!size) {
+    if (!ext_shm->hole_count) {
         /* nothing to do */
-        return;
+        return NULL;
     }
 
-    for (next = sr_ext_hole_next(NULL, ext_shm); next; next = sr_ext_hole_next(next, ext_shm)) {
-        if ((char *)next - (char *)ext_shm > (int)off) {
-            /* found the next hole */
-            break;
+    /* collect all the holes sorted by their offset */
+    holes = malloc(ext_shm->hole_count * sizeof *holes);
+    SR_CHECK_MEM_RET(!holes, err_info);
+    hole_count = 0;
+    for (hole = sr_ext_hole_next(NULL, ext_shm); hole; hole = sr_ext_hole_next(hole, ext_shm)) {
+        assert(hole_count < ext_shm->hole_count);
+        holes[hole_count++] = hole;
+    }
+    qsort(holes, hole_count, sizeof *holes, sr_ext_hole_defrag_cmp);
+
+    /* add them again, merged */
+    memset(ext_shm, 0, sizeof *ext_shm);
+    off = ((char *)holes[0]) - shm_ext->addr;
+    size = holes[0]->size;
+    for (i = 1; i < hole_count; ++i) {
+        if (off + size == (uint32_t)(((char *)holes[i]) - shm_ext->addr)) {
+            /* adjacent holes */
+            size += holes[i]->size;
+            continue;
         }
 
-        prev = next;
+        sr_ext_hole_add(ext_shm, off, size);
+        off = ((char *)holes[i]) - shm_ext->addr;
+        size = holes[i]->size;
     }
 
-    if (prev && (((char *)prev - (char *)ext_shm) + prev->size == off)) {
-        /* connecting with prev */
-        con_prev = 1;
-    }
-    if (next && ((int)(off + size) == (char *)next - (char *)ext_shm)) {
-        /* connecting with next */
-        con_next = 1;
+    if (off + size != shm_ext->size) {
+        sr_ext_hole_add(ext_shm, off, size);
     }
+    ext_shm->defrag_hole_count = ext_shm->hole_count;
 
-    hole = (sr_ext_hole_t *)((char *)ext_shm + off);
-    if (con_prev && con_next) {
-        /* prev + hole + next */
-        prev->size += size + next->size;
-        prev->next_hole_off = next->next_hole_off;
-    } else if (con_prev) {
-        /* prev + hole -> (next) */
-        prev->size += size;
-    } else if (con_next) {
-        /* (prev) -> hole + next */
-        if (prev) {
-            prev->next_hole_off = off;
-        } else {
-            ext_shm->first_hole_off = off;
-        }
-        hole->size = size + next->size;
-        hole->next_hole_off = next->next_hole_off;
-    } else {
-        /* (prev) -> hole -> (next) */
-        if (prev) {
-            prev->next_hole_off = off;
-        } else {
-            ext_shm->first_hole_off = off;
-        }
-        hole->size = size;
-        if (next) {
-            hole->next_hole_off = (char *)next - (char *)ext_shm;
-        } else {
-            hole->next_hole_off = 0;
-        }
+    if (off + size == shm_ext->size) {
+        /* the last hole is at the end, truncate ext SHM instead */
+        err_info = sr_shm_remap(shm_ext, off);
     }
+
+    free(holes);
+    return err_info;
 }
 
 off_t
@@ -1686,7 +1835,7 @@ sr_strshmlen(const char *str)
 }
 
 /**
- * @brief Use a found hole (remove it), add a smaller hole if it is not used fully.
+ * @brief Use a found hole (already removed), add a smaller hole if it is not used fully.
  *
  * @param[in] ext_shm Ext SHM.
  * @param[in] hole Hole to use.
@@ -1698,9 +1847,6 @@ sr_shmrealloc_use_hole(sr_ext_shm_t *ext_shm, sr_ext_hole_t *hole, uint32_t used
     uint32_t new_hole_size;
 
     new_hole_size = hole->size - used_size;
-
-    /* we are using this hole, remove it */
-    sr_ext_hole_del(ext_shm, hole);
     if (new_hole_size) {
         /* the full hole will not be used, add a smaller one */
         sr_ext_hole_add(ext_shm, (((char *)hole) - (char *)ext_shm) + used_size, new_hole_size);
@@ -1716,7 +1862,8 @@ sr_shmrealloc_add(sr_shm_t *shm_ext, off_t *shm_array_off, uint32_t *shm_count,
     size_t new_ext_size, new_array_size, array_size_diff;
     char *old_shm_addr;
     sr_ext_shm_t *ext_shm = (sr_ext_shm_t *)shm_ext->addr;
-    sr_ext_hole_t *con_array_hole = NULL, *array_hole = NULL, *attr_hole = NULL;
+    sr_ext_hole_t *array_hole = NULL, *attr_hole = NULL;
+    int array_at_end = 0;
 
     assert((*shm_array_off && *shm_count) || (!*shm_array_off && !*shm_count));
     assert((add_idx > -2) && (add_idx <= *shm_count));
@@ -1741,26 +1888,24 @@ sr_shmrealloc_add(sr_shm_t *shm_ext, off_t *shm_array_off, uint32_t *shm_count,
 
     /* sizes may be equal because of alignment */
     if (array_size_diff) {
-        if (*shm_array_off) {
-            /* try to find a hole right after the current array, we would not need to move the array then */
-            con_array_hole = sr_ext_hole_find(ext_shm, *shm_array_off + array_size_diff, array_size_diff);
-        }
-        if (!con_array_hole) {
+        if (*shm_array_off && ((size_t)*shm_array_off + SR_SHM_SIZE(*shm_count * item_size) == new_ext_size)) {
+            /* the array is at the end of ext SHM, we do not need to move it */
+            array_at_end = 1;
+            new_ext_size += array_size_diff;
+        } else {
             /* find suitable hole or new offset for the array */
-            array_hole = sr_ext_hole_find(ext_shm, 0, new_array_size);
+            array_hole = sr_ext_hole_get(ext_shm, new_array_size);
             if (!array_hole) {
                 new_array_off = new_ext_size;
                 new_ext_size += new_array_size;
             } else {
                 sr_shmrealloc_use_hole(ext_shm, array_hole, new_array_size);
             }
-        } else {
-            sr_shmrealloc_use_hole(ext_shm, con_array_hole, array_size_diff);
         }
     }
     if (dyn_attr_size) {
         /* find suitable hole or new offset for the dynamic attribute */
-        attr_hole = sr_ext_hole_find(ext_shm, 0, dyn_attr_size);
+        attr_hole = sr_ext_hole_get(ext_shm, dyn_attr_size);
         if (!attr_hole) {
             attr_off = new_ext_size;
             new_ext_size += dyn_attr_size;
@@ -1786,9 +1931,6 @@ sr_shmrealloc_add(sr_shm_t *shm_ext, off_t *shm_array_off, uint32_t *shm_count,
             shm_array_off = (off_t *)(shm_ext->addr + (((char *)shm_array_off) - old_shm_addr));
             shm_count = (uint32_t *)(shm_ext->addr + (((char *)shm_count) - old_shm_addr));
         }
-        if (con_array_hole) {
-            con_array_hole = (sr_ext_hole_t *)(shm_ext->addr + (((char *)con_array_hole) - old_shm_addr));
-        }
         if (array_hole) {
             array_hole = (sr_ext_hole_t *)(shm_ext->addr + (((char *)array_hole) - old_shm_addr));
         }
@@ -1801,7 +1943,7 @@ sr_shmrealloc_add(sr_shm_t *shm_ext, off_t *shm_array_off, uint32_t *shm_count,
     /*
      * set the offsets for the new array/dynamic attribute
      */
-    if (!array_size_diff || con_array_hole) {
+    if (!array_size_diff || array_at_end) {
         /* array is not moved */
         new_array_off = *shm_array_off;
     } else if (array_hole) {
@@ -1819,7 +1961,7 @@ sr_shmrealloc_add(sr_shm_t *shm_ext, off_t *shm_array_off, uint32_t *shm_count,
     /*
      * perform the actual (re)allocation
      */
-    if (array_size_diff && !con_array_hole && add_idx) {
+    if (array_size_diff && !array_at_end && add_idx) {
         /* copy preceding items (only if the array is moved) */
         memcpy(shm_ext->addr + new_array_off, shm_ext->addr + *shm_array_off, add_idx * item_size);
     }
@@ -1831,7 +1973,7 @@ sr_shmrealloc_add(sr_shm_t *shm_ext, off_t *shm_array_off, uint32_t *shm_count,
     }
 
     /* add new hole if the array was moved */
-    if (array_size_diff && *shm_array_off && !con_array_hole) {
+    if (array_size_diff && *shm_array_off && !array_at_end) {
         sr_ext_hole_add(ext_shm, *shm_array_off, SR_SHM_SIZE(*shm_count * item_size));
     }
 
@@ -1856,7 +1998,8 @@ sr_shmrealloc(sr_shm_t *shm_ext, off_t *dyn_attr_off, int in_ext_shm, size_t cur
     size_t new_ext_size;
     char *old_shm_addr;
     sr_ext_shm_t *ext_shm = (sr_ext_shm_t *)shm_ext->addr;
-    sr_ext_hole_t *con_attr_hole = NULL, *attr_hole = NULL;
+    sr_ext_hole_t *attr_hole = NULL;
+    int attr_at_end = 0;
 
     assert(!*dyn_attr_off || cur_size);
 
@@ -1869,21 +2012,19 @@ sr_shmrealloc(sr_shm_t *shm_ext, off_t *dyn_attr_off, int in_ext_shm, size_t cur
      * !! the holes are immediately updated (removed, so that the holes are not reused) so they must only be used as pointers !!
      */
     if (new_size > cur_size) {
-        if (cur_size) {
-            /* try to find a hole right after the current attr, we would not need to move it then */
-            con_attr_hole = sr_ext_hole_find(ext_shm, *dyn_attr_off + cur_size, new_size - cur_size);
-        }
-        if (!con_attr_hole) {
+        if (cur_size && ((size_t)*dyn_attr_off + cur_size == new_ext_size)) {
+            /* the attr is at the end of ext SHM, we do not need to move it */
+            attr_at_end = 1;
+            new_ext_size += new_size - cur_size;
+        } else {
             /* find suitable hole or new offset for the attr */
-            attr_hole = sr_ext_hole_find(ext_shm, 0, new_size);
+            attr_hole = sr_ext_hole_get(ext_shm, new_size);
             if (!attr_hole) {
                 new_attr_off = new_ext_size;
                 new_ext_size += new_size;
             } else {
                 sr_shmrealloc_use_hole(ext_shm, attr_hole, new_size);
             }
-        } else {
-            sr_shmrealloc_use_hole(ext_shm, con_attr_hole, new_size - cur_size);
         }
     } else if (new_size < cur_size) {
         /* size is smaller, empty space (hole) is created */
@@ -1906,9 +2047,6 @@ sr_shmrealloc(sr_shm_t *shm_ext, off_t *dyn_attr_off, int in_ext_shm, size_t cur
         if (in_ext_shm) {
             dyn_attr_off = (off_t *)(shm_ext->addr + (((char *)dyn_attr_off) - old_shm_addr));
         }
-        if (con_attr_hole) {
-            con_attr_hole = (sr_ext_hole_t *)(shm_ext->addr + (((char *)con_attr_hole) - old_shm_addr));
-        }
         if (attr_hole) {
             attr_hole = (sr_ext_hole_t *)(shm_ext->addr + (((char *)attr_hole) - old_shm_addr));
         }
@@ -1918,7 +2056,7 @@ sr_shmrealloc(sr_shm_t *shm_ext, off_t *dyn_attr_off, int in_ext_shm, size_t cur
     /*
      * set the offset for the new dynamic attribute
      */
-    if ((new_size <= cur_size) || con_attr_hole) {
+    if ((new_size <= cur_size) || attr_at_end) {
         /* attr is not moved */
         new_attr_off = *dyn_attr_off;
     } else if (attr_hole) {
@@ -1930,7 +2068,7 @@ sr_shmrealloc(sr_shm_t *shm_ext, off_t *dyn_attr_off, int in_ext_shm, size_t cur
     /*
      * perform the actual (re)allocation
      */
-    if ((new_size > cur_size) && !con_attr_hole) {
+    if ((new_size > cur_size) && !attr_at_end) {
         /* copy current attr (only if it is moved) */
         memcpy(shm_ext->addr + new_attr_off, shm_ext->addr + *dyn_attr_off, cur_size);
 
@@ -3354,7 +3492,7 @@ sr_conn_ctx_switch(sr_conn_ctx_t *conn, struct ly_ctx **new_ctx, struct ly_ctx *
     if (old_ctx) {
         *old_ctx = conn->ly_ctx;
     } else {
-        ly_ctx_destroy(conn->ly_ctx);
+        sr_ly_ctx_destroy(conn->ly_ctx);
     }
 
     /* new ctx */
@@ -5413,13 +5551,100 @@ sr_module_file_data_append(const struct lys_module *ly_mod, const struct sr_ds_h
     return NULL;
 }
 
+/**
+ * @brief Collect all the connections with some stored operational data (edit).
+ *
+ * @param[in] edit Operational edit.
+ * @param[out] cids Connections with some nodes in @p edit.
+ * @param[out] cid_count Count of @p cids.
+ * @return err_info, NULL on success.
+ */
+static sr_error_info_t *
+sr_edit_oper_collect_cids(const struct lyd_node *edit, sr_cid_t **cids, uint32_t *cid_count)
+{
+    sr_error_info_t *err_info = NULL;
+    const struct lyd_node *root, *elem;
+    struct lyd_meta *meta;
+    sr_cid_t cid;
+    uint32_t i;
+    void *mem;
+
+    *cids = NULL;
+    *cid_count = 0;
+
+    LY_LIST_FOR(edit, root) {
+        LYD_TREE_DFS_BEGIN(root, elem) {
+            meta = lyd_find_meta(elem->meta, NULL, "sysrepo:cid");
+            if (meta) {
+                cid = meta->value.uint32;
+                for (i = 0; (i < *cid_count) && ((*cids)[i] != cid); ++i) {}
+                if (i == *cid_count) {
+                    mem = realloc(*cids, (*cid_count + 1) * sizeof **cids);
+                    SR_CHECK_MEM_RET(!mem, err_info);
+                    *cids = mem;
+                    (*cids)[(*cid_count)++] = cid;
+                }
+            }
+            LYD_TREE_DFS_END(root, elem);
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Learn the dead connections with some stored operational data (edit) of a module.
+ *
+ * @param[in] shm_mod SHM module with the connections with stored data, if known.
+ * @param[in] edit Operational edit of the module, searched only if the connections are not known.
+ * @param[out] dead_cids Dead connections with stored data.
+ * @param[out] dead_count Count of @p dead_cids.
+ * @return err_info, NULL on success.
+ */
+static sr_error_info_t *
+sr_module_oper_dead_cids(const sr_mod_t *shm_mod, const struct lyd_node *edit, sr_cid_t **dead_cids,
+        uint32_t *dead_count)
+{
+    sr_error_info_t *err_info = NULL;
+    sr_cid_t *cids = NULL;
+    uint32_t i, cid_count;
+
+    *dead_cids = NULL;
+    *dead_count = 0;
+
+    if (shm_mod->oper_cid_count != SR_MOD_OPER_CID_UNKNOWN) {
+        /* known connections, no need to search the edit */
+        cid_count = shm_mod->oper_cid_count;
+        cids = malloc(cid_count * sizeof *cids);
+        SR_CHECK_MEM_GOTO(cid_count && !cids, err_info, cleanup);
+        memcpy(cids, shm_mod->oper_cids, cid_count * sizeof *cids);
+    } else if ((err_info = sr_edit_oper_collect_cids(edit, &cids, &cid_count))) {
+        goto cleanup;
+    }
+
+    /* check whether each is alive only once */
+    for (i = 0; i < cid_count; ++i) {
+        if (!sr_conn_is_alive(cids[i])) {
+            cids[(*dead_count)++] = cids[i];
+        }
+    }
+
+    if (*dead_count) {
+        *dead_cids = cids;
+        cids = NULL;
+    }
+
+cleanup:
+    free(cids);
+    return err_info;
+}
+
 sr_error_info_t *
 sr_module_file_oper_data_load(struct sr_mod_info_mod_s *mod, struct lyd_node **edit)
 {
     sr_error_info_t *err_info = NULL;
-    struct lyd_node *root, *elem;
-    struct lyd_meta *meta;
-    sr_cid_t dead_cid = 0;
+    sr_cid_t *dead_cids = NULL;
+    uint32_t i, dead_count;
 
     assert(!*edit);
 
@@ -5429,30 +5654,104 @@ sr_module_file_oper_data_load(struct sr_mod_info_mod_s *mod, struct lyd_node **e
         return err_info;
     }
 
-trim_retry:
-    if (dead_cid) {
-        /* this connection is dead, remove its stored edit */
-        SR_LOG_INF("Recovering module \"%s\" stored operational data of CID %" PRIu32 ".", mod->ly_mod->name, dead_cid);
-        if ((err_info = sr_edit_oper_del(edit, dead_cid, NULL, NULL))) {
-            return err_info;
+    /* learn the dead connections with some stored data */
+    if ((err_info = sr_module_oper_dead_cids(mod->shm_mod, *edit, &dead_cids, &dead_count))) {
+        goto cleanup;
+    }
+
+    if (dead_count) {
+        /* these connections are dead, remove their stored edits */
+        for (i = 0; i < dead_count; ++i) {
+            SR_LOG_INF("Recovering module \"%s\" stored operational data of CID %" PRIu32 ".", mod->ly_mod->name,
+                    dead_cids[i]);
+        }
+        if ((err_info = sr_edit_oper_del_cids(edit, dead_cids, dead_count))) {
+            goto cleanup;
         }
     }
 
-    /* find edit belonging to a dead connection, if any */
-    LY_LIST_FOR(*edit, root) {
-        LYD_TREE_DFS_BEGIN(root, elem) {
-            meta = lyd_find_meta(elem->meta, NULL, "sysrepo:cid");
-            if (meta && !sr_conn_is_alive(meta->value.uint32)) {
-                dead_cid = meta->value.uint32;
+cleanup:
+    free(dead_cids);
+    return err_info;
+}
 
-                /* retry the whole check until there are no dead connections */
-                goto trim_retry;
-            }
-            LYD_TREE_DFS_END(root, elem);
+sr_error_info_t *
+sr_module_oper_data_prune(struct sr_mod_info_mod_s *mod, struct lyd_node **data, int *pruned)
+{
+    sr_error_info_t *err_info = NULL;
+    struct lyd_node *mod_data;
+    sr_cid_t *dead_cids = NULL;
+    uint32_t dead_count;
+
+    *pruned = 0;
+
+    if (mod->shm_mod->oper_cid_count == SR_MOD_OPER_CID_UNKNOWN) {
+        /* the connections are learned from the stored edit */
+        return NULL;
+    }
+
+    if ((err_info = sr_module_oper_dead_cids(mod->shm_mod, NULL, &dead_cids, &dead_count))) {
+        return err_info;
+    }
+    if (!dead_count) {
+        return NULL;
+    }
+
+    /* remove the edits of the dead connections from the module data */
+    mod_data = sr_module_data_unlink(data, mod->ly_mod);
+    err_info = sr_edit_oper_del_cids(&mod_data, dead_cids, dead_count);
+    if (mod_data) {
+        lyd_insert_sibling(*data, mod_data, data);
+    }
+    free(dead_cids);
+    if (err_info) {
+        return err_info;
+    }
+
+    *pruned = 1;
+    return NULL;
+}
+
+sr_error_info_t *
+sr_module_oper_cids_update(sr_mod_t *shm_mod, sr_cid_t cid, const struct lyd_node *mod_edit, int rescan)
+{
+    sr_error_info_t *err_info = NULL;
+    sr_cid_t *cids;
+    uint32_t i, cid_count;
+
+    if (!mod_edit) {
+        /* no stored data */
+        shm_mod->oper_cid_count = 0;
+        return NULL;
+    }
+
+    if (rescan || (shm_mod->oper_cid_count == SR_MOD_OPER_CID_UNKNOWN)) {
+        /* learn the connections from the whole edit */
+        if ((err_info = sr_edit_oper_collect_cids(mod_edit, &cids, &cid_count))) {
+            shm_mod->oper_cid_count = SR_MOD_OPER_CID_UNKNOWN;
+            return err_info;
+        }
+        if (cid_count > SR_MOD_OPER_CID_COUNT) {
+            shm_mod->oper_cid_count = SR_MOD_OPER_CID_UNKNOWN;
+        } else {
+            memcpy(shm_mod->oper_cids, cids, cid_count * sizeof *cids);
+            shm_mod->oper_cid_count = cid_count;
         }
+        free(cids);
+        return NULL;
     }
 
-    return err_info;
+    /* the connection may have stored some new data, the others only kept or removed theirs */
+    for (i = 0; (i < shm_mod->oper_cid_count) && (shm_mod->oper_cids[i] != cid); ++i) {}
+    if (i == shm_mod->oper_cid_count) {
+        if (shm_mod->oper_cid_count == SR_MOD_OPER_CID_COUNT) {
+            shm_mod->oper_cid_count = SR_MOD_OPER_CID_UNKNOWN;
+        } else {
+            shm_mod->oper_cids[shm_mod->oper_cid_count++] = cid;
+        }
+    }
+
+    return NULL;
 }
 
 sr_error_info_t *
@@ -75,6 +75,9 @@ struct srplg_ntf_s;
 /** timeout for locking subscription SHM; maximum time an event handling should take (ms) */
 #define SR_SUBSHM_LOCK_TIMEOUT 10000
 
+/** number of new ext SHM memory holes since the last defragmentation that trigger another one */
+#define SR_EXT_HOLE_DEFRAG_COUNT 64
+
 /** timeout for locking ext SHM lock; time that truncating, writing into SHM but even recovering may take (ms) */
 #define SR_EXT_LOCK_TIMEOUT 500
 
@@ -123,12 +126,24 @@ struct srplg_ntf_s;
 /** default timeout for notification subscrption callback (ms) */
 #define SR_NOTIF_CB_TIMEOUT 2000
 
+/** maximum time an originator waits for lagging notification subscribers with bounded lag before dropping (ms) */
+#define SR_NOTIF_BOUNDED_LAG_TIMEOUT 50
+
 /** timeout step for parallel subscription active polling loop */
 #define SR_SHMSUB_MANY_EVENT_TIMEOUT_STEP_MS 1
 
 /** timeout for waiting until SRSN dispatch thread closes the read end of the notification pipe (ms) */
 #define SR_SN_READ_DISPATCH_CLOSE_TIMEOUT 1000
 
+/** address range reserved for a grow-only SHM mapping as a multiple of its size so that it can grow in place */
+#define SR_SHM_GROW_RESERVE_FACTOR 8
+
+/** maximum address range reserved for a grow-only SHM mapping above its size (B) */
+#define SR_SHM_GROW_RESERVE_MAX (8 * 1024 * 1024)
+
+/** minimal number of edit nodes for skipping an unneeded diff, smaller edits keep it for bounded validation */
+#define SR_EDIT_NO_DIFF_NODE_COUNT 64
+
 /** permissions of main SHM lock file and main/mod/ext SHM */
 #define SR_SHM_PERM 00666
 
@@ -182,8 +197,11 @@ extern const struct srplg_ntf_s *sr_internal_ntf_plugins[];
 extern const sr_module_ds_t sr_module_ds_default;
 extern const sr_module_ds_t sr_module_ds_disabled_run;
 
+/** nesting depth of subscription event processing (callbacks) by the current thread */
+extern _Thread_local uint32_t sr_ev_thread_depth;
+
 /** static initializer of the shared memory structure */
-#define SR_SHM_INITIALIZER {.fd = -1, .size = 0, .addr = NULL}
+#define SR_SHM_INITIALIZER {.fd = -1, .size = 0, .addr = NULL, .rsize = 0}
 
 /** initializer of mod_info structure */
 #define SR_MODINFO_INIT(mi, c, d, d2) memset(&(mi), 0, sizeof (mi)); (mi).ds = (d); (mi).ds2 = (d2); (mi).conn = (c)
@@ -238,6 +256,26 @@ typedef struct {
 sr_error_info_t *_sr_session_start(sr_conn_ctx_t *conn, const sr_datastore_t datastore, sr_sub_event_t event,
         char **shm_data_ptr, sr_session_ctx_t **session);
 
+/**
+ * @brief Start an event session, reuse an idle one of the connection if possible.
+ *
+ * @param[in] conn Connection of the session.
+ * @param[in] datastore Datastore of the session.
+ * @param[in] event Event the session is handling.
+ * @param[in,out] shm_data_ptr Optional pointer to SHM sub data where originator name and data are stored, is updated.
+ * @param[out] session Started session.
+ * @return err_info, NULL on success.
+ */
+sr_error_info_t *sr_ev_session_start(sr_conn_ctx_t *conn, const sr_datastore_t datastore, sr_sub_event_t event,
+        char **shm_data_ptr, sr_session_ctx_t **session);
+
+/**
+ * @brief Stop an event session, it is kept by the connection for reuse if possible.
+ *
+ * @param[in] session Session to stop, may be NULL.
+ */
+void sr_ev_session_stop(sr_session_ctx_t *session);
+
 /**
  * @brief Notify subscribers about the changes in diff and store the data in mod info.
  * Mod info modules are expected to be READ-locked with the ability to upgrade to WRITE-lock!
@@ -441,6 +479,14 @@ sr_error_info_t *sr_path_mod_shm(char **path);
  */
 sr_error_info_t *sr_path_ext_shm(char **path);
 
+/**
+ * @brief Get the path of the printed context image.
+ *
+ * @param[out] path Created path. Should be freed by the caller.
+ * @return err_info, NULL on success.
+ */
+sr_error_info_t *sr_path_ctx_img(char **path);
+
 /**
  * @brief Get the path to a subscription SHM.
  *
@@ -597,6 +643,19 @@ int sr_time_sub_ms(const struct timespec *ts1, const struct timespec *ts2);
  */
 sr_error_info_t *sr_shm_remap(sr_shm_t *shm, size_t new_shm_size);
 
+/**
+ * @brief Grow the mapping of a SHM, it is never shrunk. For mappings kept for a long time, a larger address
+ * range can be reserved once and the SHM mapped into it so that growing does not move the mapping. Needs WRITE lock
+ * for resizing, otherwise READ lock is fine.
+ *
+ * @param[in] shm SHM structure to remap.
+ * @param[in] min_shm_size Minimum size of the mapping.
+ * @param[in] resize Whether to also grow the SHM file if it is smaller, otherwise it must be large enough.
+ * @param[in] reserve Whether to reserve an address range for growing the mapping in place.
+ * @return err_info, NULL on success.
+ */
+sr_error_info_t *sr_shm_remap_grow(sr_shm_t *shm, size_t min_shm_size, int resize, int reserve);
+
 /**
  * @brief Clear a SHM structure.
  *
@@ -605,7 +664,7 @@ sr_error_info_t *sr_shm_remap(sr_shm_t *shm, size_t new_shm_size);
 void sr_shm_clear(sr_shm_t *shm);
 
 /**
- * @brief Get the next ext SHM memory hole.
+ * @brief Get the next ext SHM memory hole, in no particular order.
  *
  * @param[in] last Last returned hole, NULL on first call.
  * @param[in] ext_shm Ext SHM.
@@ -614,22 +673,13 @@ void sr_shm_clear(sr_shm_t *shm);
 sr_ext_hole_t *sr_ext_hole_next(sr_ext_hole_t *last, sr_ext_shm_t *ext_shm);
 
 /**
- * @brief Find an existing hole.
+ * @brief Get and remove an existing hole large enough, only the first holes of the size classes are checked.
  *
  * @param[in] ext_shm Ext SHM.
- * @param[in] off Optional offset of the hole.
  * @param[in] min_size Minimum matching hole size.
- * @return First suitable hole, NULL if none found.
+ * @return Removed suitable hole, NULL if none found.
  */
-sr_ext_hole_t *sr_ext_hole_find(sr_ext_shm_t *ext_shm, uint32_t off, uint32_t min_size);
-
-/**
- * @brief Delete an existing hole.
- *
- * @param[in] ext_shm Ext SHM.
- * @param[in] hole Hole to delete.
- */
-void sr_ext_hole_del(sr_ext_shm_t *ext_shm, sr_ext_hole_t *hole);
+sr_ext_hole_t *sr_ext_hole_get(sr_ext_shm_t *ext_shm, uint32_t min_size);
 
 /**
  * @brief Add a new hole.
@@ -637,10 +687,18 @@ void sr_ext_hole_del(sr_ext_shm_t *ext_shm, sr_ext_hole_t *hole);
  * @param[in] ext_shm Ext SHM.
  * @param[in] off Offset of the new hole.
  * @param[in] size Size of the new hole.
- * @return First suitable hole, NULL if none found.
  */
 void sr_ext_hole_add(sr_ext_shm_t *ext_shm, uint32_t off, uint32_t size);
 
+/**
+ * @brief Defragment ext SHM by merging all the adjacent holes and truncating it if there is a hole at its end.
+ * Needs ext and remap WRITE lock.
+ *
+ * @param[in] shm_ext Ext SHM.
+ * @return err_info, NULL on success.
+ */
+sr_error_info_t *sr_ext_hole_defrag(sr_shm_t *shm_ext);
+
 /**
  * @brief Copy memory into SHM.
  *
@@ -1343,6 +1401,30 @@ sr_error_info_t *sr_module_file_data_append(const struct lys_module *ly_mod, con
  */
 sr_error_info_t *sr_module_file_oper_data_load(struct sr_mod_info_mod_s *mod, struct lyd_node **edit);
 
+/**
+ * @brief Remove the operational data (edit) of the known dead connections of a module before the edit is stored.
+ *
+ * @param[in] mod Mod info mod, WRITE lock is expected to be held.
+ * @param[in,out] data Operational edit with the module data.
+ * @param[out] pruned Whether any data were removed, the connections must then be rescanned after storing.
+ * @return err_info, NULL on success.
+ */
+sr_error_info_t *sr_module_oper_data_prune(struct sr_mod_info_mod_s *mod, struct lyd_node **data, int *pruned);
+
+/**
+ * @brief Update the connections with stored operational data (edit) of a module after it was stored.
+ *
+ * The connections are kept as a superset, only @p cid may have stored some new data unless @p rescan is set.
+ *
+ * @param[in] shm_mod SHM module, WRITE lock is expected to be held.
+ * @param[in] cid Connection that stored the edit.
+ * @param[in] mod_edit Stored edit of the module.
+ * @param[in] rescan Whether to learn the connections from @p mod_edit.
+ * @return err_info, NULL on success.
+ */
+sr_error_info_t *sr_module_oper_cids_update(sr_mod_t *shm_mod, sr_cid_t cid, const struct lyd_node *mod_edit,
+        int rescan);
+
 /**
  * @brief Learn CIDs and PIDs of all the live connections.
  *
@@ -36,6 +36,7 @@ typedef struct {
     int fd;                         /**< Shared memory file desriptor. */
     size_t size;                    /**< Shared memory mapping current size. */
     char *addr;                     /**< Shared memory mapping address. */
+    size_t rsize;                   /**< Size of the reserved address range of a grow-only mapping, 0 if none. */
 } sr_shm_t;
 
 /**
@@ -52,6 +53,21 @@ typedef enum {
 /** maximum number of system-wide concurrent connection owners of a read lock */
 #define SR_RWLOCK_READ_LIMIT 16
 
+/** maximum number of idle event sessions kept by a connection for reuse */
+#define SR_EV_SESS_POOL_SIZE 8
+
+/** maximum number of worker threads of a connection executing background operations, documented in sysrepo.h */
+#define SR_BG_THREAD_COUNT 4
+
+/** maximum number of threads (including the calling one) validating or storing modules of a mod info in parallel */
+#define SR_MODINFO_THREAD_COUNT 8
+
+/** number of request slots of an RPC subscription SHM, slot 0 is used by all non-pipelined requests */
+#define SR_RPC_SUB_SLOT_COUNT 8
+
+/** maximum number of idle subscription SHM mappings kept by a connection for originating events */
+#define SR_ORIG_SHM_CACHE_SIZE 32
+
 /**
  * @brief Sysrepo read-write lock.
  */
@@ -109,6 +125,17 @@ typedef struct {
     uint32_t union_count;
 } sr_xp_atoms_t;
 
+/**
+ * @brief Subscription SHM mappings of an event originator kept for the next events.
+ */
+struct sr_orig_shm_s {
+    char *name;                     /**< Subscription name (module name). */
+    const char *suffix1;            /**< First suffix, static string. */
+    int64_t suffix2;                /**< Second suffix, none if -1. */
+    sr_shm_t sub;                   /**< Mapped sub SHM. */
+    sr_shm_t data[SR_RPC_SUB_SLOT_COUNT];   /**< Mapped data SHM of every RPC slot, only the first one for others. */
+};
+
 /*
  * Private definitions of public declarations
  */
@@ -124,6 +151,8 @@ struct sr_conn_ctx_s {
     pthread_mutex_t ptr_lock;       /**< Session-shared lock for accessing pointers to sessions. */
     sr_session_ctx_t **sessions;    /**< Array of sessions for this connection. */
     uint32_t session_count;         /**< Session count. */
+    sr_session_ctx_t *ev_sess_pool[SR_EV_SESS_POOL_SIZE];   /**< Idle event sessions to be reused, also in sessions. */
+    uint32_t ev_sess_pool_count;    /**< Idle event session count, protected by ptr_lock. */
     sr_cid_t cid;                   /**< Globally unique connection ID */
     sr_rwlock_t ly_ext_data_lock;   /**< Session-shared lock for accessing ly_ext_data. */
     struct lyd_node *ly_ext_data;   /**< Data for LY ext data callback set for ly_ctx. */
@@ -165,6 +194,7 @@ struct sr_conn_ctx_s {
         sr_rwlock_t data_lock;      /**< Lock for accessing the data and timestamp. */
         struct lyd_node *data;      /**< Cached data of a single operational get subscription. */
         struct timespec timestamp;  /**< Timestamp of the cached operational data. */
+        uint32_t generation;        /**< Generation of the cached data in the shared oper poll cache SHM. */
     } *oper_caches;                 /**< Operational get subscription data caches. */
     uint32_t oper_cache_count;      /**< Operational get subscription data cache count. */
     sr_rwlock_t oper_cache_lock;    /**< Operational get subscription data cache lock. */
@@ -172,6 +202,41 @@ struct sr_conn_ctx_s {
     char **oper_push_mods;          /**< Modules whose pushed oper data were modified by this connection. */
     uint32_t oper_push_mod_count;   /**< Count of modules with modified push oper data. */
     pthread_mutex_t oper_push_mod_lock; /**< Session-shared lock for modifying oper_push_mods. */
+
+    struct {
+        pthread_mutex_t lock;       /**< Session-shared lock for accessing the group commit attributes. */
+        sr_cond_t cond;             /**< Condition variable for waiting on queued commit requests. */
+        int active;                 /**< Whether there is a thread applying changes (leader). */
+        struct sr_commit_req_s *first;  /**< First queued commit request. */
+        struct sr_commit_req_s *last;   /**< Last queued commit request. */
+    } commit;                       /**< Group commit of changes applied concurrently using this connection. */
+
+    struct {
+        pthread_mutex_t lock;       /**< Session-shared lock for accessing the background operation attributes. */
+        sr_cond_t cond;             /**< Condition variable for waiting on queued operations. */
+        pthread_t tids[SR_BG_THREAD_COUNT];  /**< Worker threads, started on demand. */
+        uint32_t thread_count;      /**< Started worker thread count. */
+        uint32_t idle_count;        /**< Worker threads waiting for an operation. */
+        int stop;                   /**< Whether the worker threads should exit after finishing all the operations. */
+        struct sr_bg_op_s *first;       /**< First queued operation. */
+        struct sr_bg_op_s *last;        /**< Last queued operation. */
+    } bg;                          /**< Background operations executed by worker threads. */
+
+    struct {
+        pthread_mutex_t lock;       /**< Session-shared lock for accessing the module job attributes. */
+        sr_cond_t cond;             /**< Condition variable for waiting on module jobs and their completion. */
+        pthread_t tids[SR_MODINFO_THREAD_COUNT - 1];    /**< Worker threads, started on demand. */
+        uint32_t thread_count;      /**< Started worker thread count. */
+        uint32_t busy_count;        /**< Worker threads currently processing jobs. */
+        int stop;                   /**< Whether the worker threads should exit. */
+        struct sr_modinfo_jobs_s *jobs; /**< Module jobs being processed, only of a single thread at a time. */
+    } mi_jobs;                      /**< Module jobs (validation, storing) of a single thread executed in parallel. */
+
+    struct {
+        pthread_mutex_t lock;       /**< Session-shared lock for accessing the cached mappings. */
+        struct sr_orig_shm_s *entries[SR_ORIG_SHM_CACHE_SIZE];  /**< Idle mappings, taken by one thread at a time. */
+        uint32_t count;             /**< Idle mapping count. */
+    } orig_shm;                     /**< Subscription SHM mappings used for originating events. */
 };
 
 /**
@@ -182,6 +247,7 @@ struct sr_session_ctx_s {
     sr_datastore_t ds;              /**< Datastore of the session. */
     uint32_t sid;                   /**< Session ID. */
     char *user;                     /**< Session (system) user. */
+    int user_changed;               /**< Whether @p user was changed from the process user. */
     char *nacm_user;                /**< Optional NACM user. If set, NACM is applied. */
     sr_error_info_t *err_info;      /**< Session error information. */
 
@@ -189,10 +255,12 @@ struct sr_session_ctx_s {
     void *orig_data;                /**< Originator data used for all events sent on this session. */
 
     sr_sub_event_t ev;              /**< Event of a callback session. ::SR_SUB_EV_NONE for standard user sessions. */
+    int ds_locked;                  /**< Whether any module was DS-locked using this session. */
 
     struct {
         char *orig_name;            /**< Set originator name by the event originator. */
         void *orig_data;            /**< Set originator data by the event originator. */
+        uint32_t data_version;      /**< Module data version with the changes applied, for change events. */
     } ev_data;                      /**< Event data from the originator. Valid only if ev is not ::SR_SUB_EV_NONE. */
     sr_error_info_t *ev_err_info;   /**< Event error info for the originator. */
 
@@ -205,6 +273,17 @@ struct sr_session_ctx_s {
         struct lyd_node *diff;      /**< Diff data tree, used for module change iterator. */
     } dt[SR_DS_COUNT];              /**< Session-exclusive prepared changes. */
 
+    struct sr_sess_page_s {
+        char *xpath;                /**< XPath of the paged get. */
+        sr_datastore_t ds;          /**< Datastore of the paged get. */
+        sr_get_options_t opts;      /**< Options of the paged get. */
+        int subtrees;               /**< Whether only subtree roots are selected (::sr_get_data_page()). */
+        sr_data_t *data;            /**< Data snapshot the nodes are selected from, keeps the context locked. */
+        struct ly_set *set;         /**< Selected nodes of the data snapshot in the document order. */
+        uint32_t next;              /**< Index of the first node of the next page in set. */
+        char *next_path;            /**< Path of the last returned node, resume path of the next page. */
+    } page;                         /**< Cursor of an unfinished paged get. */
+
     struct sr_sess_notif_buf {
         int thread_running;         /**< Flag whether the notification buffering thread of this session is running. */
         pthread_t tid;              /**< Thread ID of the thread. */
@@ -229,6 +308,7 @@ struct sr_subscription_ctx_s {
     ATOMIC_T thread_running;        /**< Flag whether the thread handling this subscription is running. */
     pthread_t tid;                  /**< Thread ID of the handler thread. */
     sr_rwlock_t subs_lock;          /**< Session-shared lock for accessing the subscriptions. */
+    ATOMIC_T rpc_worker_count;      /**< Running RPC slot worker threads, they may outlive their RPC subscription. */
     uint32_t last_sub_id;           /**< Subscription ID of the last created subscription. */
 
     struct modsub_change_s {
@@ -251,6 +331,7 @@ struct sr_subscription_ctx_s {
         uint32_t sub_count;         /**< Configuration change module XPath subscription count. */
 
         sr_shm_t sub_shm;           /**< Subscription SHM. */
+        sr_shm_t sub_data_shm;      /**< Subscription data SHM, kept mapped across events. */
     } *change_subs;                 /**< Change subscriptions for each module. */
     uint32_t change_sub_count;      /**< Change module subscription count. */
 
@@ -266,6 +347,7 @@ struct sr_subscription_ctx_s {
 
             ATOMIC_T request_id;    /**< Request ID of the last processed request. */
             sr_shm_t sub_shm;       /**< Subscription SHM. */
+            sr_shm_t sub_data_shm;  /**< Subscription data SHM, kept mapped across events. */
             ATOMIC_T suspended;     /**< Whether the subscription is suspended. */
         } *subs;                    /**< Operational subscriptions for each XPath. */
         uint32_t sub_count;         /**< Operational module XPath subscription count. */
@@ -302,11 +384,13 @@ struct sr_subscription_ctx_s {
             sr_session_ctx_t *sess; /**< Subscription session. */
             ATOMIC_T filtered_out;  /**< Number of notifications that were filtered out. */
             ATOMIC_T suspended;     /**< Whether the subscription is suspended. */
+            uint32_t ext_idx;       /**< Cached index of the subscription in ext SHM, valid if the sub ID matches. */
         } *subs;                    /**< Notification subscriptions for each XPath. */
         uint32_t sub_count;         /**< Notification module XPath subscription count. */
 
         ATOMIC_T request_id;        /**< Request ID of the last processed request. */
         sr_shm_t sub_shm;           /**< Subscription SHM. */
+        sr_shm_t sub_data_shm;      /**< Subscription data SHM, kept mapped across events. */
     } *notif_subs;                  /**< Notification subscriptions for each module. */
     uint32_t notif_sub_count;       /**< Notification module subscription count. */
 
@@ -321,14 +405,19 @@ struct sr_subscription_ctx_s {
             sr_rpc_tree_cb tree_cb; /**< Subscription tree callback. */
             void *private_data;     /**< Subscription callback private data. */
             sr_session_ctx_t *sess; /**< Subscription session. */
+            sr_subscr_options_t opts;   /**< Subscription options. */
 
-            ATOMIC_T request_id;    /**< Request ID of the last processed request. */
-            ATOMIC_T event;         /**< Type of the last processed event. */
+            ATOMIC_T request_id[SR_RPC_SUB_SLOT_COUNT]; /**< Request ID of the last processed request in each slot. */
+            ATOMIC_T event[SR_RPC_SUB_SLOT_COUNT];  /**< Type of the last processed event in each slot. */
             ATOMIC_T suspended;     /**< Whether the subscription is suspended. */
         } *subs;                    /**< RPC/action subscription for each XPath. */
         uint32_t sub_count;         /**< RPC/action XPath subscription count. */
 
         sr_shm_t sub_shm;           /**< Subscription SHM. */
+        sr_shm_t sub_data_shm[SR_RPC_SUB_SLOT_COUNT];   /**< Subscription data SHM of each slot, kept mapped across
+                                                             events. */
+        struct sr_shmsub_rpc_workers_s *workers;    /**< Worker threads processing pipelined slots, created on
+                                                         demand. */
     } *rpc_subs;                    /**< RPC/action subscriptions for each operation. */
     uint32_t rpc_sub_count;         /**< RPC/action operation subscription count. */
 };
@@ -356,6 +445,11 @@ typedef void (*sr_lock_recover_cb)(sr_lock_mode_t mode, sr_cid_t cid, void *data
  */
 extern const struct srplg_ds_s srpds_json;
 
+/**
+ * @brief Internal DS plugin "LYB DS shm".
+ */
+extern const struct srplg_ds_s srpds_lyb;
+
 /**
  * @brief Internal DS plugin "MONGO DS".
  */
@@ -86,23 +86,35 @@ sr_lycc_lock(sr_conn_ctx_t *conn, sr_lock_mode_t mode, int lydmods_lock, const c
             goto cleanup_unlock;
         }
 
-        /* context was updated, create a new one with the current modules */
-        if ((err_info = sr_ly_ctx_init(conn, &new_ctx))) {
+        /* context was updated, try to use the printed context image of the current modules */
+        if ((err_info = sr_ly_ctx_img_load(conn, main_shm->content_id, &new_ctx))) {
             goto cleanup_unlock;
         }
-        if ((err_info = sr_shmmod_ctx_load_modules(SR_CONN_MOD_SHM(conn), new_ctx, NULL))) {
-            if (!strcmp(err_info->err[err_info->err_count - 1].message, "Loading \"ietf-datastores\" module failed.")) {
-                if (!(tmp_err = sr_path_yang_dir(&path))) {
-                    sr_errinfo_new(&err_info, SR_ERR_UNSUPPORTED,
-                            "YANG modules directory \"%s\" is different than the one used when creating the SHM state. "
-                            "Either change the SHM state files prefix, too, or clear the current SHM state.",
-                            path);
-                    free(path);
-                } else {
-                    sr_errinfo_merge(&err_info, tmp_err);
+
+        if (!new_ctx) {
+            /* no image, create a new context with the current modules */
+            if ((err_info = sr_ly_ctx_init(conn, &new_ctx))) {
+                goto cleanup_unlock;
+            }
+            if ((err_info = sr_shmmod_ctx_load_modules(SR_CONN_MOD_SHM(conn), new_ctx, NULL))) {
+                if (!strcmp(err_info->err[err_info->err_count - 1].message, "Loading \"ietf-datastores\" module failed.")) {
+                    if (!(tmp_err = sr_path_yang_dir(&path))) {
+                        sr_errinfo_new(&err_info, SR_ERR_UNSUPPORTED,
+                                "YANG modules directory \"%s\" is different than the one used when creating the SHM state. "
+                                "Either change the SHM state files prefix, too, or clear the current SHM state.",
+                                path);
+                        free(path);
+                    } else {
+                        sr_errinfo_merge(&err_info, tmp_err);
+                    }
                 }
+                goto cleanup_unlock;
+            }
+
+            if (!(conn->opts & SR_CONN_CTX_SET_PRIV_PARSED)) {
+                /* print the context for other connections */
+                sr_ly_ctx_img_store(new_ctx, main_shm->content_id);
             }
-            goto cleanup_unlock;
         }
 
         /* use the new context */
@@ -127,7 +139,7 @@ sr_lycc_lock(sr_conn_ctx_t *conn, sr_lock_mode_t mode, int lydmods_lock, const c
     }
 
 cleanup_unlock:
-    ly_ctx_destroy(new_ctx);
+    sr_ly_ctx_destroy(new_ctx);
     if (err_info) {
         if (remap_mode) {
             /* MOD REMAP UNLOCK */
@@ -186,6 +186,44 @@ sr_edit_op(const struct lyd_node *edit_node, enum edit_op parent_op, enum edit_o
     return NULL;
 }
 
+/**
+ * @brief Get own CID meta/attribute of an edit node.
+ *
+ * @param[in] edit Edit node.
+ * @return Own stored CID, 0 if none.
+ */
+static sr_cid_t
+sr_edit_get_cid(const struct lyd_node *edit)
+{
+    struct lyd_meta *cid_meta;
+    struct lyd_attr *attr;
+
+    if (edit->schema) {
+        /* data node with metadata */
+        cid_meta = lyd_find_meta(edit->meta, NULL, "sysrepo:cid");
+        if (cid_meta) {
+            return cid_meta->value.uint32;
+        }
+    } else {
+        /* opaque node with attributes */
+        LY_LIST_FOR(((struct lyd_node_opaq *)edit)->attr, attr) {
+            if (strcmp(attr->name.name, "cid")) {
+                continue;
+            }
+            if ((attr->format == LY_VALUE_XML) && strcmp(attr->name.module_ns, "http://www.sysrepo.org/yang/sysrepo")) {
+                continue;
+            }
+            if ((attr->format == LY_VALUE_JSON) && strcmp(attr->name.module_name, "sysrepo")) {
+                continue;
+            }
+
+            return strtoul(attr->value, NULL, 10);
+        }
+    }
+
+    return 0;
+}
+
 /**
  * @brief Find CID meta of an edit node or its parents.
  *
@@ -198,8 +236,7 @@ static void
 sr_edit_find_cid(struct lyd_node *edit, sr_cid_t *cid, int *meta_own)
 {
     struct lyd_node *parent;
-    struct lyd_meta *cid_meta = NULL;
-    struct lyd_attr *attr;
+    sr_cid_t cur_cid;
 
     if (cid) {
         *cid = 0;
@@ -213,41 +250,16 @@ sr_edit_find_cid(struct lyd_node *edit, sr_cid_t *cid, int *meta_own)
     }
 
     for (parent = edit; parent; parent = lyd_parent(parent)) {
-        if (parent->schema) {
-            /* data node with metadata */
-            cid_meta = lyd_find_meta(parent->meta, NULL, "sysrepo:cid");
-            if (cid_meta) {
-                /* found */
-                if (cid) {
-                    *cid = cid_meta->value.uint32;
-                }
-                if (meta_own && (parent == edit)) {
-                    *meta_own = 1;
-                }
-                break;
+        cur_cid = sr_edit_get_cid(parent);
+        if (cur_cid) {
+            /* found */
+            if (cid) {
+                *cid = cur_cid;
             }
-        } else {
-            /* opaque node with attributes */
-            LY_LIST_FOR(((struct lyd_node_opaq *)parent)->attr, attr) {
-                if (strcmp(attr->name.name, "cid")) {
-                    continue;
-                }
-                if ((attr->format == LY_VALUE_XML) && strcmp(attr->name.module_ns, "http://www.sysrepo.org/yang/sysrepo")) {
-                    continue;
-                }
-                if ((attr->format == LY_VALUE_JSON) && strcmp(attr->name.module_name, "sysrepo")) {
-                    continue;
-                }
-
-                /* found */
-                if (cid) {
-                    *cid = strtoul(attr->value, NULL, 10);
-                }
-                if (meta_own && (parent == edit)) {
-                    *meta_own = 1;
-                }
-                break;
+            if (meta_own && (parent == edit)) {
+                *meta_own = 1;
             }
+            break;
         }
 
         if (!cid) {
@@ -1014,33 +1026,376 @@ sr_edit_userord_is_moved(const struct lyd_node *data_match, enum insert_val inse
     return 0;
 }
 
+/**
+ * @brief Index of top-level user-ordered (leaf-)list instances of one schema node. Children of inner nodes are
+ * hashed by libyang but top-level siblings are not so any lookup among them would be linear.
+ */
+struct sr_edit_inst_idx {
+    const struct lysc_node *schema; /**< schema node of the instances */
+    struct ly_ht *inst_ht;          /**< instances hashed by keys/value, not for duplicate-instance (leaf-)lists */
+    struct ly_set insts;            /**< instances in their order, only for duplicate-instance (leaf-)lists */
+    int insts_valid;                /**< whether insts are valid, they are rebuilt lazily after an arbitrary change */
+    struct lyd_node *first;         /**< first instance, only for inst_ht */
+    struct lyd_node *last;          /**< last instance, only for inst_ht */
+};
+
+/**
+ * @brief Instance indexes of a single edit application, built lazily.
+ */
+struct sr_edit_idx {
+    struct lyd_node **data_root;    /**< first top-level sibling of the data tree */
+    struct sr_edit_inst_idx *idxs;  /**< instance indexes */
+    uint32_t idx_count;             /**< count of idxs */
+};
+
+/**
+ * @brief Comparison callback for indexed (leaf-)list instances.
+ *
+ * Implementation of ::lyht_value_equal_cb.
+ */
+static ly_bool
+sr_edit_inst_idx_equal_cb(void *val1_p, void *val2_p, ly_bool mod, void *UNUSED(cb_data))
+{
+    struct lyd_node *val1, *val2;
+
+    val1 = *(struct lyd_node **)val1_p;
+    val2 = *(struct lyd_node **)val2_p;
+
+    if (mod) {
+        /* removing a specific instance */
+        return val1 == val2;
+    }
+
+    /* same keys/value */
+    return !lyd_compare_single(val1, val2, 0);
+}
+
+/**
+ * @brief Free all the instance indexes of an edit application.
+ *
+ * @param[in] idx Instance indexes to free.
+ */
+static void
+sr_edit_idx_erase(struct sr_edit_idx *idx)
+{
+    uint32_t i;
+
+    for (i = 0; i < idx->idx_count; ++i) {
+        lyht_free(idx->idxs[i].inst_ht, NULL);
+        ly_set_erase(&idx->idxs[i].insts, NULL);
+    }
+    free(idx->idxs);
+}
+
+/**
+ * @brief Find an existing instance index.
+ *
+ * @param[in] idx Instance indexes, may be NULL.
+ * @param[in] schema Schema node of the instances.
+ * @return Instance index, NULL if none.
+ */
+static struct sr_edit_inst_idx *
+sr_edit_idx_find(struct sr_edit_idx *idx, const struct lysc_node *schema)
+{
+    uint32_t i;
+
+    if (!idx) {
+        return NULL;
+    }
+
+    for (i = 0; i < idx->idx_count; ++i) {
+        if (idx->idxs[i].schema == schema) {
+            return &idx->idxs[i];
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Make sure the ordered instances of a duplicate-instance (leaf-)list index are valid.
+ *
+ * @param[in] idx Instance indexes.
+ * @param[in] inst_idx Instance index to update.
+ * @return err_info, NULL on success.
+ */
+static sr_error_info_t *
+sr_edit_idx_insts_update(struct sr_edit_idx *idx, struct sr_edit_inst_idx *inst_idx)
+{
+    sr_error_info_t *err_info = NULL;
+    struct lyd_node *iter;
+
+    if (inst_idx->insts_valid) {
+        return NULL;
+    }
+
+    ly_set_clean(&inst_idx->insts, NULL);
+    LY_LIST_FOR(*idx->data_root, iter) {
+        if ((iter->schema == inst_idx->schema) && (err_info = sr_ly_set_add(&inst_idx->insts, iter))) {
+            return err_info;
+        }
+    }
+    inst_idx->insts_valid = 1;
+
+    return NULL;
+}
+
+/**
+ * @brief Get an instance index of top-level (leaf-)list instances, create it if it does not exist yet.
+ *
+ * @param[in] idx Instance indexes, NULL if the instances are not top-level.
+ * @param[in] schema Schema node of the instances.
+ * @param[out] inst_idx Instance index, NULL if the instances are not indexed.
+ * @return err_info, NULL on success.
+ */
+static sr_error_info_t *
+sr_edit_idx_get(struct sr_edit_idx *idx, const struct lysc_node *schema, struct sr_edit_inst_idx **inst_idx)
+{
+    sr_error_info_t *err_info = NULL;
+    struct sr_edit_inst_idx *new_idx;
+    struct lyd_node *iter;
+    uint32_t count;
+    void *mem;
+
+    *inst_idx = NULL;
+
+    if (!idx || !schema || !lysc_is_userordered(schema)) {
+        /* not indexed */
+        return NULL;
+    }
+
+    if ((*inst_idx = sr_edit_idx_find(idx, schema))) {
+        if (lysc_is_dup_inst_list(schema)) {
+            err_info = sr_edit_idx_insts_update(idx, *inst_idx);
+        }
+        return err_info;
+    }
+
+    /* add a new index */
+    mem = realloc(idx->idxs, (idx->idx_count + 1) * sizeof *idx->idxs);
+    SR_CHECK_MEM_RET(!mem, err_info);
+    idx->idxs = mem;
+    new_idx = &idx->idxs[idx->idx_count];
+    memset(new_idx, 0, sizeof *new_idx);
+    new_idx->schema = schema;
+    ++idx->idx_count;
+
+    if (lysc_is_dup_inst_list(schema)) {
+        /* positions of the instances */
+        if ((err_info = sr_edit_idx_insts_update(idx, new_idx))) {
+            return err_info;
+        }
+    } else {
+        /* hashes of the instances */
+        count = 0;
+        LY_LIST_FOR(*idx->data_root, iter) {
+            if (iter->schema == schema) {
+                ++count;
+            }
+        }
+        new_idx->inst_ht = lyht_new(lyht_get_fixed_size(count < 8 ? 8 : count), sizeof iter, sr_edit_inst_idx_equal_cb,
+                NULL, 1);
+        SR_CHECK_MEM_RET(!new_idx->inst_ht, err_info);
+
+        LY_LIST_FOR(*idx->data_root, iter) {
+            if (iter->schema != schema) {
+                continue;
+            }
+
+            if ((err_info = sr_lyht_insert(new_idx->inst_ht, &iter, iter->hash))) {
+                return err_info;
+            }
+            if (!new_idx->first) {
+                new_idx->first = iter;
+            }
+            new_idx->last = iter;
+        }
+    }
+
+    *inst_idx = new_idx;
+    return NULL;
+}
+
+/**
+ * @brief Update instance index before a (leaf-)list instance is unlinked from the data tree.
+ *
+ * @param[in] idx Instance indexes, may be NULL.
+ * @param[in] node Node to be unlinked, may not be linked at all.
+ */
+static void
+sr_edit_idx_inst_unlink(struct sr_edit_idx *idx, struct lyd_node *node)
+{
+    struct sr_edit_inst_idx *inst_idx;
+    struct lyd_node *next;
+
+    if (!node || lyd_parent(node) || !(inst_idx = sr_edit_idx_find(idx, node->schema))) {
+        /* not indexed */
+        return;
+    }
+
+    if ((node != *idx->data_root) && (node->prev == node)) {
+        /* not linked */
+        return;
+    }
+
+    if (inst_idx->inst_ht) {
+        if (inst_idx->first == node) {
+            next = node->next;
+            inst_idx->first = (next && (next->schema == node->schema)) ? next : NULL;
+        }
+        if (inst_idx->last == node) {
+            inst_idx->last = (struct lyd_node *)sr_edit_find_previous_instance(node);
+        }
+        lyht_remove(inst_idx->inst_ht, &node, node->hash);
+    } else if (inst_idx->insts_valid) {
+        if (inst_idx->insts.count && (inst_idx->insts.dnodes[inst_idx->insts.count - 1] == node)) {
+            /* removing the last instance */
+            --inst_idx->insts.count;
+        } else {
+            inst_idx->insts_valid = 0;
+        }
+    }
+}
+
+/**
+ * @brief Update instance index after a (leaf-)list instance was linked into the data tree.
+ *
+ * @param[in] idx Instance indexes, may be NULL.
+ * @param[in] node Linked node.
+ * @return err_info, NULL on success.
+ */
+static sr_error_info_t *
+sr_edit_idx_inst_link(struct sr_edit_idx *idx, struct lyd_node *node)
+{
+    sr_error_info_t *err_info = NULL;
+    struct sr_edit_inst_idx *inst_idx;
+    const struct lyd_node *prev;
+    int is_last;
+
+    if (lyd_parent(node) || !(inst_idx = sr_edit_idx_find(idx, node->schema))) {
+        /* not indexed */
+        return NULL;
+    }
+
+    prev = sr_edit_find_previous_instance(node);
+    is_last = !node->next || (node->next->schema != node->schema);
+
+    if (inst_idx->inst_ht) {
+        if (!prev) {
+            inst_idx->first = node;
+        }
+        if (is_last) {
+            inst_idx->last = node;
+        }
+        err_info = sr_lyht_insert(inst_idx->inst_ht, &node, node->hash);
+    } else if (inst_idx->insts_valid) {
+        if (is_last && ((!prev && !inst_idx->insts.count) ||
+                (inst_idx->insts.count && (prev == inst_idx->insts.dnodes[inst_idx->insts.count - 1])))) {
+            /* appending a new last instance */
+            err_info = sr_ly_set_add(&inst_idx->insts, node);
+        } else {
+            inst_idx->insts_valid = 0;
+        }
+    }
+
+    return err_info;
+}
+
+/**
+ * @brief Find an indexed (leaf-)list instance.
+ *
+ * @param[in] inst_idx Instance index.
+ * @param[in] inst Instance to find, from any tree.
+ * @return Found instance, NULL if not found.
+ */
+static struct lyd_node *
+sr_edit_idx_inst_find(const struct sr_edit_inst_idx *inst_idx, const struct lyd_node *inst)
+{
+    struct lyd_node **match_p;
+
+    if (lyht_find(inst_idx->inst_ht, &inst, inst->hash, (void **)&match_p)) {
+        return NULL;
+    }
+    return *match_p;
+}
+
+/**
+ * @brief Find an indexed (leaf-)list instance by its position.
+ *
+ * @param[in] inst_idx Instance index of a duplicate-instance (leaf-)list.
+ * @param[in] pos Position of the instance, starting at 1.
+ * @return Found instance, NULL if not found.
+ */
+static struct lyd_node *
+sr_edit_idx_inst_find_pos(const struct sr_edit_inst_idx *inst_idx, uint32_t pos)
+{
+    assert(inst_idx->insts_valid);
+
+    if (!pos || (pos > inst_idx->insts.count)) {
+        return NULL;
+    }
+    return inst_idx->insts.dnodes[pos - 1];
+}
+
+/**
+ * @brief Get the first or the last indexed (leaf-)list instance.
+ *
+ * @param[in] inst_idx Instance index.
+ * @param[in] last Whether to get the last instance instead of the first one.
+ * @return Instance, NULL if there are none.
+ */
+static struct lyd_node *
+sr_edit_idx_inst_edge(const struct sr_edit_inst_idx *inst_idx, int last)
+{
+    if (inst_idx->inst_ht) {
+        return last ? inst_idx->last : inst_idx->first;
+    }
+
+    assert(inst_idx->insts_valid);
+    if (!inst_idx->insts.count) {
+        return NULL;
+    }
+    return last ? inst_idx->insts.dnodes[inst_idx->insts.count - 1] : inst_idx->insts.dnodes[0];
+}
+
 /**
  * @brief Find a matching node in data tree for a specific (leaf-)list instance.
  *
  * @param[in] sibling First data tree sibling.
  * @param[in] llist Arbitrary instance of the (leaf-)list.
  * @param[in] userord_anchor Preceding user-ordered anchor of the searched instance.
+ * @param[in] idx Instance indexes, NULL if @p sibling is not top-level.
  * @param[out] match Matching instance in the data tree.
  * @return err_info, NULL on success.
  */
 static sr_error_info_t *
 sr_edit_find_userord_predicate(const struct lyd_node *sibling, const struct lyd_node *llist, const char *userord_anchor,
-        struct lyd_node **match)
+        struct sr_edit_idx *idx, struct lyd_node **match)
 {
     sr_error_info_t *err_info = NULL;
-    struct lyd_node *iter;
+    struct sr_edit_inst_idx *inst_idx;
+    struct lyd_node *iter, *anchor = NULL;
     uint32_t cur_pos, pos;
     int found = 0;
 
+    if ((err_info = sr_edit_idx_get(idx, llist->schema, &inst_idx))) {
+        return err_info;
+    }
+
     if (lysc_is_dup_inst_list(llist->schema)) {
         pos = strtoul(userord_anchor, NULL, 10);
-        cur_pos = 1;
-        LYD_LIST_FOR_INST(sibling, llist->schema, iter) {
-            if (cur_pos == pos) {
-                found = 1;
-                break;
+        if (inst_idx) {
+            iter = sr_edit_idx_inst_find_pos(inst_idx, pos);
+            found = iter ? 1 : 0;
+        } else {
+            cur_pos = 1;
+            LYD_LIST_FOR_INST(sibling, llist->schema, iter) {
+                if (cur_pos == pos) {
+                    found = 1;
+                    break;
+                }
+                ++cur_pos;
             }
-            ++cur_pos;
         }
         if (!found) {
             sr_errinfo_new(&err_info, SR_ERR_NOT_FOUND, "Node \"%s\" instance to insert next to not found.",
@@ -1049,9 +1404,22 @@ sr_edit_find_userord_predicate(const struct lyd_node *sibling, const struct lyd_
         }
         *match = iter;
     } else {
-        if ((err_info = sr_lyd_find_sibling_val(sibling, llist->schema, userord_anchor, match))) {
+        if (inst_idx) {
+            /* create the anchor instance to find it by its hash */
+            if (llist->schema->nodetype == LYS_LEAFLIST) {
+                err_info = sr_lyd_new_term2(NULL, llist->schema->module, llist->schema->name, userord_anchor, &anchor);
+            } else {
+                err_info = sr_lyd_new_list2(NULL, llist->schema->module, llist->schema->name, userord_anchor, &anchor);
+            }
+            if (err_info) {
+                return err_info;
+            }
+            *match = sr_edit_idx_inst_find(inst_idx, anchor);
+            lyd_free_tree(anchor);
+        } else if ((err_info = sr_lyd_find_sibling_val(sibling, llist->schema, userord_anchor, match))) {
             return err_info;
-        } else if (!*match) {
+        }
+        if (!*match) {
             sr_errinfo_new(&err_info, SR_ERR_NOT_FOUND, "Node \"%s\" instance to insert next to not found.",
                     llist->schema->name);
             return err_info;
@@ -1066,18 +1434,25 @@ sr_edit_find_userord_predicate(const struct lyd_node *sibling, const struct lyd_
  *
  * @param[in] data_sibling First sibling in the data tree.
  * @param[in] edit_node Edit node to match.
+ * @param[in] idx Instance indexes, NULL if @p data_sibling is not top-level.
  * @param[out] match_p Matching node.
  * @return err_info, NULL on success.
  */
 static sr_error_info_t *
-sr_edit_find_match(const struct lyd_node *data_sibling, const struct lyd_node *edit_node, struct lyd_node **match_p)
+sr_edit_find_match(const struct lyd_node *data_sibling, const struct lyd_node *edit_node, struct sr_edit_idx *idx,
+        struct lyd_node **match_p)
 {
     sr_error_info_t *err_info = NULL;
     const struct lysc_node *schema = NULL;
+    struct sr_edit_inst_idx *inst_idx = NULL;
     struct lyd_meta *m1, *m2;
     uint32_t inst_pos, pos;
     int found = 0;
 
+    if (edit_node->schema && (err_info = sr_edit_idx_get(idx, edit_node->schema, &inst_idx))) {
+        return err_info;
+    }
+
     if (!edit_node->schema) {
         /* opaque node, find the schema node first */
         schema = lyd_node_schema(edit_node);
@@ -1097,32 +1472,41 @@ sr_edit_find_match(const struct lyd_node *data_sibling, const struct lyd_node *e
         }
         pos = strtoul(lyd_get_meta_value(m1), NULL, 10);
 
-        /* iterate over all the instances */
-        lyd_find_sibling_val(data_sibling, edit_node->schema, NULL, 0, match_p);
-        inst_pos = 1;
-        while (pos && *match_p && ((*match_p)->schema == edit_node->schema)) {
-            m2 = lyd_find_meta((*match_p)->meta, NULL, "sysrepo:dup-inst-list-position");
-            if (m2) {
-                /* actually merging edits, try to find an instance with the same position */
-                if (pos == strtoul(lyd_get_meta_value(m2), NULL, 10)) {
-                    found = 1;
-                    break;
-                }
-            } else {
-                /* find instance on this position */
-                if (pos == inst_pos) {
-                    found = 1;
-                    break;
+        if (inst_idx) {
+            /* instance on this position in the data */
+            *match_p = sr_edit_idx_inst_find_pos(inst_idx, pos);
+            found = *match_p ? 1 : 0;
+        } else {
+            /* iterate over all the instances */
+            lyd_find_sibling_val(data_sibling, edit_node->schema, NULL, 0, match_p);
+            inst_pos = 1;
+            while (pos && *match_p && ((*match_p)->schema == edit_node->schema)) {
+                m2 = lyd_find_meta((*match_p)->meta, NULL, "sysrepo:dup-inst-list-position");
+                if (m2) {
+                    /* actually merging edits, try to find an instance with the same position */
+                    if (pos == strtoul(lyd_get_meta_value(m2), NULL, 10)) {
+                        found = 1;
+                        break;
+                    }
+                } else {
+                    /* find instance on this position */
+                    if (pos == inst_pos) {
+                        found = 1;
+                        break;
+                    }
                 }
-            }
 
-            *match_p = (*match_p)->next;
-            ++inst_pos;
+                *match_p = (*match_p)->next;
+                ++inst_pos;
+            }
         }
 
         if (!found) {
             *match_p = NULL;
         }
+    } else if (inst_idx) {
+        /* exact indexed (leaf-)list instance */
+        *match_p = sr_edit_idx_inst_find(inst_idx, edit_node);
     } else if (edit_node->schema->nodetype & (LYS_LIST | LYS_LEAFLIST)) {
         /* exact (leaf-)list instance */
         err_info = sr_lyd_find_sibling_first(data_sibling, edit_node, match_p);
@@ -1155,22 +1539,31 @@ sr_edit_find_match(const struct lyd_node *data_sibling, const struct lyd_node *e
  * @param[in] userord_anchor Optional user-ordered list anchor of relative (leaf-)list instance of the operation.
  * @param[in] dflt_ll_skip Whether to skip found default leaf-list instance.
  * @param[in] flags Flags modifying the behavior.
+ * @param[in] idx Instance indexes, NULL if @p data_sibling is not top-level.
  * @param[out] match_p Matching node.
  * @param[out] val_equal_p Whether even the value matches.
  * @return err_info, NULL on success.
  */
 static sr_error_info_t *
 sr_edit_find(const struct lyd_node *data_sibling, const struct lyd_node *edit_node, enum edit_op op, enum insert_val insert,
-        const char *userord_anchor, int dflt_ll_skip, int flags, struct lyd_node **match_p, int *val_equal_p)
+        const char *userord_anchor, int dflt_ll_skip, int flags, struct sr_edit_idx *idx, struct lyd_node **match_p,
+        int *val_equal_p)
 {
     sr_error_info_t *err_info = NULL;
+    struct sr_edit_inst_idx *inst_idx;
     struct lyd_node *anchor_node;
     const struct lyd_node *match = NULL;
     int val_equal = 0;
 
     if ((op == EDIT_PURGE) && edit_node->schema && (edit_node->schema->nodetype & (LYS_LIST | LYS_LEAFLIST))) {
         /* find first instance */
-        if ((err_info = sr_lyd_find_sibling_val(data_sibling, edit_node->schema, NULL, (struct lyd_node **)&match))) {
+        if ((err_info = sr_edit_idx_get(idx, edit_node->schema, &inst_idx))) {
+            return err_info;
+        }
+        if (inst_idx) {
+            match = sr_edit_idx_inst_edge(inst_idx, 0);
+        } else if ((err_info = sr_lyd_find_sibling_val(data_sibling, edit_node->schema, NULL,
+                (struct lyd_node **)&match))) {
             return err_info;
         }
         if (match) {
@@ -1178,7 +1571,7 @@ sr_edit_find(const struct lyd_node *data_sibling, const struct lyd_node *edit_no
         }
     } else {
         /* find the edit node instance efficiently in data (if possible) */
-        if ((err_info = sr_edit_find_match(data_sibling, edit_node, (struct lyd_node **)&match))) {
+        if ((err_info = sr_edit_find_match(data_sibling, edit_node, idx, (struct lyd_node **)&match))) {
             return err_info;
         }
 
@@ -1213,7 +1606,8 @@ sr_edit_find(const struct lyd_node *data_sibling, const struct lyd_node *edit_no
                         anchor_node = NULL;
                         if (userord_anchor) {
                             /* find the anchor node if set */
-                            if ((err_info = sr_edit_find_userord_predicate(data_sibling, match, userord_anchor, &anchor_node))) {
+                            if ((err_info = sr_edit_find_userord_predicate(data_sibling, match, userord_anchor, idx,
+                                    &anchor_node))) {
                                 return err_info;
                             }
                         } else if (flags & EDIT_APPLY_REPLACE_R) {
@@ -1292,25 +1686,47 @@ sr_edit_op2str(enum edit_op op)
  * @param[in] new_node Edit node to insert.
  * @param[in] insert Place where to insert the node.
  * @param[in] userord_anchor Optional user-ordered anchor of relative (leaf-)list instance.
+ * @param[in] idx Instance indexes, NULL if not inserting a top-level node.
  * @return err_info, NULL on success.
  */
 static sr_error_info_t *
 sr_edit_insert(struct lyd_node **data_root, struct lyd_node *data_parent, struct lyd_node *new_node,
-        enum insert_val insert, const char *userord_anchor)
+        enum insert_val insert, const char *userord_anchor, struct sr_edit_idx *idx)
 {
     sr_error_info_t *err_info = NULL;
+    struct sr_edit_inst_idx *inst_idx;
     struct lyd_node *anchor;
 
     assert(new_node);
 
     /* unlink properly first to avoid unwanted behavior (first node equals new_node or new_node is the first sibling) */
+    sr_edit_idx_inst_unlink(idx, new_node);
     if (new_node == *data_root) {
         *data_root = (*data_root)->next;
     }
     lyd_unlink_tree(new_node);
 
+    if ((err_info = sr_edit_idx_get(idx, new_node->schema, &inst_idx))) {
+        goto cleanup;
+    }
+
     /* insert last or first */
-    if ((insert == INSERT_DEFAULT) || (insert == INSERT_LAST)) {
+    if (inst_idx && (insert != INSERT_BEFORE) && (insert != INSERT_AFTER)) {
+        /* the first/last instance is known */
+        anchor = sr_edit_idx_inst_edge(inst_idx, insert != INSERT_FIRST);
+        if (!anchor) {
+            /* insert anywhere, there are no instances */
+            err_info = sr_lyd_insert_sibling(*data_root, new_node, data_root);
+        } else if (insert == INSERT_FIRST) {
+            lyd_insert_before(anchor, new_node);
+            if (anchor == *data_root) {
+                *data_root = new_node;
+            }
+        } else {
+            lyd_insert_after(anchor, new_node);
+        }
+        goto cleanup;
+    } else if ((insert == INSERT_DEFAULT) || (insert == INSERT_LAST)) {
         /* default insert is at the last position */
         if (data_parent) {
             if (new_node->flags & LYD_EXT) {
@@ -1351,7 +1767,7 @@ sr_edit_insert(struct lyd_node **data_root, struct lyd_node *data_parent, struct
 
     /* find the anchor sibling */
     if ((err_info = sr_edit_find_userord_predicate(data_parent ? lyd_child(data_parent) : *data_root, new_node,
-            userord_anchor, &anchor))) {
+            userord_anchor, idx, &anchor))) {
         goto cleanup;
     }
 
@@ -1371,6 +1787,9 @@ sr_edit_insert(struct lyd_node **data_root, struct lyd_node *data_parent, struct
     }
 
 cleanup:
+    if (!err_info) {
+        err_info = sr_edit_idx_inst_link(idx, new_node);
+    }
     return err_info;
 }
 
@@ -1870,6 +2289,7 @@ cleanup:
  * @param[in] key_or_value Optional relative list instance keys predicate or leaf-list value.
  * @param[in] diff_parent Current sysrepo diff parent.
  * @param[in,out] diff_root Sysrepo diff root node.
+ * @param[in] idx Instance indexes, NULL if not applying a top-level node.
  * @param[out] diff_node Created diff node.
  * @param[out] next_op Next operation to be performed with these nodes.
  * @param[out] change Whether some data change occurred.
@@ -1878,7 +2298,8 @@ cleanup:
 static sr_error_info_t *
 sr_edit_apply_move(struct lyd_node **data_root, struct lyd_node *data_parent, const struct lyd_node *edit_node,
         struct lyd_node **data_match, enum insert_val insert, const char *key_or_value, struct lyd_node *diff_parent,
-        struct lyd_node **diff_root, struct lyd_node **diff_node, enum edit_op *next_op, int *change)
+        struct lyd_node **diff_root, struct sr_edit_idx *idx, struct lyd_node **diff_node, enum edit_op *next_op,
+        int *change)
 {
     sr_error_info_t *err_info = NULL;
     const struct lyd_node *old_sibling_before, *sibling_before;
@@ -1904,18 +2325,18 @@ sr_edit_apply_move(struct lyd_node **data_root, struct lyd_node *data_parent, co
     old_sibling_before = sr_edit_find_previous_instance(*data_match);
 
     /* move the node */
-    if ((err_info = sr_edit_insert(data_root, data_parent, *data_match, insert, key_or_value))) {
+    if ((err_info = sr_edit_insert(data_root, data_parent, *data_match, insert, key_or_value, idx))) {
         goto error;
     }
 
     /* get previous instance after move */
     sibling_before = sr_edit_find_previous_instance(*data_match);
 
-    /* update diff with correct move information */
-    if (old_sibling_before) {
+    /* update diff with correct move information, the predicates are not needed without it */
+    if (old_sibling_before && (diff_parent || diff_root)) {
         old_sibling_before_val = sr_edit_create_userord_predicate(old_sibling_before);
     }
-    if (sibling_before) {
+    if (sibling_before && (diff_parent || diff_root)) {
         sibling_before_val = sr_edit_create_userord_predicate(sibling_before);
     }
     err_info = sr_edit_diff_add(*data_match, sibling_before_val, old_sibling_before_val, diff_op, diff_parent,
@@ -2078,6 +2499,7 @@ sr_edit_apply_replace(struct lyd_node *data_match, int val_equal, const struct l
  * @param[in] edit_node Current edit node.
  * @param[in] diff_parent Current sysrepo diff parent.
  * @param[in,out] diff_root Sysrepo diff root node.
+ * @param[in] idx Instance indexes, NULL if not applying a top-level node.
  * @param[out] diff_node Created diff node.
  * @param[out] next_op Next operation to be performed with these nodes.
  * @param[out] change Whether some data change occured.
@@ -2086,7 +2508,7 @@ sr_edit_apply_replace(struct lyd_node *data_match, int val_equal, const struct l
 static sr_error_info_t *
 sr_edit_apply_create(struct lyd_node **data_root, struct lyd_node *data_parent, struct lyd_node **data_match,
         int val_equal, const struct lyd_node *edit_node, struct lyd_node *diff_parent, struct lyd_node **diff_root,
-        struct lyd_node **diff_node, enum edit_op *next_op, int *change)
+        struct sr_edit_idx *idx, struct lyd_node **diff_node, enum edit_op *next_op, int *change)
 {
     sr_error_info_t *err_info = NULL;
 
@@ -2127,7 +2549,7 @@ sr_edit_apply_create(struct lyd_node **data_root, struct lyd_node *data_parent,
         return err_info;
     }
 
-    if ((err_info = sr_edit_insert(data_root, data_parent, *data_match, 0, NULL))) {
+    if ((err_info = sr_edit_insert(data_root, data_parent, *data_match, 0, NULL, idx))) {
         return err_info;
     }
 
@@ -2334,12 +2756,14 @@ sr_edit_apply_op_error(sr_error_info_t **err_info, enum edit_op op)
  * @param[in] diff_parent Current sysrepo diff parent.
  * @param[in,out] diff_root Sysrepo diff root node.
  * @param[in] flags Flags modifying the behavior.
+ * @param[in] idx Instance indexes of top-level nodes, NULL for descendants.
  * @param[out] change Set if there are some data changes.
  * @return err_info, NULL on success.
  */
 static sr_error_info_t *
 sr_edit_apply_r(struct lyd_node **data_root, struct lyd_node *data_parent, const struct lyd_node *edit_node,
-        enum edit_op parent_op, struct lyd_node *diff_parent, struct lyd_node **diff_root, int flags, int *change)
+        enum edit_op parent_op, struct lyd_node *diff_parent, struct lyd_node **diff_root, int flags,
+        struct sr_edit_idx *idx, int *change)
 {
     sr_error_info_t *err_info = NULL;
     struct lyd_node *data_match = NULL, *child, *next, *edit_match, *diff_node = NULL, *data_del = NULL;
@@ -2380,7 +2804,7 @@ sr_edit_apply_r(struct lyd_node **data_root, struct lyd_node *data_parent, const
 reapply:
     /* find an equal node in the current data */
     if ((err_info = sr_edit_find(data_parent ? lyd_child(data_parent) : *data_root, edit_node, op, insert, key_or_value,
-            1, flags, &data_match, &val_equal))) {
+            1, flags, idx, &data_match, &val_equal))) {
         goto cleanup;
     }
 
@@ -2397,7 +2821,7 @@ reapply:
             break;
         case EDIT_CREATE:
             if ((err_info = sr_edit_apply_create(data_root, data_parent, &data_match, val_equal, edit_node, diff_parent,
-                    diff_root, &diff_node, &next_op, change))) {
+                    diff_root, idx, &diff_node, &next_op, change))) {
                 sr_edit_apply_op_error(&err_info, op);
                 goto cleanup;
             }
@@ -2434,7 +2858,7 @@ reapply:
             break;
         case EDIT_MOVE:
             if ((err_info = sr_edit_apply_move(data_root, data_parent, edit_node, &data_match, insert, key_or_value,
-                    diff_parent, diff_root, &diff_node, &next_op, change))) {
+                    diff_parent, diff_root, idx, &diff_node, &next_op, change))) {
                 sr_edit_apply_op_error(&err_info, op);
                 goto cleanup;
             }
@@ -2479,6 +2903,7 @@ reapply:
          * try this whole edit again */
         prev_op = 0;
         diff_node = NULL;
+        sr_edit_idx_inst_unlink(idx, data_del);
         sr_lyd_free_tree_safe(data_del, data_root);
         data_del = NULL;
         free(origin);
@@ -2496,12 +2921,12 @@ reapply:
     if (flags & (EDIT_APPLY_REPLACE_R | EDIT_APPLY_DELETE_R)) {
         /* remove all non-default children that are not in the edit, recursively */
         LY_LIST_FOR_SAFE(lyd_child_no_keys(data_match), next, child) {
-            if ((err_info = sr_edit_find(lyd_child_no_keys(edit_node), child, EDIT_REMOVE, 0, NULL, 0, 0,
+            if ((err_info = sr_edit_find(lyd_child_no_keys(edit_node), child, EDIT_REMOVE, 0, NULL, 0, 0, NULL,
                     &edit_match, NULL))) {
                 goto cleanup;
             }
             if (!edit_match && (err_info = sr_edit_apply_r(data_root, data_match, child, EDIT_REMOVE, diff_parent,
-                    diff_root, flags, change))) {
+                    diff_root, flags, NULL, change))) {
                 goto cleanup;
             }
         }
@@ -2510,7 +2935,7 @@ reapply:
     /* apply edit recursively, keys are being checked, in case we were called by the recursion above,
      * edit_node and data_match are the same and so child will be freed, hence the safe loop */
     LY_LIST_FOR_SAFE(lyd_child(edit_node), next, child) {
-        if ((err_info = sr_edit_apply_r(data_root, data_match, child, op, diff_parent, diff_root, flags, change))) {
+        if ((err_info = sr_edit_apply_r(data_root, data_match, child, op, diff_parent, diff_root, flags, NULL, change))) {
             goto cleanup;
         }
     }
@@ -2523,6 +2948,7 @@ reapply:
     }
 
 cleanup:
+    sr_edit_idx_inst_unlink(idx, data_del);
     sr_lyd_free_tree_safe(data_del, data_root);
     free(origin);
     return err_info;
@@ -2535,6 +2961,7 @@ sr_edit_mod_apply(const struct lyd_node *edit, const struct lys_module *ly_mod,
     sr_error_info_t *err_info = NULL;
     const struct lyd_node *root;
     struct lyd_node *mod_diff = NULL;
+    struct sr_edit_idx idx = {.data_root = data};
 
     if (change) {
         *change = 0;
@@ -2547,7 +2974,8 @@ sr_edit_mod_apply(const struct lyd_node *edit, const struct lys_module *ly_mod,
         }
 
         /* apply relevant nodes from the edit datatree */
-        if ((err_info = sr_edit_apply_r(data, NULL, root, EDIT_CONTINUE, NULL, diff ? &mod_diff : NULL, 0, change))) {
+        if ((err_info = sr_edit_apply_r(data, NULL, root, EDIT_CONTINUE, NULL, diff ? &mod_diff : NULL, 0, &idx,
+                change))) {
             goto cleanup;
         }
 
@@ -2567,6 +2995,7 @@ sr_edit_mod_apply(const struct lyd_node *edit, const struct lys_module *ly_mod,
     }
 
 cleanup:
+    sr_edit_idx_erase(&idx);
     lyd_free_siblings(mod_diff);
     return err_info;
 }
@@ -2757,6 +3186,52 @@ cleanup:
     return err_info;
 }
 
+/**
+ * @brief Discard the leaves collected by an edit merge because there was another change.
+ *
+ * @param[in,out] values Optional collected leaves, are freed.
+ */
+static void
+sr_edit_merge_values_discard(struct ly_set **values)
+{
+    if (values) {
+        ly_set_free(*values, NULL);
+        *values = NULL;
+    }
+}
+
+/**
+ * @brief Learn whether merging an edit leaf changes only the value of a target leaf.
+ *
+ * @param[in] trg_node Target edit tree node.
+ * @param[in] trg_op Operation of @p trg_node.
+ * @param[in] src_node Source edit tree node.
+ * @param[in] src_op Operation of @p src_node.
+ * @param[in] meta_changed Whether the metadata of @p trg_node were changed.
+ * @return Whether only the value is changed.
+ */
+static int
+sr_edit_merge_is_value_only(const struct lyd_node *trg_node, enum edit_op trg_op, const struct lyd_node *src_node,
+        enum edit_op src_op, int meta_changed)
+{
+    char *origin = NULL, *cur_origin = NULL;
+    int value_only;
+
+    if ((src_op != EDIT_MERGE) || (trg_op != EDIT_MERGE) || meta_changed || !trg_node->schema || !src_node->schema ||
+            (trg_node->schema->nodetype != LYS_LEAF)) {
+        return 0;
+    }
+
+    /* the origin must not change either */
+    sr_edit_diff_get_origin(trg_node, &cur_origin, NULL);
+    sr_edit_diff_get_origin(src_node, &origin, NULL);
+    value_only = (!origin && !cur_origin) || (origin && cur_origin && !strcmp(origin, cur_origin));
+
+    free(origin);
+    free(cur_origin);
+    return value_only;
+}
+
 /**
  * @brief Merge sysrepo edit subtrees, recursively. Optionally, sysrepo diff is being also created/updated.
  *
@@ -2767,17 +3242,18 @@ cleanup:
  * @param[in] cid Connection ID to use for the merged edit.
  * @param[in,out] diff_root Sysrepo diff root node.
  * @param[out] change Set if there are some changes in the target edit.
+ * @param[in,out] values Optional leaves with only their value changed, discarded on any other change.
  * @return err_info, NULL on success.
  */
 static sr_error_info_t *
 sr_edit_merge_r(struct lyd_node **trg_root, struct lyd_node *trg_parent, const struct lyd_node *src_node,
-        enum edit_op parent_op, uint32_t cid, struct lyd_node **diff_root, int *change)
+        enum edit_op parent_op, uint32_t cid, struct lyd_node **diff_root, int *change, struct ly_set **values)
 {
     sr_error_info_t *err_info = NULL;
     struct lyd_node *trg_node = NULL, *trg_sibling, *child_src, *child, *next;
     struct ly_set *set = NULL;
     enum edit_op src_op, trg_op, diff_op;
-    int val_equal, meta_changed = 0, trg_op_own;
+    int val_equal, meta_changed = 0, trg_op_own, cid_changed = 0;
     char *path = NULL, *any_val = NULL;
     const char *prev_val;
     uint32_t i;
@@ -2801,7 +3277,7 @@ sr_edit_merge_r(struct lyd_node **trg_root, struct lyd_node *trg_parent, const s
         }
     } else {
         /* find an equal node in the current data */
-        if ((err_info = sr_edit_find_match(trg_sibling, src_node, &trg_node))) {
+        if ((err_info = sr_edit_find_match(trg_sibling, src_node, NULL, &trg_node))) {
             goto cleanup;
         }
     }
@@ -2831,6 +3307,14 @@ sr_edit_merge_r(struct lyd_node **trg_root, struct lyd_node *trg_parent, const s
         if ((src_op != trg_op) || meta_changed || !val_equal) {
             /* change, append to diff */
             *change = 1;
+            if (values && *values && sr_edit_merge_is_value_only(trg_node, trg_op, src_node, src_op, meta_changed)) {
+                /* collect the leaf, its value is changed below */
+                if ((err_info = sr_ly_set_add(*values, trg_node))) {
+                    goto cleanup;
+                }
+            } else {
+                sr_edit_merge_values_discard(values);
+            }
             if ((src_op == EDIT_REMOVE) && (trg_op == EDIT_MERGE)) {
                 /* add the whole tree-to-merge into the diff, it was removed now */
                 err_info = sr_edit_diff_append(trg_node, sr_op_edit2diff(EDIT_REMOVE), NULL, 1, diff_root);
@@ -2899,14 +3383,19 @@ sr_edit_merge_r(struct lyd_node **trg_root, struct lyd_node *trg_parent, const s
         }
 
         /* update CID of the node */
-        if ((err_info = sr_edit_update_cid(trg_node, cid, 1, change))) {
+        if ((err_info = sr_edit_update_cid(trg_node, cid, 1, &cid_changed))) {
             goto cleanup;
         }
+        if (cid_changed) {
+            *change = 1;
+            sr_edit_merge_values_discard(values);
+        }
 
         if (src_op != EDIT_REMOVE) {
             /* merge descendants, recursively */
             LY_LIST_FOR(lyd_child_no_keys(src_node), child_src) {
-                if ((err_info = sr_edit_merge_r(trg_root, trg_node, child_src, src_op, cid, diff_root, change))) {
+                if ((err_info = sr_edit_merge_r(trg_root, trg_node, child_src, src_op, cid, diff_root, change,
+                        values))) {
                     goto cleanup;
                 }
             }
@@ -2934,6 +3423,7 @@ sr_edit_merge_r(struct lyd_node **trg_root, struct lyd_node *trg_parent, const s
 
         /* append to diff */
         *change = 1;
+        sr_edit_merge_values_discard(values);
         if ((err_info = sr_edit_diff_append(trg_node, sr_op_edit2diff(src_op), NULL, 1, diff_root))) {
             goto cleanup;
         }
@@ -2951,7 +3441,7 @@ cleanup:
 
 sr_error_info_t *
 sr_edit_mod_merge(const struct lyd_node *edit, uint32_t cid, const struct lys_module *ly_mod, struct lyd_node **data,
-        struct lyd_node **diff, int *change)
+        struct lyd_node **diff, int *change, struct ly_set **values)
 {
     sr_error_info_t *err_info = NULL;
     const struct lyd_node *root;
@@ -2968,7 +3458,7 @@ sr_edit_mod_merge(const struct lyd_node *edit, uint32_t cid, const struct lys_mo
         }
 
         /* merge relevant nodes from the edit datatree */
-        if ((err_info = sr_edit_merge_r(data, NULL, root, 0, cid, diff ? &mod_diff : NULL, change))) {
+        if ((err_info = sr_edit_merge_r(data, NULL, root, 0, cid, diff ? &mod_diff : NULL, change, values))) {
             goto cleanup;
         }
 
@@ -3008,7 +3498,7 @@ sr_edit_diff_edit_merge_r(struct lyd_node **trg_root, struct lyd_node *trg_paren
 
     /* find an equal node in the current data */
     trg_sibling = trg_parent ? lyd_child(trg_parent) : *trg_root;
-    if ((err_info = sr_edit_find_match(trg_sibling, src_node, &trg_node))) {
+    if ((err_info = sr_edit_find_match(trg_sibling, src_node, NULL, &trg_node))) {
         goto cleanup;
     }
 
@@ -3886,6 +4376,211 @@ error_safe:
     return err_info;
 }
 
+/**
+ * @brief Edit node created for a path prefix of a bulk edit item.
+ */
+struct sr_edit_bulk_prefix {
+    struct lyd_node *node;  /**< edit node of the prefix */
+    uint32_t len;           /**< length of the prefix */
+};
+
+/**
+ * @brief Learn path prefixes of a created bulk edit item.
+ *
+ * @param[in] xpath Path of the item.
+ * @param[in] node Created node of the item.
+ * @param[in] depth Number of cached prefixes shared with the item.
+ * @param[in,out] prefixes Cached prefixes, updated to the prefixes of @p xpath.
+ * @param[in,out] prefix_count Count of @p prefixes.
+ * @param[in,out] prefix_size Allocated size of @p prefixes.
+ * @return err_info, NULL on success.
+ */
+static sr_error_info_t *
+sr_edit_bulk_prefix_learn(const char *xpath, struct lyd_node *node, uint32_t depth,
+        struct sr_edit_bulk_prefix **prefixes, uint32_t *prefix_count, uint32_t *prefix_size)
+{
+    sr_error_info_t *err_info = NULL;
+    struct lyd_node *iter, *stop;
+    const char *xp, *mod_name, *name;
+    int mlen, len;
+    uint32_t i, count;
+    void *mem;
+
+    /* count the nodes below the shared prefix */
+    stop = depth ? (*prefixes)[depth - 1].node : NULL;
+    count = depth;
+    for (iter = node; iter != stop; iter = lyd_parent(iter)) {
+        ++count;
+    }
+
+    if (count > *prefix_size) {
+        mem = realloc(*prefixes, count * sizeof **prefixes);
+        SR_CHECK_MEM_RET(!mem, err_info);
+        *prefixes = mem;
+        *prefix_size = count;
+    }
+
+    /* nodes */
+    for (iter = node, i = count; i > depth; iter = lyd_parent(iter)) {
+        (*prefixes)[--i].node = iter;
+    }
+
+    /* lengths of their path prefixes */
+    xp = depth ? xpath + (*prefixes)[depth - 1].len : xpath;
+    for (i = depth; i < count; ++i) {
+        if (xp[0] != '/') {
+            break;
+        }
+        xp = sr_xpath_next_qname(xp + 1, &mod_name, &mlen, &name, &len);
+        while (xp[0] == '[') {
+            xp = sr_xpath_skip_predicate(xp);
+        }
+
+        (*prefixes)[i].len = xp - xpath;
+    }
+
+    if ((i < count) || xp[0]) {
+        /* the path does not match the nodes, do not reuse any of them */
+        count = 0;
+    }
+    *prefix_count = count;
+
+    return NULL;
+}
+
+/**
+ * @brief Find an edit node of a bulk edit item already created for the path of a previous item.
+ *
+ * @param[in] edit Created edit.
+ * @param[in] xpath Path of the item.
+ * @return Found inner node without an own operation, NULL if there is none.
+ */
+static struct lyd_node *
+sr_edit_bulk_find_created(const struct lyd_node *edit, const char *xpath)
+{
+    sr_error_info_t *err_info = NULL;
+    struct lyd_node *node = NULL;
+    int own_oper;
+
+    if (!edit) {
+        return NULL;
+    }
+
+    if ((err_info = sr_lyd_find_path(edit, xpath, 0, &node))) {
+        sr_errinfo_free(&err_info);
+        return NULL;
+    }
+
+    if (!node || !node->schema || (node->schema->nodetype & LYD_NODE_TERM)) {
+        /* terminal nodes are never created for the path of another item */
+        return NULL;
+    }
+    sr_edit_diff_find_oper(node, 0, &own_oper);
+    if (own_oper) {
+        /* created for another item with the same path */
+        return NULL;
+    }
+
+    return node;
+}
+
+sr_error_info_t *
+sr_edit_bulk_create(const struct ly_ctx *ly_ctx, const sr_edit_item_t *items, uint32_t item_count,
+        struct lyd_node **edit)
+{
+    sr_error_info_t *err_info = NULL;
+    struct sr_edit_bulk_prefix *prefixes = NULL, *prefix;
+    struct lyd_node *parent, *node;
+    const char *xpath, *operation, *prev_xpath = NULL;
+    uint32_t i, depth, common, opts, prefix_count = 0, prefix_size = 0;
+
+    *edit = NULL;
+
+    for (i = 0; i < item_count; ++i) {
+        xpath = items[i].xpath;
+        operation = items[i].operation;
+        if (!xpath) {
+            sr_errinfo_new(&err_info, SR_ERR_INVAL_ARG, "Missing path of edit item %" PRIu32 ".", i);
+            goto cleanup;
+        }
+        if (operation && strcmp(operation, "merge") && strcmp(operation, "replace") && strcmp(operation, "create") &&
+                strcmp(operation, "delete") && strcmp(operation, "remove") && strcmp(operation, "none")) {
+            sr_errinfo_new(&err_info, SR_ERR_INVAL_ARG, "Invalid operation \"%s\" of edit item \"%s\".", operation,
+                    xpath);
+            goto cleanup;
+        }
+
+        opts = LYD_NEW_PATH_WITH_OPAQ;
+        if (operation && (!strcmp(operation, "remove") || !strcmp(operation, "delete"))) {
+            opts |= LYD_NEW_PATH_OPAQ;
+        }
+
+        /* find the deepest node of a prefix shared with the previous item */
+        depth = 0;
+        if (prev_xpath) {
+            for (common = 0; xpath[common] && (xpath[common] == prev_xpath[common]); ++common) {}
+            for (depth = prefix_count; depth; --depth) {
+                prefix = &prefixes[depth - 1];
+                if ((prefix->len <= common) && (xpath[prefix->len] == '/') && prefix->node->schema) {
+                    break;
+                }
+            }
+        }
+
+        if (depth) {
+            /* create only the rest of the path */
+            prefix = &prefixes[depth - 1];
+            err_info = sr_lyd_new_path(prefix->node, ly_ctx, xpath + prefix->len + 1, items[i].value, opts, &parent,
+                    &node);
+        } else {
+            err_info = sr_lyd_new_path(*edit, ly_ctx, xpath, items[i].value, opts, &parent, &node);
+        }
+        if (err_info && !items[i].value && (node = sr_edit_bulk_find_created(*edit, xpath))) {
+            /* the node was created for the path of a previous descendant item, only add the operation to it */
+            sr_errinfo_free(&err_info);
+            depth = 0;
+        } else if (err_info) {
+            sr_errinfo_new(&err_info, SR_ERR_INVAL_ARG, "Invalid datastore edit.");
+            goto cleanup;
+        } else {
+            if (!*edit) {
+                for (*edit = node; lyd_parent(*edit); *edit = lyd_parent(*edit)) {}
+            }
+            *edit = lyd_first_sibling(*edit);
+
+            if (lysc_is_key(node->schema)) {
+                sr_errinfo_new(&err_info, SR_ERR_INVAL_ARG, "Editing list key \"%s\" is not supported, edit list "
+                        "instances instead.", LYD_NAME(node));
+                goto cleanup;
+            }
+
+            /* check all the created nodes for forbidden ones */
+            if ((err_info = sr_edit_add_check(parent, node))) {
+                goto cleanup;
+            }
+        }
+
+        /* add the operation of the node */
+        if (operation && (err_info = sr_edit_set_oper(node, operation))) {
+            goto cleanup;
+        }
+
+        /* remember the nodes of the path for the next item */
+        if ((err_info = sr_edit_bulk_prefix_learn(xpath, node, depth, &prefixes, &prefix_count, &prefix_size))) {
+            goto cleanup;
+        }
+        prev_xpath = xpath;
+    }
+
+cleanup:
+    free(prefixes);
+    if (err_info) {
+        lyd_free_siblings(*edit);
+        *edit = NULL;
+    }
+    return err_info;
+}
+
 sr_error_info_t *
 sr_diff_set_getnext(struct ly_set *set, uint32_t *idx, struct lyd_node **node, sr_change_oper_t *op)
 {
@@ -4077,10 +4772,33 @@ cleanup:
 }
 
 /**
- * @brief Update a stored edit subtree by deleting nodes belonging to a connection and optionally selected by an xpath.
+ * @brief Learn whether a CID is one of the deleted connections.
+ *
+ * @param[in] cid CID to check.
+ * @param[in] cids Deleted connection CIDs.
+ * @param[in] cid_count Count of @p cids.
+ * @return Whether the CID is deleted.
+ */
+static int
+sr_edit_oper_del_cid_match(sr_cid_t cid, const sr_cid_t *cids, uint32_t cid_count)
+{
+    uint32_t i;
+
+    for (i = 0; i < cid_count; ++i) {
+        if (cids[i] == cid) {
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Update a stored edit subtree by deleting nodes belonging to connections and optionally selected by an xpath.
  *
  * @param[in] subtree Subtree to update, may be freed.
- * @param[in] cid CID of the deleted connection.
+ * @param[in] cids CIDs of the deleted connections.
+ * @param[in] cid_count Count of @p cids.
  * @param[in] parent_cid CID effective for (inherited from) the @p subtree parent.
  * @param[in] set Set of nodes selected by an xpath, only these can be deleted. If NULL, all the nodes can be deleted.
  * @param[out] child_cid_p CID effective for the @p subtree, 0 if it was deleted.
@@ -4088,8 +4806,8 @@ cleanup:
  * @return err_info, NULL on success.
  */
 static sr_error_info_t *
-sr_edit_oper_del_r(struct lyd_node *subtree, sr_cid_t cid, sr_cid_t parent_cid, struct ly_set *set,
-        sr_cid_t *child_cid_p, struct lyd_node **change_edit)
+sr_edit_oper_del_r(struct lyd_node *subtree, const sr_cid_t *cids, uint32_t cid_count, sr_cid_t parent_cid,
+        struct ly_set *set, sr_cid_t *child_cid_p, struct lyd_node **change_edit)
 {
     sr_error_info_t *err_info = NULL;
     struct lyd_node *next, *child;
@@ -4097,8 +4815,9 @@ sr_edit_oper_del_r(struct lyd_node *subtree, sr_cid_t cid, sr_cid_t parent_cid,
     int cid_own;
     char cid_str[11];
 
-    /* find our CID attribute, if any */
-    sr_edit_find_cid(subtree, &cur_cid, &cid_own);
+    /* find our CID attribute, if any, the parent CID is inherited otherwise */
+    cur_cid = sr_edit_get_cid(subtree);
+    cid_own = cur_cid ? 1 : 0;
     if (!cur_cid) {
         cur_cid = parent_cid;
     }
@@ -4106,7 +4825,7 @@ sr_edit_oper_del_r(struct lyd_node *subtree, sr_cid_t cid, sr_cid_t parent_cid,
     /* process children */
     child_cid = 0;
     LY_LIST_FOR_SAFE(lyd_child_no_keys(subtree), next, child) {
-        if ((err_info = sr_edit_oper_del_r(child, cid, cur_cid, set, &ch_cid, change_edit))) {
+        if ((err_info = sr_edit_oper_del_r(child, cids, cid_count, cur_cid, set, &ch_cid, change_edit))) {
             return err_info;
         }
 
@@ -4116,13 +4835,13 @@ sr_edit_oper_del_r(struct lyd_node *subtree, sr_cid_t cid, sr_cid_t parent_cid,
         }
     }
 
-    if ((cur_cid != cid) || (set && !ly_set_contains(set, subtree, NULL))) {
+    if (!sr_edit_oper_del_cid_match(cur_cid, cids, cid_count) || (set && !ly_set_contains(set, subtree, NULL))) {
         /* this node is not owned by the connection or not selected by the xpath, the subtree is kept */
         *child_cid_p = cur_cid;
         return NULL;
     }
 
-    if (child_cid && (child_cid != cid)) {
+    if (child_cid && !sr_edit_oper_del_cid_match(child_cid, cids, cid_count)) {
         /* this node was "deleted" but there are still some children */
         if (cid_own) {
             sr_edit_del_meta_attr(subtree, "cid");
@@ -4150,8 +4869,19 @@ sr_edit_oper_del_r(struct lyd_node *subtree, sr_cid_t cid, sr_cid_t parent_cid,
     return NULL;
 }
 
-sr_error_info_t *
-sr_edit_oper_del(struct lyd_node **edit, sr_cid_t cid, const char *xpath, struct lyd_node **change_edit)
+/**
+ * @brief Remove stored edit nodes that belong to any of the connections and that optionally match an xpath.
+ *
+ * @param[in,out] edit Edit to remove from.
+ * @param[in] cids Connection IDs of the deleted connections.
+ * @param[in] cid_count Count of @p cids.
+ * @param[in] xpath XPath selecting nodes to consider for deletion, NULL for all the nodes.
+ * @param[out] change_edit Optional change edit created for subscribers based on the changes made in oper edit.
+ * @return err_info, NULL on success.
+ */
+static sr_error_info_t *
+_sr_edit_oper_del(struct lyd_node **edit, const sr_cid_t *cids, uint32_t cid_count, const char *xpath,
+        struct lyd_node **change_edit)
 {
     sr_error_info_t *err_info = NULL;
     struct lyd_node *next, *elem;
@@ -4173,7 +4903,7 @@ sr_edit_oper_del(struct lyd_node **edit, sr_cid_t cid, const char *xpath, struct
     }
 
     LY_LIST_FOR_SAFE(*edit, next, elem) {
-        if ((err_info = sr_edit_oper_del_r(elem, cid, 0, set, &child_cid, change_edit))) {
+        if ((err_info = sr_edit_oper_del_r(elem, cids, cid_count, 0, set, &child_cid, change_edit))) {
             goto cleanup;
         }
 
@@ -4187,3 +4917,15 @@ cleanup:
     ly_set_free(set, NULL);
     return err_info;
 }
+
+sr_error_info_t *
+sr_edit_oper_del(struct lyd_node **edit, sr_cid_t cid, const char *xpath, struct lyd_node **change_edit)
+{
+    return _sr_edit_oper_del(edit, &cid, 1, xpath, change_edit);
+}
+
+sr_error_info_t *
+sr_edit_oper_del_cids(struct lyd_node **edit, const sr_cid_t *cids, uint32_t cid_count)
+{
+    return _sr_edit_oper_del(edit, cids, cid_count, NULL, NULL);
+}
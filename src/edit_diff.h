@@ -150,10 +150,12 @@ sr_error_info_t *sr_edit_mod_apply(const struct lyd_node *edit, const struct lys
  * @param[in,out] data Edit data tree to modify.
  * @param[in,out] diff Optionally create the diff of the original edit and the new one (or merge into diff).
  * @param[out] change Optional, set if there were some module changes.
+ * @param[in,out] values Optional empty set to collect the merged leaves in @p data with only their value changed.
+ * Freed and set to NULL if there were any other changes.
  * @return err_info, NULL on success.
  */
 sr_error_info_t *sr_edit_mod_merge(const struct lyd_node *edit, uint32_t cid, const struct lys_module *ly_mod,
-        struct lyd_node **data, struct lyd_node **diff, int *change);
+        struct lyd_node **data, struct lyd_node **diff, int *change, struct ly_set **values);
 
 /**
  * @brief Merge missing nodes in a diff from an edit and use 'none' operation for them.
@@ -185,6 +187,18 @@ sr_error_info_t *sr_edit_add(sr_session_ctx_t *session, const char *xpath, const
         const char *def_operation, const sr_move_position_t *position, const char *keys, const char *val,
         const char *origin, int isolate);
 
+/**
+ * @brief Create a new edit from bulk edit items.
+ *
+ * @param[in] ly_ctx Context to use.
+ * @param[in] items Edit items.
+ * @param[in] item_count Count of @p items.
+ * @param[out] edit Created edit, without any default operation.
+ * @return err_info, NULL on success.
+ */
+sr_error_info_t *sr_edit_bulk_create(const struct ly_ctx *ly_ctx, const sr_edit_item_t *items, uint32_t item_count,
+        struct lyd_node **edit);
+
 /**
  * @brief Get next change from a sysrepo diff set.
  *
@@ -207,4 +221,14 @@ sr_error_info_t *sr_diff_set_getnext(struct ly_set *set, uint32_t *idx, struct l
  */
 sr_error_info_t *sr_edit_oper_del(struct lyd_node **edit, sr_cid_t cid, const char *xpath, struct lyd_node **change_edit);
 
+/**
+ * @brief Remove all stored edit nodes that belong to any of several connections, in a single pass.
+ *
+ * @param[in,out] edit Edit to remove from.
+ * @param[in] cids Connection IDs of the deleted connections.
+ * @param[in] cid_count Count of @p cids.
+ * @return err_info, NULL on success.
+ */
+sr_error_info_t *sr_edit_oper_del_cids(struct lyd_node **edit, const sr_cid_t *cids, uint32_t cid_count);
+
 #endif
@@ -138,7 +138,7 @@ srpd_swap(struct srpd_plugin_s *a, struct srpd_plugin_s *b)
     *b = tmp;
 }
 
-static int
+int
 srpd_plugin_names_cmp(const struct srpd_plugin_s *plugin, const char *str2)
 {
     /* str1 does not have the filename extension */
@@ -155,7 +155,8 @@ srpd_plugin_names_cmp(const struct srpd_plugin_s *plugin, const char *str2)
 }
 
 int
-srpd_sort_plugins(sr_session_ctx_t *sess, struct srpd_plugin_s *plugins, int plugin_count, const char *plugin_name)
+srpd_sort_plugins(sr_session_ctx_t *sess, struct srpd_plugin_s *plugins, int plugin_count, const char *plugin_name,
+        int *ordered_count)
 {
     const char *xpath = "/sysrepo-plugind:sysrepo-plugind/plugin-order/plugin";
     sr_val_t *values;
@@ -177,6 +178,10 @@ srpd_sort_plugins(sr_session_ctx_t *sess, struct srpd_plugin_s *plugins, int plu
     }
     /* if values[i] wasn't found in plugins, it doesn't matter, it'll just be ignored. */
 
+    if (ordered_count) {
+        *ordered_count = ordered_part;
+    }
+
     sr_free_values(values, value_cnt);
     return SR_ERR_OK;
 }
@@ -31,6 +31,8 @@ struct srpd_plugin_s {
     void *handle;
     srp_init_cb_t init_cb;
     srp_cleanup_cb_t cleanup_cb;
+    const char **deps;
+    sr_session_ctx_t *sess;
     void *private_data;
     char *plugin_name;
     int initialized;
@@ -86,9 +88,20 @@ void srpd_swap(struct srpd_plugin_s *a, struct srpd_plugin_s *b);
  * @param[in] plugins Array of plugins to be sorted.
  * @param[in] plugin_count Number of plugins within the array.
  * @param[in] plugin_name Name of the plugin.
+ * @param[out] ordered_count Optional number of plugins at the beginning of the array in the user-defined order.
  * @return SR_ERR_OK on success.
  */
-int srpd_sort_plugins(sr_session_ctx_t *sess, struct srpd_plugin_s *plugins, int plugin_count, const char *plugin_name);
+int srpd_sort_plugins(sr_session_ctx_t *sess, struct srpd_plugin_s *plugins, int plugin_count, const char *plugin_name,
+        int *ordered_count);
+
+/**
+ * @brief Learn whether a plugin has a specific name.
+ *
+ * @param[in] plugin Plugin to examine.
+ * @param[in] name Plugin name, may or may not include the extension.
+ * @return 0 if the names match, non-zero otherwise.
+ */
+int srpd_plugin_names_cmp(const struct srpd_plugin_s *plugin, const char *name);
 
 /*
  * plugins
@@ -20,10 +20,15 @@
 #include <assert.h>
 #include <dirent.h>
 #include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
 #include <pthread.h>
 #include <stdarg.h>
 #include <stdio.h>
 #include <string.h>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 #include <libyang/libyang.h>
 #include <sysrepo.h>
@@ -32,8 +37,15 @@
 #include "config.h"
 #include "srpd_common.h"
 
+#ifdef SR_HAVE_ZLIB
+# include <zlib.h>
+#endif
+
 #define SRPD_PLUGIN_NAME "srpd_rotation"
 
+/** maximum time to wait for a notification directory change before checking whether to stop, in ms */
+#define SRPD_ROTATION_WAIT_TIMEOUT 1000
+
 /**
  * @brief Internal struct for rotation.
  *
@@ -42,7 +54,10 @@ typedef struct {
     ATOMIC64_T rotation_time;
     ATOMIC_PTR_T output_folder;
     ATOMIC_T compress;
+    ATOMIC_T output_changes;
     ATOMIC64_T rotated_files_count;
+    ATOMIC64_T rotated_bytes;
+    ATOMIC64_T archived_bytes;
     sr_subscription_ctx_t *subscr;
     pthread_t tid;
     ATOMIC_T running;
@@ -76,18 +91,25 @@ srpd_get_rot_count_cb(sr_session_ctx_t *session, uint32_t sub_id, const char *mo
     int rc = 0;
     const struct ly_ctx *ctx;
     char value[21];
+    uint64_t count;
     srpd_rotation_data_t *data = (srpd_rotation_data_t *)private_data;
 
     (void)sub_id;
     (void)module_name;
-    (void)path;
     (void)request_xpath;
     (void)request_id;
 
-    sprintf(value, "%" PRIu64, ATOMIC_LOAD_RELAXED(data->rotated_files_count));
+    if (!strcmp(path, "/sysrepo-plugind:sysrepo-plugind/notif-datastore/rotation/rotated-bytes")) {
+        count = ATOMIC_LOAD_RELAXED(data->rotated_bytes);
+    } else if (!strcmp(path, "/sysrepo-plugind:sysrepo-plugind/notif-datastore/rotation/archived-bytes")) {
+        count = ATOMIC_LOAD_RELAXED(data->archived_bytes);
+    } else {
+        count = ATOMIC_LOAD_RELAXED(data->rotated_files_count);
+    }
+
+    sprintf(value, "%" PRIu64, count);
     ctx = sr_session_acquire_context(session);
-    if ((rc = lyd_new_path(*parent, ctx, "/sysrepo-plugind:sysrepo-plugind/notif-datastore/rotation/rotated-files-count",
-            value, 0, NULL)) != LY_SUCCESS) {
+    if ((rc = lyd_new_path(*parent, ctx, path, value, 0, NULL)) != LY_SUCCESS) {
         goto cleanup;
     }
 
@@ -149,120 +171,423 @@ srpd_format_check(const char *file_name, time_t *file_time1, time_t *file_time2)
     return 0;
 }
 
+#ifdef SR_HAVE_ZLIB
+
+/**
+ * @brief Write a tar header field as an octal number.
+ *
+ * Values not fitting into the octal digits of the field (large UIDs/GIDs or sizes) are written
+ * using the base-256 extension understood by both GNU tar and bsdtar.
+ *
+ * @param[in] field Header field.
+ * @param[in] size Size of the field.
+ * @param[in] value Value to write.
+ */
+static void
+srpd_tar_octal(char *field, size_t size, uint64_t value)
+{
+    size_t i;
+
+    if (((size - 1) * 3 >= 64) || !(value >> ((size - 1) * 3))) {
+        snprintf(field, size, "%0*" PRIo64, (int)size - 1, value);
+        return;
+    }
+
+    /* base-256, big-endian with the highest bit of the first byte set */
+    for (i = size; i > 1; --i) {
+        field[i - 1] = value & 0xFF;
+        value >>= 8;
+    }
+    field[0] = (char)0x80;
+}
+
+/**
+ * @brief Create a gzip-compressed tar archive with a single file.
+ *
+ * @param[in] src_path Path to the file to archive.
+ * @param[in] st Stat of the file.
+ * @param[in] member_dir Directory of the file in the archive, without leading slash.
+ * @param[in] member_name Name of the file in the archive.
+ * @param[in] archive_path Path of the archive to create.
+ * @return 0 on success.
+ * @return -1 on failure.
+ */
+static int
+srpd_archive_file(const char *src_path, const struct stat *st, const char *member_dir, const char *member_name,
+        const char *archive_path)
+{
+    char block[512], buf[8192];
+    uint64_t left;
+    ssize_t r;
+    size_t len, dir_len;
+    uint32_t chksum, i;
+    gzFile gz = NULL;
+    int fd = -1, rc = -1;
+
+    dir_len = strlen(member_dir);
+    if (dir_len && (member_dir[dir_len - 1] == '/')) {
+        --dir_len;
+    }
+    if ((strlen(member_name) > 99) || (dir_len > 154)) {
+        SRPLG_LOG_ERR(SRPD_PLUGIN_NAME, "File name \"%s%s\" too long to be archived.", member_dir, member_name);
+        goto cleanup;
+    }
+
+    fd = open(src_path, O_RDONLY);
+    if (fd == -1) {
+        SRPLG_LOG_ERR(SRPD_PLUGIN_NAME, "Opening a file %s failed (%s).", src_path, strerror(errno));
+        goto cleanup;
+    }
+    gz = gzopen(archive_path, "wb");
+    if (!gz) {
+        SRPLG_LOG_ERR(SRPD_PLUGIN_NAME, "Creating an archive %s failed.", archive_path);
+        goto cleanup;
+    }
+
+    /* ustar header */
+    memset(block, 0, sizeof block);
+    strcpy(block, member_name);
+    srpd_tar_octal(block + 100, 8, st->st_mode & 07777);
+    srpd_tar_octal(block + 108, 8, st->st_uid);
+    srpd_tar_octal(block + 116, 8, st->st_gid);
+    srpd_tar_octal(block + 124, 12, st->st_size);
+    srpd_tar_octal(block + 136, 12, st->st_mtime);
+    block[156] = '0';
+    memcpy(block + 257, "ustar", 6);
+    memcpy(block + 263, "00", 2);
+    memcpy(block + 345, member_dir, dir_len);
+
+    /* checksum, computed with the checksum field filled with spaces */
+    memset(block + 148, ' ', 8);
+    chksum = 0;
+    for (i = 0; i < sizeof block; ++i) {
+        chksum += (unsigned char)block[i];
+    }
+    snprintf(block + 148, 8, "%06" PRIo32, chksum);
+
+    if (gzwrite(gz, block, sizeof block) != sizeof block) {
+        goto write_error;
+    }
+
+    /* file content, padded with zeros if it were truncated meanwhile */
+    left = st->st_size;
+    while (left) {
+        len = (left < sizeof buf) ? left : sizeof buf;
+        r = read(fd, buf, len);
+        if (r == -1) {
+            if (errno == EINTR) {
+                continue;
+            }
+            SRPLG_LOG_ERR(SRPD_PLUGIN_NAME, "Reading a file %s failed (%s).", src_path, strerror(errno));
+            goto cleanup;
+        } else if (!r) {
+            memset(buf, 0, len);
+            r = len;
+        }
+
+        if (gzwrite(gz, buf, r) != r) {
+            goto write_error;
+        }
+        left -= r;
+    }
+
+    /* padding of the content and the end-of-archive blocks */
+    memset(block, 0, sizeof block);
+    len = (512 - (st->st_size % 512)) % 512;
+    if (len && (gzwrite(gz, block, len) != (int)len)) {
+        goto write_error;
+    }
+    for (i = 0; i < 2; ++i) {
+        if (gzwrite(gz, block, sizeof block) != sizeof block) {
+            goto write_error;
+        }
+    }
+
+    r = gzclose(gz);
+    gz = NULL;
+    if (r != Z_OK) {
+        goto write_error;
+    }
+
+    rc = 0;
+    goto cleanup;
+
+write_error:
+    SRPLG_LOG_ERR(SRPD_PLUGIN_NAME, "Writing an archive %s failed.", archive_path);
+
+cleanup:
+    if (gz) {
+        gzclose(gz);
+    }
+    if (fd > -1) {
+        close(fd);
+    }
+    if (rc) {
+        unlink(archive_path);
+    }
+    return rc;
+}
+
+#endif
+
+/**
+ * @brief Rotate a single notification file, either archive or move it into the output folder.
+ *
+ * @param[in] data Rotation data.
+ * @param[in] notif_dir_name Notification directory.
+ * @param[in] file_name Notification file name.
+ * @return 0 on success.
+ * @return -1 on failure.
+ */
+static int
+srpd_rotate_file(srpd_rotation_data_t *data, const char *notif_dir_name, const char *file_name)
+{
+    const char *output_folder = ATOMIC_PTR_LOAD_RELAXED(data->output_folder);
+    char *src = NULL, *dst = NULL;
+    struct stat st, archive_st;
+    int rc = -1;
+
+#ifndef SR_HAVE_ZLIB
+    char *member = NULL;
+#endif
+
+    if (asprintf(&src, "%s%s", notif_dir_name, file_name) == -1) {
+        src = NULL;
+        goto cleanup;
+    }
+    if (stat(src, &st) == -1) {
+        SRPLG_LOG_ERR(SRPD_PLUGIN_NAME, "Stat of a file %s failed (%s).", src, strerror(errno));
+        goto cleanup;
+    }
+
+    if (ATOMIC_LOAD_RELAXED(data->compress)) {
+        if (asprintf(&dst, "%s%s.tar.gz", output_folder, file_name) == -1) {
+            dst = NULL;
+            goto cleanup;
+        }
+
+#ifdef SR_HAVE_ZLIB
+        /* compress the file in the output folder, skip the leading slash of its path */
+        if (srpd_archive_file(src, &st, notif_dir_name + 1, file_name, dst)) {
+            SRPLG_LOG_ERR(SRPD_PLUGIN_NAME, "Compressing a file %s failed.", src);
+            goto cleanup;
+        }
+#else
+        /* skip the leading slash */
+        if (asprintf(&member, "%s%s", notif_dir_name + 1, file_name) == -1) {
+            goto cleanup;
+        }
+
+        /* compress a file with tar in output folder */
+        if (srpd_exec(SRPD_PLUGIN_NAME, SRPD_TAR_BINARY, 6, SRPD_TAR_BINARY, "-czf", dst, "-C", "/", member)) {
+            SRPLG_LOG_ERR(SRPD_PLUGIN_NAME, "Compressing a file %s failed.", member);
+            free(member);
+            goto cleanup;
+        }
+        free(member);
+#endif
+
+        if (stat(dst, &archive_st) == -1) {
+            archive_st.st_size = 0;
+        }
+
+        /* remove a file from notif folder */
+        if (remove(src)) {
+            SRPLG_LOG_ERR(SRPD_PLUGIN_NAME, "Removing a file %s failed.", src);
+        }
+    } else {
+        if (asprintf(&dst, "%s%s", output_folder, file_name) == -1) {
+            dst = NULL;
+            goto cleanup;
+        }
+
+        /* move a file to the output folder */
+        if (rename(src, dst) == -1) {
+            SRPLG_LOG_ERR(SRPD_PLUGIN_NAME, "Moving a file %s failed.", src);
+            goto cleanup;
+        }
+        archive_st.st_size = st.st_size;
+    }
+
+    ATOMIC_INC_RELAXED(data->rotated_files_count);
+    ATOMIC_ADD_RELAXED(data->rotated_bytes, st.st_size);
+    ATOMIC_ADD_RELAXED(data->archived_bytes, archive_st.st_size);
+    rc = 0;
+
+cleanup:
+    free(src);
+    free(dst);
+    return rc;
+}
+
+/**
+ * @brief Rotate all the expired notification files.
+ *
+ * @param[in] data Rotation data.
+ * @param[in] notif_dir_name Notification directory.
+ * @param[in] rotation_time Time after which notification files expire.
+ * @param[out] next_rotation Time when the next file expires or the failed rotations are retried,
+ * 0 if there are no files.
+ * @return 0 on success.
+ * @return -1 if any file failed to be rotated.
+ */
+static int
+srpd_rotation_pass(srpd_rotation_data_t *data, const char *notif_dir_name, time_t rotation_time,
+        time_t *next_rotation)
+{
+    DIR *d;
+    struct dirent *dir;
+    time_t current_time, file_time2 = 0;
+    int rc = 0;
+
+    *next_rotation = 0;
+
+    /* remember current time */
+    time(&current_time);
+
+    /* open directory */
+    d = opendir(notif_dir_name);
+    if (!d) {
+        return 0;
+    }
+
+    /* read whole directory */
+    while ((dir = readdir(d)) && ATOMIC_LOAD_RELAXED(data->running)) {
+
+        /* skip current and parent directories */
+        if (!strcmp(dir->d_name, ".") || !strcmp(dir->d_name, "..")) {
+            continue;
+        }
+
+        /* check correct format of the file and retrieve file times */
+        if (srpd_format_check(dir->d_name, NULL, &file_time2)) {
+            continue;
+        }
+
+        /* check whether a file is older than configured time */
+        if ((current_time >= rotation_time) && (file_time2 < (current_time - rotation_time))) {
+            if (srpd_rotate_file(data, notif_dir_name, dir->d_name)) {
+                rc = -1;
+            }
+        } else if (!*next_rotation || (file_time2 + rotation_time + 1 < *next_rotation)) {
+            /* remember the earliest expiration */
+            *next_rotation = file_time2 + rotation_time + 1;
+        }
+    }
+    closedir(d);
+
+    if (rc) {
+        /* retry the failed rotations */
+        *next_rotation = current_time + 1;
+    }
+    return rc;
+}
+
+/**
+ * @brief Process all pending inotify events.
+ *
+ * @param[in] ino_fd Inotify file descriptor.
+ * @param[in,out] wd Watch descriptor, set to -1 if the watch was removed.
+ * @return Whether there was any event.
+ */
+static int
+srpd_rotation_inotify_read(int ino_fd, int *wd)
+{
+    char buf[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+    const struct inotify_event *ev;
+    ssize_t len;
+    char *ptr;
+    int events = 0;
+
+    while ((len = read(ino_fd, buf, sizeof buf)) > 0) {
+        for (ptr = buf; ptr < buf + len; ptr += sizeof *ev + ev->len) {
+            ev = (const struct inotify_event *)ptr;
+            if (ev->mask & IN_IGNORED) {
+                /* directory removed */
+                *wd = -1;
+            }
+            events = 1;
+        }
+    }
+
+    return events;
+}
+
 static void *
 srpd_rotation_loop(void *arg)
 {
-    int rc = 0;
-    DIR *d = NULL;
-    struct dirent *dir = NULL;
-    time_t current_time, file_time2 = 0;
     srpd_rotation_data_t *data = (srpd_rotation_data_t *)arg;
-    char *arg1 = NULL, *arg2 = NULL, *remove_str = NULL, *notif_dir_name = NULL;
+    char *notif_dir_name = NULL;
+    time_t current_time, rotation_time, last_rotation_time = 0, next_rotation = 0;
+    struct pollfd pfd;
+    int ino_fd = -1, wd = -1, rescan = 1;
+    uint32_t output_changes, last_output_changes;
 
     notif_dir_name = srpd_get_notif_path();
     if (!notif_dir_name) {
         SRPLG_LOG_ERR(SRPD_PLUGIN_NAME, "Notif directory is NULL.");
         goto cleanup;
     }
+    last_output_changes = ATOMIC_LOAD_RELAXED(data->output_changes);
     if (srpd_mkpath((char *)ATOMIC_PTR_LOAD_RELAXED(data->output_folder), 0777, NULL) == -1) {
         SRPLG_LOG_ERR(SRPD_PLUGIN_NAME, "Archive directory could not be created");
         goto cleanup;
     }
 
-    for ( ; ATOMIC_LOAD_RELAXED(data->running); sleep(1)) {
-
-        /* remember current time */
-        time(&current_time);
+    /* new notification files are noticed using inotify, otherwise the directory is scanned every second */
+    ino_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (ino_fd == -1) {
+        SRPLG_LOG_WRN(SRPD_PLUGIN_NAME, "Inotify not available (%s), scanning notification directory periodically.",
+                strerror(errno));
+    }
 
-        /* open directory */
-        d = opendir(notif_dir_name);
-        if (!d) {
-            continue;
+    while (ATOMIC_LOAD_RELAXED(data->running)) {
+        if ((ino_fd > -1) && (wd == -1)) {
+            /* watch the notification directory, it may not exist yet */
+            wd = inotify_add_watch(ino_fd, notif_dir_name, IN_CREATE | IN_MOVED_TO);
+            if (wd > -1) {
+                rescan = 1;
+            }
         }
 
-        /* read whole directory */
-        while ((dir = readdir(d)) && ATOMIC_LOAD_RELAXED(data->running)) {
-
-            /* skip current and parent directories */
-            if (!strcmp(dir->d_name, ".") || !strcmp(dir->d_name, "..")) {
-                continue;
-            }
+        /* rotation time may have been changed */
+        rotation_time = ATOMIC_LOAD_RELAXED(data->rotation_time);
+        if (rotation_time != last_rotation_time) {
+            last_rotation_time = rotation_time;
+            rescan = 1;
+        }
 
-            /* check correct format of the file and retrieve file times */
-            if (srpd_format_check(dir->d_name, NULL, &file_time2)) {
-                continue;
+        /* output folder or compression may have been changed, the files are rotated differently */
+        output_changes = ATOMIC_LOAD_RELAXED(data->output_changes);
+        if (output_changes != last_output_changes) {
+            last_output_changes = output_changes;
+            if (srpd_mkpath((char *)ATOMIC_PTR_LOAD_RELAXED(data->output_folder), 0777, NULL) == -1) {
+                SRPLG_LOG_ERR(SRPD_PLUGIN_NAME, "Archive directory could not be created");
             }
+            rescan = 1;
+        }
 
-            /* check whether a file is older than configured time */
-            if ((current_time >= (time_t)ATOMIC_LOAD_RELAXED(data->rotation_time)) &&
-                    (file_time2 < (current_time - (time_t)ATOMIC_LOAD_RELAXED(data->rotation_time)))) {
-
-                /* build compressing args */
-                if (ATOMIC_LOAD_RELAXED(data->compress)) {
-                    if (asprintf(&arg1, "%s%s.tar.gz", (char *)ATOMIC_PTR_LOAD_RELAXED(data->output_folder), dir->d_name) == -1) {
-                        goto cleanup;
-                    }
-
-                    /* skip the leading slash */
-                    if (asprintf(&arg2, "%s%s", notif_dir_name + 1, dir->d_name) == -1) {
-                        goto cleanup;
-                    }
-
-                    /* compress a file with tar in output folder */
-                    if ((rc = srpd_exec(SRPD_PLUGIN_NAME, SRPD_TAR_BINARY, 6, SRPD_TAR_BINARY, "-czf", arg1, "-C", "/", arg2))) {
-                        SRPLG_LOG_ERR(SRPD_PLUGIN_NAME, "Compressing a file %s failed.", arg2);
-                    } else {
-                        ATOMIC_INC_RELAXED(data->rotated_files_count);
-
-                        if (asprintf(&remove_str, "%s%s", notif_dir_name, dir->d_name) == -1) {
-                            goto cleanup;
-                        }
-
-                        /* remove a file from notif folder */
-                        if (remove(remove_str)) {
-                            SRPLG_LOG_ERR(SRPD_PLUGIN_NAME, "Removing a file %s failed.", remove_str);
-                        }
-                    }
-
-                    /* build moving args */
-                } else {
-                    if (asprintf(&arg1, "%s%s", notif_dir_name, dir->d_name) == -1) {
-                        goto cleanup;
-                    }
-                    if (asprintf(&arg2, "%s%s", (char *)ATOMIC_PTR_LOAD_RELAXED(data->output_folder), dir->d_name) == -1) {
-                        goto cleanup;
-                    }
-
-                    /* move a file to the output folder */
-                    if ((rc = rename(arg1, arg2)) == -1) {
-                        SRPLG_LOG_ERR(SRPD_PLUGIN_NAME, "Moving a file %s failed.", arg1);
-                    } else {
-                        ATOMIC_INC_RELAXED(data->rotated_files_count);
-                    }
-                }
+        /* rotate all the expired files in a single pass */
+        time(&current_time);
+        if (rescan || (wd == -1) || (next_rotation && (current_time >= next_rotation))) {
+            rescan = 0;
+            srpd_rotation_pass(data, notif_dir_name, rotation_time, &next_rotation);
+        }
 
-                /* reset commands for next folders */
-                rc = 0;
-                free(arg1);
-                free(arg2);
-                free(remove_str);
-                arg1 = NULL;
-                arg2 = NULL;
-                remove_str = NULL;
-            }
+        /* wait for a new file or a timeout to check for expired files and whether to stop */
+        pfd.fd = (wd > -1) ? ino_fd : -1;
+        pfd.events = POLLIN;
+        pfd.revents = 0;
+        if ((poll(&pfd, 1, SRPD_ROTATION_WAIT_TIMEOUT) > 0) && (pfd.revents & POLLIN)) {
+            rescan = srpd_rotation_inotify_read(ino_fd, &wd);
         }
-        closedir(d);
-        d = NULL;
     }
 
 cleanup:
-    free(arg1);
-    free(arg2);
-    free(remove_str);
-    free(notif_dir_name);
-    if (d) {
-        closedir(d);
+    if (ino_fd > -1) {
+        close(ino_fd);
     }
+    free(notif_dir_name);
     return NULL;
 }
 
@@ -346,6 +671,7 @@ srpd_rotation_change_cb(sr_session_ctx_t *session, uint32_t UNUSED(sub_id), cons
             ATOMIC_PTR_STORE_RELAXED(data->output_folder, dir_str);
             free(temp);
             temp = NULL;
+            ATOMIC_INC_RELAXED(data->output_changes);
 
         } else if (!strcmp(node->schema->name, "compress")) {
             if (!strcmp(lyd_get_value(node), "true")) {
@@ -353,6 +679,7 @@ srpd_rotation_change_cb(sr_session_ctx_t *session, uint32_t UNUSED(sub_id), cons
             } else {
                 ATOMIC_STORE_RELAXED(data->compress, 0);
             }
+            ATOMIC_INC_RELAXED(data->output_changes);
         }
     }
 
@@ -392,12 +719,22 @@ srpd_rotation_init_cb(sr_session_ctx_t *session, void **private_data)
         goto cleanup;
     }
 
-    /* create notification rotation state data change subscription */
+    /* create notification rotation state data change subscriptions */
     if ((rc = sr_oper_get_subscribe(session, "sysrepo-plugind", "/sysrepo-plugind:sysrepo-plugind/notif-datastore/rotation/rotated-files-count",
             srpd_get_rot_count_cb, data, 0, &data->subscr))) {
         SRPLG_LOG_ERR(SRPD_PLUGIN_NAME, "Failed to subscribe (%s)", sr_strerror(rc));
         goto cleanup;
     }
+    if ((rc = sr_oper_get_subscribe(session, "sysrepo-plugind", "/sysrepo-plugind:sysrepo-plugind/notif-datastore/rotation/rotated-bytes",
+            srpd_get_rot_count_cb, data, 0, &data->subscr))) {
+        SRPLG_LOG_ERR(SRPD_PLUGIN_NAME, "Failed to subscribe (%s)", sr_strerror(rc));
+        goto cleanup;
+    }
+    if ((rc = sr_oper_get_subscribe(session, "sysrepo-plugind", "/sysrepo-plugind:sysrepo-plugind/notif-datastore/rotation/archived-bytes",
+            srpd_get_rot_count_cb, data, 0, &data->subscr))) {
+        SRPLG_LOG_ERR(SRPD_PLUGIN_NAME, "Failed to subscribe (%s)", sr_strerror(rc));
+        goto cleanup;
+    }
 
 cleanup:
     if (rc) {
@@ -23,6 +23,7 @@
 #include <errno.h>
 #include <fcntl.h>
 #include <getopt.h>
+#include <inttypes.h>
 #include <pthread.h>
 #include <signal.h>
 #include <stdarg.h>
@@ -32,6 +33,7 @@
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <sys/wait.h>
+#include <time.h>
 #include <unistd.h>
 
 #include "bin_common.h"
@@ -50,6 +52,25 @@ pthread_cond_t cond = PTHREAD_COND_INITIALIZER;
 /** The name of the configuration module for the sysrepo-plugind program itself. */
 #define SRPD_MODULE_NAME "sysrepo-plugind"
 
+/** Initialization state of a plugin. */
+#define SRPD_INIT_WAITING 0
+#define SRPD_INIT_RUNNING 1
+#define SRPD_INIT_DONE 2
+
+/**
+ * @brief Shared context of parallel plugin initialization.
+ */
+struct srpd_init_s {
+    struct srpd_plugin_s *plugins;  /**< Plugins to initialize. */
+    int plugin_count;               /**< Plugin count. */
+    int ordered_count;              /**< Number of plugins in the user-defined order, always initialized in order. */
+    int *state;                     /**< Initialization state of every plugin. */
+    int fatal_fail;                 /**< Whether to stop initialization on the first failure. */
+    int abort;                      /**< Set if initialization was stopped. */
+    pthread_mutex_t lock;           /**< Lock for all the members. */
+    pthread_cond_t cond;            /**< Condition signalled on every plugin state change. */
+};
+
 /**
  * @brief An array of internal plugins
  */
@@ -89,7 +110,7 @@ help_print(void)
 {
     printf(
             "Usage:\n"
-            "  sysrepo-plugind [-h] [-v <level>] [-d]\n"
+            "  sysrepo-plugind [-h] [-v <level>] [-d] [-j <count>]\n"
             "\n"
             "Options:\n"
             "  -h, --help           Prints usage help.\n"
@@ -106,6 +127,11 @@ help_print(void)
             "                       plugin initialization is finished.\n"
             "  -f, --fatal-plugin-fail\n"
             "                       If any plugin initialization fails, terminate sysrepo-plugind.\n"
+            "  -j, --init-threads <count>\n"
+            "                       Initialize plugins in parallel using the number of threads (default 1).\n"
+            "                       Plugins in the configured plugin order and plugin dependencies are still\n"
+            "                       initialized in order, other plugins only after all the ordered ones.\n"
+            "                       Every plugin is given its own session.\n"
             "\n"
             "Environment variable $SRPD_PLUGINS_PATH overwrites the default plugins directory.\n"
             "\n");
@@ -343,6 +369,9 @@ load_plugins(struct srpd_plugin_s **plugins, int *plugin_count)
             break;
         }
 
+        /* optional dependencies */
+        plugin->deps = dlsym(handle, SRP_DEPS);
+
         /* finally store the plugin */
         plugin->handle = handle;
 
@@ -405,6 +434,248 @@ cleanup:
     return rc;
 }
 
+/**
+ * @brief Initialize a plugin and log the result.
+ *
+ * @param[in] plugin Plugin to initialize.
+ * @return Plugin initialization callback return value.
+ */
+static int
+init_plugin(struct srpd_plugin_s *plugin)
+{
+    struct timespec start, end;
+    uint64_t msec;
+    int r;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    r = plugin->init_cb(plugin->sess, &plugin->private_data);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    msec = (end.tv_sec - start.tv_sec) * 1000 + (end.tv_nsec - start.tv_nsec) / 1000000;
+
+    if (r) {
+        SRPLG_LOG_ERR("sysrepo-plugind", "Plugin \"%s\" initialization failed (%s) after %" PRIu64 " ms.",
+                plugin->plugin_name, sr_strerror(r), msec);
+    } else {
+        SRPLG_LOG_INF("sysrepo-plugind", "Plugin \"%s\" initialized in %" PRIu64 " ms.", plugin->plugin_name, msec);
+        plugin->initialized = 1;
+    }
+
+    return r;
+}
+
+/**
+ * @brief Find a plugin by its name.
+ *
+ * @param[in] plugins Array of plugins.
+ * @param[in] plugin_count Number of plugins.
+ * @param[in] name Plugin name, may or may not include the extension.
+ * @return Index of the plugin, -1 if not found.
+ */
+static int
+find_plugin(struct srpd_plugin_s *plugins, int plugin_count, const char *name)
+{
+    int i;
+
+    for (i = 0; i < plugin_count; ++i) {
+        if (!srpd_plugin_names_cmp(&plugins[i], name)) {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+/**
+ * @brief Learn whether a plugin can be initialized because all its dependencies are.
+ * Init lock must be held.
+ *
+ * @param[in] init Init context.
+ * @param[in] idx Index of the plugin.
+ * @return Whether the plugin is ready or not.
+ */
+static int
+init_plugin_is_ready(struct srpd_init_s *init, int idx)
+{
+    struct srpd_plugin_s *plugin = &init->plugins[idx];
+    int i, dep;
+
+    if ((idx > 0) && (idx < init->ordered_count) && (init->state[idx - 1] != SRPD_INIT_DONE)) {
+        /* previous plugin in the user-defined order not yet initialized */
+        return 0;
+    } else if ((idx >= init->ordered_count) && init->ordered_count &&
+            (init->state[init->ordered_count - 1] != SRPD_INIT_DONE)) {
+        /* plugins not in the user-defined order are initialized after all the ordered ones, as if sequentially */
+        return 0;
+    }
+
+    for (i = 0; plugin->deps && plugin->deps[i]; ++i) {
+        dep = find_plugin(init->plugins, init->plugin_count, plugin->deps[i]);
+        if ((dep > -1) && (dep != idx) && (init->state[dep] != SRPD_INIT_DONE)) {
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+/**
+ * @brief Thread initializing plugins whose dependencies are initialized until there are none left.
+ *
+ * @param[in] arg Init context.
+ * @return NULL.
+ */
+static void *
+init_plugins_thread(void *arg)
+{
+    struct srpd_init_s *init = arg;
+    int i, idx, waiting, running, r;
+
+    pthread_mutex_lock(&init->lock);
+
+    while (!init->abort) {
+        /* find a plugin ready to be initialized */
+        idx = -1;
+        waiting = 0;
+        running = 0;
+        for (i = 0; i < init->plugin_count; ++i) {
+            if (init->state[i] == SRPD_INIT_RUNNING) {
+                ++running;
+            } else if (init->state[i] == SRPD_INIT_WAITING) {
+                ++waiting;
+                if ((idx == -1) && init_plugin_is_ready(init, i)) {
+                    idx = i;
+                }
+            }
+        }
+
+        if (!waiting) {
+            /* all plugins initialized or being initialized */
+            break;
+        } else if (idx == -1) {
+            if (running) {
+                /* wait for a plugin to finish initialization */
+                pthread_cond_wait(&init->cond, &init->lock);
+                continue;
+            }
+
+            /* cyclic dependencies */
+            for (i = 0; i < init->plugin_count; ++i) {
+                if (init->state[i] == SRPD_INIT_WAITING) {
+                    SRPLG_LOG_ERR("sysrepo-plugind", "Plugin \"%s\" dependencies cannot be satisfied.",
+                            init->plugins[i].plugin_name);
+                    init->state[i] = SRPD_INIT_DONE;
+                }
+            }
+            if (init->fatal_fail) {
+                init->abort = 1;
+            }
+            pthread_cond_broadcast(&init->cond);
+            break;
+        }
+
+        /* initialize the plugin, unlocked */
+        init->state[idx] = SRPD_INIT_RUNNING;
+        pthread_mutex_unlock(&init->lock);
+
+        r = init_plugin(&init->plugins[idx]);
+
+        pthread_mutex_lock(&init->lock);
+        init->state[idx] = SRPD_INIT_DONE;
+        if (r && init->fatal_fail) {
+            init->abort = 1;
+        }
+        pthread_cond_broadcast(&init->cond);
+    }
+
+    pthread_mutex_unlock(&init->lock);
+    return NULL;
+}
+
+/**
+ * @brief Initialize plugins in parallel.
+ *
+ * @param[in] conn Connection to create plugin sessions on.
+ * @param[in] plugins Sorted array of plugins.
+ * @param[in] plugin_count Number of plugins.
+ * @param[in] ordered_count Number of plugins in the user-defined order.
+ * @param[in] thread_count Number of threads to use.
+ * @param[in] fatal_fail Whether to stop initialization on the first failure.
+ * @return 0 on success, -1 on error or a plugin initialization failure with @p fatal_fail.
+ */
+static int
+init_plugins_parallel(sr_conn_ctx_t *conn, struct srpd_plugin_s *plugins, int plugin_count, int ordered_count,
+        int thread_count, int fatal_fail)
+{
+    struct srpd_init_s init = {0};
+    pthread_t *tids = NULL;
+    int i, j, r, tid_count = 0, rc = 0;
+
+    /* every plugin gets its own session because sessions cannot be used concurrently */
+    for (i = 0; i < plugin_count; ++i) {
+        if ((r = sr_session_start(conn, SR_DS_RUNNING, &plugins[i].sess))) {
+            error_print(r, "Failed to start new session");
+            return -1;
+        }
+
+        for (j = 0; plugins[i].deps && plugins[i].deps[j]; ++j) {
+            if (find_plugin(plugins, plugin_count, plugins[i].deps[j]) == -1) {
+                SRPLG_LOG_WRN("sysrepo-plugind", "Plugin \"%s\" dependency \"%s\" not found.",
+                        plugins[i].plugin_name, plugins[i].deps[j]);
+            }
+        }
+    }
+
+    init.plugins = plugins;
+    init.plugin_count = plugin_count;
+    init.ordered_count = ordered_count;
+    init.fatal_fail = fatal_fail;
+    init.state = calloc(plugin_count, sizeof *init.state);
+    if (!init.state) {
+        error_print(0, "calloc() failed (%s).", strerror(errno));
+        return -1;
+    }
+    pthread_mutex_init(&init.lock, NULL);
+    pthread_cond_init(&init.cond, NULL);
+
+    /* start the threads, this thread initializes plugins as well */
+    if (thread_count > plugin_count) {
+        thread_count = plugin_count;
+    }
+    if (thread_count > 1) {
+        tids = malloc((thread_count - 1) * sizeof *tids);
+        if (!tids) {
+            error_print(0, "malloc() failed (%s).", strerror(errno));
+            rc = -1;
+            goto cleanup;
+        }
+    }
+    for (i = 0; i < thread_count - 1; ++i) {
+        if ((r = pthread_create(&tids[tid_count], NULL, init_plugins_thread, &init))) {
+            /* continue with fewer threads */
+            SRPLG_LOG_WRN("sysrepo-plugind", "Creating plugin initialization thread failed (%s).", strerror(r));
+            break;
+        }
+        ++tid_count;
+    }
+    init_plugins_thread(&init);
+
+    /* wait for all the plugins to be initialized */
+    for (i = 0; i < tid_count; ++i) {
+        pthread_join(tids[i], NULL);
+    }
+
+    if (init.abort) {
+        rc = -1;
+    }
+
+cleanup:
+    free(tids);
+    free(init.state);
+    pthread_mutex_destroy(&init.lock);
+    pthread_cond_destroy(&init.cond);
+    return rc;
+}
+
 static int
 open_pidfile(const char *pidfile)
 {
@@ -458,7 +729,9 @@ main(int argc, char **argv)
     sr_conn_ctx_t *conn = NULL;
     sr_session_ctx_t *sess = NULL;
     sr_log_level_t log_level = SR_LL_ERR;
-    int plugin_count = 0, i, r, rc = EXIT_FAILURE, opt, debug = 0, pidfd = -1, fatal_fail = 0;
+    int plugin_count = 0, ordered_count, i, r, rc = EXIT_FAILURE, opt, debug = 0, pidfd = -1, fatal_fail = 0;
+    int thread_count = 1;
+    struct timespec start, end;
     const char *plugins_dir, *pidfile = NULL;
 
     struct option options[] = {
@@ -469,12 +742,13 @@ main(int argc, char **argv)
         {"plugin-install",    required_argument, NULL, 'P'},
         {"pid-file",          required_argument, NULL, 'p'},
         {"fatal-plugin-fail", no_argument,       NULL, 'f'},
+        {"init-threads",      required_argument, NULL, 'j'},
         {NULL,                0,                 NULL, 0},
     };
 
     /* process options */
     opterr = 0;
-    while ((opt = getopt_long(argc, argv, "hVv:dP:p:f", options, NULL)) != -1) {
+    while ((opt = getopt_long(argc, argv, "hVv:dP:p:fj:", options, NULL)) != -1) {
         switch (opt) {
         case 'h':
             version_print();
@@ -525,6 +799,13 @@ main(int argc, char **argv)
         case 'f':
             fatal_fail = 1;
             break;
+        case 'j':
+            thread_count = atoi(optarg);
+            if (thread_count < 1) {
+                error_print(0, "Invalid thread count \"%s\"", optarg);
+                goto cleanup;
+            }
+            break;
         default:
             error_print(0, "Invalid option or missing argument: -%c", optopt);
             goto cleanup;
@@ -563,25 +844,28 @@ main(int argc, char **argv)
     }
 
     /* sort plugins based on user-defined order */
-    if ((r = srpd_sort_plugins(sess, plugins, plugin_count, "sysrepo-plugind"))) {
+    if ((r = srpd_sort_plugins(sess, plugins, plugin_count, "sysrepo-plugind", &ordered_count))) {
         error_print(r, "Sorting of plugins failed.");
         goto cleanup;
     }
 
     /* init plugins */
-    for (i = 0; i < plugin_count; ++i) {
-        r = plugins[i].init_cb(sess, &plugins[i].private_data);
-        if (r) {
-            SRPLG_LOG_ERR("sysrepo-plugind", "Plugin \"%s\" initialization failed (%s).", plugins[i].plugin_name,
-                    sr_strerror(r));
-            if (fatal_fail) {
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    if (thread_count > 1) {
+        if (init_plugins_parallel(conn, plugins, plugin_count, ordered_count, thread_count, fatal_fail)) {
+            goto cleanup;
+        }
+    } else {
+        for (i = 0; i < plugin_count; ++i) {
+            plugins[i].sess = sess;
+            if (init_plugin(&plugins[i]) && fatal_fail) {
                 goto cleanup;
             }
-        } else {
-            SRPLG_LOG_INF("sysrepo-plugind", "Plugin \"%s\" initialized.", plugins[i].plugin_name);
-            plugins[i].initialized = 1;
         }
     }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    SRPLG_LOG_INF("sysrepo-plugind", "All plugins initialized in %" PRIu64 " ms.",
+            (uint64_t)((end.tv_sec - start.tv_sec) * 1000 + (end.tv_nsec - start.tv_nsec) / 1000000));
 
     /* set state data */
     if ((r = publish_loaded_plugins(sess, plugins, plugin_count))) {
@@ -618,7 +902,10 @@ cleanup:
     for (i = 0; i < plugin_count; ++i) {
         /* plugin cleanup */
         if (plugins[i].initialized) {
-            plugins[i].cleanup_cb(sess, plugins[i].private_data);
+            plugins[i].cleanup_cb(plugins[i].sess, plugins[i].private_data);
+        }
+        if (plugins[i].sess && (plugins[i].sess != sess)) {
+            sr_session_stop(plugins[i].sess);
         }
 
         if (plugins[i].handle) {
@@ -87,6 +87,8 @@ help_print(void)
             "                               (\"xml\", \"json\", or \"lyb\"). Accepted by import, export, edit, rpc,\n"
             "                               notification, copy-from op.\n"
             "  -l, --lock                   Lock the specified datastore for the whole operation. Accepted by edit op.\n"
+            "  -b, --bulk                   Replace the data in bulk without generating any diff if there are no change\n"
+            "                               subscribers, meant for large imports. Accepted by import op.\n"
             "  -n, --not-strict             Silently ignore any unknown data. Accepted by import, edit, rpc, notification,\n"
             "                               copy-from op.\n"
             "  -o, --opaque                 Parse invalid nodes in the edit into opaque nodes. Accepted by edit op.\n"
@@ -320,7 +322,7 @@ step_create_input_file(LYD_FORMAT format, char *tmp_file)
 
 static int
 op_import(sr_session_ctx_t *sess, const char *file_path, const char *module_name, LYD_FORMAT format, int not_strict,
-        int timeout_s)
+        int bulk, int timeout_s)
 {
     const struct ly_ctx *ly_ctx;
     struct lyd_node *data;
@@ -334,7 +336,11 @@ op_import(sr_session_ctx_t *sess, const char *file_path, const char *module_name
     }
 
     /* replace config (always spends data) */
-    r = sr_replace_config(sess, module_name, data, timeout_s * 1000);
+    if (bulk) {
+        r = sr_replace_config_bulk(sess, module_name, data, timeout_s * 1000);
+    } else {
+        r = sr_replace_config(sess, module_name, data, timeout_s * 1000);
+    }
     if (r) {
         error_sr_print(sess);
         error_print(r, "Replace config failed");
@@ -468,7 +474,7 @@ op_edit(sr_session_ctx_t *sess, const char *file_path, const char *editor, const
     }
 
     /* use import operation to store edited data */
-    if (op_import(sess, tmp_file, module_name, format, not_strict, timeout_s)) {
+    if (op_import(sess, tmp_file, module_name, format, not_strict, 0, timeout_s)) {
         goto cleanup_unlock;
     }
 
@@ -762,7 +768,7 @@ main(int argc, char **argv)
     LYD_FORMAT format = LYD_UNKNOWN;
     const char *module_name = NULL, *editor = NULL, *file_path = NULL, *xpath = NULL, *op_str, *value = NULL;
     char *ptr;
-    int r, rc = EXIT_FAILURE, opt, operation = 0, lock = 0, not_strict = 0, opaq = 0, timeout = 0, wd_opt = 0;
+    int r, rc = EXIT_FAILURE, opt, operation = 0, lock = 0, bulk = 0, not_strict = 0, opaq = 0, timeout = 0, wd_opt = 0;
     uint32_t max_depth = 0;
     int no_subs = 0;
 
@@ -782,6 +788,7 @@ main(int argc, char **argv)
         {"xpath",           required_argument, NULL, 'x'},
         {"format",          required_argument, NULL, 'f'},
         {"lock",            no_argument,       NULL, 'l'},
+        {"bulk",            no_argument,       NULL, 'b'},
         {"not-strict",      no_argument,       NULL, 'n'},
         {"opaque",          no_argument,       NULL, 'o'},
         {"depth",           required_argument, NULL, 'p'},
@@ -800,7 +807,7 @@ main(int argc, char **argv)
 
     /* process options */
     opterr = 0;
-    while ((opt = getopt_long(argc, argv, "hVI::X::E::R::N::C:S:G:d:m:x:f:lnop:st:e:u:v:", options, NULL)) != -1) {
+    while ((opt = getopt_long(argc, argv, "hVI::X::E::R::N::C:S:G:d:m:x:f:lbnop:st:e:u:v:", options, NULL)) != -1) {
         /* parameters with optional arguments */
         switch (opt) {
         case 'I':
@@ -960,6 +967,9 @@ main(int argc, char **argv)
         case 'l':
             lock = 1;
             break;
+        case 'b':
+            bulk = 1;
+            break;
         case 'n':
             not_strict = 1;
             break;
@@ -1081,7 +1091,7 @@ main(int argc, char **argv)
     /* perform the operation */
     switch (operation) {
     case 'I':
-        rc = op_import(sess, file_path, module_name, format, not_strict, timeout);
+        rc = op_import(sess, file_path, module_name, format, not_strict, bulk, timeout);
         break;
     case 'X':
         rc = op_export(sess, file_path, module_name, xpath, format, max_depth, no_subs, wd_opt, timeout);
@@ -104,6 +104,8 @@ help_print(void)
             "  -P, --plugin-install <path>\n"
             "                       Install a datastore or notification sysrepo plugin. The plugin is simply copied\n"
             "                       to the designated plugin directory.\n"
+            "  -C, --compact-shm    Compact the shared memory with subscriptions by merging its free memory and\n"
+            "                       releasing any at its end.\n"
             "\n"
             "Available options:\n"
             "  -s, --search-dirs <dir-path> [:<dir-path>...]\n"
@@ -649,6 +651,7 @@ main(int argc, char **argv)
         {"update",          required_argument, NULL, 'U'},
         {"plugin-list",     no_argument,       NULL, 'L'},
         {"plugin-install",  required_argument, NULL, 'P'},
+        {"compact-shm",     no_argument,       NULL, 'C'},
         {"search-dirs",     required_argument, NULL, 's'},
         {"enable-feature",  required_argument, NULL, 'e'},
         {"disable-feature", required_argument, NULL, 'd'},
@@ -671,7 +674,7 @@ main(int argc, char **argv)
 
     /* process options */
     opterr = 0;
-    while ((opt = getopt_long(argc, argv, "hVli:u:c:U:LP:s:e:d:r:o:g:p:D:m:I:fv:", options, NULL)) != -1) {
+    while ((opt = getopt_long(argc, argv, "hVli:u:c:U:LP:Cs:e:d:r:o:g:p:D:m:I:fv:", options, NULL)) != -1) {
         switch (opt) {
         case 'h':
             /* help */
@@ -751,6 +754,14 @@ main(int argc, char **argv)
             operation = 'P';
             file_path = optarg;
             break;
+        case 'C':
+            /* compact-shm */
+            if (operation) {
+                error_print(0, "Operation already specified");
+                goto cleanup;
+            }
+            operation = 'C';
+            break;
         case 's':
             /* search-dirs */
             if (search_dirs) {
@@ -979,6 +990,13 @@ main(int argc, char **argv)
             goto cleanup;
         }
         break;
+    case 'C':
+        /* compact-shm */
+        if ((r = sr_compact_shm(conn))) {
+            error_print(r, "Failed to compact shared memory");
+            goto cleanup;
+        }
+        break;
     case 0:
         error_print(0, "No operation specified");
         goto cleanup;
@@ -20,8 +20,16 @@
 #include "ly_wrap.h"
 
 #include <assert.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
 #include <stdint.h>
+#include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 #include <libyang/hash_table.h>
 #include <libyang/libyang.h>
@@ -34,6 +42,34 @@
 #define SR_CHECK_LY_GOTO(cond, ly_ctx, err_info, go) if (cond) { sr_errinfo_new_ly(&(err_info), ly_ctx, NULL); goto go; }
 #define SR_CHECK_LY_RET(cond, ly_ctx, err_info) if (cond) { sr_errinfo_new_ly(&(err_info), ly_ctx, NULL); return err_info; }
 
+#if defined (SR_HAVE_LY_CTX_PRINTED) && defined (MAP_FIXED_NOREPLACE)
+# define SR_LY_CTX_IMG
+#endif
+
+#ifdef SR_LY_CTX_IMG
+
+/**
+ * @brief Header of the printed context image file, followed by the printed context.
+ */
+struct sr_ly_ctx_img_hdr {
+    uint32_t content_id;    /**< content ID of the modules in the printed context */
+    uint32_t padding;
+    uint64_t size;          /**< size of the printed context */
+};
+
+/**
+ * @brief Process-wide mapping of the context image, it is position-dependent so only a single one can be mapped
+ * at the fixed address and used by a single context.
+ */
+static struct {
+    pthread_mutex_t lock;       /**< lock for accessing the members */
+    void *addr;                 /**< mapped image, NULL if none */
+    size_t size;                /**< size of the mapping */
+    struct ly_ctx *ly_ctx;      /**< context created from the image */
+} sr_ly_ctx_img = {.lock = PTHREAD_MUTEX_INITIALIZER};
+
+#endif
+
 /**
  * @brief Log the error(s) from a libyang context and add them into an error info structure.
  *
@@ -219,6 +255,239 @@ cleanup:
     return err_info;
 }
 
+sr_error_info_t *
+sr_ly_ctx_img_load(sr_conn_ctx_t *conn, uint32_t content_id, struct ly_ctx **ly_ctx)
+{
+    sr_error_info_t *err_info = NULL;
+#ifdef SR_LY_CTX_IMG
+    struct sr_ly_ctx_img_hdr hdr;
+    struct stat st;
+    char *path = NULL;
+    void *addr = MAP_FAILED;
+    size_t size = 0;
+    int fd = -1, locked = 0;
+
+    *ly_ctx = NULL;
+
+    if (conn->opts & SR_CONN_CTX_SET_PRIV_PARSED) {
+        /* printed context includes only the compiled modules */
+        return NULL;
+    }
+
+    if ((err_info = sr_path_ctx_img(&path))) {
+        goto cleanup;
+    }
+
+    /* open the image, it may not exist */
+    fd = sr_open(path, O_RDONLY, 0);
+    if (fd == -1) {
+        if (errno != ENOENT) {
+            SR_LOG_WRN("Failed to open context image \"%s\" (%s).", path, strerror(errno));
+        }
+        goto cleanup;
+    }
+
+    /* check it is an image of the current modules */
+    if ((pread(fd, &hdr, sizeof hdr, 0) != sizeof hdr) || (hdr.content_id != content_id)) {
+        goto cleanup;
+    }
+    if ((fstat(fd, &st) == -1) || ((uint64_t)st.st_size != sizeof hdr + hdr.size)) {
+        goto cleanup;
+    }
+
+    /* PRINTED CTX LOCK */
+    pthread_mutex_lock(&sr_ly_ctx_img.lock);
+    locked = 1;
+
+    if (sr_ly_ctx_img.addr) {
+        /* the address is already used by another context */
+        goto cleanup;
+    }
+
+    /* map the image privately at the address it was printed to */
+    size = st.st_size;
+    addr = mmap(SR_LY_CTX_IMG_ADDR, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED_NOREPLACE, fd, 0);
+    if (addr == MAP_FAILED) {
+        SR_LOG_WRN("Failed to map context image \"%s\" (%s).", path, strerror(errno));
+        goto cleanup;
+    } else if (addr != SR_LY_CTX_IMG_ADDR) {
+        /* older kernels treat the flag only as a hint */
+        goto cleanup;
+    }
+
+    /* create the context */
+    if (ly_ctx_new_printed((char *)addr + sizeof hdr, ly_ctx)) {
+        SR_LOG_WRN("Failed to create a context from image \"%s\" (%s).", path, ly_last_logmsg());
+        *ly_ctx = NULL;
+        goto cleanup;
+    }
+
+    /* set the ext callback */
+    ly_ctx_set_ext_data_clb(*ly_ctx, sr_ly_ext_data_clb, conn);
+
+    /* the mapping is now owned by the context */
+    sr_ly_ctx_img.addr = addr;
+    sr_ly_ctx_img.size = size;
+    sr_ly_ctx_img.ly_ctx = *ly_ctx;
+    addr = MAP_FAILED;
+
+cleanup:
+    if (locked) {
+        /* PRINTED CTX UNLOCK */
+        pthread_mutex_unlock(&sr_ly_ctx_img.lock);
+    }
+    if (addr != MAP_FAILED) {
+        munmap(addr, size);
+    }
+    if (fd > -1) {
+        close(fd);
+    }
+    free(path);
+#else
+    (void)conn;
+    (void)content_id;
+
+    *ly_ctx = NULL;
+#endif
+    return err_info;
+}
+
+void
+sr_ly_ctx_img_store(const struct ly_ctx *ly_ctx, uint32_t content_id)
+{
+#ifdef SR_LY_CTX_IMG
+    sr_error_info_t *err_info = NULL;
+    struct sr_ly_ctx_img_hdr hdr = {0};
+    char *path = NULL, *tmp_path = NULL;
+    void *addr = MAP_FAILED;
+    size_t size = 0;
+    int fd = -1, r, locked = 0;
+
+    /* the image is only an optimization so all the errors are just warnings */
+    if ((err_info = sr_path_ctx_img(&path))) {
+        sr_errinfo_free(&err_info);
+        goto cleanup;
+    }
+    if (asprintf(&tmp_path, "%s.%ld", path, (long)getpid()) == -1) {
+        tmp_path = NULL;
+        goto cleanup;
+    }
+
+    /* learn the size */
+    if ((r = ly_ctx_compiled_size(ly_ctx)) < 0) {
+        SR_LOG_WRN("Failed to get the printed context size (%s).", ly_last_logmsg());
+        goto cleanup;
+    }
+    hdr.content_id = content_id;
+    hdr.size = r;
+    size = sizeof hdr + hdr.size;
+
+    /* create a new temporary file, the image is replaced atomically */
+    if ((fd = sr_open(tmp_path, O_RDWR | O_CREAT | O_TRUNC, SR_SHM_PERM)) == -1) {
+        SR_LOG_WRN("Failed to create context image \"%s\" (%s).", tmp_path, strerror(errno));
+        goto cleanup;
+    }
+    if (ftruncate(fd, size) == -1) {
+        SR_LOG_WRN("Failed to truncate context image \"%s\" (%s).", tmp_path, strerror(errno));
+        goto cleanup;
+    }
+
+    /* PRINTED CTX LOCK */
+    pthread_mutex_lock(&sr_ly_ctx_img.lock);
+    locked = 1;
+
+    if (sr_ly_ctx_img.addr) {
+        /* the address is used by a context, the image cannot be printed by this process */
+        goto cleanup;
+    }
+
+    /* the context must be printed at the address it will be used at */
+    addr = mmap(SR_LY_CTX_IMG_ADDR, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED_NOREPLACE, fd, 0);
+    if (addr == MAP_FAILED) {
+        SR_LOG_WRN("Failed to map context image \"%s\" (%s).", tmp_path, strerror(errno));
+        goto cleanup;
+    } else if (addr != SR_LY_CTX_IMG_ADDR) {
+        /* older kernels treat the flag only as a hint */
+        goto cleanup;
+    }
+    memcpy(addr, &hdr, sizeof hdr);
+    if (ly_ctx_compiled_print(ly_ctx, (char *)addr + sizeof hdr, NULL)) {
+        SR_LOG_WRN("Failed to print the context (%s).", ly_last_logmsg());
+        goto cleanup;
+    }
+
+    /* publish the image */
+    if (rename(tmp_path, path) == -1) {
+        SR_LOG_WRN("Failed to rename context image \"%s\" (%s).", tmp_path, strerror(errno));
+        goto cleanup;
+    }
+    free(tmp_path);
+    tmp_path = NULL;
+
+cleanup:
+    if (addr != MAP_FAILED) {
+        munmap(addr, size);
+    }
+    if (locked) {
+        /* PRINTED CTX UNLOCK */
+        pthread_mutex_unlock(&sr_ly_ctx_img.lock);
+    }
+    if (fd > -1) {
+        close(fd);
+    }
+    if (tmp_path) {
+        unlink(tmp_path);
+    }
+    free(path);
+    free(tmp_path);
+#else
+    (void)ly_ctx;
+    (void)content_id;
+#endif
+}
+
+void
+sr_ly_ctx_img_remove(void)
+{
+    char *path = NULL;
+
+    if (sr_path_ctx_img(&path)) {
+        return;
+    }
+    if ((unlink(path) == -1) && (errno != ENOENT)) {
+        SR_LOG_WRN("Failed to unlink \"%s\" (%s).", path, strerror(errno));
+    }
+    free(path);
+}
+
+void
+sr_ly_ctx_destroy(struct ly_ctx *ly_ctx)
+{
+    if (!ly_ctx) {
+        return;
+    }
+
+#ifdef SR_LY_CTX_IMG
+    /* PRINTED CTX LOCK */
+    pthread_mutex_lock(&sr_ly_ctx_img.lock);
+
+    if (ly_ctx == sr_ly_ctx_img.ly_ctx) {
+        /* the image can be unmapped only after the context is destroyed */
+        ly_ctx_destroy(ly_ctx);
+        munmap(sr_ly_ctx_img.addr, sr_ly_ctx_img.size);
+        sr_ly_ctx_img.addr = NULL;
+        sr_ly_ctx_img.size = 0;
+        sr_ly_ctx_img.ly_ctx = NULL;
+        ly_ctx = NULL;
+    }
+
+    /* PRINTED CTX UNLOCK */
+    pthread_mutex_unlock(&sr_ly_ctx_img.lock);
+#endif
+
+    ly_ctx_destroy(ly_ctx);
+}
+
 sr_error_info_t *
 sr_lys_parse(struct ly_ctx *ctx, const char *data, const char *path, LYS_INFORMAT format, const char **features,
         struct lys_module **ly_mod)
@@ -707,6 +976,25 @@ cleanup:
     return err_info;
 }
 
+sr_error_info_t *
+sr_lyd_new_list2(struct lyd_node *parent, const struct lys_module *mod, const char *name, const char *keys,
+        struct lyd_node **node)
+{
+    sr_error_info_t *err_info = NULL;
+    uint32_t temp_lo = LY_LOSTORE;
+
+    ly_temp_log_options(&temp_lo);
+
+    if (lyd_new_list2(parent, mod, name, keys, 0, node)) {
+        sr_errinfo_new_ly(&err_info, parent ? LYD_CTX(parent) : mod->ctx, NULL, SR_ERR_LY);
+        goto cleanup;
+    }
+
+cleanup:
+    ly_temp_log_options(NULL);
+    return err_info;
+}
+
 sr_error_info_t *
 sr_lyd_new_inner(struct lyd_node *parent, const struct lys_module *mod, const char *name, struct lyd_node **node)
 {
@@ -34,6 +34,37 @@
  */
 sr_error_info_t *sr_ly_ctx_init(sr_conn_ctx_t *conn, struct ly_ctx **ly_ctx);
 
+/**
+ * @brief Create a libyang context from the printed context image, if there is one for the current modules.
+ *
+ * @param[in] conn Connection to read opts from and use for the LY ext data callback.
+ * @param[in] content_id Current content ID the image must match.
+ * @param[out] ly_ctx libyang context, NULL if no usable image exists.
+ * @return err_info, NULL on success.
+ */
+sr_error_info_t *sr_ly_ctx_img_load(sr_conn_ctx_t *conn, uint32_t content_id, struct ly_ctx **ly_ctx);
+
+/**
+ * @brief Print a compiled libyang context into the context image to be loaded by other connections.
+ * Errors are only logged as warnings.
+ *
+ * @param[in] ly_ctx Context with all the modules.
+ * @param[in] content_id Content ID of the modules in @p ly_ctx.
+ */
+void sr_ly_ctx_img_store(const struct ly_ctx *ly_ctx, uint32_t content_id);
+
+/**
+ * @brief Remove the printed context image.
+ */
+void sr_ly_ctx_img_remove(void);
+
+/**
+ * @brief Destroy a libyang context, which may have been created from the context image.
+ *
+ * @param[in] ly_ctx Context to destroy.
+ */
+void sr_ly_ctx_destroy(struct ly_ctx *ly_ctx);
+
 /**
  * @brief Parse a YANG module.
  *
@@ -285,6 +316,19 @@ sr_error_info_t *sr_lyd_new_term2(struct lyd_node *parent, const struct lys_modu
 sr_error_info_t *sr_lyd_new_list(struct lyd_node *parent, const char *name, const char *key_value,
         struct lyd_node **node);
 
+/**
+ * @brief Create a new list node from its keys predicate.
+ *
+ * @param[in] parent Node parent.
+ * @param[in] mod Node module.
+ * @param[in] name Node name.
+ * @param[in] keys Predicate with all the keys.
+ * @param[out] node Created list node.
+ * @return err_info, NULL on success.
+ */
+sr_error_info_t *sr_lyd_new_list2(struct lyd_node *parent, const struct lys_module *mod, const char *name,
+        const char *keys, struct lyd_node **node);
+
 /**
  * @brief Create a new inner node.
  *
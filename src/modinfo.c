@@ -27,6 +27,7 @@
 #include <stdarg.h>
 #include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
 #include <sys/mman.h>
 #include <time.h>
 #include <unistd.h>
@@ -468,6 +469,7 @@ sr_modinfo_perm_check(struct sr_mod_info_s *mod_info, int wr, int strict)
                 /* remove this module from mod_info by moving all succeding modules */
                 SR_LOG_INF("No %s permission for the module \"%s\", skipping.", wr ? "write" : "read", mod->ly_mod->name);
                 free(mod->xpaths);
+                ly_set_free(mod->oper_values, NULL);
                 --mod_info->mod_count;
                 if (!mod_info->mod_count) {
                     free(mod_info->mods);
@@ -597,6 +599,7 @@ sr_modinfo_edit_merge(struct sr_mod_info_s *mod_info, const struct lyd_node *edi
     struct sr_mod_info_mod_s *mod;
     const struct lyd_node *node, *iter;
     struct lyd_node *change_edit = NULL, *diff = NULL;
+    struct ly_set **values;
     uint32_t *aux = NULL, i;
     const char *xpath;
     int change;
@@ -664,9 +667,18 @@ sr_modinfo_edit_merge(struct sr_mod_info_s *mod_info, const struct lyd_node *edi
     while ((mod = sr_modinfo_next_mod(mod, mod_info, edit, &aux))) {
         assert(mod->state & MOD_INFO_REQ);
 
+        values = NULL;
+        if (!create_diff && (!(mod->state & MOD_INFO_CHANGED) || mod->oper_values)) {
+            /* track leaves with only their value changed so that the plugin may store just those */
+            if (!mod->oper_values && (err_info = sr_ly_set_new(&mod->oper_values))) {
+                goto cleanup;
+            }
+            values = &mod->oper_values;
+        }
+
         /* merge relevant edit changes */
         if ((err_info = sr_edit_mod_merge(edit, mod_info->conn->cid, mod->ly_mod, &mod_info->data,
-                create_diff ? &mod_info->diff : NULL, &change))) {
+                create_diff ? &mod_info->diff : NULL, &change, values))) {
             goto cleanup;
         }
 
@@ -715,47 +727,311 @@ sr_modinfo_diff_merge(struct sr_mod_info_s *mod_info, const struct lyd_node *new
     return NULL;
 }
 
+/**
+ * @brief Learn whether a netconf-config-change notification would be generated for any changes.
+ *
+ * @param[in] conn Connection to use.
+ * @param[out] needed Whether the notification is needed, it is either subscribed to or stored for replay.
+ * @return err_info, NULL on success.
+ */
+static sr_error_info_t *
+sr_modinfo_config_change_notif_is_needed(sr_conn_ctx_t *conn, int *needed)
+{
+    sr_error_info_t *err_info = NULL;
+    sr_mod_t *shm_mod;
+    sr_mod_notif_sub_t *notif_subs;
+    uint32_t notif_sub_count;
+
+    *needed = 0;
+
+    /* EXT READ LOCK */
+    if ((err_info = sr_shmext_conn_remap_lock(conn, SR_LOCK_READ, 0, __func__))) {
+        return err_info;
+    }
+
+    /* get subscriber count */
+    err_info = sr_notif_find_subscriber(conn, "ietf-netconf-notifications", &notif_subs, &notif_sub_count, NULL);
+
+    /* EXT READ UNLOCK */
+    sr_shmext_conn_remap_unlock(conn, SR_LOCK_READ, 0, __func__);
+
+    if (err_info) {
+        return err_info;
+    }
+
+    /* get this module and check replay support */
+    shm_mod = sr_shmmod_find_module(SR_CONN_MOD_SHM(conn), "ietf-netconf-notifications");
+    SR_CHECK_INT_RET(!shm_mod, err_info);
+    if (shm_mod->replay_supp || notif_sub_count) {
+        *needed = 1;
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Learn whether storing data of a module may require their diff.
+ *
+ * @param[in] mod_info Mod info to use.
+ * @param[in] mod Mod info module.
+ * @return Whether the diff may be required.
+ */
+static int
+sr_modinfo_mod_store_needs_diff(struct sr_mod_info_s *mod_info, struct sr_mod_info_mod_s *mod)
+{
+    const struct sr_ds_handle_s *ds_handle;
+
+    if (mod_info->ds == SR_DS_OPERATIONAL) {
+        /* stored operational data are an edit, never stored using a diff */
+        return 0;
+    } else if ((mod_info->ds != SR_DS_RUNNING) && (mod_info->ds != SR_DS_STARTUP)) {
+        /* candidate data are stored as a diff from running until modified */
+        return 1;
+    }
+
+    /* the plugin storing the data must not require a diff */
+    ds_handle = mod->ds_handle[mod_info->ds] ? mod->ds_handle[mod_info->ds] : mod->ds_handle[SR_DS_STARTUP];
+    if (!ds_handle || (ds_handle->plugin->flags & SRPLG_DS_FLAG_STORE_DIFF)) {
+        return 1;
+    }
+
+    return 0;
+}
+
 sr_error_info_t *
-sr_modinfo_replace(struct sr_mod_info_s *mod_info, struct lyd_node **src_data)
+sr_modinfo_diff_is_needed(struct sr_mod_info_s *mod_info, int *needed)
 {
     sr_error_info_t *err_info = NULL;
     struct sr_mod_info_mod_s *mod;
-    struct lyd_node *src_mod_data, *dst_mod_data, *diff;
     uint32_t i;
 
-    assert(!mod_info->diff && !mod_info->data_cached);
+    /* netconf-config-change notification is generated from the diff, not for candidate and operational */
+    if ((mod_info->ds != SR_DS_CANDIDATE) && (mod_info->ds != SR_DS_OPERATIONAL)) {
+        if ((err_info = sr_modinfo_config_change_notif_is_needed(mod_info->conn, needed)) || *needed) {
+            return err_info;
+        }
+    } else {
+        *needed = 0;
+    }
 
     for (i = 0; i < mod_info->mod_count; ++i) {
         mod = &mod_info->mods[i];
-        if (mod->state & MOD_INFO_REQ) {
-            dst_mod_data = sr_module_data_unlink(&mod_info->data, mod->ly_mod);
-            src_mod_data = sr_module_data_unlink(src_data, mod->ly_mod);
+        if (!(mod->state & MOD_INFO_REQ)) {
+            continue;
+        }
 
-            /* get diff on only this module's data */
-            if ((err_info = sr_lyd_diff_siblings(dst_mod_data, src_mod_data, LYD_DIFF_DEFAULTS, &diff))) {
-                lyd_free_all(dst_mod_data);
-                lyd_free_all(src_mod_data);
-                return err_info;
-            }
+        /* the datastore plugin or any subscribers need the diff */
+        if (sr_modinfo_mod_store_needs_diff(mod_info, mod) ||
+                sr_shmsub_change_notify_has_any_subscription(mod_info->conn, mod, mod_info->ds)) {
+            *needed = 1;
+            break;
+        }
+    }
 
-            if (diff) {
-                /* there is a diff */
-                mod->state |= MOD_INFO_CHANGED;
+    return NULL;
+}
+
+/**
+ * @brief Add a changed top-level subtree into a diff summary.
+ *
+ * @param[in] node Changed top-level data node.
+ * @param[in,out] summary Diff summary to add to.
+ * @return err_info, NULL on success.
+ */
+static sr_error_info_t *
+sr_modinfo_diff_summary_add(const struct lyd_node *node, struct lyd_node **summary)
+{
+    sr_error_info_t *err_info = NULL;
+    struct lyd_node *dup = NULL, *match;
 
-                /* merge the diff */
-                lyd_insert_sibling(mod_info->diff, diff, &mod_info->diff);
+    if (*summary) {
+        /* may already be there */
+        if ((err_info = sr_lyd_find_sibling_first(*summary, node, &match))) {
+            goto cleanup;
+        }
+        if (match) {
+            goto cleanup;
+        }
+    }
 
-                /* update data */
-                if (src_mod_data) {
-                    lyd_insert_sibling(mod_info->data, src_mod_data, &mod_info->data);
-                }
-                lyd_free_all(dst_mod_data);
-            } else {
-                /* keep old data (for validation) */
-                if (dst_mod_data) {
-                    lyd_insert_sibling(mod_info->data, dst_mod_data, &mod_info->data);
-                }
-                lyd_free_all(src_mod_data);
+    /* only the node itself with any list keys */
+    if ((err_info = sr_lyd_dup(node, NULL, LYD_DUP_NO_META, 0, &dup))) {
+        goto cleanup;
+    }
+    if ((err_info = sr_diff_set_oper(dup, "none"))) {
+        goto cleanup;
+    }
+    if ((dup->schema->nodetype & LYD_NODE_TERM) && (err_info = sr_lyd_new_meta(dup, NULL, "yang:orig-default",
+            (node->flags & LYD_DEFAULT) ? "true" : "false"))) {
+        goto cleanup;
+    }
+
+    lyd_insert_sibling(*summary, dup, summary);
+    dup = NULL;
+
+cleanup:
+    lyd_free_tree(dup);
+    return err_info;
+}
+
+/**
+ * @brief Learn whether a user-ordered top-level node was moved, meaning its preceding instance differs.
+ *
+ * @param[in] src_node New data node.
+ * @param[in] dst_node Matching previous data node.
+ * @return Whether the node was moved.
+ */
+static int
+sr_modinfo_diff_summary_is_moved(const struct lyd_node *src_node, const struct lyd_node *dst_node)
+{
+    const struct lyd_node *src_prev, *dst_prev;
+
+    src_prev = (src_node->prev->next && (src_node->prev->schema == src_node->schema)) ? src_node->prev : NULL;
+    dst_prev = (dst_node->prev->next && (dst_node->prev->schema == dst_node->schema)) ? dst_node->prev : NULL;
+
+    if (!src_prev && !dst_prev) {
+        return 0;
+    } else if (!src_prev || !dst_prev) {
+        return 1;
+    }
+    return lyd_compare_single(src_prev, dst_prev, 0) ? 1 : 0;
+}
+
+/**
+ * @brief Create a diff summary of a module data, which includes only the changed top-level subtrees.
+ *
+ * @param[in] dst_mod_data Previous module data.
+ * @param[in] src_mod_data New module data.
+ * @param[out] summary Diff summary, NULL if there are no changes.
+ * @return err_info, NULL on success.
+ */
+static sr_error_info_t *
+sr_modinfo_diff_summary(const struct lyd_node *dst_mod_data, const struct lyd_node *src_mod_data,
+        struct lyd_node **summary)
+{
+    sr_error_info_t *err_info = NULL;
+    const struct lyd_node *node;
+    struct lyd_node *match;
+
+    *summary = NULL;
+
+    /* deleted subtrees */
+    LY_LIST_FOR(dst_mod_data, node) {
+        if ((err_info = sr_lyd_find_sibling_first(src_mod_data, node, &match))) {
+            goto cleanup;
+        }
+        if (!match && (err_info = sr_modinfo_diff_summary_add(node, summary))) {
+            goto cleanup;
+        }
+    }
+
+    /* created, modified, and moved subtrees */
+    LY_LIST_FOR(src_mod_data, node) {
+        if ((err_info = sr_lyd_find_sibling_first(dst_mod_data, node, &match))) {
+            goto cleanup;
+        }
+        if (match && !lyd_compare_single(node, match, LYD_COMPARE_FULL_RECURSION | LYD_COMPARE_DEFAULTS) &&
+                (!lysc_is_userordered(node->schema) || !sr_modinfo_diff_summary_is_moved(node, match))) {
+            /* unchanged */
+            continue;
+        }
+
+        if ((err_info = sr_modinfo_diff_summary_add(node, summary))) {
+            goto cleanup;
+        }
+    }
+
+cleanup:
+    if (err_info) {
+        lyd_free_siblings(*summary);
+        *summary = NULL;
+    }
+    return err_info;
+}
+
+/**
+ * @brief Replace data of a single module with new data and create their diff.
+ *
+ * @param[in] mod_info Mod info to use.
+ * @param[in] mod Mod info module to replace.
+ * @param[in,out] src_data New data, the module data are spent.
+ * @param[in] summary Whether to create only a diff summary.
+ * @return err_info, NULL on success.
+ */
+static sr_error_info_t *
+sr_modinfo_replace_mod(struct sr_mod_info_s *mod_info, struct sr_mod_info_mod_s *mod, struct lyd_node **src_data,
+        int summary)
+{
+    sr_error_info_t *err_info = NULL;
+    struct lyd_node *src_mod_data, *dst_mod_data, *diff;
+
+    dst_mod_data = sr_module_data_unlink(&mod_info->data, mod->ly_mod);
+    src_mod_data = sr_module_data_unlink(src_data, mod->ly_mod);
+
+    /* get diff (summary) on only this module's data */
+    if (summary) {
+        err_info = sr_modinfo_diff_summary(dst_mod_data, src_mod_data, &diff);
+    } else {
+        err_info = sr_lyd_diff_siblings(dst_mod_data, src_mod_data, LYD_DIFF_DEFAULTS, &diff);
+    }
+    if (err_info) {
+        lyd_free_all(dst_mod_data);
+        lyd_free_all(src_mod_data);
+        return err_info;
+    }
+
+    if (diff) {
+        /* there is a diff */
+        mod->state |= MOD_INFO_CHANGED;
+        if (summary) {
+            mod->state |= MOD_INFO_DIFF_SUMMARY;
+        }
+
+        /* merge the diff */
+        lyd_insert_sibling(mod_info->diff, diff, &mod_info->diff);
+
+        /* update data */
+        if (src_mod_data) {
+            lyd_insert_sibling(mod_info->data, src_mod_data, &mod_info->data);
+        }
+        lyd_free_all(dst_mod_data);
+    } else {
+        /* keep old data (for validation) */
+        if (dst_mod_data) {
+            lyd_insert_sibling(mod_info->data, dst_mod_data, &mod_info->data);
+        }
+        lyd_free_all(src_mod_data);
+    }
+
+    return NULL;
+}
+
+sr_error_info_t *
+sr_modinfo_replace(struct sr_mod_info_s *mod_info, struct lyd_node **src_data, int summary)
+{
+    sr_error_info_t *err_info = NULL;
+    struct sr_mod_info_mod_s *mod;
+    uint32_t i;
+    int needed, mod_summary;
+
+    assert(!mod_info->diff && !mod_info->data_cached);
+
+    if (summary) {
+        /* netconf-config-change notification is generated from the full diff */
+        if ((err_info = sr_modinfo_config_change_notif_is_needed(mod_info->conn, &needed))) {
+            return err_info;
+        }
+        summary = !needed;
+    }
+
+    for (i = 0; i < mod_info->mod_count; ++i) {
+        mod = &mod_info->mods[i];
+        if (mod->state & MOD_INFO_REQ) {
+            /* a summary is enough if all the subscribers are coarse and the datastore plugin does not need the diff */
+            mod_summary = summary && !sr_modinfo_mod_store_needs_diff(mod_info, mod) &&
+                    sr_shmsub_change_notify_is_coarse(mod_info->conn, mod, mod_info->ds);
+            if ((err_info = sr_modinfo_replace_mod(mod_info, mod, src_data, mod_summary))) {
+                return err_info;
             }
         }
     }
@@ -1108,6 +1384,9 @@ cleanup:
 /**
  * @brief Try to merge operational get cached data of a subscription.
  *
+ * Data cached by this connection are used first, then valid data in the shared cache of any other connection.
+ * Shared data that cannot be parsed are dropped and not merged so that the provider callback is used instead.
+ *
  * @param[in] mod Mod info module.
  * @param[in] sub_xpath Subscription XPath.
  * @param[in] conn Connection to use.
@@ -1121,7 +1400,9 @@ sr_module_oper_data_update_cached(struct sr_mod_info_mod_s *mod, const char *sub
 {
     sr_error_info_t *err_info = NULL;
     struct sr_oper_poll_cache_s *cache = NULL;
-    uint32_t i;
+    sr_mod_oper_poll_sub_t *poll_subs;
+    struct lyd_node *cached = NULL;
+    uint32_t i, gen;
 
     *merged = 0;
 
@@ -1140,7 +1421,32 @@ sr_module_oper_data_update_cached(struct sr_mod_info_mod_s *mod, const char *sub
         }
     }
     if (!cache) {
-        goto cleanup_cache_unlock;
+        /* CONN OPER CACHE UNLOCK */
+        sr_rwunlock(&conn->oper_cache_lock, SR_CONN_OPER_CACHE_LOCK_TIMEOUT, SR_LOCK_READ, conn->cid, __func__);
+
+        /* learn whether the data are polled by any other connection */
+        poll_subs = (sr_mod_oper_poll_sub_t *)(conn->ext_shm.addr + mod->shm_mod->oper_poll_subs);
+        for (i = 0; i < mod->shm_mod->oper_poll_sub_count; ++i) {
+            if (!strcmp(conn->ext_shm.addr + poll_subs[i].xpath, sub_xpath)) {
+                break;
+            }
+        }
+        if (i == mod->shm_mod->oper_poll_sub_count) {
+            goto cleanup;
+        }
+
+        /* try to get the data from the shared cache */
+        if ((err_info = sr_shmsub_oper_poll_cache_get(conn, mod->ly_mod->name, sub_xpath, 0, &cached, NULL, &gen))) {
+            goto cleanup;
+        }
+        if (gen) {
+            /* merge the shared cached data */
+            if (cached && (err_info = sr_lyd_merge(data, cached, 1, 0))) {
+                goto cleanup;
+            }
+            *merged = 1;
+        }
+        goto cleanup;
     }
 
     /* CACHE DATA READ LOCK */
@@ -1164,6 +1470,7 @@ cleanup_cache_unlock:
     sr_rwunlock(&conn->oper_cache_lock, SR_CONN_OPER_CACHE_LOCK_TIMEOUT, SR_LOCK_READ, conn->cid, __func__);
 
 cleanup:
+    lyd_free_all(cached);
     return err_info;
 }
 
@@ -2049,6 +2356,42 @@ operpoll_sub_unlock:
         if ((err_info = sr_lyd_new_term(sr_sub, NULL, "suspended", buf))) {
             goto notif_ext_sub_unlock;
         }
+
+        /* bounded-lag */
+        sprintf(buf, "%s", (notif_subs[i].opts & SR_SUBSCR_NOTIF_BOUNDED_LAG) ? "true" : "false");
+        if ((err_info = sr_lyd_new_term(sr_sub, NULL, "bounded-lag", buf))) {
+            goto notif_ext_sub_unlock;
+        }
+
+        /* delivered */
+        sprintf(buf, "%" PRIu32, (uint32_t)ATOMIC_LOAD_RELAXED(notif_subs[i].delivered));
+        if ((err_info = sr_lyd_new_term(sr_sub, NULL, "delivered", buf))) {
+            goto notif_ext_sub_unlock;
+        }
+
+        /* filtered-out */
+        sprintf(buf, "%" PRIu32, (uint32_t)ATOMIC_LOAD_RELAXED(notif_subs[i].filtered_out));
+        if ((err_info = sr_lyd_new_term(sr_sub, NULL, "filtered-out", buf))) {
+            goto notif_ext_sub_unlock;
+        }
+
+        /* dropped */
+        sprintf(buf, "%" PRIu32, (uint32_t)ATOMIC_LOAD_RELAXED(notif_subs[i].dropped));
+        if ((err_info = sr_lyd_new_term(sr_sub, NULL, "dropped", buf))) {
+            goto notif_ext_sub_unlock;
+        }
+
+        /* blocked-time */
+        sprintf(buf, "%" PRIu32, (uint32_t)ATOMIC_LOAD_RELAXED(notif_subs[i].blocked_ms));
+        if ((err_info = sr_lyd_new_term(sr_sub, NULL, "blocked-time", buf))) {
+            goto notif_ext_sub_unlock;
+        }
+
+        /* max-latency */
+        sprintf(buf, "%" PRIu32, (uint32_t)ATOMIC_LOAD_RELAXED(notif_subs[i].max_latency_us));
+        if ((err_info = sr_lyd_new_term(sr_sub, NULL, "max-latency", buf))) {
+            goto notif_ext_sub_unlock;
+        }
     }
 
 notif_ext_sub_unlock:
@@ -2824,31 +3167,78 @@ cleanup:
 }
 
 sr_error_info_t *
-sr_modinfo_consolidate(struct sr_mod_info_s *mod_info, sr_lock_mode_t mod_lock, int mi_opts, uint32_t sid,
-        const char *orig_name, const void *orig_data, uint32_t timeout_ms, uint32_t ds_lock_timeout_ms,
-        sr_get_oper_flag_t get_oper_opts)
+sr_modinfo_replace_bulk(struct sr_mod_info_s *mod_info, struct lyd_node **src_data, const char *orig_name,
+        const void *orig_data, int *bulk)
 {
     sr_error_info_t *err_info = NULL;
-    int mod_type, new = 0;
+    struct sr_mod_info_mod_s *mod;
+    struct lyd_node *src_mod_data;
     uint32_t i;
+    int needed;
 
-    assert(mi_opts & (SR_MI_PERM_NO | SR_MI_PERM_READ | SR_MI_PERM_WRITE));
+    assert(!mod_info->diff && !mod_info->data_cached);
 
-    if (!mod_info->mod_count) {
-        goto cleanup;
+    /* learn whether all the modules can be replaced without a diff */
+    if ((err_info = sr_modinfo_diff_is_needed(mod_info, &needed))) {
+        return err_info;
     }
+    *bulk = !needed;
 
-    if (mi_opts & SR_MI_NEW_DEPS) {
-        mod_type = MOD_INFO_DEP;
-    } else {
-        mod_type = MOD_INFO_REQ;
+    if (*bulk) {
+        /* the current data of the modules are not needed at all, use the new data directly */
+        for (i = 0; i < mod_info->mod_count; ++i) {
+            mod = &mod_info->mods[i];
+            if (mod->state & MOD_INFO_REQ) {
+                src_mod_data = sr_module_data_unlink(src_data, mod->ly_mod);
+                if (src_mod_data) {
+                    lyd_insert_sibling(mod_info->data, src_mod_data, &mod_info->data);
+                }
+                mod->state |= MOD_INFO_DATA | MOD_INFO_CHANGED;
+            }
+        }
     }
 
-    /* check for new modules in mod_info */
-    for (i = 0; i < mod_info->mod_count; ++i) {
-        if (mod_info->mods[i].state & MOD_INFO_NEW) {
-            /* new module */
-            new = 1;
+    /* load data of the remaining modules */
+    if ((err_info = sr_modinfo_data_load(mod_info, 0, orig_name, orig_data, 0, 0))) {
+        return err_info;
+    }
+
+    if (!*bulk) {
+        /* standard replace */
+        if ((err_info = sr_modinfo_replace(mod_info, src_data, 1))) {
+            return err_info;
+        }
+    }
+
+    return NULL;
+}
+
+sr_error_info_t *
+sr_modinfo_consolidate(struct sr_mod_info_s *mod_info, sr_lock_mode_t mod_lock, int mi_opts, uint32_t sid,
+        const char *orig_name, const void *orig_data, uint32_t timeout_ms, uint32_t ds_lock_timeout_ms,
+        sr_get_oper_flag_t get_oper_opts)
+{
+    sr_error_info_t *err_info = NULL;
+    int mod_type, new = 0;
+    uint32_t i;
+
+    assert(mi_opts & (SR_MI_PERM_NO | SR_MI_PERM_READ | SR_MI_PERM_WRITE));
+
+    if (!mod_info->mod_count) {
+        goto cleanup;
+    }
+
+    if (mi_opts & SR_MI_NEW_DEPS) {
+        mod_type = MOD_INFO_DEP;
+    } else {
+        mod_type = MOD_INFO_REQ;
+    }
+
+    /* check for new modules in mod_info */
+    for (i = 0; i < mod_info->mod_count; ++i) {
+        if (mod_info->mods[i].state & MOD_INFO_NEW) {
+            /* new module */
+            new = 1;
 
             /* consolidate without inverse dependencies to not lose track of new modules */
             if ((err_info = sr_modinfo_mod_new(mod_info->mods[i].ly_mod, mod_type, mod_info))) {
@@ -2912,27 +3302,753 @@ cleanup:
     return err_info;
 }
 
+/**
+ * @brief Learn whether a path step ends its path so that the string value of the whole selected node is used.
+ *
+ * @param[in] step_end First character after the step name.
+ * @return Whether the step is the last one.
+ */
+static int
+sr_modinfo_expr_step_is_last(const char *step_end)
+{
+    const char *ptr = step_end;
+    int depth;
+
+    /* skip predicates */
+    while (ptr[0] == '[') {
+        for (depth = 0; ptr[0]; ++ptr) {
+            if (ptr[0] == '[') {
+                ++depth;
+            } else if ((ptr[0] == ']') && !--depth) {
+                ++ptr;
+                break;
+            }
+        }
+    }
+    while (isspace(ptr[0])) {
+        ++ptr;
+    }
+
+    return ptr[0] != '/';
+}
+
+/**
+ * @brief Learn whether a character can be a part of a YANG identifier.
+ *
+ * @param[in] c Character to check.
+ * @return Whether it is an identifier character.
+ */
+static int
+sr_modinfo_expr_is_id_char(char c)
+{
+    return isalnum(c) || (c == '_') || (c == '-') || (c == '.');
+}
+
+/**
+ * @brief Check whether an XPath expression uses the string value of a node with a name as a whole.
+ *
+ * @param[in] expr XPath expression.
+ * @param[in] name Node name.
+ * @return Whether the name is used as the last step of a path.
+ */
+static int
+sr_modinfo_expr_refs_value(const char *expr, const char *name)
+{
+    const char *ptr;
+    size_t len = strlen(name);
+
+    for (ptr = strstr(expr, name); ptr; ptr = strstr(ptr + 1, name)) {
+        if (((ptr > expr) && sr_modinfo_expr_is_id_char(ptr[-1])) || sr_modinfo_expr_is_id_char(ptr[len])) {
+            /* part of another identifier */
+            continue;
+        }
+
+        if (sr_modinfo_expr_step_is_last(ptr + len)) {
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Check whether an XPath expression may reference any of the changed leaves.
+ *
+ * Any use of a node whose string value may include a changed leaf value is considered a reference. That is the
+ * leaf itself, any of its ancestors, and any context or parent node (`.`, `current()`, `..`) used as a whole.
+ * Only the node names are compared so there may be false positives but never false negatives.
+ *
+ * @param[in] expr XPath expression.
+ * @param[in] leaves Set of changed leaves (schema nodes).
+ * @return Whether the expression may reference a changed leaf.
+ */
+static int
+sr_modinfo_expr_refs_leaves(const char *expr, const struct ly_set *leaves)
+{
+    const struct lysc_node *parent;
+    const char *ptr;
+    uint32_t i, len;
+
+    if (strchr(expr, '*') || strstr(expr, "node()") || strstr(expr, "text()")) {
+        /* wildcard or a string value of a whole subtree */
+        return 1;
+    }
+
+    /* context node or its parent used as a whole, it may be an ancestor of a changed leaf */
+    for (ptr = strchr(expr, '.'); ptr; ptr = strchr(ptr + len, '.')) {
+        len = (ptr[1] == '.') ? 2 : 1;
+        if ((len == 1) && (((ptr > expr) && sr_modinfo_expr_is_id_char(ptr[-1])) || isdigit(ptr[1]))) {
+            /* part of an identifier or a number */
+            continue;
+        }
+        if (sr_modinfo_expr_step_is_last(ptr + len)) {
+            return 1;
+        }
+    }
+    for (ptr = strstr(expr, "current()"); ptr; ptr = strstr(ptr + 9, "current()")) {
+        if (sr_modinfo_expr_step_is_last(ptr + 9)) {
+            return 1;
+        }
+    }
+
+    for (i = 0; i < leaves->count; ++i) {
+        if (strstr(expr, leaves->snodes[i]->name)) {
+            return 1;
+        }
+
+        /* ancestors with the leaf value in their string value */
+        for (parent = lysc_data_parent(leaves->snodes[i]); parent; parent = lysc_data_parent(parent)) {
+            if (sr_modinfo_expr_refs_value(expr, parent->name)) {
+                return 1;
+            }
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Check whether a type may reference any of the changed leaves.
+ *
+ * @param[in] type Type to inspect.
+ * @param[in] leaves Set of changed leaves (schema nodes).
+ * @return Whether the type may reference a changed leaf.
+ */
+static int
+sr_modinfo_type_refs_leaves(const struct lysc_type *type, const struct ly_set *leaves)
+{
+    const struct lysc_type_union *uni;
+    LY_ARRAY_COUNT_TYPE u;
+
+    switch (type->basetype) {
+    case LY_TYPE_LEAFREF:
+        return sr_modinfo_expr_refs_leaves(lyxp_get_expr(((struct lysc_type_leafref *)type)->path), leaves);
+    case LY_TYPE_UNION:
+        uni = (struct lysc_type_union *)type;
+        LY_ARRAY_FOR(uni->types, u) {
+            if (sr_modinfo_type_refs_leaves(uni->types[u], leaves)) {
+                return 1;
+            }
+        }
+        break;
+    default:
+        break;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief libyang callback for full module traversal when searching for constraints referencing changed leaves.
+ */
+static LY_ERR
+sr_modinfo_leaves_refs_dfs_cb(struct lysc_node *node, void *data, ly_bool *dfs_continue)
+{
+    const struct ly_set *leaves = data;
+    struct lysc_when **when;
+    struct lysc_must *musts;
+    struct lysc_node_leaf ***uniques;
+    LY_ARRAY_COUNT_TYPE u, v;
+
+    (void)dfs_continue;
+
+    LY_ARRAY_FOR(node->exts, u) {
+        if (!strcmp(node->exts[u].def->name, "mount-point") &&
+                !strcmp(node->exts[u].def->module->name, "ietf-yang-schema-mount")) {
+            /* mounted data may reference anything */
+            return LY_EEXIST;
+        }
+    }
+
+    when = lysc_node_when(node);
+    LY_ARRAY_FOR(when, u) {
+        if (sr_modinfo_expr_refs_leaves(lyxp_get_expr(when[u]->cond), leaves)) {
+            return LY_EEXIST;
+        }
+    }
+
+    musts = lysc_node_musts(node);
+    LY_ARRAY_FOR(musts, u) {
+        if (sr_modinfo_expr_refs_leaves(lyxp_get_expr(musts[u].cond), leaves)) {
+            return LY_EEXIST;
+        }
+    }
+
+    if (node->nodetype & (LYS_LEAF | LYS_LEAFLIST)) {
+        if (sr_modinfo_type_refs_leaves(((struct lysc_node_leaf *)node)->type, leaves)) {
+            return LY_EEXIST;
+        }
+    } else if (node->nodetype == LYS_LIST) {
+        uniques = ((struct lysc_node_list *)node)->uniques;
+        LY_ARRAY_FOR(uniques, u) {
+            LY_ARRAY_FOR(uniques[u], v) {
+                if (ly_set_contains(leaves, uniques[u][v], NULL)) {
+                    return LY_EEXIST;
+                }
+            }
+        }
+    }
+
+    return LY_SUCCESS;
+}
+
+/**
+ * @brief Check whether any data dependencies of a module may reference the changed leaves.
+ *
+ * @param[in] mod_shm Mod SHM.
+ * @param[in] shm_mod SHM module with the dependencies.
+ * @param[in] leaves Set of changed leaves (schema nodes).
+ * @return Whether a dependency may reference a changed leaf.
+ */
+static int
+sr_modinfo_deps_refs_leaves(sr_mod_shm_t *mod_shm, sr_mod_t *shm_mod, const struct ly_set *leaves)
+{
+    sr_dep_t *shm_deps;
+    uint32_t i;
+
+    shm_deps = (sr_dep_t *)((char *)mod_shm + shm_mod->deps);
+    for (i = 0; i < shm_mod->dep_count; ++i) {
+        switch (shm_deps[i].type) {
+        case SR_DEP_LREF:
+            if (sr_modinfo_expr_refs_leaves((char *)mod_shm + shm_deps[i].lref.target_path, leaves)) {
+                return 1;
+            }
+            break;
+        case SR_DEP_INSTID:
+            /* instance-identifiers reference instances only by keys and leaf-list values, which are never bounded */
+            break;
+        case SR_DEP_XPATH:
+            if (sr_modinfo_expr_refs_leaves((char *)mod_shm + shm_deps[i].xpath.expr, leaves)) {
+                return 1;
+            }
+            break;
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Learn whether the diff of changed modules is bounded so that validating the previously valid data
+ * can be skipped.
+ *
+ * Changes are bounded if they are only value changes of non-key leaves without any must or when conditions
+ * and referenced, directly or through the string value of an ancestor, neither by any constraints in their own
+ * module nor by any data dependencies of the modules depending on them.
+ *
+ * @param[in] mod_info Mod info to use.
+ * @param[out] bounded Whether the changes are bounded.
+ * @return err_info, NULL on success.
+ */
+static sr_error_info_t *
+sr_modinfo_validate_diff_bounded(struct sr_mod_info_s *mod_info, int *bounded)
+{
+    sr_error_info_t *err_info = NULL;
+    sr_mod_shm_t *mod_shm = SR_CONN_MOD_SHM(mod_info->conn);
+    struct sr_mod_info_mod_s *mod;
+    struct lyd_node *root, *node;
+    const struct lysc_node_leaf *sleaf;
+    struct ly_set leaves = {0};
+    sr_mod_t *dep_smod;
+    off_t *shm_inv_deps;
+    enum edit_op op;
+    uint32_t i, j;
+    int has_diff;
+
+    *bounded = 0;
+
+    for (i = 0; i < mod_info->mod_count; ++i) {
+        mod = &mod_info->mods[i];
+        if (!(mod->state & MOD_INFO_CHANGED)) {
+            continue;
+        }
+        if (mod->state & MOD_INFO_DIFF_SUMMARY) {
+            /* the actual changes are not known */
+            goto cleanup;
+        }
+
+        /* collect all the changed leaves of this module */
+        ly_set_erase(&leaves, NULL);
+        has_diff = 0;
+        LY_LIST_FOR(mod_info->diff, root) {
+            if (lyd_owner_module(root) != mod->ly_mod) {
+                continue;
+            }
+            has_diff = 1;
+
+            LYD_TREE_DFS_BEGIN(root, node) {
+                if (!node->schema || (node->schema->module->ctx != mod->ly_mod->ctx)) {
+                    /* opaque or mounted data */
+                    goto cleanup;
+                }
+
+                op = sr_edit_diff_find_oper(node, 1, NULL);
+                if (op == EDIT_REPLACE) {
+                    if ((node->schema->nodetype != LYS_LEAF) || lysc_is_key(node->schema) ||
+                            lysc_node_when(node->schema) || lysc_node_musts(node->schema)) {
+                        goto cleanup;
+                    }
+
+                    sleaf = (struct lysc_node_leaf *)node->schema;
+                    if ((sleaf->type->basetype == LY_TYPE_LEAFREF) || (sleaf->type->basetype == LY_TYPE_INST) ||
+                            (sleaf->type->basetype == LY_TYPE_UNION)) {
+                        goto cleanup;
+                    }
+
+                    if (ly_set_add(&leaves, (void *)node->schema, 0, NULL)) {
+                        SR_ERRINFO_MEM(&err_info);
+                        goto cleanup;
+                    }
+                } else if (op != EDIT_NONE) {
+                    /* nodes created, deleted, or moved */
+                    goto cleanup;
+                }
+
+                LYD_TREE_DFS_END(root, node);
+            }
+        }
+        if (!has_diff || !leaves.count) {
+            /* the changes are not known */
+            goto cleanup;
+        }
+
+        /* constraints in the module itself, including augments from other modules */
+        if (lysc_module_dfs_full(mod->ly_mod, sr_modinfo_leaves_refs_dfs_cb, &leaves)) {
+            goto cleanup;
+        }
+
+        /* constraints of modules depending on this module */
+        shm_inv_deps = (off_t *)((char *)mod_shm + mod->shm_mod->inv_deps);
+        for (j = 0; j < mod->shm_mod->inv_dep_count; ++j) {
+            dep_smod = sr_shmmod_find_module(mod_shm, (char *)mod_shm + shm_inv_deps[j]);
+            SR_CHECK_INT_GOTO(!dep_smod, err_info, cleanup);
+
+            if (sr_modinfo_deps_refs_leaves(mod_shm, dep_smod, &leaves)) {
+                goto cleanup;
+            }
+        }
+    }
+
+    *bounded = 1;
+
+cleanup:
+    ly_set_erase(&leaves, NULL);
+    return err_info;
+}
+
+/**
+ * @brief Job processing a single module, may run in parallel with jobs of other modules.
+ */
+struct sr_modinfo_job_s {
+    struct sr_mod_info_mod_s *mod;  /**< Mod info module. */
+    sr_datastore_t ds;              /**< Datastore of the module to use. */
+    int val_opts;                   /**< Validation options. */
+    int finish_diff;                /**< Whether to create diff of the changes caused by validation. */
+    struct lyd_node *diff;          /**< Separated diff of the module. */
+    struct lyd_node *data;          /**< Separated data of the module. */
+    sr_error_info_t *err_info;      /**< Error info of the job, if it failed. */
+    int done;                       /**< Whether the job was processed, it is skipped after an error otherwise. */
+    int oper_rescan;                /**< Whether the connections with stored oper data must be learned again. */
+};
+
+/**
+ * @brief Module jobs shared by all the threads processing them.
+ */
+struct sr_modinfo_jobs_s {
+    struct sr_modinfo_job_s *jobs;  /**< Array of jobs. */
+    uint32_t count;                 /**< Count of jobs. */
+    ATOMIC_T next;                  /**< Index of the next job to process. */
+    void (*job_cb)(struct sr_modinfo_job_s *job);   /**< Callback processing a job. */
+    int stop_on_error;              /**< Whether to skip all the following jobs after a job fails. */
+    ATOMIC_T failed;                /**< Set if a job failed and @p stop_on_error is set. */
+};
+
+/**
+ * @brief Process module jobs until there are none left.
+ *
+ * @param[in] jobs Module jobs.
+ */
+static void
+sr_modinfo_jobs_process(struct sr_modinfo_jobs_s *jobs)
+{
+    struct sr_modinfo_job_s *job;
+    uint32_t i;
+
+    while (!ATOMIC_LOAD_RELAXED(jobs->failed) && ((i = ATOMIC_INC_RELAXED(jobs->next)) < jobs->count)) {
+        job = &jobs->jobs[i];
+        jobs->job_cb(job);
+        job->done = 1;
+
+        if (job->err_info && jobs->stop_on_error) {
+            ATOMIC_STORE_RELAXED(jobs->failed, 1);
+        }
+    }
+}
+
+/**
+ * @brief Learn whether there are any module jobs of a connection left to process.
+ *
+ * @param[in] conn Connection to use, module job lock is expected to be held.
+ * @return Whether there are some jobs.
+ */
+static int
+sr_modinfo_jobs_pending(sr_conn_ctx_t *conn)
+{
+    struct sr_modinfo_jobs_s *jobs = conn->mi_jobs.jobs;
+
+    return jobs && !ATOMIC_LOAD_RELAXED(jobs->failed) && (ATOMIC_LOAD_RELAXED(jobs->next) < jobs->count);
+}
+
+/**
+ * @brief Worker thread of a connection processing module jobs.
+ *
+ * @param[in] arg Connection.
+ * @return Always NULL.
+ */
+static void *
+sr_modinfo_jobs_thread(void *arg)
+{
+    sr_conn_ctx_t *conn = arg;
+    struct sr_modinfo_jobs_s *jobs;
+
+    /* MI JOBS LOCK */
+    pthread_mutex_lock(&conn->mi_jobs.lock);
+
+    while (1) {
+        while (!sr_modinfo_jobs_pending(conn) && !conn->mi_jobs.stop) {
+            /* COND WAIT */
+            sr_cond_wait(&conn->mi_jobs.cond, &conn->mi_jobs.lock);
+        }
+        if (conn->mi_jobs.stop) {
+            break;
+        }
+
+        jobs = conn->mi_jobs.jobs;
+        ++conn->mi_jobs.busy_count;
+
+        /* MI JOBS UNLOCK */
+        pthread_mutex_unlock(&conn->mi_jobs.lock);
+
+        sr_modinfo_jobs_process(jobs);
+
+        /* MI JOBS LOCK */
+        pthread_mutex_lock(&conn->mi_jobs.lock);
+
+        if (!--conn->mi_jobs.busy_count) {
+            /* the caller may be waiting for us */
+            sr_cond_broadcast(&conn->mi_jobs.cond);
+        }
+    }
+
+    /* MI JOBS UNLOCK */
+    pthread_mutex_unlock(&conn->mi_jobs.lock);
+
+    return NULL;
+}
+
+/**
+ * @brief Process module jobs by the worker threads of a connection, including the calling one.
+ *
+ * The workers are started on demand and kept until the connection is destroyed. If they are already processing jobs
+ * of another thread, all the jobs are processed by the calling thread. Errors are left in the jobs so that
+ * the caller can handle them in a deterministic order.
+ *
+ * @param[in] conn Connection to use.
+ * @param[in] job_arr Array of jobs.
+ * @param[in] job_count Count of jobs.
+ * @param[in] job_cb Callback processing a job.
+ * @param[in] stop_on_error Whether to skip all the jobs not yet started after a job fails.
+ */
+static void
+sr_modinfo_jobs_run(sr_conn_ctx_t *conn, struct sr_modinfo_job_s *job_arr, uint32_t job_count,
+        void (*job_cb)(struct sr_modinfo_job_s *job), int stop_on_error)
+{
+    struct sr_modinfo_jobs_s jobs;
+    int r, pool = 0;
+
+    jobs.jobs = job_arr;
+    jobs.count = job_count;
+    ATOMIC_STORE_RELAXED(jobs.next, 0);
+    jobs.job_cb = job_cb;
+    jobs.stop_on_error = stop_on_error;
+    ATOMIC_STORE_RELAXED(jobs.failed, 0);
+
+    if (job_count > 1) {
+        /* MI JOBS LOCK */
+        pthread_mutex_lock(&conn->mi_jobs.lock);
+
+        if (!conn->mi_jobs.jobs && !conn->mi_jobs.busy_count) {
+            /* start more workers, up to the limit */
+            while ((conn->mi_jobs.thread_count < SR_MODINFO_THREAD_COUNT - 1) &&
+                    (conn->mi_jobs.thread_count + 1 < job_count)) {
+                if ((r = pthread_create(&conn->mi_jobs.tids[conn->mi_jobs.thread_count], NULL, sr_modinfo_jobs_thread,
+                        conn))) {
+                    /* the jobs will just be processed by fewer threads */
+                    SR_LOG_WRN("Creating a new thread failed (%s).", strerror(r));
+                    break;
+                }
+                ++conn->mi_jobs.thread_count;
+            }
+
+            if (conn->mi_jobs.thread_count) {
+                /* publish the jobs */
+                conn->mi_jobs.jobs = &jobs;
+                sr_cond_broadcast(&conn->mi_jobs.cond);
+                pool = 1;
+            }
+        } /* else the workers are busy, process the jobs alone */
+
+        /* MI JOBS UNLOCK */
+        pthread_mutex_unlock(&conn->mi_jobs.lock);
+    }
+
+    /* process jobs in this thread as well */
+    sr_modinfo_jobs_process(&jobs);
+
+    if (pool) {
+        /* MI JOBS LOCK */
+        pthread_mutex_lock(&conn->mi_jobs.lock);
+
+        /* no worker can start processing the jobs anymore, wait for those processing them */
+        conn->mi_jobs.jobs = NULL;
+        while (conn->mi_jobs.busy_count) {
+            /* COND WAIT */
+            sr_cond_wait(&conn->mi_jobs.cond, &conn->mi_jobs.lock);
+        }
+
+        /* MI JOBS UNLOCK */
+        pthread_mutex_unlock(&conn->mi_jobs.lock);
+    }
+}
+
+void
+sr_modinfo_jobs_stop(sr_conn_ctx_t *conn)
+{
+    uint32_t i;
+
+    /* MI JOBS LOCK */
+    pthread_mutex_lock(&conn->mi_jobs.lock);
+
+    conn->mi_jobs.stop = 1;
+    sr_cond_broadcast(&conn->mi_jobs.cond);
+
+    /* MI JOBS UNLOCK */
+    pthread_mutex_unlock(&conn->mi_jobs.lock);
+
+    for (i = 0; i < conn->mi_jobs.thread_count; ++i) {
+        pthread_join(conn->mi_jobs.tids[i], NULL);
+    }
+    conn->mi_jobs.thread_count = 0;
+    conn->mi_jobs.stop = 0;
+}
+
+/**
+ * @brief Merge diff created by validation of a module into mod info diff.
+ *
+ * @param[in] mod_info Mod info to use.
+ * @param[in] mod Validated module.
+ * @param[in] diff Validation diff of the module.
+ * @return err_info, NULL on success.
+ */
+static sr_error_info_t *
+sr_modinfo_validate_diff_merge(struct sr_mod_info_s *mod_info, struct sr_mod_info_mod_s *mod, const struct lyd_node *diff)
+{
+    sr_error_info_t *err_info = NULL;
+    const struct lyd_node *root;
+    struct lyd_node *iter;
+
+    /* it may not have been modified before */
+    mod->state |= MOD_INFO_CHANGED;
+
+    if (mod->state & MOD_INFO_DIFF_SUMMARY) {
+        /* only add the changed subtrees into the summary */
+        LY_LIST_FOR(diff, root) {
+            if ((err_info = sr_modinfo_diff_summary_add(root, &mod_info->diff))) {
+                return err_info;
+            }
+        }
+        return NULL;
+    }
+
+    /* merge the changes made by the validation into our diff */
+    if ((err_info = sr_lyd_diff_merge_all(&mod_info->diff, diff))) {
+        return err_info;
+    }
+
+    LY_LIST_FOR(mod_info->diff, iter) {
+        if (lyd_owner_module(iter) == mod->ly_mod) {
+            break;
+        }
+    }
+    if (!iter) {
+        /* the previous changes have actually been reverted */
+        mod->state &= ~MOD_INFO_CHANGED;
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Validate data of a single module that do not depend on any other data.
+ *
+ * @param[in] job Module job.
+ */
+static void
+sr_modinfo_validate_job(struct sr_modinfo_job_s *job)
+{
+    if ((job->err_info = sr_lyd_validate_module(&job->data, job->mod->ly_mod, job->val_opts | LYD_VALIDATE_NOT_FINAL,
+            job->finish_diff ? &job->diff : NULL))) {
+        return;
+    }
+
+    job->err_info = sr_lyd_validate_module_final(job->data, job->mod->ly_mod, job->val_opts);
+}
+
+/**
+ * @brief Validate modules of mod info that do not depend on any other data in parallel.
+ *
+ * @param[in] mod_info Mod info to use.
+ * @param[in] mod_state Bitmask of state flags, module with at least one matching bit will be validated.
+ * @param[in] val_opts Validation options.
+ * @param[in] finish_diff Whether to update diff with possible changes caused by validation.
+ * @param[out] validated Whether the independent modules were validated, otherwise all the modules must be validated
+ * sequentially.
+ * @return err_info, NULL on success.
+ */
+static sr_error_info_t *
+sr_modinfo_validate_independent(struct sr_mod_info_s *mod_info, uint32_t mod_state, int val_opts, int finish_diff,
+        int *validated)
+{
+    sr_error_info_t *err_info = NULL, *tmp_err;
+    struct sr_modinfo_job_s *jobs = NULL, *job;
+    struct sr_mod_info_mod_s *mod;
+    uint32_t i, job_count = 0;
+
+    *validated = 0;
+
+    if (ly_ctx_get_module_implemented(mod_info->conn->ly_ctx, "ietf-yang-schema-mount")) {
+        /* mounted data may reference parent data without recorded dependencies */
+        goto cleanup;
+    }
+
+    for (i = 0; i < mod_info->mod_count; ++i) {
+        mod = &mod_info->mods[i];
+        if ((mod->state & mod_state) && !mod->shm_mod->dep_count) {
+            ++job_count;
+        }
+    }
+    if (job_count < 2) {
+        /* nothing to parallelize */
+        goto cleanup;
+    }
+
+    jobs = calloc(job_count, sizeof *jobs);
+    SR_CHECK_MEM_GOTO(!jobs, err_info, cleanup);
+
+    /* separate data of all the independent modules */
+    job_count = 0;
+    for (i = 0; i < mod_info->mod_count; ++i) {
+        mod = &mod_info->mods[i];
+        if ((mod->state & mod_state) && !mod->shm_mod->dep_count) {
+            job = &jobs[job_count++];
+            job->mod = mod;
+            job->val_opts = val_opts;
+            job->finish_diff = finish_diff;
+            job->data = sr_module_data_unlink(&mod_info->data, mod->ly_mod);
+        }
+    }
+
+    sr_modinfo_jobs_run(mod_info->conn, jobs, job_count, sr_modinfo_validate_job, 0);
+
+    /* connect the data back and handle the results in the module order */
+    for (i = 0; i < job_count; ++i) {
+        job = &jobs[i];
+        if (job->data) {
+            lyd_insert_sibling(mod_info->data, job->data, &mod_info->data);
+        }
+
+        if (job->err_info) {
+            /* report only the first failed module, as if validated sequentially */
+            if (!err_info) {
+                err_info = job->err_info;
+                SR_ERRINFO_VALID(&err_info);
+            } else {
+                sr_errinfo_free(&job->err_info);
+            }
+        } else if (job->diff && !err_info) {
+            if ((tmp_err = sr_modinfo_validate_diff_merge(mod_info, job->mod, job->diff))) {
+                sr_errinfo_merge(&err_info, tmp_err);
+            }
+        }
+        lyd_free_all(job->diff);
+    }
+
+    *validated = 1;
+
+cleanup:
+    free(jobs);
+    return err_info;
+}
+
 sr_error_info_t *
 sr_modinfo_validate(struct sr_mod_info_s *mod_info, uint32_t mod_state, int finish_diff)
 {
     sr_error_info_t *err_info = NULL;
     struct sr_mod_info_mod_s *mod;
-    struct lyd_node *diff = NULL, *iter;
+    struct lyd_node *diff = NULL;
     uint32_t i;
-    int val_opts;
+    int val_opts, bounded, indep_validated;
 
     assert(!mod_info->data_cached);
     assert(SR_IS_CONVENTIONAL_DS(mod_info->ds) || !finish_diff);
 
-    /* validate all the modules individually */
+    if (finish_diff && ((mod_info->ds == SR_DS_RUNNING) || (mod_info->ds == SR_DS_STARTUP)) &&
+            (mod_state == (MOD_INFO_CHANGED | MOD_INFO_INV_DEP))) {
+        /* stored data are valid, skip validation if the changes cannot affect it */
+        if ((err_info = sr_modinfo_validate_diff_bounded(mod_info, &bounded))) {
+            goto cleanup;
+        }
+        if (bounded) {
+            SR_LOG_DBG("Changes cannot affect valid \"%s\" data, validation skipped.", sr_ds2str(mod_info->ds));
+            goto cleanup;
+        }
+    }
+
     if (SR_IS_CONVENTIONAL_DS(mod_info->ds)) {
         val_opts = LYD_VALIDATE_NO_STATE;
     } else {
         val_opts = LYD_VALIDATE_OPERATIONAL | LYD_VALIDATE_NO_DEFAULTS;
     }
+
+    /* validate the modules without any dependencies first, each on its own */
+    if ((err_info = sr_modinfo_validate_independent(mod_info, mod_state, val_opts, finish_diff, &indep_validated))) {
+        goto cleanup;
+    }
+
+    /* validate all the remaining modules individually */
     for (i = 0; i < mod_info->mod_count; ++i) {
         mod = &mod_info->mods[i];
-        if (mod->state & mod_state) {
+        if ((mod->state & mod_state) && (!indep_validated || mod->shm_mod->dep_count)) {
             /* validate this module */
             if ((err_info = sr_lyd_validate_module(&mod_info->data, mod->ly_mod, val_opts | LYD_VALIDATE_NOT_FINAL,
                     finish_diff ? &diff : NULL))) {
@@ -2941,26 +4057,12 @@ sr_modinfo_validate(struct sr_mod_info_s *mod_info, uint32_t mod_state, int fini
             }
 
             if (diff) {
-                /* it may not have been modified before */
-                mod->state |= MOD_INFO_CHANGED;
-
-                /* merge the changes made by the validation into our diff */
-                if ((err_info = sr_lyd_diff_merge_all(&mod_info->diff, diff))) {
+                if ((err_info = sr_modinfo_validate_diff_merge(mod_info, mod, diff))) {
                     goto cleanup;
                 }
 
                 lyd_free_all(diff);
                 diff = NULL;
-
-                LY_LIST_FOR(mod_info->diff, iter) {
-                    if (lyd_owner_module(iter) == mod->ly_mod) {
-                        break;
-                    }
-                }
-                if (!iter) {
-                    /* the previous changes have actually been reverted */
-                    mod->state &= ~MOD_INFO_CHANGED;
-                }
             }
         }
     }
@@ -2968,7 +4070,7 @@ sr_modinfo_validate(struct sr_mod_info_s *mod_info, uint32_t mod_state, int fini
     /* finish each module validation now */
     for (i = 0; i < mod_info->mod_count; ++i) {
         mod = &mod_info->mods[i];
-        if (mod->state & mod_state) {
+        if ((mod->state & mod_state) && (!indep_validated || mod->shm_mod->dep_count)) {
             if ((err_info = sr_lyd_validate_module_final(mod_info->data, mod->ly_mod, val_opts))) {
                 SR_ERRINFO_VALID(&err_info);
                 goto cleanup;
@@ -3438,13 +4540,12 @@ sr_modinfo_generate_config_change_notif(struct sr_mod_info_s *mod_info, sr_sessi
     struct ly_set *set;
     sr_mod_t *shm_mod;
     struct timespec notif_ts_mono, notif_ts_real;
-    sr_mod_notif_sub_t *notif_subs;
-    uint32_t idx = 0, notif_sub_count;
+    uint32_t idx = 0;
     char *xpath;
     const char *op_enum;
     sr_change_oper_t op;
     enum edit_op edit_op;
-    int changes;
+    int changes, needed;
     LY_ERR lyrc;
 
     /* make sure there are some actual node changes */
@@ -3472,28 +4573,18 @@ sr_modinfo_generate_config_change_notif(struct sr_mod_info_s *mod_info, sr_sessi
         return NULL;
     }
 
-    /* EXT READ LOCK */
-    if ((err_info = sr_shmext_conn_remap_lock(mod_info->conn, SR_LOCK_READ, 0, __func__))) {
+    /* check whether the notification is needed */
+    if ((err_info = sr_modinfo_config_change_notif_is_needed(mod_info->conn, &needed))) {
         return err_info;
     }
-
-    /* get subscriber count */
-    err_info = sr_notif_find_subscriber(mod_info->conn, "ietf-netconf-notifications", &notif_subs, &notif_sub_count, NULL);
-
-    /* EXT READ UNLOCK */
-    sr_shmext_conn_remap_unlock(mod_info->conn, SR_LOCK_READ, 0, __func__);
-
-    if (err_info) {
-        return err_info;
+    if (!needed) {
+        /* nothing to do */
+        return NULL;
     }
 
-    /* get this module and check replay support */
+    /* get this module */
     shm_mod = sr_shmmod_find_module(SR_CONN_MOD_SHM(mod_info->conn), "ietf-netconf-notifications");
     SR_CHECK_INT_RET(!shm_mod, err_info);
-    if (!shm_mod->replay_supp && !notif_sub_count) {
-        /* nothing to do */
-        return NULL;
-    }
 
     lyrc = ly_set_new(&set);
     SR_CHECK_MEM_GOTO(lyrc, err_info, cleanup);
@@ -3617,82 +4708,170 @@ cleanup:
     return err_info;
 }
 
+/**
+ * @brief Store data of a single module.
+ *
+ * @param[in] job Module job.
+ */
+static void
+sr_modinfo_store_job(struct sr_modinfo_job_s *job)
+{
+    const struct sr_ds_handle_s *ds_handle = job->mod->ds_handle[job->ds];
+    const struct ly_set *values = job->mod->oper_values;
+
+    if (values && ds_handle->plugin->store_oper_values_cb) {
+        /* only values of stored operational edit leaves were changed */
+        job->err_info = ds_handle->plugin->store_oper_values_cb(job->mod->ly_mod,
+                (const struct lyd_node **)values->dnodes, values->count, job->data, ds_handle->plg_data);
+    } else {
+        job->err_info = ds_handle->plugin->store_cb(job->mod->ly_mod, job->ds, job->diff, job->data,
+                ds_handle->plg_data);
+    }
+}
+
 sr_error_info_t *
 sr_modinfo_data_store(struct sr_mod_info_s *mod_info)
 {
-    sr_error_info_t *err_info = NULL;
+    sr_error_info_t *err_info = NULL, *tmp_err;
     struct sr_mod_info_mod_s *mod;
-    struct lyd_node *mod_diff, *mod_data;
-    sr_datastore_t store_ds;
-    uint32_t i;
+    struct sr_modinfo_job_s *jobs = NULL, *job;
+    uint32_t i, job_count = 0;
+    int pruned;
 
     assert(!mod_info->data_cached);
 
+    for (i = 0; i < mod_info->mod_count; ++i) {
+        if (mod_info->mods[i].state & MOD_INFO_CHANGED) {
+            ++job_count;
+        }
+    }
+    if (!job_count) {
+        goto cleanup;
+    }
+
+    jobs = calloc(job_count, sizeof *jobs);
+    SR_CHECK_MEM_GOTO(!jobs, err_info, cleanup);
+
+    /* prepare the jobs while the data of all the modules are still connected */
+    job_count = 0;
+    for (i = 0; i < mod_info->mod_count; ++i) {
+        mod = &mod_info->mods[i];
+        if (mod->state & MOD_INFO_CHANGED) {
+            job = &jobs[job_count++];
+            job->mod = mod;
+
+            if ((mod_info->ds == SR_DS_OPERATIONAL) && (mod_info->ds2 == SR_DS_OPERATIONAL)) {
+                /* do not keep storing the data of dead connections */
+                if ((err_info = sr_module_oper_data_prune(mod, &mod_info->data, &pruned))) {
+                    goto cleanup;
+                }
+                if (pruned) {
+                    /* store the whole edit */
+                    ly_set_free(mod->oper_values, NULL);
+                    mod->oper_values = NULL;
+                    job->oper_rescan = 1;
+                }
+            }
+        }
+    }
+
+    job_count = 0;
     for (i = 0; i < mod_info->mod_count; ++i) {
         mod = &mod_info->mods[i];
         if (mod->state & MOD_INFO_CHANGED) {
+            job = &jobs[job_count++];
+
             /* separate diff and data of this module */
-            mod_diff = (mod_info->ds == SR_DS_OPERATIONAL) ? NULL : sr_module_data_unlink(&mod_info->diff, mod->ly_mod);
-            mod_data = sr_module_data_unlink(&mod_info->data, mod->ly_mod);
+            job->diff = (mod_info->ds == SR_DS_OPERATIONAL) ? NULL : sr_module_data_unlink(&mod_info->diff, mod->ly_mod);
+            job->data = sr_module_data_unlink(&mod_info->data, mod->ly_mod);
 
             if ((mod_info->ds == SR_DS_RUNNING) && !mod->ds_handle[mod_info->ds]) {
                 /* 'running' disabled, use 'startup' */
-                store_ds = SR_DS_STARTUP;
+                job->ds = SR_DS_STARTUP;
             } else {
-                store_ds = mod_info->ds;
+                job->ds = mod_info->ds;
             }
+        }
+    }
 
-            /* store the new data */
-            if ((err_info = mod->ds_handle[store_ds]->plugin->store_cb(mod->ly_mod, store_ds, mod_diff, mod_data,
-                    mod->ds_handle[store_ds]->plg_data))) {
-                lyd_free_siblings(mod_diff);
-                lyd_free_siblings(mod_data);
-                goto cleanup;
-            }
+    /* store the new data, the modules are independent so the plugin callbacks may run in parallel,
+     * stop storing after the first failure */
+    sr_modinfo_jobs_run(mod_info->conn, jobs, job_count, sr_modinfo_store_job, 1);
 
-            if (mod_info->ds == SR_DS_RUNNING) {
-                /* update the cache ID because data were modified, ignored if data_version callback is used instead */
-                mod->shm_mod->run_cache_id++;
+    /* handle the results in the module order */
+    for (i = 0; i < job_count; ++i) {
+        job = &jobs[i];
+        mod = job->mod;
 
-                if (mod_info->conn->opts & SR_CONN_CACHE_RUNNING) {
-                    /* store the changed data in the cache */
-                    if ((err_info = sr_conn_run_cache_update_mod(mod_info->conn, mod->ly_mod, mod->shm_mod->run_cache_id,
-                            mod_data))) {
-                        goto cleanup;
-                    }
+        if (!job->done) {
+            /* skipped after another module failed to be stored, connect them back */
+            if (job->diff) {
+                lyd_insert_sibling(mod_info->diff, job->diff, &mod_info->diff);
+            }
+            if (job->data) {
+                lyd_insert_sibling(mod_info->data, job->data, &mod_info->data);
+            }
+            continue;
+        } else if (job->err_info) {
+            sr_errinfo_merge(&err_info, job->err_info);
+            job->err_info = NULL;
+            lyd_free_siblings(job->diff);
+            lyd_free_siblings(job->data);
+            continue;
+        }
+
+        /* new data version */
+        mod->shm_mod->data_version[mod_info->ds]++;
 
+        if (mod_info->ds == SR_DS_RUNNING) {
+            /* update the cache ID because data were modified, ignored if data_version callback is used instead */
+            mod->shm_mod->run_cache_id++;
+
+            if (mod_info->conn->opts & SR_CONN_CACHE_RUNNING) {
+                /* store the changed data in the cache */
+                if ((tmp_err = sr_conn_run_cache_update_mod(mod_info->conn, mod->ly_mod, mod->shm_mod->run_cache_id,
+                        job->data))) {
+                    sr_errinfo_merge(&err_info, tmp_err);
+                } else {
                     /* mod data spent */
-                    mod_data = NULL;
+                    job->data = NULL;
                     mod->state &= ~MOD_INFO_DATA;
                 }
             }
+        }
 
-            /* connect them back */
-            if (mod_diff) {
-                lyd_insert_sibling(mod_info->diff, mod_diff, &mod_info->diff);
-            }
-            if (mod_data) {
-                lyd_insert_sibling(mod_info->data, mod_data, &mod_info->data);
+        if ((mod_info->ds == SR_DS_OPERATIONAL) && (mod_info->ds2 == SR_DS_OPERATIONAL)) {
+            /* stored oper data, update the connections with stored data of the module */
+            if ((tmp_err = sr_module_oper_cids_update(mod->shm_mod, mod_info->conn->cid, job->data,
+                    job->oper_rescan))) {
+                sr_errinfo_merge(&err_info, tmp_err);
             }
+        }
 
-            if ((mod_info->ds == SR_DS_OPERATIONAL) && (mod_info->ds2 == SR_DS_OPERATIONAL)) {
-                /* stored oper data, update cache of the modified modules in the connection */
-                if (mod_data) {
-                    if ((err_info = sr_conn_push_oper_mod_add(mod_info->conn, mod->ly_mod->name))) {
-                        goto cleanup;
-                    }
-                } else {
-                    if ((err_info = sr_conn_push_oper_mod_del(mod_info->conn, mod->ly_mod->name))) {
-                        goto cleanup;
-                    }
-                }
+        /* connect them back */
+        if (job->diff) {
+            lyd_insert_sibling(mod_info->diff, job->diff, &mod_info->diff);
+        }
+        if (job->data) {
+            lyd_insert_sibling(mod_info->data, job->data, &mod_info->data);
+        }
+
+        if ((mod_info->ds == SR_DS_OPERATIONAL) && (mod_info->ds2 == SR_DS_OPERATIONAL)) {
+            /* update cache of the modified modules in the connection */
+            if (job->data) {
+                tmp_err = sr_conn_push_oper_mod_add(mod_info->conn, mod->ly_mod->name);
+            } else {
+                tmp_err = sr_conn_push_oper_mod_del(mod_info->conn, mod->ly_mod->name);
+            }
+            if (tmp_err) {
+                sr_errinfo_merge(&err_info, tmp_err);
             }
         }
     }
 
 cleanup:
+    free(jobs);
     return err_info;
-
 }
 
 sr_error_info_t *
@@ -3758,6 +4937,7 @@ sr_modinfo_erase(struct sr_mod_info_s *mod_info)
             }
         }
         free(mod->xpaths);
+        ly_set_free(mod->oper_values, NULL);
     }
 
     free(mod_info->mods);
@@ -38,6 +38,7 @@
 #define MOD_INFO_DATA       0x0100 /* module data were loaded */
 #define MOD_INFO_CHANGED    0x0200 /* module data were changed */
 #define MOD_INFO_XPATH_DYN  0x0400 /* module XPaths are dynamically allocated and need to be freed */
+#define MOD_INFO_DIFF_SUMMARY 0x0800 /* module diff is only a summary of changed top-level subtrees */
 
 /**
  * @brief Mod info structure, used for keeping all relevant modules for a data operation.
@@ -58,6 +59,8 @@ struct sr_mod_info_s {
         uint32_t xpath_count;   /**< Count of XPaths. */
         uint32_t state;         /**< Module state (flags). */
         uint32_t request_id;    /**< Request ID of the published event. */
+        struct ly_set *oper_values; /**< Stored operational edit leaves with only their value changed, NULL if
+                                         there were other changes or they are not tracked. */
     } *mods;                    /**< Relevant modules. */
     uint32_t mod_count;         /**< Modules count. */
 };
@@ -182,9 +185,37 @@ sr_error_info_t *sr_modinfo_edit_merge(struct sr_mod_info_s *mod_info, const str
  *
  * @param[in] mod_info Mod info to use.
  * @param[in,out] src_data New data to set, are spent.
+ * @param[in] summary Whether only a diff summary may be created for modules with only coarse change subscriptions
+ * (::SR_SUBSCR_CHANGE_COARSE). Must not be set if the diff is needed for NACM.
  * @return err_info, NULL on success.
  */
-sr_error_info_t *sr_modinfo_replace(struct sr_mod_info_s *mod_info, struct lyd_node **src_data);
+sr_error_info_t *sr_modinfo_replace(struct sr_mod_info_s *mod_info, struct lyd_node **src_data, int summary);
+
+/**
+ * @brief Learn whether the diff of changes of required modules in mod info is needed. It is if there are any change
+ * subscriptions, the netconf-config-change notification is generated, or a datastore plugin requires the diff.
+ * NACM is not considered.
+ *
+ * @param[in] mod_info Mod info to use.
+ * @param[out] needed Whether the diff is needed.
+ * @return err_info, NULL on success.
+ */
+sr_error_info_t *sr_modinfo_diff_is_needed(struct sr_mod_info_s *mod_info, int *needed);
+
+/**
+ * @brief Replace mod info data with new data without creating any diff, if possible. If there are any change
+ * subscribers, config-change notification, or a datastore plugin requiring the diff, a standard replace is performed.
+ * Mod info is expected to be consolidated without data (::SR_MI_DATA_NO).
+ *
+ * @param[in] mod_info Mod info to use.
+ * @param[in,out] src_data New data to set, are spent.
+ * @param[in] orig_name Event originator name.
+ * @param[in] orig_data Event originator data.
+ * @param[out] bulk Whether the data were replaced without a diff.
+ * @return err_info, NULL on success.
+ */
+sr_error_info_t *sr_modinfo_replace_bulk(struct sr_mod_info_s *mod_info, struct lyd_node **src_data, const char *orig_name,
+        const void *orig_data, int *bulk);
 
 /**
  * @brief Read-lock all changed modules in mod info.
@@ -232,6 +263,9 @@ sr_error_info_t *sr_modinfo_consolidate(struct sr_mod_info_s *mod_info, sr_lock_
 /**
  * @brief Validate data for modules in mod info.
  *
+ * Validation of running or startup is skipped if the changes in the diff cannot affect the validity
+ * of the previously valid data. Modules without any data dependencies are validated in parallel.
+ *
  * @param[in] mod_info Mod info to use.
  * @param[in] mod_state Bitmask of state flags, module with at least one matching bit will be validated.
  * @param[in] finish_diff Whether to update diff with possible changes caused by validation.
@@ -303,11 +337,21 @@ sr_error_info_t *sr_modinfo_generate_config_change_notif(struct sr_mod_info_s *m
 /**
  * @brief Store data (persistently) from mod info.
  *
+ * Modules are stored in parallel, errors are reported in the module order. No more modules are stored after
+ * storing one fails.
+ *
  * @param[in] mod_info Mod info to use.
  * @return err_info, NULL on success.
  */
 sr_error_info_t *sr_modinfo_data_store(struct sr_mod_info_s *mod_info);
 
+/**
+ * @brief Stop all the worker threads of a connection processing module jobs.
+ *
+ * @param[in] conn Connection to use.
+ */
+void sr_modinfo_jobs_stop(sr_conn_ctx_t *conn);
+
 /**
  * @brief Reset (unlock SHM files) all candidate data for mod info.
  *
@@ -28,6 +28,9 @@
 /** suffix of backed-up JSON files */
 #define SRPJSON_FILE_BACKUP_SUFFIX ".bck"
 
+/** suffix of operational value log files */
+#define SRPJSON_FILE_VLOG_SUFFIX ".vlog"
+
 /** permissions of new directories */
 #define SRPJSON_DIR_PERM 00777
 
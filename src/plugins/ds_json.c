@@ -29,6 +29,7 @@
 #include <string.h>
 #include <sys/stat.h>
 #include <sys/types.h>
+#include <sys/uio.h>
 #include <time.h>
 #include <unistd.h>
 
@@ -162,6 +163,135 @@ cleanup:
     return err_info;
 }
 
+/**
+ * @brief Get the path of the operational value log file of a module.
+ *
+ * The log holds records of a leaf path and its new value, both null-terminated, applied on the operational
+ * data file when loaded.
+ *
+ * @param[in] mod Module.
+ * @param[out] path Log file path.
+ * @return err_info, NULL on success.
+ */
+static sr_error_info_t *
+srpds_json_vlog_path(const struct lys_module *mod, char **path)
+{
+    sr_error_info_t *err_info = NULL;
+    char *data_path = NULL;
+
+    if ((err_info = srpjson_get_path(srpds_name, mod->name, SR_DS_OPERATIONAL, &data_path))) {
+        return err_info;
+    }
+
+    if (asprintf(path, "%s%s", data_path, SRPJSON_FILE_VLOG_SUFFIX) == -1) {
+        *path = NULL;
+        srplg_log_errinfo(&err_info, srpds_name, NULL, SR_ERR_NO_MEMORY, "Memory allocation failed.");
+    }
+    free(data_path);
+    return err_info;
+}
+
+/**
+ * @brief Remove the operational value log file of a module.
+ *
+ * @param[in] mod Module.
+ * @return err_info, NULL on success.
+ */
+static sr_error_info_t *
+srpds_json_vlog_unlink(const struct lys_module *mod)
+{
+    sr_error_info_t *err_info = NULL;
+    char *path = NULL;
+
+    if ((err_info = srpds_json_vlog_path(mod, &path))) {
+        return err_info;
+    }
+
+    if ((unlink(path) == -1) && (errno != ENOENT)) {
+        srplg_log_errinfo(&err_info, srpds_name, NULL, SR_ERR_SYS, "Failed to unlink \"%s\" (%s).", path,
+                strerror(errno));
+    }
+    free(path);
+    return err_info;
+}
+
+/**
+ * @brief Apply the operational value log of a module on its loaded edit.
+ *
+ * @param[in] mod Module.
+ * @param[in] mod_data Loaded edit of @p mod.
+ * @return err_info, NULL on success.
+ */
+static sr_error_info_t *
+srpds_json_vlog_replay(const struct lys_module *mod, struct lyd_node *mod_data)
+{
+    sr_error_info_t *err_info = NULL;
+    struct stat st;
+    struct lyd_node *node;
+    char *path = NULL, *buf = NULL, *rec, *value, *end;
+    int fd = -1;
+    LY_ERR lyrc;
+
+    if ((err_info = srpds_json_vlog_path(mod, &path))) {
+        goto cleanup;
+    }
+
+    /* open the log, if any */
+    if ((fd = srpjson_open(srpds_name, path, O_RDONLY, 0)) == -1) {
+        if (errno != ENOENT) {
+            err_info = srpjson_open_error(srpds_name, path);
+        }
+        goto cleanup;
+    }
+    if (fstat(fd, &st) == -1) {
+        srplg_log_errinfo(&err_info, srpds_name, NULL, SR_ERR_SYS, "Stat of \"%s\" failed (%s).", path,
+                strerror(errno));
+        goto cleanup;
+    }
+    if (!st.st_size) {
+        goto cleanup;
+    }
+
+    /* read it whole */
+    if (!(buf = malloc(st.st_size))) {
+        srplg_log_errinfo(&err_info, srpds_name, NULL, SR_ERR_NO_MEMORY, "Memory allocation failed.");
+        goto cleanup;
+    }
+    if ((err_info = srpjson_read(srpds_name, fd, buf, st.st_size))) {
+        goto cleanup;
+    }
+
+    /* apply the records in order */
+    end = buf + st.st_size;
+    for (rec = buf; rec < end; rec = value + strlen(value) + 1) {
+        value = memchr(rec, '\0', end - rec);
+        if (!value || (++value == end) || !memchr(value, '\0', end - value)) {
+            /* interrupted append, the values were never stored */
+            SRPLG_LOG_WRN(srpds_name, "Ignoring an incomplete record at the end of \"%s\".", path);
+            break;
+        }
+
+        if (lyd_find_path(mod_data, rec, 0, &node)) {
+            srplg_log_errinfo(&err_info, srpds_name, NULL, SR_ERR_INTERNAL, "Leaf \"%s\" of a value in \"%s\" "
+                    "not found.", rec, path);
+            goto cleanup;
+        }
+        lyrc = lyd_change_term(node, value);
+        if (lyrc && (lyrc != LY_EEXIST) && (lyrc != LY_ENOT)) {
+            err_info = srpjson_log_err_ly(srpds_name, mod->ctx);
+            goto cleanup;
+        }
+    }
+
+cleanup:
+    if (fd > -1) {
+        close(fd);
+    }
+    free(path);
+    free(buf);
+    return err_info;
+}
+
 /**
  * @brief Initialize persistent datastore file.
  *
@@ -268,6 +398,8 @@ srpds_json_uninstall(const struct lys_module *mod, sr_datastore_t ds, void *UNUS
     if ((ds == SR_DS_STARTUP) || (ds == SR_DS_FACTORY_DEFAULT)) {
         /* done */
         goto cleanup;
+    } else if ((ds == SR_DS_OPERATIONAL) && (err_info = srpds_json_vlog_unlink(mod))) {
+        goto cleanup;
     }
 
     /* unlink perm file */
@@ -385,6 +517,11 @@ srpds_json_store(const struct lys_module *mod, sr_datastore_t ds, const struct l
         break;
     }
 
+    /* the whole edit is stored, so any older logged values must not be applied on it even after a crash */
+    if ((ds == SR_DS_OPERATIONAL) && (err_info = srpds_json_vlog_unlink(mod))) {
+        goto cleanup;
+    }
+
     /* store */
     if ((err_info = srpds_json_store_(mod, ds, mod_data, NULL, NULL, perm, 1))) {
         goto cleanup;
@@ -395,6 +532,104 @@ cleanup:
     return err_info;
 }
 
+static sr_error_info_t *
+srpds_json_store_oper_values(const struct lys_module *mod, const struct lyd_node **values, uint32_t value_count,
+        const struct lyd_node *mod_data, void *plg_data)
+{
+    sr_error_info_t *err_info = NULL;
+    struct stat st;
+    struct iovec iov;
+    char *path = NULL, *buf = NULL, *val_path = NULL;
+    const char *value;
+    size_t size = 0, path_len, val_len;
+    off_t data_size, log_size;
+    mode_t perm;
+    int fd = -1;
+    uint32_t i;
+    void *mem;
+
+    /* learn the size of the data file */
+    if ((err_info = srpjson_get_path(srpds_name, mod->name, SR_DS_OPERATIONAL, &path))) {
+        goto cleanup;
+    }
+    if (stat(path, &st) == -1) {
+        if (errno == ENOENT) {
+            /* nothing stored yet */
+            goto store;
+        }
+        srplg_log_errinfo(&err_info, srpds_name, NULL, SR_ERR_SYS, "Stat of \"%s\" failed (%s).", path,
+                strerror(errno));
+        goto cleanup;
+    }
+    data_size = st.st_size;
+    perm = st.st_mode & 0007777;
+
+    /* learn the size of the log */
+    free(path);
+    if ((err_info = srpds_json_vlog_path(mod, &path))) {
+        goto cleanup;
+    }
+    if (stat(path, &st) == 0) {
+        log_size = st.st_size;
+    } else if (errno == ENOENT) {
+        log_size = 0;
+    } else {
+        srplg_log_errinfo(&err_info, srpds_name, NULL, SR_ERR_SYS, "Stat of \"%s\" failed (%s).", path,
+                strerror(errno));
+        goto cleanup;
+    }
+
+    /* print the records */
+    for (i = 0; i < value_count; ++i) {
+        if (!(val_path = lyd_path(values[i], LYD_PATH_STD, NULL, 0))) {
+            err_info = srpjson_log_err_ly(srpds_name, LYD_CTX(values[i]));
+            goto cleanup;
+        }
+        value = lyd_get_value(values[i]);
+        path_len = strlen(val_path) + 1;
+        val_len = strlen(value) + 1;
+
+        if (!(mem = realloc(buf, size + path_len + val_len))) {
+            srplg_log_errinfo(&err_info, srpds_name, NULL, SR_ERR_NO_MEMORY, "Memory allocation failed.");
+            goto cleanup;
+        }
+        buf = mem;
+        memcpy(buf + size, val_path, path_len);
+        memcpy(buf + size + path_len, value, val_len);
+        size += path_len + val_len;
+
+        free(val_path);
+        val_path = NULL;
+    }
+
+    if (log_size + (off_t)size > data_size) {
+        /* the log would outgrow the data, store them whole instead, which removes the log */
+        goto store;
+    }
+
+    /* append the records */
+    if ((fd = srpjson_open(srpds_name, path, O_WRONLY | O_APPEND | O_CREAT, perm)) == -1) {
+        err_info = srpjson_open_error(srpds_name, path);
+        goto cleanup;
+    }
+    iov.iov_base = buf;
+    iov.iov_len = size;
+    err_info = srpjson_writev(srpds_name, fd, &iov, 1);
+    goto cleanup;
+
+store:
+    err_info = srpds_json_store(mod, SR_DS_OPERATIONAL, NULL, mod_data, plg_data);
+
+cleanup:
+    if (fd > -1) {
+        close(fd);
+    }
+    free(path);
+    free(buf);
+    free(val_path);
+    return err_info;
+}
+
 static void
 srpds_json_recover(const struct lys_module *mod, sr_datastore_t ds, void *UNUSED(plg_data))
 {
@@ -457,6 +692,11 @@ srpds_json_recover(const struct lys_module *mod, sr_datastore_t ds, void *UNUSED
                     strerror(errno));
             goto cleanup;
         }
+
+        /* the logged values belong to the removed data */
+        if ((ds == SR_DS_OPERATIONAL) && (err_info = srpds_json_vlog_unlink(mod))) {
+            goto cleanup;
+        }
     }
 
 cleanup:
@@ -527,6 +767,13 @@ srpds_json_load(const struct lys_module *mod, sr_datastore_t ds, const char **UN
         goto cleanup;
     }
 
+    /* apply any values stored after the edit */
+    if ((ds == SR_DS_OPERATIONAL) && (err_info = srpds_json_vlog_replay(mod, *mod_data))) {
+        lyd_free_all(*mod_data);
+        *mod_data = NULL;
+        goto cleanup;
+    }
+
 cleanup:
     if (fd > -1) {
         close(fd);
@@ -854,6 +1101,18 @@ srpds_json_last_modif(const struct lys_module *mod, sr_datastore_t ds, void *UNU
         mtime->tv_nsec = 0;
     } else {
         srplg_log_errinfo(&err_info, srpds_name, NULL, SR_ERR_SYS, "Stat of \"%s\" failed (%s).", path, strerror(errno));
+        goto cleanup;
+    }
+
+    if (mtime->tv_sec && (ds == SR_DS_OPERATIONAL)) {
+        /* values may have been stored in the log later */
+        free(path);
+        if ((err_info = srpds_json_vlog_path(mod, &path))) {
+            goto cleanup;
+        }
+        if ((stat(path, &st) == 0) && (srpjson_time_cmp(&st.st_mtim, mtime) > 0)) {
+            *mtime = st.st_mtim;
+        }
     }
 
 cleanup:
@@ -879,4 +1138,6 @@ const struct srplg_ds_s srpds_json = {
     .access_check_cb = srpds_json_access_check,
     .last_modif_cb = srpds_json_last_modif,
     .data_version_cb = NULL,
+    .store_oper_values_cb = srpds_json_store_oper_values,
+    .flags = 0,
 };
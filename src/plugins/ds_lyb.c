@@ -0,0 +1,664 @@
+/**
+ * @file ds_lyb.c
+ * @brief internal LYB SHM datastore plugin
+ *
+ * @copyright
+ * Copyright (c) 2021 - 2023 Deutsche Telekom AG.
+ * Copyright (c) 2021 - 2023 CESNET, z.s.p.o.
+ *
+ * This source code is licensed under BSD 3-Clause License (the "License").
+ * You may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://opensource.org/licenses/BSD-3-Clause
+ */
+
+#define _GNU_SOURCE
+#define _POSIX_C_SOURCE 200809L /* stat.mtim */
+
+#include "compat.h"
+#include "plugins_datastore.h"
+
+#include <assert.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <libyang/libyang.h>
+
+#include "common_json.h"
+#include "common_types.h"
+#include "sysrepo.h"
+
+#define srpds_name "LYB DS shm"  /**< plugin name */
+
+#define SRPLYB_SIZE_INVALID UINT64_MAX  /**< data size marking an interrupted store */
+
+/**
+ * @brief Header of every LYB SHM data file, followed by the LYB data.
+ */
+struct srplyb_hdr {
+    uint32_t version;   /**< data version, incremented on every store, never UINT32_MAX */
+    uint32_t padding;
+    uint64_t size;      /**< size of the following LYB data, ::SRPLYB_SIZE_INVALID while being written */
+};
+
+/**
+ * @brief Check whether a datastore is handled by this plugin and not forwarded to the JSON plugin.
+ *
+ * @param[in] ds Datastore.
+ * @return Whether the datastore is volatile and kept in SHM.
+ */
+#define SRPLYB_DS_SHM(ds) (((ds) == SR_DS_RUNNING) || ((ds) == SR_DS_CANDIDATE) || ((ds) == SR_DS_OPERATIONAL))
+
+static sr_error_info_t *srpds_lyb_load(const struct lys_module *mod, sr_datastore_t ds, const char **xpaths,
+        uint32_t xpath_count, void *plg_data, struct lyd_node **mod_data);
+
+/**
+ * @brief Get path of a LYB SHM data file.
+ *
+ * @param[in] mod_name Module name.
+ * @param[in] ds Volatile datastore.
+ * @param[out] path Path to the file.
+ * @return SR err info, NULL on success.
+ */
+static sr_error_info_t *
+srplyb_get_path(const char *mod_name, sr_datastore_t ds, char **path)
+{
+    sr_error_info_t *err_info = NULL;
+    const char *prefix;
+
+    assert(SRPLYB_DS_SHM(ds));
+
+    if ((err_info = srpjson_shm_prefix(srpds_name, &prefix))) {
+        return err_info;
+    }
+
+    if (asprintf(path, "%s/%s_%s.%s.lyb", SR_SHM_DIR, prefix, mod_name, srpjson_ds2str(ds)) == -1) {
+        *path = NULL;
+        srplg_log_errinfo(&err_info, srpds_name, NULL, SR_ERR_NO_MEMORY, "Memory allocation failed.");
+        return err_info;
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Read the header of a LYB SHM data file.
+ *
+ * @param[in] fd File descriptor.
+ * @param[in] path File path for logging.
+ * @param[out] hdr Read header, zeroed for an empty file.
+ * @return SR err info, NULL on success.
+ */
+static sr_error_info_t *
+srplyb_read_hdr(int fd, const char *path, struct srplyb_hdr *hdr)
+{
+    sr_error_info_t *err_info = NULL;
+    ssize_t r;
+
+    memset(hdr, 0, sizeof *hdr);
+
+    r = pread(fd, hdr, sizeof *hdr, 0);
+    if (r == -1) {
+        srplg_log_errinfo(&err_info, srpds_name, NULL, SR_ERR_SYS, "Reading \"%s\" failed (%s).", path, strerror(errno));
+        return err_info;
+    } else if (!r) {
+        /* new file */
+        return NULL;
+    } else if (r < (signed)sizeof *hdr) {
+        srplg_log_errinfo(&err_info, srpds_name, NULL, SR_ERR_INTERNAL, "Data file \"%s\" is truncated.", path);
+        return err_info;
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Write the header of a LYB SHM data file.
+ *
+ * @param[in] fd File descriptor.
+ * @param[in] path File path for logging.
+ * @param[in] hdr Header to write.
+ * @return SR err info, NULL on success.
+ */
+static sr_error_info_t *
+srplyb_write_hdr(int fd, const char *path, const struct srplyb_hdr *hdr)
+{
+    sr_error_info_t *err_info = NULL;
+
+    if (pwrite(fd, hdr, sizeof *hdr, 0) != (signed)sizeof *hdr) {
+        srplg_log_errinfo(&err_info, srpds_name, NULL, SR_ERR_SYS, "Writing \"%s\" failed (%s).", path, strerror(errno));
+        return err_info;
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Store data into a LYB SHM data file, create it if it does not exist.
+ *
+ * @param[in] mod Module of the data.
+ * @param[in] ds Volatile datastore.
+ * @param[in] mod_data Data to store, may be NULL.
+ * @param[in] set_owner Whether to also set owner/group of a created file, not only its permissions.
+ * @return SR err info, NULL on success.
+ */
+static sr_error_info_t *
+srpds_lyb_store_(const struct lys_module *mod, sr_datastore_t ds, const struct lyd_node *mod_data, int set_owner)
+{
+    sr_error_info_t *err_info = NULL;
+    struct srplyb_hdr hdr;
+    struct ly_out *out = NULL;
+    char *path = NULL, *owner = NULL, *group = NULL, *buf = NULL;
+    size_t size = 0, written;
+    ssize_t r;
+    mode_t perm = 0;
+    int fd = -1, creat = 0;
+
+    if ((err_info = srplyb_get_path(mod->name, ds, &path))) {
+        goto cleanup;
+    }
+
+    /* print the data into memory first so that the file is only copied into */
+    if (mod_data) {
+        if (ly_out_new_memory(&buf, 0, &out)) {
+            err_info = srpjson_log_err_ly(srpds_name, mod->ctx);
+            goto cleanup;
+        }
+        if (lyd_print_all(out, mod_data, LYD_LYB, 0)) {
+            err_info = srpjson_log_err_ly(srpds_name, mod->ctx);
+            goto cleanup;
+        }
+        size = ly_out_printed(out);
+    }
+
+    /* open the file, create it with the correct permissions if needed */
+    if ((fd = srpjson_open(srpds_name, path, O_RDWR, 0)) == -1) {
+        if (errno != ENOENT) {
+            err_info = srpjson_open_error(srpds_name, path);
+            goto cleanup;
+        }
+
+        /* owner/group only if requested because we may not have permissions to set them */
+        if ((err_info = srpds_json.access_get_cb(mod, ds, NULL, set_owner ? &owner : NULL, set_owner ? &group : NULL,
+                &perm))) {
+            goto cleanup;
+        }
+        if ((fd = srpjson_open(srpds_name, path, O_RDWR | O_CREAT | O_EXCL, perm)) == -1) {
+            err_info = srpjson_open_error(srpds_name, path);
+            goto cleanup;
+        }
+        creat = 1;
+    }
+
+    /* learn the current version and mark the data as being written */
+    if ((err_info = srplyb_read_hdr(fd, path, &hdr))) {
+        goto cleanup;
+    }
+    hdr.size = SRPLYB_SIZE_INVALID;
+    if ((err_info = srplyb_write_hdr(fd, path, &hdr))) {
+        goto cleanup;
+    }
+
+    /* write the data */
+    if (ftruncate(fd, sizeof hdr + size) == -1) {
+        srplg_log_errinfo(&err_info, srpds_name, NULL, SR_ERR_SYS, "Truncating \"%s\" failed (%s).", path, strerror(errno));
+        goto cleanup;
+    }
+    written = 0;
+    while (written < size) {
+        r = pwrite(fd, buf + written, size - written, sizeof hdr + written);
+        if (r == -1) {
+            if (errno == EINTR) {
+                continue;
+            }
+            srplg_log_errinfo(&err_info, srpds_name, NULL, SR_ERR_SYS, "Writing \"%s\" failed (%s).", path, strerror(errno));
+            goto cleanup;
+        }
+        written += r;
+    }
+
+    /* publish the new data version */
+    ++hdr.version;
+    if (hdr.version == UINT32_MAX) {
+        hdr.version = 1;
+    }
+    hdr.size = size;
+    if ((err_info = srplyb_write_hdr(fd, path, &hdr))) {
+        goto cleanup;
+    }
+
+    if (creat && (owner || group) && (err_info = srpjson_chmodown(srpds_name, path, owner, group, 0))) {
+        goto cleanup;
+    }
+
+cleanup:
+    if (fd > -1) {
+        close(fd);
+    }
+    ly_out_free(out, NULL, 1);
+    if (err_info && creat) {
+        unlink(path);
+    }
+    free(path);
+    free(owner);
+    free(group);
+    return err_info;
+}
+
+static sr_error_info_t *
+srpds_lyb_install(const struct lys_module *mod, sr_datastore_t ds, const char *owner, const char *group, mode_t perm,
+        void *plg_data)
+{
+    /* persistent files and volatile permission files are shared with the JSON plugin */
+    return srpds_json.install_cb(mod, ds, owner, group, perm, plg_data);
+}
+
+static sr_error_info_t *
+srpds_lyb_uninstall(const struct lys_module *mod, sr_datastore_t ds, void *plg_data)
+{
+    sr_error_info_t *err_info = NULL;
+    char *path = NULL;
+
+    if (SRPLYB_DS_SHM(ds)) {
+        /* unlink data file */
+        if ((err_info = srplyb_get_path(mod->name, ds, &path))) {
+            return err_info;
+        }
+        if ((unlink(path) == -1) && (errno != ENOENT)) {
+            SRPLG_LOG_WRN(srpds_name, "Failed to unlink \"%s\" (%s).", path, strerror(errno));
+        }
+        free(path);
+    }
+
+    return srpds_json.uninstall_cb(mod, ds, plg_data);
+}
+
+static sr_error_info_t *
+srpds_lyb_init(const struct lys_module *mod, sr_datastore_t ds, void *UNUSED(plg_data))
+{
+    if (ds != SR_DS_RUNNING) {
+        /* startup and factory-default are JSON files and candidate with operational exists only if modified */
+        return NULL;
+    }
+
+    if (!srpjson_module_has_data(mod, 0)) {
+        /* no data, do not create the file */
+        return NULL;
+    }
+
+    /* create empty running data */
+    return srpds_lyb_store_(mod, ds, NULL, 1);
+}
+
+static sr_error_info_t *
+srpds_lyb_conn_init(sr_conn_ctx_t *UNUSED(conn), void **UNUSED(plg_data))
+{
+    return NULL;
+}
+
+static void
+srpds_lyb_conn_destroy(sr_conn_ctx_t *UNUSED(conn), void *UNUSED(plg_data))
+{
+}
+
+static sr_error_info_t *
+srpds_lyb_store(const struct lys_module *mod, sr_datastore_t ds, const struct lyd_node *mod_diff,
+        const struct lyd_node *mod_data, void *plg_data)
+{
+    if (!SRPLYB_DS_SHM(ds)) {
+        return srpds_json.store_cb(mod, ds, mod_diff, mod_data, plg_data);
+    }
+
+    return srpds_lyb_store_(mod, ds, mod_data, 0);
+}
+
+static void
+srpds_lyb_recover(const struct lys_module *mod, sr_datastore_t ds, void *plg_data)
+{
+    sr_error_info_t *err_info = NULL;
+    char *path = NULL;
+    struct lyd_node *mod_data = NULL;
+
+    if (!SRPLYB_DS_SHM(ds)) {
+        srpds_json.recover_cb(mod, ds, plg_data);
+        return;
+    }
+
+    /* check whether the data are valid */
+    if (!(err_info = srpds_lyb_load(mod, ds, NULL, 0, NULL, &mod_data))) {
+        goto cleanup;
+    }
+    srplg_errinfo_free(&err_info);
+
+    if (ds == SR_DS_RUNNING) {
+        SRPLG_LOG_WRN(srpds_name, "Recovering \"%s\" running data from the startup data.", mod->name);
+
+        /* store startup data into running */
+        if ((err_info = srpds_json.load_cb(mod, SR_DS_STARTUP, NULL, 0, NULL, &mod_data))) {
+            goto cleanup;
+        }
+        if ((err_info = srpds_lyb_store_(mod, ds, mod_data, 0))) {
+            goto cleanup;
+        }
+    } else {
+        /* there is not much to do but remove the corrupted file */
+        SRPLG_LOG_WRN(srpds_name, "Recovering \"%s\" %s data by removing the corrupted data file.", mod->name,
+                srpjson_ds2str(ds));
+
+        if ((err_info = srplyb_get_path(mod->name, ds, &path))) {
+            goto cleanup;
+        }
+        if (unlink(path) == -1) {
+            srplg_log_errinfo(&err_info, srpds_name, NULL, SR_ERR_SYS, "Unlinking \"%s\" failed (%s).", path,
+                    strerror(errno));
+            goto cleanup;
+        }
+    }
+
+cleanup:
+    free(path);
+    lyd_free_all(mod_data);
+    srplg_errinfo_free(&err_info);
+}
+
+static sr_error_info_t *
+srpds_lyb_load(const struct lys_module *mod, sr_datastore_t ds, const char **xpaths, uint32_t xpath_count,
+        void *plg_data, struct lyd_node **mod_data)
+{
+    sr_error_info_t *err_info = NULL;
+    struct srplyb_hdr hdr;
+    struct stat st;
+    char *path = NULL, *addr = MAP_FAILED;
+    size_t map_size = 0;
+    int fd = -1;
+    uint32_t parse_opts;
+
+    if (!SRPLYB_DS_SHM(ds)) {
+        return srpds_json.load_cb(mod, ds, xpaths, xpath_count, plg_data, mod_data);
+    }
+
+    *mod_data = NULL;
+
+    if ((err_info = srplyb_get_path(mod->name, ds, &path))) {
+        goto cleanup;
+    }
+
+    /* open fd */
+    if ((fd = srpjson_open(srpds_name, path, O_RDONLY, 0)) == -1) {
+        if (errno == ENOENT) {
+            if ((ds == SR_DS_OPERATIONAL) || ((ds == SR_DS_RUNNING) && !srpjson_module_has_data(mod, 0))) {
+                /* no data */
+                goto cleanup;
+            }
+        }
+
+        err_info = srpjson_open_error(srpds_name, path);
+        goto cleanup;
+    }
+
+    /* check the data are complete */
+    if ((err_info = srplyb_read_hdr(fd, path, &hdr))) {
+        goto cleanup;
+    }
+    if (hdr.size == SRPLYB_SIZE_INVALID) {
+        srplg_log_errinfo(&err_info, srpds_name, NULL, SR_ERR_INTERNAL, "Data file \"%s\" was not completely written.",
+                path);
+        goto cleanup;
+    }
+    if (!hdr.size) {
+        /* empty data */
+        goto cleanup;
+    }
+
+    /* map the data */
+    if (fstat(fd, &st) == -1) {
+        srplg_log_errinfo(&err_info, srpds_name, NULL, SR_ERR_SYS, "Stat of \"%s\" failed (%s).", path, strerror(errno));
+        goto cleanup;
+    }
+    if ((uint64_t)st.st_size < sizeof hdr + hdr.size) {
+        srplg_log_errinfo(&err_info, srpds_name, NULL, SR_ERR_INTERNAL, "Data file \"%s\" is truncated.", path);
+        goto cleanup;
+    }
+    map_size = sizeof hdr + hdr.size;
+    addr = mmap(NULL, map_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (addr == MAP_FAILED) {
+        srplg_log_errinfo(&err_info, srpds_name, NULL, SR_ERR_SYS, "Mapping \"%s\" failed (%s).", path, strerror(errno));
+        goto cleanup;
+    }
+
+    /* set parse options, same as the JSON plugin */
+    parse_opts = LYD_PARSE_STORE_ONLY | LYD_PARSE_ORDERED;
+    if (ds == SR_DS_OPERATIONAL) {
+        /* edit may include opaque nodes */
+        parse_opts |= LYD_PARSE_OPAQ;
+    } else {
+        parse_opts |= LYD_PARSE_STRICT;
+    }
+    if (ds == SR_DS_RUNNING) {
+        /* always valid datastore */
+        parse_opts |= LYD_PARSE_WHEN_TRUE | LYD_PARSE_NO_NEW;
+    }
+
+    /* load the data */
+    if (lyd_parse_data_mem(mod->ctx, addr + sizeof hdr, LYD_LYB, parse_opts, 0, mod_data)) {
+        err_info = srpjson_log_err_ly(srpds_name, mod->ctx);
+        goto cleanup;
+    }
+
+cleanup:
+    if (addr != MAP_FAILED) {
+        munmap(addr, map_size);
+    }
+    if (fd > -1) {
+        close(fd);
+    }
+    free(path);
+    return err_info;
+}
+
+static sr_error_info_t *
+srpds_lyb_copy(const struct lys_module *mod, sr_datastore_t trg_ds, sr_datastore_t src_ds, void *plg_data)
+{
+    sr_error_info_t *err_info = NULL;
+    struct lyd_node *mod_data = NULL;
+
+    if (!SRPLYB_DS_SHM(trg_ds) && !SRPLYB_DS_SHM(src_ds)) {
+        /* JSON files */
+        return srpds_json.copy_cb(mod, trg_ds, src_ds, plg_data);
+    }
+
+    /* load source data */
+    if ((err_info = srpds_lyb_load(mod, src_ds, NULL, 0, plg_data, &mod_data))) {
+        goto cleanup;
+    }
+
+    /* store them into the target */
+    if (SRPLYB_DS_SHM(trg_ds)) {
+        err_info = srpds_lyb_store_(mod, trg_ds, mod_data, 1);
+    } else {
+        err_info = srpds_json.store_cb(mod, trg_ds, NULL, mod_data, plg_data);
+    }
+    if (err_info) {
+        goto cleanup;
+    }
+
+cleanup:
+    lyd_free_all(mod_data);
+    return err_info;
+}
+
+static sr_error_info_t *
+srpds_lyb_candidate_modified(const struct lys_module *mod, void *UNUSED(plg_data), int *modified)
+{
+    sr_error_info_t *err_info = NULL;
+    char *path = NULL;
+
+    /* candidate DS file cannot exist */
+    if ((err_info = srplyb_get_path(mod->name, SR_DS_CANDIDATE, &path))) {
+        return err_info;
+    }
+
+    *modified = srpjson_file_exists(srpds_name, path);
+
+    free(path);
+    return NULL;
+}
+
+static sr_error_info_t *
+srpds_lyb_candidate_reset(const struct lys_module *mod, void *UNUSED(plg_data))
+{
+    sr_error_info_t *err_info = NULL;
+    char *path;
+
+    if ((err_info = srplyb_get_path(mod->name, SR_DS_CANDIDATE, &path))) {
+        return err_info;
+    }
+
+    if ((unlink(path) == -1) && (errno != ENOENT)) {
+        SRPLG_LOG_WRN(srpds_name, "Failed to unlink \"%s\" (%s).", path, strerror(errno));
+    }
+    free(path);
+
+    return NULL;
+}
+
+static sr_error_info_t *
+srpds_lyb_access_set(const struct lys_module *mod, sr_datastore_t ds, const char *owner, const char *group,
+        mode_t perm, void *plg_data)
+{
+    sr_error_info_t *err_info = NULL;
+    char *path = NULL;
+
+    if (SRPLYB_DS_SHM(ds)) {
+        /* data file may not exist */
+        if ((err_info = srplyb_get_path(mod->name, ds, &path))) {
+            goto cleanup;
+        }
+        if (srpjson_file_exists(srpds_name, path) && (err_info = srpjson_chmodown(srpds_name, path, owner, group, perm))) {
+            goto cleanup;
+        }
+    }
+
+    /* JSON files or volatile datastore permission file */
+    err_info = srpds_json.access_set_cb(mod, ds, owner, group, perm, plg_data);
+
+cleanup:
+    free(path);
+    return err_info;
+}
+
+static sr_error_info_t *
+srpds_lyb_access_get(const struct lys_module *mod, sr_datastore_t ds, void *plg_data, char **owner, char **group,
+        mode_t *perm)
+{
+    return srpds_json.access_get_cb(mod, ds, plg_data, owner, group, perm);
+}
+
+static sr_error_info_t *
+srpds_lyb_access_check(const struct lys_module *mod, sr_datastore_t ds, void *plg_data, int *read, int *write)
+{
+    return srpds_json.access_check_cb(mod, ds, plg_data, read, write);
+}
+
+static sr_error_info_t *
+srpds_lyb_last_modif(const struct lys_module *mod, sr_datastore_t ds, void *plg_data, struct timespec *mtime)
+{
+    sr_error_info_t *err_info = NULL;
+    char *path = NULL;
+    struct stat st;
+
+    if (!SRPLYB_DS_SHM(ds)) {
+        return srpds_json.last_modif_cb(mod, ds, plg_data, mtime);
+    }
+
+    if ((err_info = srplyb_get_path(mod->name, ds, &path))) {
+        goto cleanup;
+    }
+
+    if (stat(path, &st) == 0) {
+        *mtime = st.st_mtim;
+    } else if (errno == ENOENT) {
+        /* the file may not exist */
+        mtime->tv_sec = 0;
+        mtime->tv_nsec = 0;
+    } else {
+        srplg_log_errinfo(&err_info, srpds_name, NULL, SR_ERR_SYS, "Stat of \"%s\" failed (%s).", path, strerror(errno));
+    }
+
+cleanup:
+    free(path);
+    return err_info;
+}
+
+static sr_error_info_t *
+srpds_lyb_data_version(const struct lys_module *mod, sr_datastore_t ds, void *UNUSED(plg_data), uint32_t *version)
+{
+    sr_error_info_t *err_info = NULL;
+    struct srplyb_hdr hdr = {0};
+    char *path = NULL;
+    int fd = -1;
+
+    *version = 0;
+
+    if (!SRPLYB_DS_SHM(ds)) {
+        /* not cached */
+        srplg_log_errinfo(&err_info, srpds_name, NULL, SR_ERR_UNSUPPORTED, "Data version of %s datastore not supported.",
+                srpjson_ds2str(ds));
+        goto cleanup;
+    }
+
+    if ((err_info = srplyb_get_path(mod->name, ds, &path))) {
+        goto cleanup;
+    }
+
+    /* only the header is read, the data are never touched */
+    if ((fd = srpjson_open(srpds_name, path, O_RDONLY, 0)) == -1) {
+        if (errno != ENOENT) {
+            err_info = srpjson_open_error(srpds_name, path);
+        }
+        goto cleanup;
+    }
+    if ((err_info = srplyb_read_hdr(fd, path, &hdr))) {
+        goto cleanup;
+    }
+    *version = hdr.version;
+
+cleanup:
+    if (fd > -1) {
+        close(fd);
+    }
+    free(path);
+    return err_info;
+}
+
+const struct srplg_ds_s srpds_lyb = {
+    .name = srpds_name,
+    .install_cb = srpds_lyb_install,
+    .uninstall_cb = srpds_lyb_uninstall,
+    .init_cb = srpds_lyb_init,
+    .conn_init_cb = srpds_lyb_conn_init,
+    .conn_destroy_cb = srpds_lyb_conn_destroy,
+    .store_cb = srpds_lyb_store,
+    .recover_cb = srpds_lyb_recover,
+    .load_cb = srpds_lyb_load,
+    .copy_cb = srpds_lyb_copy,
+    .candidate_modified_cb = srpds_lyb_candidate_modified,
+    .candidate_reset_cb = srpds_lyb_candidate_reset,
+    .access_set_cb = srpds_lyb_access_set,
+    .access_get_cb = srpds_lyb_access_get,
+    .access_check_cb = srpds_lyb_access_check,
+    .last_modif_cb = srpds_lyb_last_modif,
+    .data_version_cb = srpds_lyb_data_version,
+    .store_oper_values_cb = NULL,
+    .flags = 0,
+};
@@ -1514,63 +1514,80 @@ cleanup:
 }
 
 /**
- * @brief If there is only one point order gap between elements where newly created element
- *          should be placed, shifting has to be done, e.g. 1  3  {4}   [5]  8  13
- *                                                                    *
- *                                                                    |
- *                                                                new element
- *                                                                    |
-*                                                                     *
- *                                                          1  3  {4} 5 [6]  8  13
+ * @brief If there is no order gap between elements where newly created element should be placed,
+ *          all the following elements are rebalanced so that there is a full gap after each of them,
+ *          e.g. 1  3  {4}   [5]  8  13
+ *                         *
+ *                         |
+ *                     new element
+ *                         |
+ *                         *
+ *              1  3  {4}  [1029]  2053  3077
+ *
+ * All the elements are retrieved in a single query and updated in a single unordered bulk operation.
+ *
  * @param[in] module Given MongoDB collection.
  * @param[in] path_no_pred Path of a list/leaf-list instance without a predicate.
  * @param[in] next_elem_order Order of the next element.
- * @param[out] max_order Changed maximum order (shifting can change maximum order).
+ * @param[in,out] max_order Changed maximum order (rebalancing changes maximum order).
+ * @param[out] new_next_elem_order New order of the next element.
  * @return NULL on success;
  * @return Sysrepo error info on error.
  */
 static sr_error_info_t *
-srpds_shift_uo_list_recursively(mongoc_collection_t *module, const char *path_no_pred, uint64_t next_elem_order, uint64_t *max_order)
+srpds_rebalance_uo_list(mongoc_collection_t *module, const char *path_no_pred, uint64_t next_elem_order,
+        uint64_t *max_order, uint64_t *new_next_elem_order)
 {
-    sr_error_info_t *err_info = 0;
-    int found = 0;
+    sr_error_info_t *err_info = NULL;
     bson_error_t error;
     mongoc_cursor_t *cursor = NULL;
-    bson_t *doc = NULL, *doc2 = NULL, *bson_query_key = NULL,
-            *bson_query_rep = NULL;
+    mongoc_bulk_operation_t *bulk = NULL;
+    bson_t *doc = NULL, *opts = NULL, *bulk_opts = NULL, *bson_query_key = NULL, *bson_query_rep = NULL, reply;
+    const bson_t *doc2;
     bson_iter_t iter;
-    const char *path = NULL;
+    char **paths = NULL;
+    const char *path;
+    uint32_t i, path_count = 0;
+    uint64_t order;
+    void *mem;
+
+    bson_init(&reply);
+    *new_next_elem_order = next_elem_order;
 
     if ((err_info = srpds_get_maxord(module, path_no_pred, max_order))) {
         goto cleanup;
     }
 
-    if (*max_order < next_elem_order) {
-        *max_order = next_elem_order;
-    }
+    /* find all the following elements sorted by their order, retrieve only their paths */
+    doc = BCON_NEW("path_no_pred", BCON_UTF8(path_no_pred), "order", "{", "$gte", BCON_INT64(next_elem_order), "}");
+    opts = BCON_NEW("sort", "{", "order", BCON_INT32(1), "}", "projection", "{", "_id", BCON_INT32(1), "}");
+    cursor = mongoc_collection_find_with_opts(module, doc, opts, NULL);
 
-    /* find the next element */
-    doc = BCON_NEW("order", BCON_INT64(next_elem_order), "path_no_pred", BCON_UTF8(path_no_pred));
-    cursor = mongoc_collection_find_with_opts(module, doc, NULL, NULL);
-
-    if (mongoc_cursor_next(cursor, (const bson_t **) &doc2)) {
-        found = 1;
-
-        if (!bson_iter_init(&iter, doc2)) {
-            ERRINFO(&err_info, plugin_name, SR_ERR_OPERATION_FAILED, "bson_iter_init()", "")
+    /* collect all the paths first, the elements cannot be changed while the cursor is being read */
+    while (mongoc_cursor_next(cursor, &doc2)) {
+        if (!bson_iter_init_find(&iter, doc2, "_id")) {
+            ERRINFO(&err_info, plugin_name, SR_ERR_OPERATION_FAILED, "bson_iter_init_find()", "")
+            goto cleanup;
+        }
+        path = bson_iter_utf8(&iter, NULL);
+        if (!path || !bson_utf8_validate(path, strlen(path), 0)) {
+            ERRINFO(&err_info, plugin_name, SR_ERR_OPERATION_FAILED, "bson_iter_utf8()", "")
             goto cleanup;
         }
 
-        /* get path of the next element */
-        if (!bson_iter_next(&iter)) {
-            ERRINFO(&err_info, plugin_name, SR_ERR_OPERATION_FAILED, "bson_iter_next()", "")
+        mem = realloc(paths, (path_count + 1) * sizeof *paths);
+        if (!mem) {
+            ERRINFO(&err_info, plugin_name, SR_ERR_NO_MEMORY, "realloc()", "")
             goto cleanup;
         }
-        path = bson_iter_utf8(&iter, NULL);
-        if (!bson_utf8_validate(path, strlen(path), 0)) {
-            ERRINFO(&err_info, plugin_name, SR_ERR_OPERATION_FAILED, "bson_iter_utf8()", "")
+        paths = mem;
+
+        paths[path_count] = strdup(path);
+        if (!paths[path_count]) {
+            ERRINFO(&err_info, plugin_name, SR_ERR_NO_MEMORY, "strdup()", "")
             goto cleanup;
         }
+        ++path_count;
     }
 
     if (mongoc_cursor_error(cursor, &error)) {
@@ -1578,30 +1595,53 @@ srpds_shift_uo_list_recursively(mongoc_collection_t *module, const char *path_no
         goto cleanup;
     }
 
-    if (found) {
-        /* An element with such order has been found, shift all elements
-         * after this element */
-        if ((err_info = srpds_shift_uo_list_recursively(module, path_no_pred, next_elem_order + 1, max_order))) {
-            goto cleanup;
-        }
+    if (!path_count) {
+        goto cleanup;
+    }
 
-        /* change order of this element,
-         * selector for replace command */
-        bson_query_key = BCON_NEW("_id", BCON_UTF8(path));
+    /* set new orders with a full gap after the element before the next one,
+     * the updates are independent of each other so they need not be ordered */
+    bulk_opts = BCON_NEW("ordered", BCON_BOOL(0));
+    bulk = mongoc_collection_create_bulk_operation_with_opts(module, bulk_opts);
+    order = next_elem_order;
+    for (i = 0; i < path_count; ++i) {
+        order += SRPDS_DB_UO_ELEMS_GAP_SIZE;
 
-        /* replace command */
-        bson_query_rep = BCON_NEW("$set", "{", "order", BCON_INT64(next_elem_order + 1), "}");
-        if (!mongoc_collection_update_one(module, bson_query_key, bson_query_rep, NULL, NULL, &error)) {
-            ERRINFO(&err_info, plugin_name, SR_ERR_OPERATION_FAILED, "mongoc_collection_update_one()", error.message)
+        bson_query_key = BCON_NEW("_id", BCON_UTF8(paths[i]));
+        bson_query_rep = BCON_NEW("$set", "{", "order", BCON_INT64(order), "}");
+        if (!mongoc_bulk_operation_update_one_with_opts(bulk, bson_query_key, bson_query_rep, NULL, &error)) {
+            ERRINFO(&err_info, plugin_name, SR_ERR_OPERATION_FAILED, "mongoc_bulk_operation_update_one_with_opts()",
+                    error.message)
             goto cleanup;
         }
+        bson_destroy(bson_query_key);
+        bson_query_key = NULL;
+        bson_destroy(bson_query_rep);
+        bson_query_rep = NULL;
+    }
+    if (!mongoc_bulk_operation_execute(bulk, &reply, &error)) {
+        ERRINFO(&err_info, plugin_name, SR_ERR_OPERATION_FAILED, "mongoc_bulk_operation_execute()", error.message)
+        goto cleanup;
+    }
+
+    *new_next_elem_order = next_elem_order + SRPDS_DB_UO_ELEMS_GAP_SIZE;
+    if (*max_order < order) {
+        *max_order = order;
     }
 
 cleanup:
+    for (i = 0; i < path_count; ++i) {
+        free(paths[i]);
+    }
+    free(paths);
     bson_destroy(doc);
-    mongoc_cursor_destroy(cursor);
+    bson_destroy(opts);
+    bson_destroy(bulk_opts);
     bson_destroy(bson_query_key);
     bson_destroy(bson_query_rep);
+    bson_destroy(&reply);
+    mongoc_cursor_destroy(cursor);
+    mongoc_bulk_operation_destroy(bulk);
     return err_info;
 }
 
@@ -1659,26 +1699,14 @@ srpds_create_uo_op(mongoc_collection_t *module, struct lyd_node *node, const cha
 
             /* calculate order */
             order = *max_order;
-        } else if (next_order - prev_order == 1) {
-            /* shift the next elements by one recursively */
-            if ((err_info = srpds_shift_uo_list_recursively(module, path_no_pred, next_order, max_order))) {
-                goto cleanup;
+        } else {
+            if (next_order - prev_order == 1) {
+                /* no gap left, rebalance the next elements */
+                if ((err_info = srpds_rebalance_uo_list(module, path_no_pred, next_order, max_order, &next_order))) {
+                    goto cleanup;
+                }
             }
 
-            /* calculate order */
-            order = next_order;
-
-            /* add new prev element to the next element,
-             * selector for replace command */
-            bson_query_uo_key = BCON_NEW("prev", BCON_UTF8(prev_pred), "path_no_pred", BCON_UTF8(path_no_pred));
-
-            /* replace command */
-            bson_query_uo_rep = BCON_NEW("$set", "{", "prev", BCON_UTF8(predicate), "}");
-            if (!mongoc_collection_update_one(module, bson_query_uo_key, bson_query_uo_rep, NULL, NULL, &error)) {
-                ERRINFO(&err_info, plugin_name, SR_ERR_OPERATION_FAILED, "mongoc_collection_update_one()", error.message)
-                goto cleanup;
-            }
-        } else {
             /* calculate order */
             order = (uint64_t)(prev_order + (next_order - prev_order) / 2);
 
@@ -1713,26 +1741,14 @@ srpds_create_uo_op(mongoc_collection_t *module, struct lyd_node *node, const cha
 
             /* calculate order */
             order = SRPDS_DB_UO_ELEMS_GAP_SIZE;
-        } else if (next_order == 1) {
-            /* shift next elements by one recursively */
-            if ((err_info = srpds_shift_uo_list_recursively(module, path_no_pred, next_order, max_order))) {
-                goto cleanup;
+        } else {
+            if (next_order == 1) {
+                /* no gap left, rebalance the next elements */
+                if ((err_info = srpds_rebalance_uo_list(module, path_no_pred, next_order, max_order, &next_order))) {
+                    goto cleanup;
+                }
             }
 
-            /* calculate order */
-            order = next_order;
-
-            /* add new prev element to the next element,
-             * selector for replace command */
-            bson_query_uo_key = BCON_NEW("prev", BCON_UTF8(prev_pred), "path_no_pred", BCON_UTF8(path_no_pred));
-
-            /* replace command */
-            bson_query_uo_rep = BCON_NEW("$set", "{", "prev", BCON_UTF8(predicate), "}");
-            if (!mongoc_collection_update_one(module, bson_query_uo_key, bson_query_uo_rep, NULL, NULL, &error)) {
-                ERRINFO(&err_info, plugin_name, SR_ERR_OPERATION_FAILED, "mongoc_collection_update_one()", error.message)
-                goto cleanup;
-            }
-        } else {
             /* calculate order */
             order = (uint64_t)(next_order / 2);
 
@@ -3073,7 +3089,7 @@ srpds_mongo_install(const struct lys_module *mod, sr_datastore_t ds, const char
     }
 
     /* create a compound index on prev and path for load_next(),
-     * compound index on order and path_no_pred for srpds_shift_uo_list_recursively()
+     * compound index on order and path_no_pred for srpds_rebalance_uo_list()
      * and index on path_modif for quicker loading */
     bson_index_keys[0] = BCON_NEW("prev", BCON_INT32(1), "path_no_pred", BCON_INT32(1));
     bson_index_keys[1] = BCON_NEW("order", BCON_INT32(1), "path_no_pred", BCON_INT32(1));
@@ -3514,4 +3530,6 @@ const struct srplg_ds_s srpds_mongo = {
     .access_check_cb = srpds_mongo_access_check,
     .last_modif_cb = srpds_mongo_last_modif,
     .data_version_cb = NULL,
+    .store_oper_values_cb = NULL,
+    .flags = SRPLG_DS_FLAG_STORE_DIFF,
 };
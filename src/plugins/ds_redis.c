@@ -732,39 +732,46 @@ cleanup:
 }
 
 /**
- * @brief If there is only one point order gap between elements where newly created element
- *          should be placed, shifting has to be done, e.g. 1  3  {4}   [5]  8  13
- *                                                                    *
- *                                                                    |
- *                                                                new element
- *                                                                    |
- *                                                                    *
- *                                                          1  3  {4} 5 [6]  8  13
+ * @brief If there is no order gap between elements where newly created element should be placed,
+ *          all the following elements are rebalanced so that there is a full gap after each of them,
+ *          e.g. 1  3  {4}   [5]  8  13
+ *                         *
+ *                         |
+ *                     new element
+ *                         |
+ *                         *
+ *              1  3  {4}  [1029]  2053  3077
+ *
+ * All the elements are retrieved in a single query and updated in a single bulk operation.
+ *
  * @param[in] ctx Redis context
  * @param[in] mod_ns Database prefix for the module.
  * @param[in] path_no_pred Path of a list/leaf-list instance without a predicate.
  * @param[in] next_elem_order Order of the next element.
- * @param[out] max_order Changed maximum order (shifting can change maximum order).
+ * @param[in,out] max_order Changed maximum order (rebalancing changes maximum order).
+ * @param[out] new_next_elem_order New order of the next element.
  * @return NULL on success;
  * @return Sysrepo error info on error.
  */
 static sr_error_info_t *
-srpds_shift_uo_list_recursively(redisContext *ctx, const char *mod_ns, const char *path_no_pred, uint64_t next_elem_order, uint64_t *max_order)
+srpds_rebalance_uo_list(redisContext *ctx, const char *mod_ns, const char *path_no_pred, uint64_t next_elem_order,
+        uint64_t *max_order, uint64_t *new_next_elem_order)
 {
     sr_error_info_t *err_info = NULL;
-    int argnum = 6;
-    redisReply *reply = NULL, *reply2 = NULL;
-    char *arg = NULL, *args_array[argnum], *path_no_pred_escaped = NULL;
+    int argnum = 16;
+    redisReply *reply = NULL, *partial;
+    char *arg = NULL, *args_array[argnum], *path_no_pred_escaped = NULL, **keys = NULL;
+    uint64_t cursor, order;
+    uint32_t i, j, key_count = 0;
+    void *mem;
+    struct redis_bulk bulk = {0};
+
+    *new_next_elem_order = next_elem_order;
 
     if ((err_info = srpds_get_maxord(ctx, mod_ns, path_no_pred, max_order))) {
         goto cleanup;
     }
 
-    /* in case of overflow, update maxorder */
-    if (*max_order < next_elem_order) {
-        *max_order = next_elem_order;
-    }
-
     /* escape all special characters so that query is valid */
     if ((err_info = srpds_escape_string(plugin_name, path_no_pred, &path_no_pred_escaped))) {
         goto cleanup;
@@ -776,16 +783,26 @@ srpds_shift_uo_list_recursively(redisContext *ctx, const char *mod_ns, const cha
         goto cleanup;
     }
     args_array[1] = arg;
-    if (asprintf(&arg, "@order:[%" PRIu64 " %" PRIu64 "] @path_no_pred:{%s}", next_elem_order, next_elem_order, path_no_pred_escaped) == -1) {
+    if (asprintf(&arg, "@order:[%" PRIu64 " +inf] @path_no_pred:{%s}", next_elem_order, path_no_pred_escaped) == -1) {
         ERRINFO(&err_info, plugin_name, SR_ERR_NO_MEMORY, "asprintf()", strerror(errno))
         goto cleanup;
     }
     args_array[2] = arg;
 
-    /* retrieve only key */
+    /* retrieve keys of all the following elements sorted by their order */
     args_array[3] = "LOAD";
     args_array[4] = "1";
     args_array[5] = "__key";
+    args_array[6] = "SORTBY";
+    args_array[7] = "2";
+    args_array[8] = "@order";
+    args_array[9] = "ASC";
+    args_array[10] = "LIMIT";
+    args_array[11] = "0";
+    args_array[12] = REDIS_MAX_AGGREGATE_LIMIT;
+    args_array[13] = "WITHCURSOR";
+    args_array[14] = "COUNT";
+    args_array[15] = REDIS_MAX_AGGREGATE_COUNT;
 
     reply = redisCommandArgv(ctx, argnum, (const char **)args_array, NULL);
     if (reply->type == REDIS_REPLY_ERROR) {
@@ -797,27 +814,100 @@ srpds_shift_uo_list_recursively(redisContext *ctx, const char *mod_ns, const cha
         goto cleanup;
     }
 
-    if (reply->element[0]->integer == 1) {
-        /* An element with such order has been found, shift all elements
-         * after this element */
-        if ((err_info = srpds_shift_uo_list_recursively(ctx, mod_ns, path_no_pred, next_elem_order + 1, max_order))) {
+    /* collect all the keys first, the elements cannot be changed while the cursor is being read */
+    while (1) {
+        mem = realloc(keys, (key_count + reply->element[0]->elements) * sizeof *keys);
+        if (!mem) {
+            ERRINFO(&err_info, plugin_name, SR_ERR_NO_MEMORY, "realloc()", "")
             goto cleanup;
         }
+        keys = mem;
 
-        /* on [1] -> [1] is the key of the found element */
-        reply2 = redisCommand(ctx, "HSET %s order %" PRIu64, reply->element[1]->element[1]->str, next_elem_order + 1);
-        if (reply2->type == REDIS_REPLY_ERROR) {
-            ERRINFO(&err_info, plugin_name, SR_ERR_OPERATION_FAILED, "Setting order", reply2->str)
+        for (i = 1; i < reply->element[0]->elements; ++i) {
+            partial = reply->element[0]->element[i];
+
+            /* find the key among the field name and value pairs */
+            for (j = 0; j + 1 < partial->elements; j += 2) {
+                if (!strcmp(partial->element[j]->str, "__key")) {
+                    break;
+                }
+            }
+            if (j + 1 >= partial->elements) {
+                ERRINFO(&err_info, plugin_name, SR_ERR_OPERATION_FAILED, "FT.AGGREGATE", "No key of an element")
+                goto cleanup;
+            }
+
+            keys[key_count] = strdup(partial->element[j + 1]->str);
+            if (!keys[key_count]) {
+                ERRINFO(&err_info, plugin_name, SR_ERR_NO_MEMORY, "strdup()", "")
+                goto cleanup;
+            }
+            ++key_count;
+        }
+
+        cursor = reply->element[1]->integer;
+        if (cursor == 0) {
+            break;
+        }
+        freeReplyObject(reply);
+
+        reply = redisCommand(ctx, "FT.CURSOR READ %s:data %" PRIu64 " COUNT " REDIS_MAX_AGGREGATE_COUNT, mod_ns, cursor);
+        if (reply->type == REDIS_REPLY_ERROR) {
+            ERRINFO(&err_info, plugin_name, SR_ERR_OPERATION_FAILED, "FT.AGGREGATE", reply->str)
+            goto cleanup;
+        }
+        if (reply->type != REDIS_REPLY_ARRAY) {
+            ERRINFO(&err_info, plugin_name, SR_ERR_OPERATION_FAILED, "FT.AGGREGATE", "No reply array")
             goto cleanup;
         }
     }
 
+    if (!key_count) {
+        goto cleanup;
+    }
+
+    /* set new orders with a full gap after the element before the next one */
+    if ((err_info = srpds_bulk_init(0, &bulk))) {
+        goto cleanup;
+    }
+    order = next_elem_order;
+    for (i = 0; i < key_count; ++i) {
+        order += SRPDS_DB_UO_ELEMS_GAP_SIZE;
+
+        if ((err_info = srpds_bulk_start(4, &bulk))) {
+            goto cleanup;
+        }
+        srpds_bulk_add_const("HSET", 4, &bulk);
+        if ((err_info = srpds_bulk_add_alloc(keys[i], strlen(keys[i]), &bulk))) {
+            goto cleanup;
+        }
+        srpds_bulk_add_const("order", 5, &bulk);
+        if ((err_info = srpds_bulk_add_format(&bulk, "%" PRIu64, order))) {
+            goto cleanup;
+        }
+        if ((err_info = srpds_bulk_end(ctx, &bulk))) {
+            goto cleanup;
+        }
+    }
+    if ((err_info = srpds_bulk_exec(ctx, &bulk))) {
+        goto cleanup;
+    }
+
+    *new_next_elem_order = next_elem_order + SRPDS_DB_UO_ELEMS_GAP_SIZE;
+    if (*max_order < order) {
+        *max_order = order;
+    }
+
 cleanup:
+    srpds_bulk_destroy(&bulk);
+    for (i = 0; i < key_count; ++i) {
+        free(keys[i]);
+    }
+    free(keys);
     free(path_no_pred_escaped);
     free(args_array[1]);
     free(args_array[2]);
     freeReplyObject(reply);
-    freeReplyObject(reply2);
     return err_info;
 }
 
@@ -1105,22 +1195,14 @@ srpds_create_uo_op(redisContext *ctx, const char *mod_ns, struct lyd_node *node,
                     *max_order, path_no_pred, path_modif))) {
                 goto cleanup;
             }
-        } else if (next_order - prev_order == 1) {
-            /* shift next elements by one recursively */
-            if ((err_info = srpds_shift_uo_list_recursively(ctx, mod_ns, path_no_pred, next_order, max_order))) {
-                goto cleanup;
-            }
-
-            /* set new prev field of the next element */
-            if ((err_info = srpds_change_next_element(ctx, mod_ns, path_no_pred, prev_pred, predicate))) {
-                goto cleanup;
+        } else {
+            if (next_order - prev_order == 1) {
+                /* no gap left, rebalance the next elements */
+                if ((err_info = srpds_rebalance_uo_list(ctx, mod_ns, path_no_pred, next_order, max_order, &next_order))) {
+                    goto cleanup;
+                }
             }
 
-            if ((err_info = srpds_insert_uo_element(ctx, mod_ns, node, module_name, path, value, prev, prev_pred,
-                    next_order, path_no_pred, path_modif))) {
-                goto cleanup;
-            }
-        } else {
             /* set new prev field of the next element */
             if ((err_info = srpds_change_next_element(ctx, mod_ns, path_no_pred, prev_pred, predicate))) {
                 goto cleanup;
@@ -1153,22 +1235,14 @@ srpds_create_uo_op(redisContext *ctx, const char *mod_ns, struct lyd_node *node,
                     SRPDS_DB_UO_ELEMS_GAP_SIZE, path_no_pred, path_modif))) {
                 goto cleanup;
             }
-        } else if (next_order == 1) {
-            /* shift next elements by one recursively */
-            if ((err_info = srpds_shift_uo_list_recursively(ctx, mod_ns, path_no_pred, next_order, max_order))) {
-                goto cleanup;
-            }
-
-            /* set new prev field of the next element */
-            if ((err_info = srpds_change_next_element(ctx, mod_ns, path_no_pred, prev_pred, predicate))) {
-                goto cleanup;
+        } else {
+            if (next_order == 1) {
+                /* no gap left, rebalance the next elements */
+                if ((err_info = srpds_rebalance_uo_list(ctx, mod_ns, path_no_pred, next_order, max_order, &next_order))) {
+                    goto cleanup;
+                }
             }
 
-            if ((err_info = srpds_insert_uo_element(ctx, mod_ns, node, module_name, path, value, prev, prev_pred,
-                    next_order, path_no_pred, path_modif))) {
-                goto cleanup;
-            }
-        } else {
             /* set new prev field of the next element */
             if ((err_info = srpds_change_next_element(ctx, mod_ns, path_no_pred, prev_pred, predicate))) {
                 goto cleanup;
@@ -4058,4 +4132,6 @@ const struct srplg_ds_s srpds_redis = {
     .access_check_cb = srpds_redis_access_check,
     .last_modif_cb = srpds_redis_last_modif,
     .data_version_cb = NULL,
+    .store_oper_values_cb = NULL,
+    .flags = SRPLG_DS_FLAG_STORE_DIFF,
 };
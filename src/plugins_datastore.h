@@ -40,7 +40,7 @@ extern "C" {
 /**
  * @brief Datastore plugin API version
  */
-#define SRPLG_DS_API_VERSION 11
+#define SRPLG_DS_API_VERSION 13
 
 /**
  * @brief Setup datastore of a newly installed module.
@@ -135,6 +135,29 @@ typedef void (*srds_conn_destroy)(sr_conn_ctx_t *conn, void *plg_data);
 typedef sr_error_info_t *(*srds_store)(const struct lys_module *mod, sr_datastore_t ds, const struct lyd_node *mod_diff,
         const struct lyd_node *mod_data, void *plg_data);
 
+/**
+ * @brief Store only changed values of leaves in the operational edit of a module, optional callback.
+ *
+ * Called instead of ::srds_store for ::SR_DS_OPERATIONAL if an edit merged into the stored edit only changed
+ * values of leaves that were already stored, such as frequently updated counters. The plugin may store only
+ * the new values, for example by appending them to a log, instead of the whole edit. Any following ::srds_load
+ * __must return__ @p mod_data.
+ *
+ * May be called simultaneously but with unique @p mod.
+ *
+ * Write access rights do not have to be checked, ::srds_access_check() is called before this callback.
+ *
+ * @param[in] mod Specific module.
+ * @param[in] values Array of the leaves in @p mod_data with a changed value.
+ * @param[in] value_count Count of @p values.
+ * @param[in] mod_data New module edit data tree to store.
+ * @param[in] plg_data Plugin data.
+ * @return NULL on success;
+ * @return Sysrepo error info on error.
+ */
+typedef sr_error_info_t *(*srds_store_oper_values)(const struct lys_module *mod, const struct lyd_node **values,
+        uint32_t value_count, const struct lyd_node *mod_data, void *plg_data);
+
 /**
  * @brief Recover module data when a crash occurred while they were being written.
  *
@@ -284,6 +307,12 @@ typedef sr_error_info_t *(*srds_last_modif)(const struct lys_module *mod, sr_dat
 typedef sr_error_info_t *(*srds_data_version)(const struct lys_module *mod, sr_datastore_t ds, void *plg_data,
         uint32_t *version);
 
+/**
+ * @brief Datastore plugin flag, ::srds_store callback requires @p mod_diff to store ::SR_DS_STARTUP, ::SR_DS_RUNNING,
+ * or ::SR_DS_CANDIDATE data. Unless set, the diff may not be generated at all in some cases.
+ */
+#define SRPLG_DS_FLAG_STORE_DIFF 0x01
+
 /**
  * @brief Datastore plugin structure
  */
@@ -305,6 +334,8 @@ struct srplg_ds_s {
     srds_access_check access_check_cb;  /**< callback for checking user access to module data */
     srds_last_modif last_modif_cb;  /**< callback for getting the time of last modification */
     srds_data_version data_version_cb;  /**< optional callback for checking data version */
+    srds_store_oper_values store_oper_values_cb;    /**< optional callback for storing changed oper edit values */
+    uint32_t flags;                 /**< plugin flags, bitwise OR of SRPLG_DS_FLAG_* */
 };
 
 /**
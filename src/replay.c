@@ -358,7 +358,7 @@ sr_replay_notify(sr_conn_ctx_t *conn, const char *mod_name, uint32_t sub_id, con
 
             /* call callback */
             if ((err_info = sr_notif_call_callback(ev_sess, cb, tree_cb, private_data, SR_EV_NOTIF_REPLAY, sub_id,
-                    notif_op, &notif_ts))) {
+                    notif_op, &notif_ts, NULL))) {
                 goto cleanup;
             }
         }
@@ -374,7 +374,7 @@ sr_replay_notify(sr_conn_ctx_t *conn, const char *mod_name, uint32_t sub_id, con
 replay_complete:
     /* replay is completed */
     if ((err_info = sr_notif_call_callback(ev_sess, cb, tree_cb, private_data, SR_EV_NOTIF_REPLAY_COMPLETE, sub_id,
-            NULL, &stop_ts))) {
+            NULL, &stop_ts, NULL))) {
         goto cleanup;
     }
 
@@ -130,33 +130,17 @@ void
 sr_shmext_conn_remap_unlock(sr_conn_ctx_t *conn, sr_lock_mode_t mode, int ext_lock, const char *func)
 {
     sr_error_info_t *err_info = NULL;
-    sr_ext_hole_t *iter, *last = NULL;
-    uint32_t last_size;
-    size_t shm_file_size = 0;
+    sr_ext_shm_t *ext_shm;
 
-    /* make ext SHM smaller if there is a memory hole at its end */
+    /* merge memory holes and make ext SHM smaller if there are too many of them */
     if (((mode == SR_LOCK_WRITE) || (mode == SR_LOCK_WRITE_URGE)) && ext_lock) {
-        while ((iter = sr_ext_hole_next(last, SR_CONN_EXT_SHM(conn)))) {
-            last = iter;
-        }
-
-        if (last && ((uint32_t)((char *)last - conn->ext_shm.addr) + last->size == conn->ext_shm.size)) {
-            if ((err_info = sr_file_get_size(conn->ext_shm.fd, &shm_file_size))) {
-                goto cleanup_unlock;
-            }
-
-            /* remove the hole */
-            last_size = last->size;
-            sr_ext_hole_del(SR_CONN_EXT_SHM(conn), last);
-
-            /* remap (and truncate) ext SHM */
-            if ((err_info = sr_shm_remap(&conn->ext_shm, shm_file_size - last_size))) {
-                goto cleanup_unlock;
-            }
+        ext_shm = SR_CONN_EXT_SHM(conn);
+        if ((ext_shm->hole_count >= 2 * ext_shm->defrag_hole_count + SR_EXT_HOLE_DEFRAG_COUNT) ||
+                ((ext_shm->hole_count > 2 * ext_shm->defrag_hole_count) && (2 * ext_shm->hole_size > conn->ext_shm.size))) {
+            err_info = sr_ext_hole_defrag(&conn->ext_shm);
         }
     }
 
-cleanup_unlock:
     /* REMAP UNLOCK */
     sr_rwunlock(&conn->ext_remap_lock, SR_CONN_REMAP_LOCK_TIMEOUT, mode, conn->cid, func);
 
@@ -191,7 +175,7 @@ sr_shmext_open(sr_shm_t *shm, int zero)
         goto error;
     }
     if (zero) {
-        ((sr_ext_shm_t *)shm->addr)->first_hole_off = 0;
+        memset(shm->addr, 0, sizeof(sr_ext_shm_t));
     }
 
     return NULL;
@@ -1113,6 +1097,7 @@ sr_shmext_oper_poll_sub_add(sr_conn_ctx_t *conn, sr_mod_t *shm_mod, uint32_t sub
     off_t xpath_off;
     sr_mod_oper_poll_sub_t *shm_sub;
     uint32_t i;
+    int path_exists = 0;
 
     assert(path);
 
@@ -1123,15 +1108,25 @@ sr_shmext_oper_poll_sub_add(sr_conn_ctx_t *conn, sr_mod_t *shm_mod, uint32_t sub
 
     sr_shmext_oper_poll_sub_remove_dead(conn, shm_mod);
 
-    if (sub_opts & SR_SUBSCR_OPER_POLL_DIFF) {
+    for (i = 0; i < shm_mod->oper_poll_sub_count; ++i) {
+        shm_sub = &((sr_mod_oper_poll_sub_t *)(conn->ext_shm.addr + shm_mod->oper_poll_subs))[i];
+        if (strcmp(conn->ext_shm.addr + shm_sub->xpath, path)) {
+            continue;
+        }
+        path_exists = 1;
+
         /* check globally that a subscription with the same path generating diff does not exist yet */
-        for (i = 0; i < shm_mod->oper_poll_sub_count; ++i) {
-            shm_sub = &((sr_mod_oper_poll_sub_t *)(conn->ext_shm.addr + shm_mod->oper_poll_subs))[i];
-            if ((shm_sub->opts & SR_SUBSCR_OPER_POLL_DIFF) && !strcmp(conn->ext_shm.addr + shm_sub->xpath, path)) {
-                sr_errinfo_new(&err_info, SR_ERR_INVAL_ARG, "Operational poll subscription for \"%s\" reporting changes "
-                        "already exists.", conn->ext_shm.addr + shm_sub->xpath);
-                goto cleanup_unlock;
-            }
+        if ((sub_opts & SR_SUBSCR_OPER_POLL_DIFF) && (shm_sub->opts & SR_SUBSCR_OPER_POLL_DIFF)) {
+            sr_errinfo_new(&err_info, SR_ERR_INVAL_ARG, "Operational poll subscription for \"%s\" reporting changes "
+                    "already exists.", conn->ext_shm.addr + shm_sub->xpath);
+            goto cleanup_unlock;
+        }
+    }
+
+    if (!path_exists) {
+        /* create the shared cache SHM while still holding the lock */
+        if ((err_info = sr_shmsub_oper_poll_cache_create(conn->mod_shm.addr + shm_mod->name, path))) {
+            goto cleanup_unlock;
         }
     }
 
@@ -1174,9 +1169,24 @@ cleanup_unlock:
 static sr_error_info_t *
 sr_shmext_oper_poll_sub_free(sr_conn_ctx_t *conn, sr_mod_t *shm_mod, uint32_t del_idx)
 {
-    sr_mod_oper_poll_sub_t *shm_sub;
+    sr_error_info_t *err_info = NULL;
+    sr_mod_oper_poll_sub_t *shm_sub, *shm_subs;
+    uint32_t i;
 
-    shm_sub = &((sr_mod_oper_poll_sub_t *)(conn->ext_shm.addr + shm_mod->oper_poll_subs))[del_idx];
+    shm_subs = (sr_mod_oper_poll_sub_t *)(conn->ext_shm.addr + shm_mod->oper_poll_subs);
+    shm_sub = &shm_subs[del_idx];
+
+    /* check whether there is another subscription with the same path */
+    for (i = 0; i < shm_mod->oper_poll_sub_count; ++i) {
+        if ((i != del_idx) && !strcmp(conn->ext_shm.addr + shm_subs[i].xpath, conn->ext_shm.addr + shm_sub->xpath)) {
+            break;
+        }
+    }
+    if (i == shm_mod->oper_poll_sub_count) {
+        /* last subscription of this path, unlink the shared cache SHM */
+        err_info = sr_shmsub_oper_poll_cache_unlink(conn->mod_shm.addr + shm_mod->name,
+                conn->ext_shm.addr + shm_sub->xpath);
+    }
 
     SR_LOG_DBG("#SHM before (removing oper poll sub)");
     sr_shmext_print(SR_CONN_MOD_SHM(conn), &conn->ext_shm);
@@ -1188,7 +1198,7 @@ sr_shmext_oper_poll_sub_free(sr_conn_ctx_t *conn, sr_mod_t *shm_mod, uint32_t de
     SR_LOG_DBG("#SHM after (removing oper poll sub)");
     sr_shmext_print(SR_CONN_MOD_SHM(conn), &conn->ext_shm);
 
-    return NULL;
+    return err_info;
 }
 
 sr_error_info_t *
@@ -1288,11 +1298,13 @@ sr_shmext_notif_sub_remove_dead(sr_conn_ctx_t *conn, sr_mod_t *shm_mod)
 }
 
 sr_error_info_t *
-sr_shmext_notif_sub_add(sr_conn_ctx_t *conn, sr_mod_t *shm_mod, uint32_t sub_id, const char *xpath, uint32_t evpipe_num)
+sr_shmext_notif_sub_add(sr_conn_ctx_t *conn, sr_mod_t *shm_mod, uint32_t sub_id, const char *xpath, int sub_opts,
+        uint32_t evpipe_num)
 {
     sr_error_info_t *err_info = NULL, *tmp_err;
     off_t xpath_off;
     sr_mod_notif_sub_t *shm_sub;
+    sr_shm_t notif_shm = SR_SHM_INITIALIZER;
 
     /* EXT WRITE LOCK */
     if ((err_info = sr_shmext_conn_remap_lock(conn, SR_LOCK_WRITE, 1, __func__))) {
@@ -1317,15 +1329,30 @@ sr_shmext_notif_sub_add(sr_conn_ctx_t *conn, sr_mod_t *shm_mod, uint32_t sub_id,
     } else {
         shm_sub->xpath = 0;
     }
+    shm_sub->opts = sub_opts;
     shm_sub->sub_id = sub_id;
     shm_sub->evpipe_num = evpipe_num;
     ATOMIC_STORE_RELAXED(shm_sub->suspended, 0);
     shm_sub->cid = conn->cid;
+    ATOMIC_STORE_RELAXED(shm_sub->request_id, 0);
+    ATOMIC_STORE_RELAXED(shm_sub->delivered, 0);
+    ATOMIC_STORE_RELAXED(shm_sub->filtered_out, 0);
+    ATOMIC_STORE_RELAXED(shm_sub->dropped, 0);
+    ATOMIC_STORE_RELAXED(shm_sub->blocked_ms, 0);
+    ATOMIC_STORE_RELAXED(shm_sub->max_latency_us, 0);
+    shm_sub->start_request_id = 0;
 
     SR_LOG_DBG("#SHM after (adding notif sub)");
     sr_shmext_print(SR_CONN_MOD_SHM(conn), &conn->ext_shm);
 
-    if (shm_mod->notif_sub_count == 1) {
+    if (shm_mod->notif_sub_count > 1) {
+        /* the subscription never processes the notifications sent before, NOTIF SUB lock prevents sending new ones */
+        if ((err_info = sr_shmsub_open_map(conn->mod_shm.addr + shm_mod->name, "notif", -1, &notif_shm))) {
+            goto cleanup_unlock;
+        }
+        shm_sub->start_request_id = ATOMIC_LOAD_RELAXED(((sr_sub_shm_t *)notif_shm.addr)->request_id);
+        sr_shm_clear(&notif_shm);
+    } else {
         /* create the sub SHM while still holding the locks */
         if ((err_info = sr_shmsub_create(conn->mod_shm.addr + shm_mod->name, "notif", -1, sizeof(sr_sub_shm_t)))) {
             goto cleanup_unlock;
@@ -1502,7 +1529,7 @@ sr_error_info_t *
 sr_shmext_rpc_sub_add(sr_conn_ctx_t *conn, off_t *subs, uint32_t *sub_count, const char *path,
         uint32_t sub_id, const char *xpath, uint32_t priority, int sub_opts, uint32_t evpipe_num, sr_cid_t sub_cid)
 {
-    sr_error_info_t *err_info = NULL, *tmp_err;
+    sr_error_info_t *err_info = NULL;
     off_t xpath_off;
     sr_mod_rpc_sub_t *shm_sub;
     uint32_t i;
@@ -1567,15 +1594,7 @@ sr_shmext_rpc_sub_add(sr_conn_ctx_t *conn, off_t *subs, uint32_t *sub_count, con
     if (!path_found && sub_cid) {
         /* create the sub SHM while still holding the locks */
         mod_name = sr_get_first_ns(path);
-        if ((err_info = sr_shmsub_create(mod_name, "rpc", sr_str_hash(path, 0), sizeof(sr_sub_shm_t)))) {
-            goto cleanup_unlock;
-        }
-
-        /* create the data sub SHM */
-        if ((err_info = sr_shmsub_data_create(mod_name, "rpc", sr_str_hash(path, 0)))) {
-            if ((tmp_err = sr_shmsub_unlink(mod_name, "rpc", sr_str_hash(path, 0)))) {
-                sr_errinfo_merge(&err_info, tmp_err);
-            }
+        if ((err_info = sr_shmsub_rpc_create(mod_name, sr_str_hash(path, 0)))) {
             goto cleanup_unlock;
         }
     }
@@ -1636,14 +1655,9 @@ sr_shmext_rpc_sub_free(sr_conn_ctx_t *conn, off_t *subs, uint32_t *sub_count, co
     }
 
     if (i == *sub_count) {
-        /* unlink the sub SHM */
+        /* unlink the sub SHM and sub data SHMs */
         mod_name = sr_get_first_ns(path);
-        if ((err_info = sr_shmsub_unlink(mod_name, "rpc", sr_str_hash(path, 0)))) {
-            goto cleanup;
-        }
-
-        /* unlink the sub data SHM */
-        if ((err_info = sr_shmsub_data_unlink(mod_name, "rpc", sr_str_hash(path, 0)))) {
+        if ((err_info = sr_shmsub_rpc_unlink(mod_name, sr_str_hash(path, 0)))) {
             goto cleanup;
         }
     }
@@ -201,11 +201,12 @@ sr_error_info_t *sr_shmext_oper_poll_sub_stop(sr_conn_ctx_t *conn, sr_mod_t *shm
  * @param[in] shm_mod SHM module.
  * @param[in] sub_id Unique sub ID.
  * @param[in] xpath Subscription XPath.
+ * @param[in] sub_opts Subscription options.
  * @param[in] evpipe_num Subscription event pipe number.
  * @return err_info, NULL on success.
  */
 sr_error_info_t *sr_shmext_notif_sub_add(sr_conn_ctx_t *conn, sr_mod_t *shm_mod, uint32_t sub_id, const char *xpath,
-        uint32_t evpipe_num);
+        int sub_opts, uint32_t evpipe_num);
 
 /**
  * @brief Remove main SHM module notification subscription and unlink sub SHM if the last subscription was removed.
@@ -207,6 +207,7 @@ sr_shmmod_fill(sr_shm_t *shm_mod, size_t shm_mod_idx, const struct lyd_node *sr_
 
     /* zero SHM mod */
     memset(smod, 0, sizeof *smod);
+    smod->oper_cid_count = SR_MOD_OPER_CID_UNKNOWN;
 
     /* remember name, set fields from sr_mod, and count enabled features */
     name = NULL;
@@ -291,6 +292,10 @@ sr_shmmod_fill(sr_shm_t *shm_mod, size_t shm_mod_idx, const struct lyd_node *sr_
         /* copy notif subscriptions */
         smod->notif_subs = old_smod->notif_subs;
         smod->notif_sub_count = old_smod->notif_sub_count;
+
+        /* copy connections with stored oper data */
+        memcpy(smod->oper_cids, old_smod->oper_cids, sizeof smod->oper_cids);
+        smod->oper_cid_count = old_smod->oper_cid_count;
     }
 
     return NULL;
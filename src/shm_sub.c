@@ -24,6 +24,8 @@
 #include <fcntl.h>
 #include <inttypes.h>
 #include <poll.h>
+#include <pthread.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <sys/mman.h>
@@ -50,8 +52,7 @@
  * @brief Generic structure for parallel notifications.
  */
 struct sr_shmsub_many_info_s {
-    sr_shm_t shm_sub;
-    sr_shm_t shm_data_sub;
+    struct sr_orig_shm_s *orig;
     sr_sub_shm_t *sub_shm;
     sr_sub_event_t event;
     uint32_t request_id;
@@ -64,8 +65,7 @@ struct sr_shmsub_many_info_s {
  * @brief Structure for parallel (for all the modules) module change notifications.
  */
 struct sr_shmsub_many_info_change_s {
-    sr_shm_t shm_sub;
-    sr_shm_t shm_data_sub;
+    struct sr_orig_shm_s *orig;
     sr_sub_shm_t *sub_shm;
     sr_sub_event_t event;
     uint32_t request_id;
@@ -85,8 +85,7 @@ struct sr_shmsub_many_info_change_s {
  * @brief Structure for parallel (for all subscribers for the same XPath) oper get notifications.
  */
 struct sr_shmsub_many_info_oper_get_s {
-    sr_shm_t shm_sub;
-    sr_shm_t shm_data_sub;
+    struct sr_orig_shm_s *orig;
     sr_sub_shm_t *sub_shm;
     sr_sub_event_t event;
     uint32_t request_id;
@@ -179,6 +178,8 @@ sr_shmsub_unlink(const char *name, const char *suffix1, int64_t suffix2)
 {
     sr_error_info_t *err_info = NULL;
     char *path = NULL;
+    sr_shm_t shm = SR_SHM_INITIALIZER;
+    sr_sub_shm_t *sub_shm;
 
     assert(name && suffix1);
 
@@ -187,6 +188,14 @@ sr_shmsub_unlink(const char *name, const char *suffix1, int64_t suffix2)
         goto cleanup;
     }
 
+    /* mark it so that originators drop their kept mappings instead of using a SHM no one listens on */
+    shm.fd = sr_open(path, O_RDWR, SR_SUB_SHM_PERM);
+    if ((shm.fd > -1) && !sr_shm_remap(&shm, 0)) {
+        sub_shm = (sr_sub_shm_t *)shm.addr;
+        ATOMIC_STORE_RELAXED(sub_shm->unlinked, 1);
+    }
+    sr_shm_clear(&shm);
+
     /* unlink */
     if (unlink(path) == -1) {
         sr_errinfo_new(&err_info, SR_ERR_SYS, "Failed to unlink \"%s\" SHM (%s).", path, strerror(errno));
@@ -198,6 +207,136 @@ cleanup:
     return err_info;
 }
 
+/**
+ * @brief Check whether subscription SHM mappings of an originator are of a specific subscription SHM.
+ *
+ * @param[in] orig Subscription SHM mappings.
+ * @param[in] name Subscription name (module name).
+ * @param[in] suffix1 First suffix.
+ * @param[in] suffix2 Second suffix, none if set to -1.
+ * @return Whether the mappings match.
+ */
+static int
+sr_shmsub_orig_match(const struct sr_orig_shm_s *orig, const char *name, const char *suffix1, int64_t suffix2)
+{
+    return (orig->suffix2 == suffix2) && !strcmp(orig->suffix1, suffix1) && !strcmp(orig->name, name);
+}
+
+void
+sr_shmsub_orig_free(struct sr_orig_shm_s *orig)
+{
+    uint32_t i;
+
+    if (!orig) {
+        return;
+    }
+
+    free(orig->name);
+    sr_shm_clear(&orig->sub);
+    for (i = 0; i < SR_RPC_SUB_SLOT_COUNT; ++i) {
+        sr_shm_clear(&orig->data[i]);
+    }
+    free(orig);
+}
+
+sr_error_info_t *
+sr_shmsub_orig_open_map(sr_conn_ctx_t *conn, const char *name, const char *suffix1, int64_t suffix2,
+        struct sr_orig_shm_s **orig)
+{
+    sr_error_info_t *err_info = NULL;
+    struct sr_orig_shm_s *o = NULL;
+    sr_sub_shm_t *sub_shm;
+    uint32_t i;
+
+    /* already opened */
+    if (*orig) {
+        return NULL;
+    }
+
+    /* ORIG SHM LOCK */
+    pthread_mutex_lock(&conn->orig_shm.lock);
+
+    /* take the kept mappings, if any */
+    for (i = 0; i < conn->orig_shm.count; ++i) {
+        if (sr_shmsub_orig_match(conn->orig_shm.entries[i], name, suffix1, suffix2)) {
+            o = conn->orig_shm.entries[i];
+            --conn->orig_shm.count;
+            conn->orig_shm.entries[i] = conn->orig_shm.entries[conn->orig_shm.count];
+            break;
+        }
+    }
+
+    /* ORIG SHM UNLOCK */
+    pthread_mutex_unlock(&conn->orig_shm.lock);
+
+    if (o) {
+        sub_shm = (sr_sub_shm_t *)o->sub.addr;
+        if (!ATOMIC_LOAD_RELAXED(sub_shm->unlinked)) {
+            *orig = o;
+            return NULL;
+        }
+
+        /* the subscription SHM was unlinked since, it may have been created again */
+        sr_shmsub_orig_free(o);
+    }
+
+    /* new mappings */
+    o = calloc(1, sizeof *o);
+    SR_CHECK_MEM_GOTO(!o, err_info, cleanup);
+    o->name = strdup(name);
+    SR_CHECK_MEM_GOTO(!o->name, err_info, cleanup);
+    o->suffix1 = suffix1;
+    o->suffix2 = suffix2;
+    o->sub.fd = -1;
+    for (i = 0; i < SR_RPC_SUB_SLOT_COUNT; ++i) {
+        o->data[i].fd = -1;
+    }
+
+    if ((err_info = sr_shmsub_open_map(name, suffix1, suffix2, &o->sub))) {
+        goto cleanup;
+    }
+
+    *orig = o;
+
+cleanup:
+    if (err_info) {
+        sr_shmsub_orig_free(o);
+    }
+    return err_info;
+}
+
+void
+sr_shmsub_orig_release(sr_conn_ctx_t *conn, struct sr_orig_shm_s *orig)
+{
+    uint32_t i;
+
+    if (!orig) {
+        return;
+    }
+
+    /* ORIG SHM LOCK */
+    pthread_mutex_lock(&conn->orig_shm.lock);
+
+    if (conn->orig_shm.count < SR_ORIG_SHM_CACHE_SIZE) {
+        /* keep only one mapping of every subscription SHM */
+        for (i = 0; i < conn->orig_shm.count; ++i) {
+            if (sr_shmsub_orig_match(conn->orig_shm.entries[i], orig->name, orig->suffix1, orig->suffix2)) {
+                break;
+            }
+        }
+        if (i == conn->orig_shm.count) {
+            conn->orig_shm.entries[conn->orig_shm.count] = orig;
+            ++conn->orig_shm.count;
+            orig = NULL;
+        }
+    }
+
+    /* ORIG SHM UNLOCK */
+    pthread_mutex_unlock(&conn->orig_shm.lock);
+
+    sr_shmsub_orig_free(orig);
+}
+
 sr_error_info_t *
 sr_shmsub_data_create(const char *name, const char *suffix1, int64_t suffix2)
 {
@@ -228,15 +367,21 @@ cleanup:
 /**
  * @brief Open and map or only remap a subscription data SHM.
  *
+ * The data SHM is never shrunk and its size is published in the sub SHM so that it is remapped only after it grew,
+ * without reading the size of the file. Needs sub SHM WRITE lock for resizing, otherwise READ lock is fine.
+ *
  * @param[in] name Subscription name (module name).
  * @param[in] suffix1 First suffix.
  * @param[in] suffix2 Second suffix, none if set to -1.
+ * @param[in] sub_shm Locked sub SHM of the data SHM.
  * @param[in,out] shm Mapped SHM.
- * @param[in] new_shm_size Resize SHM to this size, if 0 read the size of the SHM file.
+ * @param[in] new_shm_size Grow SHM to at least this size, if 0 map the size published in @p sub_shm.
+ * @param[in] reserve Whether to reserve address range for growing, only for mappings kept across events.
  * @return err_info, NULL on success.
  */
 static sr_error_info_t *
-sr_shmsub_data_open_remap(const char *name, const char *suffix1, int64_t suffix2, sr_shm_t *shm, size_t new_shm_size)
+sr_shmsub_data_open_remap(const char *name, const char *suffix1, int64_t suffix2, sr_sub_shm_t *sub_shm, sr_shm_t *shm,
+        size_t new_shm_size, int reserve)
 {
     sr_error_info_t *err_info = NULL;
     char *path = NULL;
@@ -257,9 +402,19 @@ sr_shmsub_data_open_remap(const char *name, const char *suffix1, int64_t suffix2
         }
     }
 
-    /* map it */
-    if ((err_info = sr_shm_remap(shm, new_shm_size))) {
-        goto cleanup;
+    if (new_shm_size) {
+        /* grow it if needed and let the others know */
+        if ((err_info = sr_shm_remap_grow(shm, new_shm_size, 1, reserve))) {
+            goto cleanup;
+        }
+        if (sub_shm->data_size < shm->size) {
+            sub_shm->data_size = shm->size;
+        }
+    } else {
+        /* map it, no need to check the file size */
+        if ((err_info = sr_shm_remap_grow(shm, sub_shm->data_size, 0, reserve))) {
+            goto cleanup;
+        }
     }
 
 cleanup:
@@ -294,6 +449,131 @@ cleanup:
     return err_info;
 }
 
+/**
+ * @brief Get the first suffix of the data SHM of an RPC subscription slot.
+ *
+ * @param[in] slot RPC subscription SHM slot.
+ * @param[in] buf Buffer for the suffix.
+ * @param[in] size Size of @p buf.
+ * @return First suffix to use.
+ */
+static const char *
+sr_shmsub_rpc_slot_suffix(uint32_t slot, char *buf, size_t size)
+{
+    if (!slot) {
+        /* standard name */
+        return "rpc";
+    }
+
+    snprintf(buf, size, "rpc%" PRIu32, slot);
+    return buf;
+}
+
+sr_error_info_t *
+sr_shmsub_rpc_create(const char *name, int64_t suffix2)
+{
+    sr_error_info_t *err_info = NULL, *tmp_err;
+    sr_shm_t shm = SR_SHM_INITIALIZER;
+    sr_rpc_sub_shm_t *rpc_shm;
+    char buf[16];
+    uint32_t i, j;
+
+    /* create the sub SHM, initializes the lock of the first slot */
+    if ((err_info = sr_shmsub_create(name, "rpc", suffix2, sizeof *rpc_shm))) {
+        return err_info;
+    }
+
+    /* initialize the locks of the other slots */
+    if ((err_info = sr_shmsub_open_map(name, "rpc", suffix2, &shm))) {
+        goto error;
+    }
+    rpc_shm = (sr_rpc_sub_shm_t *)shm.addr;
+    for (i = 1; i < SR_RPC_SUB_SLOT_COUNT; ++i) {
+        if ((err_info = sr_rwlock_init(&rpc_shm->slot[i].lock, 1))) {
+            goto error;
+        }
+    }
+    sr_shm_clear(&shm);
+
+    /* create the data SHM of every slot */
+    for (i = 0; i < SR_RPC_SUB_SLOT_COUNT; ++i) {
+        if ((err_info = sr_shmsub_data_create(name, sr_shmsub_rpc_slot_suffix(i, buf, sizeof buf), suffix2))) {
+            for (j = 0; j < i; ++j) {
+                if ((tmp_err = sr_shmsub_data_unlink(name, sr_shmsub_rpc_slot_suffix(j, buf, sizeof buf), suffix2))) {
+                    sr_errinfo_merge(&err_info, tmp_err);
+                }
+            }
+            goto error;
+        }
+    }
+
+    return NULL;
+
+error:
+    sr_shm_clear(&shm);
+    if ((tmp_err = sr_shmsub_unlink(name, "rpc", suffix2))) {
+        sr_errinfo_merge(&err_info, tmp_err);
+    }
+    return err_info;
+}
+
+sr_error_info_t *
+sr_shmsub_rpc_unlink(const char *name, int64_t suffix2)
+{
+    sr_error_info_t *err_info = NULL, *tmp_err;
+    char buf[16];
+    uint32_t i;
+
+    /* unlink the sub SHM */
+    err_info = sr_shmsub_unlink(name, "rpc", suffix2);
+
+    /* unlink the data SHM of every slot */
+    for (i = 0; i < SR_RPC_SUB_SLOT_COUNT; ++i) {
+        if ((tmp_err = sr_shmsub_data_unlink(name, sr_shmsub_rpc_slot_suffix(i, buf, sizeof buf), suffix2))) {
+            sr_errinfo_merge(&err_info, tmp_err);
+        }
+    }
+
+    return err_info;
+}
+
+sr_error_info_t *
+sr_shmsub_oper_poll_cache_create(const char *name, const char *path)
+{
+    sr_error_info_t *err_info = NULL, *tmp_err;
+
+    /* create the sub SHM */
+    if ((err_info = sr_shmsub_create(name, "poll", sr_str_hash(path, 0), sizeof(sr_oper_poll_cache_shm_t)))) {
+        return err_info;
+    }
+
+    /* create the data SHM */
+    if ((err_info = sr_shmsub_data_create(name, "poll", sr_str_hash(path, 0)))) {
+        if ((tmp_err = sr_shmsub_unlink(name, "poll", sr_str_hash(path, 0)))) {
+            sr_errinfo_merge(&err_info, tmp_err);
+        }
+        return err_info;
+    }
+
+    return NULL;
+}
+
+sr_error_info_t *
+sr_shmsub_oper_poll_cache_unlink(const char *name, const char *path)
+{
+    sr_error_info_t *err_info = NULL, *tmp_err;
+
+    /* unlink the sub SHM */
+    err_info = sr_shmsub_unlink(name, "poll", sr_str_hash(path, 0));
+
+    /* unlink the data SHM */
+    if ((tmp_err = sr_shmsub_data_unlink(name, "poll", sr_str_hash(path, 0)))) {
+        sr_errinfo_merge(&err_info, tmp_err);
+    }
+
+    return err_info;
+}
+
 /*
  * NOTIFIER functions
  */
@@ -336,11 +616,13 @@ sr_shmsub_recover(sr_sub_shm_t *sub_shm)
  * @param[in] sub_shm Subscription SHM to lock.
  * @param[in] shm_name Subscription SHM name.
  * @param[in] lock_event Which leftover event is OK to lock the SHM with, if any.
+ * @param[in] timeout_ms Timeout for the previous event to be processed, notification event is discarded on timeout.
  * @param[in] cid Connection ID.
  * @return err_info, NULL on success.
  */
 static sr_error_info_t *
-sr_shmsub_notify_new_wrlock(sr_sub_shm_t *sub_shm, const char *shm_name, sr_sub_event_t lock_event, sr_cid_t cid)
+sr_shmsub_notify_new_wrlock(sr_sub_shm_t *sub_shm, const char *shm_name, sr_sub_event_t lock_event,
+        uint32_t timeout_ms, sr_cid_t cid)
 {
     sr_error_info_t *err_info = NULL;
     struct timespec timeout_abs;
@@ -366,7 +648,7 @@ sr_shmsub_notify_new_wrlock(sr_sub_shm_t *sub_shm, const char *shm_name, sr_sub_
     sub_shm->lock.writer = 0;
 
     /* wait until there is no event and there are no readers (just like write lock) */
-    sr_timeouttime_get(&timeout_abs, SR_SUBSHM_LOCK_TIMEOUT);
+    sr_timeouttime_get(&timeout_abs, timeout_ms);
     ret = 0;
     while (!ret && (sub_shm->lock.readers[0] || (ATOMIC_LOAD_RELAXED(sub_shm->event) &&
             (ATOMIC_LOAD_RELAXED(sub_shm->event) != lock_event)))) {
@@ -396,7 +678,11 @@ sr_shmsub_notify_new_wrlock(sr_sub_shm_t *sub_shm, const char *shm_name, sr_sub_
         if ((ret == ETIMEDOUT) && !sub_shm->lock.readers[0] &&
                 (!last_event || (last_event == lock_event) || (last_event == SR_SUB_EV_NOTIF))) {
             /* even though the timeout has elapsed, the event was handled so continue normally (if there are no readers) */
-            if (last_event == SR_SUB_EV_NOTIF) {
+            if ((last_event == SR_SUB_EV_NOTIF) && (timeout_ms < SR_SUBSHM_LOCK_TIMEOUT)) {
+                /* only subscribers with bounded lag are lagging */
+                SR_LOG_DBG("Previous event \"%s\" ID %" PRIu32 " of \"%s\" will be dropped for lagging subscribers.",
+                        sr_ev2str(last_event), last_request_id, shm_name);
+            } else if (last_event == SR_SUB_EV_NOTIF) {
                 /* special case on notif event, assume its subscriber died */
                 SR_LOG_WRN("Waiting for subscription of \"%s\" failed, previous event \"%s\" ID %" PRIu32
                         " was not processed and will be disarded.", shm_name, sr_ev2str(last_event), last_request_id);
@@ -557,7 +843,7 @@ event_handled:
     sub_shm->lock.writer = cid;
 
     /* remap sub data SHM */
-    if ((err_info = sr_shmsub_data_open_remap(NULL, NULL, -1, shm_data_sub, 0))) {
+    if ((err_info = sr_shmsub_data_open_remap(NULL, NULL, -1, sub_shm, shm_data_sub, 0, 1))) {
         return err_info;
     }
 
@@ -756,7 +1042,7 @@ sr_shmsub_notify_many_wait_wr(struct sr_shmsub_many_info_s *notify_subs, uint32_
 
         /* wait for an event change */
         tmp_err = _sr_shmsub_notify_wait_wr(nsub->sub_shm, nsub->event, nsub->request_id, expected_ev, clear_ev_on_err,
-                cid, &nsub->shm_data_sub, &timeout_abs, &lock_lost, &nsub->cb_err_info);
+                cid, &nsub->orig->data[0], &timeout_abs, &lock_lost, &nsub->cb_err_info);
         if (tmp_err) {
             if (lock_lost) {
                 /* WRITE lock lost */
@@ -820,8 +1106,8 @@ sr_shmsub_notify_write_event(sr_sub_shm_t *sub_shm, sr_cid_t orig_cid, uint32_t
 
     /* remap if needed */
     if (xpath || data_len) {
-        if ((err_info = sr_shmsub_data_open_remap(NULL, NULL, -1, shm_data_sub, orig_size +
-                (xpath ? sr_strshmlen(xpath) : 0) + data_len))) {
+        if ((err_info = sr_shmsub_data_open_remap(NULL, NULL, -1, sub_shm, shm_data_sub, orig_size +
+                (xpath ? sr_strshmlen(xpath) : 0) + data_len, 1))) {
             return err_info;
         }
 
@@ -996,6 +1282,83 @@ sr_shmsub_change_notify_has_subscription(sr_conn_ctx_t *conn, struct sr_mod_info
     return has_sub;
 }
 
+int
+sr_shmsub_change_notify_has_any_subscription(sr_conn_ctx_t *conn, struct sr_mod_info_mod_s *mod, sr_datastore_t ds)
+{
+    sr_error_info_t *err_info = NULL;
+    sr_mod_change_sub_t *shm_sub;
+    int has_sub = 0;
+    uint32_t i;
+
+    /* EXT READ LOCK */
+    if ((err_info = sr_shmext_conn_remap_lock(conn, SR_LOCK_READ, 0, __func__))) {
+        sr_errinfo_free(&err_info);
+        return 1;
+    }
+
+    shm_sub = (sr_mod_change_sub_t *)(conn->ext_shm.addr + mod->shm_mod->change_sub[ds].subs);
+    for (i = 0; i < mod->shm_mod->change_sub[ds].sub_count; i++) {
+        /* suspended subscriptions may be resumed at any time */
+        if (sr_conn_is_alive(shm_sub[i].cid)) {
+            has_sub = 1;
+            break;
+        }
+    }
+
+    /* EXT READ UNLOCK */
+    sr_shmext_conn_remap_unlock(conn, SR_LOCK_READ, 0, __func__);
+
+    return has_sub;
+}
+
+int
+sr_shmsub_change_notify_is_coarse(sr_conn_ctx_t *conn, struct sr_mod_info_mod_s *mod, sr_datastore_t ds)
+{
+    sr_error_info_t *err_info = NULL;
+    sr_mod_change_sub_t *shm_sub;
+    int coarse = 1;
+    uint32_t i;
+
+    /* EXT READ LOCK */
+    if ((err_info = sr_shmext_conn_remap_lock(conn, SR_LOCK_READ, 0, __func__))) {
+        sr_errinfo_free(&err_info);
+        return 0;
+    }
+
+    shm_sub = (sr_mod_change_sub_t *)(conn->ext_shm.addr + mod->shm_mod->change_sub[ds].subs);
+    for (i = 0; i < mod->shm_mod->change_sub[ds].sub_count; i++) {
+        /* suspended subscriptions may be resumed at any time */
+        if (sr_conn_is_alive(shm_sub[i].cid) && !(shm_sub[i].opts & SR_SUBSCR_CHANGE_COARSE)) {
+            coarse = 0;
+            break;
+        }
+    }
+
+    /* EXT READ UNLOCK */
+    sr_shmext_conn_remap_unlock(conn, SR_LOCK_READ, 0, __func__);
+
+    return coarse;
+}
+
+/**
+ * @brief Get module data version with the changes of a change event applied.
+ *
+ * @param[in] mod Mod info module.
+ * @param[in] ds Datastore.
+ * @param[in] ev Change event.
+ * @return Data version.
+ */
+static uint32_t
+sr_shmsub_change_data_version(struct sr_mod_info_mod_s *mod, sr_datastore_t ds, sr_sub_event_t ev)
+{
+    if (ev == SR_SUB_EV_DONE) {
+        /* the changes were already stored */
+        return mod->shm_mod->data_version[ds];
+    }
+
+    return mod->shm_mod->data_version[ds] + 1;
+}
+
 /**
  * @brief Learn the priority of the next valid subscriber for a change event.
  *
@@ -1191,6 +1554,11 @@ sr_shmsub_change_notify_diff_has_changes(struct sr_mod_info_mod_s *mod, const st
             continue;
         }
 
+        if (mod->state & MOD_INFO_DIFF_SUMMARY) {
+            /* every node in a summary is a changed subtree */
+            return 1;
+        }
+
         LYD_TREE_DFS_BEGIN(root, elem) {
             op = sr_edit_diff_find_oper(elem, 0, NULL);
             if (op && (op != EDIT_NONE)) {
@@ -1214,7 +1582,7 @@ sr_shmsub_change_notify_update(struct sr_mod_info_s *mod_info, const char *orig_
     uint32_t cur_priority, subscriber_count, diff_lyb_len, *aux = NULL;
     char *diff_lyb = NULL;
     struct ly_ctx *ly_ctx;
-    sr_shm_t shm_sub = SR_SHM_INITIALIZER, shm_data_sub = SR_SHM_INITIALIZER;
+    struct sr_orig_shm_s *orig = NULL;
     sr_cid_t cid;
     int lock_lost;
 
@@ -1254,18 +1622,20 @@ sr_shmsub_change_notify_update(struct sr_mod_info_s *mod_info, const char *orig_
         }
 
         /* open sub SHM and map it */
-        if ((err_info = sr_shmsub_open_map(mod->ly_mod->name, sr_ds2str(mod_info->ds), -1, &shm_sub))) {
+        if ((err_info = sr_shmsub_orig_open_map(mod_info->conn, mod->ly_mod->name, sr_ds2str(mod_info->ds), -1,
+                &orig))) {
             goto cleanup;
         }
-        sub_shm = (sr_sub_shm_t *)shm_sub.addr;
+        sub_shm = (sr_sub_shm_t *)orig->sub.addr;
 
         /* SUB WRITE LOCK */
-        if ((err_info = sr_shmsub_notify_new_wrlock(sub_shm, mod->ly_mod->name, 0, cid))) {
+        if ((err_info = sr_shmsub_notify_new_wrlock(sub_shm, mod->ly_mod->name, 0, SR_SUBSHM_LOCK_TIMEOUT, cid))) {
             goto cleanup;
         }
 
         /* open sub data SHM */
-        if ((err_info = sr_shmsub_data_open_remap(mod->ly_mod->name, sr_ds2str(mod_info->ds), -1, &shm_data_sub, 0))) {
+        if ((err_info = sr_shmsub_data_open_remap(mod->ly_mod->name, sr_ds2str(mod_info->ds), -1, sub_shm,
+                &orig->data[0], 0, 1))) {
             goto cleanup_wrunlock;
         }
 
@@ -1278,10 +1648,11 @@ sr_shmsub_change_notify_update(struct sr_mod_info_s *mod_info, const char *orig_
                 mod->request_id = ++sub_shm->request_id;
             }
             if ((err_info = sr_shmsub_notify_write_event(sub_shm, cid, mod->request_id, cur_priority,
-                    SR_SUB_EV_UPDATE, orig_name, orig_data, subscriber_count, &shm_data_sub, NULL, diff_lyb,
+                    SR_SUB_EV_UPDATE, orig_name, orig_data, subscriber_count, &orig->data[0], NULL, diff_lyb,
                     diff_lyb_len, mod->ly_mod->name))) {
                 goto cleanup_wrunlock;
             }
+            sub_shm->data_version = sr_shmsub_change_data_version(mod, mod_info->ds, SR_SUB_EV_UPDATE);
 
             /* notify using event pipe and wait until all the subscribers have processed the event */
             if ((err_info = sr_shmsub_change_notify_evpipe(mod_info->conn, mod, mod_info->ds, mod_info->diff,
@@ -1290,7 +1661,7 @@ sr_shmsub_change_notify_update(struct sr_mod_info_s *mod_info, const char *orig_
             }
 
             /* wait until the event is processed */
-            if ((err_info = sr_shmsub_notify_wait_wr(sub_shm, SR_SUB_EV_ERROR, 0, cid, &shm_data_sub, timeout_ms,
+            if ((err_info = sr_shmsub_notify_wait_wr(sub_shm, SR_SUB_EV_ERROR, 0, cid, &orig->data[0], timeout_ms,
                     &lock_lost, cb_err_info))) {
                 if (lock_lost) {
                     goto cleanup;
@@ -1312,7 +1683,7 @@ sr_shmsub_change_notify_update(struct sr_mod_info_s *mod_info, const char *orig_
             assert(sub_shm->event == SR_SUB_EV_SUCCESS);
 
             /* parse updated edit */
-            if ((err_info = sr_lyd_parse_data(ly_ctx, shm_data_sub.addr, NULL, LYD_LYB,
+            if ((err_info = sr_lyd_parse_data(ly_ctx, orig->data[0].addr, NULL, LYD_LYB,
                     LYD_PARSE_STRICT | LYD_PARSE_OPAQ | LYD_PARSE_STORE_ONLY, 0, &edit))) {
                 sr_errinfo_new(&err_info, SR_ERR_VALIDATION_FAILED, "Failed to parse \"update\" edit.");
                 goto cleanup_wrunlock;
@@ -1341,8 +1712,8 @@ sr_shmsub_change_notify_update(struct sr_mod_info_s *mod_info, const char *orig_
         /* SUB WRITE UNLOCK */
         sr_rwunlock(&sub_shm->lock, 0, SR_LOCK_WRITE, cid, __func__);
 
-        sr_shm_clear(&shm_sub);
-        sr_shm_clear(&shm_data_sub);
+        sr_shmsub_orig_release(mod_info->conn, orig);
+        orig = NULL;
     }
 
     goto cleanup;
@@ -1359,8 +1730,7 @@ cleanup_wrunlock:
 cleanup:
     free(aux);
     free(diff_lyb);
-    sr_shm_clear(&shm_sub);
-    sr_shm_clear(&shm_data_sub);
+    sr_shmsub_orig_release(mod_info->conn, orig);
     if (err_info || *cb_err_info) {
         lyd_free_all(*update_edit);
         *update_edit = NULL;
@@ -1513,8 +1883,7 @@ sr_shmsub_change_notify_change(struct sr_mod_info_s *mod_info, const char *orig_
         memset(&notify_subs[notify_count], 0, sizeof *notify_subs);
         notify_subs[notify_count].mod = mod;
         notify_subs[notify_count].cur_priority = max_priority + 1;
-        notify_subs[notify_count].shm_sub.fd = -1;
-        notify_subs[notify_count].shm_data_sub.fd = -1;
+        notify_subs[notify_count].orig = NULL;
         ++notify_count;
     }
 
@@ -1554,20 +1923,22 @@ sr_shmsub_change_notify_change(struct sr_mod_info_s *mod_info, const char *orig_
             pending_events = 1;
 
             /* open sub SHM and map it */
-            if ((err_info = sr_shmsub_open_map(nsub->mod->ly_mod->name, sr_ds2str(mod_info->ds), -1, &nsub->shm_sub))) {
+            if ((err_info = sr_shmsub_orig_open_map(mod_info->conn, nsub->mod->ly_mod->name,
+                    sr_ds2str(mod_info->ds), -1, &nsub->orig))) {
                 goto cleanup;
             }
-            nsub->sub_shm = (sr_sub_shm_t *)nsub->shm_sub.addr;
+            nsub->sub_shm = (sr_sub_shm_t *)nsub->orig->sub.addr;
 
             /* SUB WRITE LOCK */
-            if ((err_info = sr_shmsub_notify_new_wrlock(nsub->sub_shm, nsub->mod->ly_mod->name, 0, cid))) {
+            if ((err_info = sr_shmsub_notify_new_wrlock(nsub->sub_shm, nsub->mod->ly_mod->name, 0,
+                    SR_SUBSHM_LOCK_TIMEOUT, cid))) {
                 goto cleanup;
             }
             nsub->lock = SR_LOCK_WRITE;
 
             /* open sub data SHM */
             if ((err_info = sr_shmsub_data_open_remap(nsub->mod->ly_mod->name, sr_ds2str(mod_info->ds), -1,
-                    &nsub->shm_data_sub, 0))) {
+                    nsub->sub_shm, &nsub->orig->data[0], 0, 1))) {
                 goto cleanup;
             }
 
@@ -1575,11 +1946,12 @@ sr_shmsub_change_notify_change(struct sr_mod_info_s *mod_info, const char *orig_
             if (!nsub->mod->request_id) {
                 nsub->mod->request_id = ++nsub->sub_shm->request_id;
             }
-            if ((err_info = sr_shmsub_notify_write_event((sr_sub_shm_t *)nsub->shm_sub.addr, cid, nsub->mod->request_id,
-                    nsub->cur_priority, SR_SUB_EV_CHANGE, orig_name, orig_data, subscriber_count, &nsub->shm_data_sub,
+            if ((err_info = sr_shmsub_notify_write_event(nsub->sub_shm, cid, nsub->mod->request_id,
+                    nsub->cur_priority, SR_SUB_EV_CHANGE, orig_name, orig_data, subscriber_count, &nsub->orig->data[0],
                     NULL, diff_lyb, diff_lyb_len, nsub->mod->ly_mod->name))) {
                 goto cleanup;
             }
+            nsub->sub_shm->data_version = sr_shmsub_change_data_version(nsub->mod, mod_info->ds, SR_SUB_EV_CHANGE);
 
             /* notify the subscribers using an event pipe */
             if ((err_info = sr_shmsub_change_notify_evpipe(mod_info->conn, nsub->mod, mod_info->ds, mod_info->diff,
@@ -1647,8 +2019,7 @@ cleanup:
             sr_rwunlock(&notify_subs[i].sub_shm->lock, 0, notify_subs[i].lock, cid, __func__);
             notify_subs[i].lock = SR_LOCK_NONE;
         }
-        sr_shm_clear(&notify_subs[i].shm_sub);
-        sr_shm_clear(&notify_subs[i].shm_data_sub);
+        sr_shmsub_orig_release(mod_info->conn, notify_subs[i].orig);
     }
 
     free(aux);
@@ -1690,8 +2061,7 @@ sr_shmsub_change_notify_change_done(struct sr_mod_info_s *mod_info, const char *
         memset(&notify_subs[notify_count], 0, sizeof *notify_subs);
         notify_subs[notify_count].mod = mod;
         notify_subs[notify_count].cur_priority = max_priority + 1;
-        notify_subs[notify_count].shm_sub.fd = -1;
-        notify_subs[notify_count].shm_data_sub.fd = -1;
+        notify_subs[notify_count].orig = NULL;
         ++notify_count;
     }
 
@@ -1730,20 +2100,22 @@ sr_shmsub_change_notify_change_done(struct sr_mod_info_s *mod_info, const char *
             pending_events = 1;
 
             /* open sub SHM and map it */
-            if ((err_info = sr_shmsub_open_map(nsub->mod->ly_mod->name, sr_ds2str(mod_info->ds), -1, &nsub->shm_sub))) {
+            if ((err_info = sr_shmsub_orig_open_map(mod_info->conn, nsub->mod->ly_mod->name,
+                    sr_ds2str(mod_info->ds), -1, &nsub->orig))) {
                 goto cleanup;
             }
-            nsub->sub_shm = (sr_sub_shm_t *)nsub->shm_sub.addr;
+            nsub->sub_shm = (sr_sub_shm_t *)nsub->orig->sub.addr;
 
             /* SUB WRITE LOCK */
-            if ((err_info = sr_shmsub_notify_new_wrlock(nsub->sub_shm, nsub->mod->ly_mod->name, 0, cid))) {
+            if ((err_info = sr_shmsub_notify_new_wrlock(nsub->sub_shm, nsub->mod->ly_mod->name, 0,
+                    SR_SUBSHM_LOCK_TIMEOUT, cid))) {
                 goto cleanup;
             }
             nsub->lock = SR_LOCK_WRITE;
 
             /* open sub data SHM */
             if ((err_info = sr_shmsub_data_open_remap(nsub->mod->ly_mod->name, sr_ds2str(mod_info->ds), -1,
-                    &nsub->shm_data_sub, 0))) {
+                    nsub->sub_shm, &nsub->orig->data[0], 0, 1))) {
                 goto cleanup;
             }
 
@@ -1751,11 +2123,12 @@ sr_shmsub_change_notify_change_done(struct sr_mod_info_s *mod_info, const char *
             if (!nsub->mod->request_id) {
                 nsub->mod->request_id = ++nsub->sub_shm->request_id;
             }
-            if ((err_info = sr_shmsub_notify_write_event((sr_sub_shm_t *)nsub->shm_sub.addr, cid, nsub->mod->request_id,
-                    nsub->cur_priority, SR_SUB_EV_DONE, orig_name, orig_data, subscriber_count, &nsub->shm_data_sub,
+            if ((err_info = sr_shmsub_notify_write_event(nsub->sub_shm, cid, nsub->mod->request_id,
+                    nsub->cur_priority, SR_SUB_EV_DONE, orig_name, orig_data, subscriber_count, &nsub->orig->data[0],
                     NULL, diff_lyb, diff_lyb_len, nsub->mod->ly_mod->name))) {
                 goto cleanup;
             }
+            nsub->sub_shm->data_version = sr_shmsub_change_data_version(nsub->mod, mod_info->ds, SR_SUB_EV_DONE);
 
             /* notify the subscribers using an event pipe */
             if ((err_info = sr_shmsub_change_notify_evpipe(mod_info->conn, nsub->mod, mod_info->ds, mod_info->diff,
@@ -1812,8 +2185,7 @@ cleanup:
             sr_rwunlock(&notify_subs[i].sub_shm->lock, 0, notify_subs[i].lock, cid, __func__);
             notify_subs[i].lock = SR_LOCK_NONE;
         }
-        sr_shm_clear(&notify_subs[i].shm_sub);
-        sr_shm_clear(&notify_subs[i].shm_data_sub);
+        sr_shmsub_orig_release(mod_info->conn, notify_subs[i].orig);
     }
 
     free(aux);
@@ -1861,8 +2233,7 @@ sr_shmsub_change_notify_change_abort(struct sr_mod_info_s *mod_info, const char
         memset(&notify_subs[notify_count], 0, sizeof *notify_subs);
         notify_subs[notify_count].mod = mod;
         notify_subs[notify_count].cur_priority = max_priority + 1;
-        notify_subs[notify_count].shm_sub.fd = -1;
-        notify_subs[notify_count].shm_data_sub.fd = -1;
+        notify_subs[notify_count].orig = NULL;
         ++notify_count;
     }
 
@@ -1875,21 +2246,23 @@ sr_shmsub_change_notify_change_abort(struct sr_mod_info_s *mod_info, const char
         nsub = &notify_subs[i];
 
         /* open sub SHM and map it */
-        if ((err_info = sr_shmsub_open_map(nsub->mod->ly_mod->name, sr_ds2str(mod_info->ds), -1, &nsub->shm_sub))) {
+        if ((err_info = sr_shmsub_orig_open_map(mod_info->conn, nsub->mod->ly_mod->name, sr_ds2str(mod_info->ds),
+                -1, &nsub->orig))) {
             goto cleanup;
         }
-        nsub->sub_shm = (sr_sub_shm_t *)nsub->shm_sub.addr;
-        sub_shm = (sr_sub_shm_t *)nsub->shm_sub.addr;
+        nsub->sub_shm = (sr_sub_shm_t *)nsub->orig->sub.addr;
+        sub_shm = (sr_sub_shm_t *)nsub->orig->sub.addr;
 
         /* SUB WRITE LOCK */
-        if ((err_info = sr_shmsub_notify_new_wrlock(nsub->sub_shm, nsub->mod->ly_mod->name, SR_SUB_EV_ERROR, cid))) {
+        if ((err_info = sr_shmsub_notify_new_wrlock(nsub->sub_shm, nsub->mod->ly_mod->name, SR_SUB_EV_ERROR,
+                SR_SUBSHM_LOCK_TIMEOUT, cid))) {
             goto cleanup;
         }
         nsub->lock = SR_LOCK_WRITE;
 
         /* open sub data SHM */
         if ((err_info = sr_shmsub_data_open_remap(nsub->mod->ly_mod->name, sr_ds2str(mod_info->ds), -1,
-                &nsub->shm_data_sub, 0))) {
+                nsub->sub_shm, &nsub->orig->data[0], 0, 1))) {
             goto cleanup;
         }
 
@@ -1902,7 +2275,7 @@ sr_shmsub_change_notify_change_abort(struct sr_mod_info_s *mod_info, const char
             /* clear the error */
             assert(nsub->sub_shm->request_id == nsub->mod->request_id);
             if ((err_info = sr_shmsub_notify_write_event(sub_shm, 0, nsub->mod->request_id,
-                    nsub->cur_priority, 0, NULL, NULL, 0, &nsub->shm_data_sub, NULL, NULL, 0, NULL))) {
+                    nsub->cur_priority, 0, NULL, NULL, 0, &nsub->orig->data[0], NULL, NULL, 0, NULL))) {
                 goto cleanup;
             }
         }
@@ -1953,30 +2326,33 @@ sr_shmsub_change_notify_change_abort(struct sr_mod_info_s *mod_info, const char
             pending_events = 1;
 
             /* open sub SHM and map it */
-            if ((err_info = sr_shmsub_open_map(nsub->mod->ly_mod->name, sr_ds2str(mod_info->ds), -1, &nsub->shm_sub))) {
+            if ((err_info = sr_shmsub_orig_open_map(mod_info->conn, nsub->mod->ly_mod->name,
+                    sr_ds2str(mod_info->ds), -1, &nsub->orig))) {
                 goto cleanup;
             }
-            nsub->sub_shm = (sr_sub_shm_t *)nsub->shm_sub.addr;
-            sub_shm = (sr_sub_shm_t *)nsub->shm_sub.addr;
+            nsub->sub_shm = (sr_sub_shm_t *)nsub->orig->sub.addr;
+            sub_shm = (sr_sub_shm_t *)nsub->orig->sub.addr;
 
             /* SUB WRITE LOCK */
-            if ((err_info = sr_shmsub_notify_new_wrlock(nsub->sub_shm, nsub->mod->ly_mod->name, 0, cid))) {
+            if ((err_info = sr_shmsub_notify_new_wrlock(nsub->sub_shm, nsub->mod->ly_mod->name, 0,
+                    SR_SUBSHM_LOCK_TIMEOUT, cid))) {
                 goto cleanup;
             }
             nsub->lock = SR_LOCK_WRITE;
 
             /* open sub data SHM */
             if ((err_info = sr_shmsub_data_open_remap(nsub->mod->ly_mod->name, sr_ds2str(mod_info->ds), -1,
-                    &nsub->shm_data_sub, 0))) {
+                    nsub->sub_shm, &nsub->orig->data[0], 0, 1))) {
                 goto cleanup;
             }
 
             /* write the event */
             if ((err_info = sr_shmsub_notify_write_event(sub_shm, cid, nsub->mod->request_id, nsub->cur_priority,
-                    SR_SUB_EV_ABORT, orig_name, orig_data, subscriber_count, &nsub->shm_data_sub, NULL, diff_lyb,
+                    SR_SUB_EV_ABORT, orig_name, orig_data, subscriber_count, &nsub->orig->data[0], NULL, diff_lyb,
                     diff_lyb_len, nsub->mod->ly_mod->name))) {
                 goto cleanup;
             }
+            sub_shm->data_version = sr_shmsub_change_data_version(nsub->mod, mod_info->ds, SR_SUB_EV_ABORT);
 
             /* notify the subscribers using an event pipe */
             if ((err_info = sr_shmsub_change_notify_evpipe(mod_info->conn, nsub->mod, mod_info->ds, mod_info->diff,
@@ -2039,8 +2415,7 @@ cleanup:
             sr_rwunlock(&notify_subs[i].sub_shm->lock, 0, notify_subs[i].lock, cid, __func__);
             notify_subs[i].lock = SR_LOCK_NONE;
         }
-        sr_shm_clear(&notify_subs[i].shm_sub);
-        sr_shm_clear(&notify_subs[i].shm_data_sub);
+        sr_shmsub_orig_release(mod_info->conn, notify_subs[i].orig);
     }
 
     free(aux);
@@ -2090,8 +2465,7 @@ sr_shmsub_oper_get_notify(struct sr_mod_info_mod_s *mod, const char *xpath, cons
         /* init */
         memset(&notify_subs[notify_count], 0, sizeof *notify_subs);
         notify_subs[notify_count].xpath_sub = xpath_sub;
-        notify_subs[notify_count].shm_sub.fd = -1;
-        notify_subs[notify_count].shm_data_sub.fd = -1;
+        notify_subs[notify_count].orig = NULL;
         ++notify_count;
     }
 
@@ -2104,28 +2478,29 @@ sr_shmsub_oper_get_notify(struct sr_mod_info_mod_s *mod, const char *xpath, cons
         nsub = &notify_subs[i];
 
         /* open sub SHM and map it */
-        if ((err_info = sr_shmsub_open_map(mod->ly_mod->name, "oper", sr_str_hash(xpath, nsub->xpath_sub->priority),
-                &nsub->shm_sub))) {
+        if ((err_info = sr_shmsub_orig_open_map(conn, mod->ly_mod->name, "oper",
+                sr_str_hash(xpath, nsub->xpath_sub->priority), &nsub->orig))) {
             goto cleanup;
         }
-        nsub->sub_shm = (sr_sub_shm_t *)nsub->shm_sub.addr;
+        nsub->sub_shm = (sr_sub_shm_t *)nsub->orig->sub.addr;
 
         /* SUB WRITE LOCK */
-        if ((err_info = sr_shmsub_notify_new_wrlock(nsub->sub_shm, mod->ly_mod->name, 0, cid))) {
+        if ((err_info = sr_shmsub_notify_new_wrlock(nsub->sub_shm, mod->ly_mod->name, 0, SR_SUBSHM_LOCK_TIMEOUT,
+                cid))) {
             goto cleanup;
         }
         nsub->lock = SR_LOCK_WRITE;
 
         /* open sub data SHM */
         if ((err_info = sr_shmsub_data_open_remap(mod->ly_mod->name, "oper",
-                sr_str_hash(xpath, nsub->xpath_sub->priority), &nsub->shm_data_sub, 0))) {
+                sr_str_hash(xpath, nsub->xpath_sub->priority), nsub->sub_shm, &nsub->orig->data[0], 0, 1))) {
             goto cleanup;
         }
 
         /* write the request for state data */
         request_id = ATOMIC_LOAD_RELAXED(nsub->sub_shm->request_id) + 1;
         if ((err_info = sr_shmsub_notify_write_event(nsub->sub_shm, cid, request_id, 0, SR_SUB_EV_OPER, orig_name,
-                orig_data, 1, &nsub->shm_data_sub, request_xpath, parent_lyb, parent_lyb_len, NULL))) {
+                orig_data, 1, &nsub->orig->data[0], request_xpath, parent_lyb, parent_lyb_len, NULL))) {
             goto cleanup;
         }
         SR_LOG_DBG("EV ORIGIN: \"%s\" \"%s\" index %" PRIu32 " ID %" PRIu32 " published.", xpath,
@@ -2169,7 +2544,7 @@ sr_shmsub_oper_get_notify(struct sr_mod_info_mod_s *mod, const char *xpath, cons
         assert(ATOMIC_LOAD_RELAXED(nsub->sub_shm->event) == SR_SUB_EV_SUCCESS);
 
         /* parse returned data */
-        if ((err_info = sr_lyd_parse_data(mod->ly_mod->ctx, nsub->shm_data_sub.addr, NULL, LYD_LYB,
+        if ((err_info = sr_lyd_parse_data(mod->ly_mod->ctx, nsub->orig->data[0].addr, NULL, LYD_LYB,
                 LYD_PARSE_STORE_ONLY | LYD_PARSE_STRICT, 0, &oper_data))) {
             sr_errinfo_new(&err_info, SR_ERR_VALIDATION_FAILED, "Failed to parse returned \"operational\" data.");
             goto cleanup;
@@ -2202,8 +2577,7 @@ cleanup:
             sr_rwunlock(&notify_subs[i].sub_shm->lock, 0, notify_subs[i].lock, cid, __func__);
             notify_subs[i].lock = SR_LOCK_NONE;
         }
-        sr_shm_clear(&notify_subs[i].shm_sub);
-        sr_shm_clear(&notify_subs[i].shm_data_sub);
+        sr_shmsub_orig_release(conn, notify_subs[i].orig);
     }
 
     free(parent_lyb);
@@ -2333,7 +2707,7 @@ sr_shmsub_rpc_internal_call_callback(sr_conn_ctx_t *conn, const struct lyd_node
         }
 
         /* update affected data and create corresponding diff, data are spent */
-        if ((err_info = sr_modinfo_replace(&mod_info, &data[ds]))) {
+        if ((err_info = sr_modinfo_replace(&mod_info, &data[ds], 1))) {
             goto cleanup;
         }
 
@@ -2418,16 +2792,17 @@ sr_shmsub_rpc_listen_filter_is_valid(const struct lyd_node *input, const char *x
  * @param[in,out] sub_count Ext SHM RPC sub count.
  * @param[in] input Operation input.
  * @param[out] max_priority_p Highest priority among the valid subscribers.
+ * @param[out] pipelined_p Optional, set if all the valid subscribers are pipelined.
  * @return 0 if not, non-zero if there is.
  */
 static int
 sr_shmsub_rpc_notify_has_subscription(sr_conn_ctx_t *conn, off_t *subs, uint32_t *sub_count,
-        const struct lyd_node *input, uint32_t *max_priority_p)
+        const struct lyd_node *input, uint32_t *max_priority_p, int *pipelined_p)
 {
     sr_error_info_t *err_info = NULL;
     sr_mod_rpc_sub_t *shm_subs;
     uint32_t i;
-    int has_sub = 0;
+    int has_sub = 0, pipelined = 1;
 
     /* EXT READ LOCK */
     if ((err_info = sr_shmext_conn_remap_lock(conn, SR_LOCK_READ, 0, __func__))) {
@@ -2456,12 +2831,19 @@ sr_shmsub_rpc_notify_has_subscription(sr_conn_ctx_t *conn, off_t *subs, uint32_t
             if (shm_subs[i].priority > *max_priority_p) {
                 *max_priority_p = shm_subs[i].priority;
             }
+            if (!shm_subs[i].cid || !(shm_subs[i].opts & SR_SUBSCR_RPC_PIPELINE)) {
+                /* internal or standard subscription */
+                pipelined = 0;
+            }
         }
     }
 
     /* EXT READ UNLOCK */
     sr_shmext_conn_remap_unlock(conn, SR_LOCK_READ, 0, __func__);
 
+    if (pipelined_p) {
+        *pipelined_p = has_sub && pipelined;
+    }
     return has_sub;
 }
 
@@ -2560,16 +2942,18 @@ sr_shmsub_rpc_notify(sr_conn_ctx_t *conn, off_t *subs, uint32_t *sub_count, cons
 {
     sr_error_info_t *err_info = NULL;
     char *input_lyb = NULL;
-    uint32_t i, input_lyb_len, cur_priority, subscriber_count, *evpipes = NULL;
-    int opts, lock_lost;
+    uint32_t i, input_lyb_len, cur_priority, subscriber_count, slot = 0, *evpipes = NULL;
+    int opts, lock_lost, pipelined;
+    sr_rpc_sub_shm_t *rpc_shm;
     sr_sub_shm_t *sub_shm;
-    sr_shm_t shm_sub = SR_SHM_INITIALIZER, shm_data_sub = SR_SHM_INITIALIZER;
+    struct sr_orig_shm_s *orig = NULL;
+    char buf[16];
 
     assert(!input->parent);
     *output = NULL;
 
     /* just find out whether there are any subscriptions and if so, what is the highest priority */
-    if (!sr_shmsub_rpc_notify_has_subscription(conn, subs, sub_count, input, &cur_priority)) {
+    if (!sr_shmsub_rpc_notify_has_subscription(conn, subs, sub_count, input, &cur_priority, &pipelined)) {
         sr_errinfo_new(&err_info, SR_ERR_UNSUPPORTED, "There are no matching subscribers for RPC/action \"%s\".",
                 path);
         goto cleanup;
@@ -2605,18 +2989,26 @@ first_sub:
     }
 
     /* open sub SHM and map it */
-    if ((err_info = sr_shmsub_open_map(lyd_owner_module(input)->name, "rpc", sr_str_hash(path, 0), &shm_sub))) {
+    if ((err_info = sr_shmsub_orig_open_map(conn, lyd_owner_module(input)->name, "rpc", sr_str_hash(path, 0),
+            &orig))) {
         goto cleanup;
     }
-    sub_shm = (sr_sub_shm_t *)shm_sub.addr;
+    rpc_shm = (sr_rpc_sub_shm_t *)orig->sub.addr;
+
+    if (pipelined) {
+        /* use one of the pipelined slots, round-robin */
+        slot = 1 + ATOMIC_INC_RELAXED(rpc_shm->next_slot) % (SR_RPC_SUB_SLOT_COUNT - 1);
+    }
+    sub_shm = &rpc_shm->slot[slot];
 
     /* SUB WRITE LOCK */
-    if ((err_info = sr_shmsub_notify_new_wrlock(sub_shm, path, 0, conn->cid))) {
+    if ((err_info = sr_shmsub_notify_new_wrlock(sub_shm, path, 0, SR_SUBSHM_LOCK_TIMEOUT, conn->cid))) {
         goto cleanup;
     }
 
     /* open sub data SHM */
-    if ((err_info = sr_shmsub_data_open_remap(lyd_owner_module(input)->name, "rpc", sr_str_hash(path, 0), &shm_data_sub, 0))) {
+    if ((err_info = sr_shmsub_data_open_remap(lyd_owner_module(input)->name, sr_shmsub_rpc_slot_suffix(slot, buf,
+            sizeof buf), sr_str_hash(path, 0), sub_shm, &orig->data[slot], 0, 1))) {
         goto cleanup_wrunlock;
     }
 
@@ -2637,10 +3029,11 @@ first_sub:
 
         /* write the event */
         if (!*request_id) {
-            *request_id = ++sub_shm->request_id;
+            /* unique among all the slots */
+            *request_id = ATOMIC_INC_RELAXED(rpc_shm->request_id) + 1;
         }
         if ((err_info = sr_shmsub_notify_write_event(sub_shm, conn->cid, *request_id, cur_priority, SR_SUB_EV_RPC,
-                orig_name, orig_data, subscriber_count, &shm_data_sub, NULL, input_lyb, input_lyb_len, path))) {
+                orig_name, orig_data, subscriber_count, &orig->data[slot], NULL, input_lyb, input_lyb_len, path))) {
             goto cleanup_wrunlock;
         }
 
@@ -2652,7 +3045,7 @@ first_sub:
         }
 
         /* wait until the event is processed */
-        if ((err_info = sr_shmsub_notify_wait_wr(sub_shm, SR_SUB_EV_ERROR, 0, conn->cid, &shm_data_sub, timeout_ms,
+        if ((err_info = sr_shmsub_notify_wait_wr(sub_shm, SR_SUB_EV_ERROR, 0, conn->cid, &orig->data[slot], timeout_ms,
                 &lock_lost, cb_err_info))) {
             if (lock_lost) {
                 goto cleanup;
@@ -2674,7 +3067,7 @@ first_sub:
         assert(sub_shm->event == SR_SUB_EV_SUCCESS);
 
         /* parse returned reply */
-        if ((err_info = sr_lyd_parse_op(LYD_CTX(input), shm_data_sub.addr, LYD_LYB, LYD_TYPE_REPLY_YANG, output))) {
+        if ((err_info = sr_lyd_parse_op(LYD_CTX(input), orig->data[slot].addr, LYD_LYB, LYD_TYPE_REPLY_YANG, output))) {
             sr_errinfo_new(&err_info, SR_ERR_VALIDATION_FAILED, "Failed to parse returned \"RPC\" data.");
             goto cleanup_wrunlock;
         }
@@ -2705,8 +3098,7 @@ cleanup_wrunlock:
 cleanup:
     free(input_lyb);
     free(evpipes);
-    sr_shm_clear(&shm_sub);
-    sr_shm_clear(&shm_data_sub);
+    sr_shmsub_orig_release(conn, orig);
     if (err_info) {
         lyd_free_all(*output);
         *output = NULL;
@@ -2721,36 +3113,51 @@ sr_shmsub_rpc_notify_abort(sr_conn_ctx_t *conn, off_t *subs, uint32_t *sub_count
 {
     sr_error_info_t *err_info = NULL, *cb_err_info = NULL;
     char *input_lyb = NULL;
-    uint32_t i, input_lyb_len, cur_priority, err_priority, subscriber_count, err_subscriber_count, *evpipes = NULL;
+    uint32_t i, input_lyb_len, cur_priority, err_priority, subscriber_count, err_subscriber_count, slot,
+            *evpipes = NULL;
+    sr_rpc_sub_shm_t *rpc_shm;
     sr_sub_shm_t *sub_shm;
-    sr_shm_t shm_sub = SR_SHM_INITIALIZER, shm_data_sub = SR_SHM_INITIALIZER;
+    struct sr_orig_shm_s *orig = NULL;
     int first_iter, lock_lost;
+    char buf[16];
 
     assert(request_id);
 
     /* open sub SHM and map it */
-    if ((err_info = sr_shmsub_open_map(lyd_owner_module(input)->name, "rpc", sr_str_hash(path, 0), &shm_sub))) {
+    if ((err_info = sr_shmsub_orig_open_map(conn, lyd_owner_module(input)->name, "rpc", sr_str_hash(path, 0),
+            &orig))) {
         goto cleanup;
     }
-    sub_shm = (sr_sub_shm_t *)shm_sub.addr;
+    rpc_shm = (sr_rpc_sub_shm_t *)orig->sub.addr;
+
+    /* find the slot with the failed request, it is left there until aborted */
+    for (slot = SR_RPC_SUB_SLOT_COUNT - 1; slot; --slot) {
+        if ((ATOMIC_LOAD_RELAXED(rpc_shm->slot[slot].request_id) == request_id) &&
+                (ATOMIC_LOAD_RELAXED(rpc_shm->slot[slot].event) == SR_SUB_EV_ERROR)) {
+            break;
+        }
+    }
+    sub_shm = &rpc_shm->slot[slot];
 
     /* SUB WRITE LOCK */
-    if ((err_info = sr_shmsub_notify_new_wrlock(sub_shm, path, SR_SUB_EV_ERROR, conn->cid))) {
+    if ((err_info = sr_shmsub_notify_new_wrlock(sub_shm, path, SR_SUB_EV_ERROR, SR_SUBSHM_LOCK_TIMEOUT,
+            conn->cid))) {
         goto cleanup;
     }
 
     /* open sub data SHM */
-    if ((err_info = sr_shmsub_data_open_remap(lyd_owner_module(input)->name, "rpc", sr_str_hash(path, 0), &shm_data_sub, 0))) {
+    if ((err_info = sr_shmsub_data_open_remap(lyd_owner_module(input)->name, sr_shmsub_rpc_slot_suffix(slot, buf,
+            sizeof buf), sr_str_hash(path, 0), sub_shm, &orig->data[slot], 0, 1))) {
         goto cleanup_wrunlock;
     }
 
-    if (!sr_shmsub_rpc_notify_has_subscription(conn, subs, sub_count, input, &cur_priority)) {
+    if (!sr_shmsub_rpc_notify_has_subscription(conn, subs, sub_count, input, &cur_priority, NULL)) {
         /* no subscriptions interested in this event, but we still want to clear the event */
 clear_shm:
         /* clear the SHM */
         assert(sub_shm->event == SR_SUB_EV_ERROR);
         if ((err_info = sr_shmsub_notify_write_event(sub_shm, 0, request_id, cur_priority, 0, NULL, NULL, 0,
-                &shm_data_sub, NULL, NULL, 0, NULL))) {
+                &orig->data[slot], NULL, NULL, 0, NULL))) {
             goto cleanup_wrunlock;
         }
 
@@ -2794,7 +3201,7 @@ clear_shm:
 
         /* write "abort" event with the same input */
         if ((err_info = sr_shmsub_notify_write_event(sub_shm, conn->cid, request_id, cur_priority, SR_SUB_EV_ABORT,
-                orig_name, orig_data, subscriber_count, &shm_data_sub, NULL, input_lyb, input_lyb_len, path))) {
+                orig_name, orig_data, subscriber_count, &orig->data[slot], NULL, input_lyb, input_lyb_len, path))) {
             goto cleanup_wrunlock;
         }
 
@@ -2806,8 +3213,8 @@ clear_shm:
         }
 
         /* wait until the event is processed */
-        if ((err_info = sr_shmsub_notify_wait_wr(sub_shm, SR_SUB_EV_FINISHED, 1, conn->cid, &shm_data_sub, timeout_ms,
-                &lock_lost, &cb_err_info))) {
+        if ((err_info = sr_shmsub_notify_wait_wr(sub_shm, SR_SUB_EV_FINISHED, 1, conn->cid, &orig->data[slot],
+                timeout_ms, &lock_lost, &cb_err_info))) {
             if (lock_lost) {
                 goto cleanup;
             } else {
@@ -2839,28 +3246,129 @@ cleanup_wrunlock:
 cleanup:
     free(input_lyb);
     free(evpipes);
-    sr_shm_clear(&shm_sub);
-    sr_shm_clear(&shm_data_sub);
+    sr_shmsub_orig_release(conn, orig);
     return err_info;
 }
 
-sr_error_info_t *
-sr_shmsub_notif_notify(sr_conn_ctx_t *conn, const struct lyd_node *notif, struct timespec notif_ts_mono,
-        struct timespec notif_ts_real, const char *orig_name, const void *orig_data, uint32_t timeout_ms, int wait)
+/**
+ * @brief Learn which notification subscribers have not processed the previous notification yet.
+ * Must be called with EXT READ lock.
+ *
+ * @param[in] conn Connection to use.
+ * @param[in] shm_mod SHM module with the subscriptions.
+ * @param[in] sub_shm Notification subscription SHM.
+ * @param[out] lag_ids Sub IDs of the lagging subscribers.
+ * @param[out] lag_count Count of @p lag_ids.
+ * @param[out] bounded Whether all the lagging subscribers have bounded lag.
+ * @return err_info, NULL on success.
+ */
+static sr_error_info_t *
+sr_shmsub_notif_notify_lagging(sr_conn_ctx_t *conn, sr_mod_t *shm_mod, sr_sub_shm_t *sub_shm, uint32_t **lag_ids,
+        uint32_t *lag_count, int *bounded)
 {
-    sr_error_info_t *err_info = NULL, *cb_err_info = NULL;
-    const struct lys_module *ly_mod;
-    sr_mod_notif_sub_t *notif_subs;
-    char *notif_lyb = NULL, *data = NULL;
-    uint32_t notif_sub_count, notif_lyb_len, data_len = 0, request_id, i;
-    int lock_lost;
-    sr_cid_t sub_cid;
-    sr_sub_shm_t *sub_shm;
-    sr_shm_t shm_sub = SR_SHM_INITIALIZER, shm_data_sub = SR_SHM_INITIALIZER;
+    sr_error_info_t *err_info = NULL;
+    sr_mod_notif_sub_t *shm_subs;
+    uint32_t i, request_id;
+
+    *lag_ids = NULL;
+    *lag_count = 0;
+    *bounded = 0;
+
+    if (ATOMIC_LOAD_RELAXED(sub_shm->event) != SR_SUB_EV_NOTIF) {
+        /* no previous notification being processed */
+        return NULL;
+    }
+    request_id = ATOMIC_LOAD_RELAXED(sub_shm->request_id);
+
+    shm_subs = (sr_mod_notif_sub_t *)(conn->ext_shm.addr + shm_mod->notif_subs);
+    for (i = 0; i < shm_mod->notif_sub_count; ++i) {
+        if (!sr_conn_is_alive(shm_subs[i].cid) || ATOMIC_LOAD_RELAXED(shm_subs[i].suspended)) {
+            continue;
+        }
+
+        if (ATOMIC_LOAD_RELAXED(shm_subs[i].request_id) == request_id) {
+            /* processed */
+            continue;
+        } else if (shm_subs[i].start_request_id == request_id) {
+            /* sent before the subscription was added, it is never processed by it */
+            continue;
+        }
+
+        if (!*lag_ids) {
+            *lag_ids = malloc(shm_mod->notif_sub_count * sizeof **lag_ids);
+            SR_CHECK_MEM_RET(!*lag_ids, err_info);
+            *bounded = 1;
+        }
+        (*lag_ids)[(*lag_count)++] = shm_subs[i].sub_id;
+        if (!(shm_subs[i].opts & SR_SUBSCR_NOTIF_BOUNDED_LAG)) {
+            *bounded = 0;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Update statistics of notification subscribers that were lagging when an originator started waiting.
+ * Must be called with EXT READ lock.
+ *
+ * @param[in] conn Connection to use.
+ * @param[in] shm_mod SHM module with the subscriptions.
+ * @param[in] sub_shm Locked notification subscription SHM.
+ * @param[in] lag_ids Sub IDs of the lagging subscribers.
+ * @param[in] lag_count Count of @p lag_ids.
+ * @param[in] blocked_ms Time the originator was blocked.
+ */
+static void
+sr_shmsub_notif_notify_lagging_stats(sr_conn_ctx_t *conn, sr_mod_t *shm_mod, sr_sub_shm_t *sub_shm,
+        const uint32_t *lag_ids, uint32_t lag_count, uint32_t blocked_ms)
+{
+    sr_mod_notif_sub_t *shm_subs;
+    uint32_t i, j;
+    int dropped;
+
+    /* previous notification was not processed by everyone and will be overwritten */
+    dropped = (ATOMIC_LOAD_RELAXED(sub_shm->event) == SR_SUB_EV_NOTIF);
+
+    shm_subs = (sr_mod_notif_sub_t *)(conn->ext_shm.addr + shm_mod->notif_subs);
+    for (i = 0; i < shm_mod->notif_sub_count; ++i) {
+        for (j = 0; j < lag_count; ++j) {
+            if (shm_subs[i].sub_id == lag_ids[j]) {
+                break;
+            }
+        }
+        if (j == lag_count) {
+            continue;
+        }
+
+        ATOMIC_ADD_RELAXED(shm_subs[i].blocked_ms, blocked_ms);
+        if (dropped && (ATOMIC_LOAD_RELAXED(shm_subs[i].request_id) != ATOMIC_LOAD_RELAXED(sub_shm->request_id))) {
+            ATOMIC_INC_RELAXED(shm_subs[i].dropped);
+        }
+    }
+}
+
+sr_error_info_t *
+sr_shmsub_notif_notify(sr_conn_ctx_t *conn, const struct lyd_node *notif, struct timespec notif_ts_mono,
+        struct timespec notif_ts_real, const char *orig_name, const void *orig_data, uint32_t timeout_ms, int wait)
+{
+    sr_error_info_t *err_info = NULL, *cb_err_info = NULL;
+    const struct lys_module *ly_mod;
+    sr_mod_notif_sub_t *notif_subs;
+    sr_mod_t *shm_mod;
+    char *notif_lyb = NULL, *data = NULL;
+    uint32_t notif_sub_count, notif_lyb_len, data_len = 0, request_id, i, *lag_ids = NULL, lag_count = 0;
+    int lock_lost, bounded = 0;
+    sr_cid_t sub_cid;
+    sr_sub_shm_t *sub_shm;
+    struct sr_orig_shm_s *orig = NULL;
+    struct timespec wait_start, wait_end;
 
     assert(!notif->parent);
 
     ly_mod = lyd_owner_module(notif);
+    shm_mod = sr_shmmod_find_module(SR_CONN_MOD_SHM(conn), ly_mod->name);
+    SR_CHECK_INT_RET(!shm_mod, err_info);
 
     /* EXT READ LOCK */
     if ((err_info = sr_shmext_conn_remap_lock(conn, SR_LOCK_READ, 0, __func__))) {
@@ -2894,10 +3402,15 @@ sr_shmsub_notif_notify(sr_conn_ctx_t *conn, const struct lyd_node *notif, struct
     data_len += notif_lyb_len;
 
     /* open sub SHM and map it */
-    if ((err_info = sr_shmsub_open_map(ly_mod->name, "notif", -1, &shm_sub))) {
+    if ((err_info = sr_shmsub_orig_open_map(conn, ly_mod->name, "notif", -1, &orig))) {
+        goto cleanup_ext_unlock;
+    }
+    sub_shm = (sr_sub_shm_t *)orig->sub.addr;
+
+    /* learn whether we are going to wait only for subscribers with bounded lag */
+    if ((err_info = sr_shmsub_notif_notify_lagging(conn, shm_mod, sub_shm, &lag_ids, &lag_count, &bounded))) {
         goto cleanup_ext_unlock;
     }
-    sub_shm = (sr_sub_shm_t *)shm_sub.addr;
 
     /* EXT READ UNLOCK */
     sr_shmext_conn_remap_unlock(conn, SR_LOCK_READ, 0, __func__);
@@ -2905,9 +3418,12 @@ sr_shmsub_notif_notify(sr_conn_ctx_t *conn, const struct lyd_node *notif, struct
     /* do not wait for previous events with EXT lock */
 
     /* SUB WRITE LOCK */
-    if ((err_info = sr_shmsub_notify_new_wrlock(sub_shm, ly_mod->name, 0, conn->cid))) {
+    sr_timeouttime_get(&wait_start, 0);
+    if ((err_info = sr_shmsub_notify_new_wrlock(sub_shm, ly_mod->name, 0,
+            bounded ? SR_NOTIF_BOUNDED_LAG_TIMEOUT : SR_SUBSHM_LOCK_TIMEOUT, conn->cid))) {
         goto cleanup;
     }
+    sr_timeouttime_get(&wait_end, 0);
 
     /* EXT READ LOCK */
     if ((err_info = sr_shmext_conn_remap_lock(conn, SR_LOCK_READ, 0, __func__))) {
@@ -2920,15 +3436,21 @@ sr_shmsub_notif_notify(sr_conn_ctx_t *conn, const struct lyd_node *notif, struct
     }
     assert(notif_sub_count);
 
+    if (lag_count) {
+        /* account the waiting to the lagging subscribers */
+        sr_shmsub_notif_notify_lagging_stats(conn, shm_mod, sub_shm, lag_ids, lag_count,
+                sr_time_sub_ms(&wait_end, &wait_start));
+    }
+
     /* open sub data SHM */
-    if ((err_info = sr_shmsub_data_open_remap(ly_mod->name, "notif", -1, &shm_data_sub, 0))) {
+    if ((err_info = sr_shmsub_data_open_remap(ly_mod->name, "notif", -1, sub_shm, &orig->data[0], 0, 1))) {
         goto cleanup_ext_sub_unlock;
     }
 
     /* write the notification, use first subscriber CID if not waiting - depends on the subscriber, not originator */
     request_id = sub_shm->request_id + 1;
     if ((err_info = sr_shmsub_notify_write_event(sub_shm, wait ? conn->cid : sub_cid, request_id, 0, SR_SUB_EV_NOTIF,
-            orig_name, orig_data, notif_sub_count, &shm_data_sub, NULL, data, data_len, ly_mod->name))) {
+            orig_name, orig_data, notif_sub_count, &orig->data[0], NULL, data, data_len, ly_mod->name))) {
         goto cleanup_ext_sub_unlock;
     }
 
@@ -2954,7 +3476,7 @@ sr_shmsub_notif_notify(sr_conn_ctx_t *conn, const struct lyd_node *notif, struct
 
     if (wait) {
         /* wait until the event is processed */
-        if ((err_info = sr_shmsub_notify_wait_wr(sub_shm, SR_SUB_EV_NONE, 1, conn->cid, &shm_data_sub, timeout_ms,
+        if ((err_info = sr_shmsub_notify_wait_wr(sub_shm, SR_SUB_EV_NONE, 1, conn->cid, &orig->data[0], timeout_ms,
                 &lock_lost, &cb_err_info))) {
             if (lock_lost) {
                 goto cleanup;
@@ -2991,8 +3513,8 @@ cleanup_ext_unlock:
 cleanup:
     free(notif_lyb);
     free(data);
-    sr_shm_clear(&shm_sub);
-    sr_shm_clear(&shm_data_sub);
+    free(lag_ids);
+    sr_shmsub_orig_release(conn, orig);
     return err_info;
 }
 
@@ -3093,7 +3615,7 @@ sr_shmsub_listen_write_event(sr_sub_shm_t *sub_shm, uint32_t valid_subscr_count,
 
     if (data && data_len) {
         /* remap if needed */
-        if ((err_info = sr_shmsub_data_open_remap(NULL, NULL, -1, shm_data_sub, data_len))) {
+        if ((err_info = sr_shmsub_data_open_remap(NULL, NULL, -1, sub_shm, shm_data_sub, data_len, 1))) {
             return err_info;
         }
 
@@ -3288,7 +3810,7 @@ sr_shmsub_change_listen_process_module_events(struct modsub_change_s *change_sub
     sr_error_t err_code = SR_ERR_OK;
     struct modsub_changesub_s *change_sub;
     sr_sub_shm_t *sub_shm;
-    sr_shm_t shm_data_sub = SR_SHM_INITIALIZER;
+    sr_shm_t *shm_data_sub = &change_subs->sub_data_shm;
     sr_session_ctx_t *ev_sess = NULL;
     struct info_sub_s sub_info;
 
@@ -3322,10 +3844,11 @@ sr_shmsub_change_listen_process_module_events(struct modsub_change_s *change_sub
     }
 
     /* open sub data SHM */
-    if ((err_info = sr_shmsub_data_open_remap(change_subs->module_name, sr_ds2str(change_subs->ds), -1, &shm_data_sub, 0))) {
+    if ((err_info = sr_shmsub_data_open_remap(change_subs->module_name, sr_ds2str(change_subs->ds), -1, sub_shm,
+            shm_data_sub, 0, 1))) {
         goto cleanup;
     }
-    shm_data_ptr = shm_data_sub.addr;
+    shm_data_ptr = shm_data_sub->addr;
 
     /* remember subscription info in SHM */
     sub_info.event = ATOMIC_LOAD_RELAXED(sub_shm->event);
@@ -3333,9 +3856,10 @@ sr_shmsub_change_listen_process_module_events(struct modsub_change_s *change_sub
     sub_info.priority = ATOMIC_LOAD_RELAXED(sub_shm->priority);
 
     /* parse originator name and data (while creating the event session) */
-    if ((err_info = _sr_session_start(conn, change_subs->ds, sub_info.event, &shm_data_ptr, &ev_sess))) {
+    if ((err_info = sr_ev_session_start(conn, change_subs->ds, sub_info.event, &shm_data_ptr, &ev_sess))) {
         goto cleanup;
     }
+    ev_sess->ev_data.data_version = sub_shm->data_version;
 
     /* parse event diff */
     if ((err_info = sr_lyd_parse_data(conn->ly_ctx, shm_data_ptr, NULL, LYD_LYB,
@@ -3463,7 +3987,7 @@ process_event:
     sub_lock = SR_LOCK_WRITE_URGE;
 
     /* finish event */
-    if ((err_info = sr_shmsub_listen_write_event(sub_shm, valid_subscr_count, err_code, &shm_data_sub, data,
+    if ((err_info = sr_shmsub_listen_write_event(sub_shm, valid_subscr_count, err_code, shm_data_sub, data,
             data_len, change_subs->module_name, err_code ? "fail" : "success"))) {
         goto cleanup;
     }
@@ -3475,8 +3999,7 @@ cleanup:
     }
 
     free(data);
-    sr_session_stop(ev_sess);
-    sr_shm_clear(&shm_data_sub);
+    sr_ev_session_stop(ev_sess);
     return err_info;
 }
 
@@ -3531,12 +4054,13 @@ sr_shmsub_oper_get_listen_process_module_events(struct modsub_operget_s *oper_ge
     struct modsub_opergetsub_s *oper_get_sub;
     struct lyd_node *parent = NULL, *orig_parent, *node;
     sr_sub_shm_t *sub_shm;
-    sr_shm_t shm_data_sub = SR_SHM_INITIALIZER;
+    sr_shm_t *shm_data_sub;
     sr_session_ctx_t *ev_sess = NULL;
 
     for (i = 0; (err_code == SR_ERR_OK) && (i < oper_get_subs->sub_count); ++i) {
         oper_get_sub = &oper_get_subs->subs[i];
         sub_shm = (sr_sub_shm_t *)oper_get_sub->sub_shm.addr;
+        shm_data_sub = &oper_get_sub->sub_data_shm;
 
         /* do not process events for suspended subscriptions */
         if (ATOMIC_LOAD_RELAXED(oper_get_sub->suspended)) {
@@ -3566,13 +4090,13 @@ sr_shmsub_oper_get_listen_process_module_events(struct modsub_operget_s *oper_ge
 
         /* open sub data SHM */
         if ((err_info = sr_shmsub_data_open_remap(oper_get_subs->module_name, "oper", sr_str_hash(oper_get_sub->path,
-                oper_get_sub->priority), &shm_data_sub, 0))) {
+                oper_get_sub->priority), sub_shm, shm_data_sub, 0, 1))) {
             goto error_rdunlock;
         }
-        shm_data_ptr = shm_data_sub.addr;
+        shm_data_ptr = shm_data_sub->addr;
 
         /* parse originator name and data (while creating the event session) */
-        if ((err_info = _sr_session_start(conn, SR_DS_OPERATIONAL, SR_SUB_EV_CHANGE, &shm_data_ptr, &ev_sess))) {
+        if ((err_info = sr_ev_session_start(conn, SR_DS_OPERATIONAL, SR_SUB_EV_CHANGE, &shm_data_ptr, &ev_sess))) {
             goto error_rdunlock;
         }
 
@@ -3651,7 +4175,7 @@ sr_shmsub_oper_get_listen_process_module_events(struct modsub_operget_s *oper_ge
         }
 
         /* finish event */
-        if ((err_info = sr_shmsub_listen_write_event(sub_shm, 1, err_code, &shm_data_sub, data, data_len,
+        if ((err_info = sr_shmsub_listen_write_event(sub_shm, 1, err_code, shm_data_sub, data, data_len,
                 oper_get_sub->path, err_code ? "fail" : "success"))) {
             goto error_wrunlock;
         }
@@ -3661,7 +4185,7 @@ sr_shmsub_oper_get_listen_process_module_events(struct modsub_operget_s *oper_ge
 
 next_iter:
         /* next iteration */
-        sr_session_stop(ev_sess);
+        sr_ev_session_stop(ev_sess);
         ev_sess = NULL;
         free(request_xpath);
         request_xpath = NULL;
@@ -3669,7 +4193,6 @@ next_iter:
         data = NULL;
         lyd_free_all(parent);
         parent = NULL;
-        sr_shm_clear(&shm_data_sub);
     }
 
     /* success */
@@ -3685,11 +4208,10 @@ error_rdunlock:
     sr_rwunlock(&sub_shm->lock, SR_SUBSHM_LOCK_TIMEOUT, SR_LOCK_READ, conn->cid, __func__);
 
 error:
-    sr_session_stop(ev_sess);
+    sr_ev_session_stop(ev_sess);
     free(data);
     lyd_free_all(parent);
     free(request_xpath);
-    sr_shm_clear(&shm_data_sub);
     return err_info;
 }
 
@@ -3758,24 +4280,24 @@ cleanup:
 /**
  * @brief Check whether particular cached data are still valid.
  *
- * @param[in] cache Cached data to check.
+ * @param[in] timestamp Timestamp of the cached data to check.
  * @param[in] valid_ms Validity period of the data.
  * @param[out] invalid_in Optional relative time when the cache will become invalid, set only if valid.
  * @return Whether the cache data are valid or not.
  */
 static int
-sr_shmsub_oper_poll_listen_is_cache_valid(const struct sr_oper_poll_cache_s *cache, uint32_t valid_ms,
+sr_shmsub_oper_poll_listen_is_cache_valid(const struct timespec *timestamp, uint32_t valid_ms,
         struct timespec *invalid_in)
 {
     struct timespec cur_ts, timeout_ts;
 
-    if (!cache->timestamp.tv_sec) {
+    if (!timestamp->tv_sec) {
         /* uninitialized */
         return 0;
     }
 
     sr_realtime_get(&cur_ts);
-    timeout_ts = sr_time_ts_add(&cache->timestamp, valid_ms);
+    timeout_ts = sr_time_ts_add(timestamp, valid_ms);
     if (sr_time_cmp(&timeout_ts, &cur_ts) <= 0) {
         /* not valid */
         return 0;
@@ -3788,6 +4310,172 @@ sr_shmsub_oper_poll_listen_is_cache_valid(const struct sr_oper_poll_cache_s *cac
     return 1;
 }
 
+/**
+ * @brief Publish data of an operational poll cache in its SHM so that all the connections can use them.
+ *
+ * @param[in] conn Connection to use.
+ * @param[in] name Module name.
+ * @param[in] path Operational poll subscription path.
+ * @param[in] data Cached data to publish.
+ * @param[in] timestamp Timestamp of @p data, NULL to invalidate any published data.
+ * @param[in] valid_ms Validity period of @p data.
+ * @param[out] generation Generation of the published data, 0 if not published.
+ * @return err_info, NULL on success.
+ */
+static sr_error_info_t *
+sr_shmsub_oper_poll_cache_publish(sr_conn_ctx_t *conn, const char *name, const char *path, const struct lyd_node *data,
+        const struct timespec *timestamp, uint32_t valid_ms, uint32_t *generation)
+{
+    sr_error_info_t *err_info = NULL;
+    sr_shm_t shm_sub = SR_SHM_INITIALIZER, shm_data_sub = SR_SHM_INITIALIZER;
+    sr_oper_poll_cache_shm_t *cache_shm;
+    char *data_lyb = NULL;
+    uint32_t data_lyb_len = 0;
+
+    *generation = 0;
+
+    if (timestamp && data) {
+        /* print the data into LYB */
+        if ((err_info = sr_lyd_print_data(data, LYD_LYB, 0, -1, &data_lyb, &data_lyb_len))) {
+            goto cleanup;
+        }
+    }
+
+    /* open the cache SHM, it does not exist if the subscription is just being removed */
+    if ((err_info = sr_shmsub_open_map(name, "poll", sr_str_hash(path, 0), &shm_sub))) {
+        sr_errinfo_free(&err_info);
+        goto cleanup;
+    }
+    cache_shm = (sr_oper_poll_cache_shm_t *)shm_sub.addr;
+
+    /* SUB WRITE LOCK */
+    if ((err_info = sr_rwlock(&cache_shm->sub.lock, SR_SUBSHM_LOCK_TIMEOUT, SR_LOCK_WRITE, conn->cid, __func__,
+            NULL, NULL))) {
+        goto cleanup;
+    }
+
+    if (!timestamp) {
+        /* invalidate */
+        memset(&cache_shm->timestamp, 0, sizeof cache_shm->timestamp);
+        cache_shm->data_len = 0;
+        goto cleanup_unlock;
+    }
+
+    if (data_lyb_len) {
+        /* open the data SHM and grow it if needed */
+        if ((err_info = sr_shmsub_data_open_remap(name, "poll", sr_str_hash(path, 0), &cache_shm->sub, &shm_data_sub,
+                data_lyb_len, 0))) {
+            goto cleanup_unlock;
+        }
+        memcpy(shm_data_sub.addr, data_lyb, data_lyb_len);
+    }
+
+    /* update the cache */
+    cache_shm->timestamp = *timestamp;
+    cache_shm->valid_ms = valid_ms;
+    cache_shm->data_len = data_lyb_len;
+    if (!++cache_shm->generation) {
+        /* 0 means no data */
+        ++cache_shm->generation;
+    }
+    *generation = cache_shm->generation;
+
+cleanup_unlock:
+    /* SUB WRITE UNLOCK */
+    sr_rwunlock(&cache_shm->sub.lock, 0, SR_LOCK_WRITE, conn->cid, __func__);
+
+cleanup:
+    free(data_lyb);
+    sr_shm_clear(&shm_sub);
+    sr_shm_clear(&shm_data_sub);
+    return err_info;
+}
+
+sr_error_info_t *
+sr_shmsub_oper_poll_cache_get(sr_conn_ctx_t *conn, const char *name, const char *path, uint32_t known_gen,
+        struct lyd_node **data, struct timespec *timestamp, uint32_t *generation)
+{
+    sr_error_info_t *err_info = NULL;
+    sr_shm_t shm_sub = SR_SHM_INITIALIZER, shm_data_sub = SR_SHM_INITIALIZER;
+    sr_oper_poll_cache_shm_t *cache_shm;
+    uint32_t drop_gen = 0;
+
+    *data = NULL;
+    *generation = 0;
+
+    /* open the cache SHM, it does not exist if the subscription is just being removed */
+    if ((err_info = sr_shmsub_open_map(name, "poll", sr_str_hash(path, 0), &shm_sub))) {
+        sr_errinfo_free(&err_info);
+        goto cleanup;
+    }
+    cache_shm = (sr_oper_poll_cache_shm_t *)shm_sub.addr;
+
+    /* SUB READ LOCK */
+    if ((err_info = sr_rwlock(&cache_shm->sub.lock, SR_SUBSHM_LOCK_TIMEOUT, SR_LOCK_READ, conn->cid, __func__,
+            NULL, NULL))) {
+        goto cleanup;
+    }
+
+    if (!sr_shmsub_oper_poll_listen_is_cache_valid(&cache_shm->timestamp, cache_shm->valid_ms, NULL)) {
+        /* no valid data */
+        goto cleanup_unlock;
+    }
+    if (timestamp) {
+        *timestamp = cache_shm->timestamp;
+    }
+    if (cache_shm->generation == known_gen) {
+        /* caller already has these data */
+        *generation = known_gen;
+        goto cleanup_unlock;
+    }
+
+    if (cache_shm->data_len) {
+        /* open and map the data SHM */
+        if ((err_info = sr_shmsub_data_open_remap(name, "poll", sr_str_hash(path, 0), &cache_shm->sub, &shm_data_sub,
+                0, 0))) {
+            goto cleanup_unlock;
+        }
+
+        /* parse the data */
+        if ((err_info = sr_lyd_parse_data(conn->ly_ctx, shm_data_sub.addr, NULL, LYD_LYB,
+                LYD_PARSE_STORE_ONLY | LYD_PARSE_STRICT, 0, data))) {
+            /* unusable data (printed with a different context, for example), drop them as if there were none */
+            SR_LOG_WRN("Dropping operational poll cache data of \"%s\" \"%s\" (%s).", name, path,
+                    err_info->err[err_info->err_count - 1].message);
+            sr_errinfo_free(&err_info);
+            drop_gen = cache_shm->generation;
+            goto cleanup_unlock;
+        }
+    }
+    *generation = cache_shm->generation;
+
+cleanup_unlock:
+    /* SUB READ UNLOCK */
+    sr_rwunlock(&cache_shm->sub.lock, SR_SUBSHM_LOCK_TIMEOUT, SR_LOCK_READ, conn->cid, __func__);
+
+    if (drop_gen) {
+        /* SUB WRITE LOCK */
+        if ((err_info = sr_rwlock(&cache_shm->sub.lock, SR_SUBSHM_LOCK_TIMEOUT, SR_LOCK_WRITE, conn->cid, __func__,
+                NULL, NULL))) {
+            goto cleanup;
+        }
+
+        if (cache_shm->generation == drop_gen) {
+            /* invalidate, unless the data were updated meanwhile */
+            memset(&cache_shm->timestamp, 0, sizeof cache_shm->timestamp);
+            cache_shm->data_len = 0;
+        }
+
+        /* SUB WRITE UNLOCK */
+        sr_rwunlock(&cache_shm->sub.lock, 0, SR_LOCK_WRITE, conn->cid, __func__);
+    }
+
+cleanup:
+    sr_shm_clear(&shm_sub);
+    sr_shm_clear(&shm_data_sub);
+    return err_info;
+}
+
 sr_error_info_t *
 sr_shmsub_oper_poll_listen_process_module_events(struct modsub_operpoll_s *oper_poll_subs, sr_conn_ctx_t *conn,
         struct timespec *wake_up_in)
@@ -3800,7 +4488,9 @@ sr_shmsub_oper_poll_listen_process_module_events(struct modsub_operpoll_s *oper_
     sr_lock_mode_t change_sub_lock = SR_LOCK_NONE;
     struct sr_oper_poll_cache_s *cache;
     struct modsub_operpollsub_s *oper_poll_sub;
-    struct timespec invalid_in;
+    struct lyd_node *new_data = NULL;
+    struct timespec invalid_in, new_ts;
+    uint32_t shared_gen;
     int found;
     sr_session_ctx_t *ev_sess = NULL;
     sr_get_options_t get_opts;
@@ -3865,13 +4555,20 @@ sr_shmsub_oper_poll_listen_process_module_events(struct modsub_operpoll_s *oper_
             lyd_free_siblings(cache->data);
             cache->data = NULL;
             memset(&cache->timestamp, 0, sizeof cache->timestamp);
+            cache->generation = 0;
+
+            /* invalidate the shared cache as well */
+            if ((err_info = sr_shmsub_oper_poll_cache_publish(conn, oper_poll_subs->module_name, oper_poll_sub->path,
+                    NULL, NULL, 0, &shared_gen))) {
+                goto finish_iter;
+            }
 
             SR_LOG_INF("No oper get subscription \"%s\" to cache.", oper_poll_sub->path);
             goto finish_iter;
         }
 
         /* 2) check cache validity */
-        if (sr_shmsub_oper_poll_listen_is_cache_valid(cache, oper_poll_sub->valid_ms, &invalid_in)) {
+        if (sr_shmsub_oper_poll_listen_is_cache_valid(&cache->timestamp, oper_poll_sub->valid_ms, &invalid_in)) {
             /* update when to wake up */
             if (wake_up_in && (!wake_up_in->tv_sec || (sr_time_cmp(&invalid_in, wake_up_in) < 0))) {
                 *wake_up_in = invalid_in;
@@ -3879,27 +4576,50 @@ sr_shmsub_oper_poll_listen_process_module_events(struct modsub_operpoll_s *oper_
             goto finish_iter;
         }
 
-        /* create a session */
-        if ((err_info = _sr_session_start(conn, SR_DS_OPERATIONAL, SR_SUB_EV_NONE, NULL, &ev_sess))) {
+        /* 3) check whether another connection has not cached valid data meanwhile */
+        if ((err_info = sr_shmsub_oper_poll_cache_get(conn, oper_poll_subs->module_name, oper_poll_sub->path,
+                cache->generation, &new_data, &new_ts, &shared_gen))) {
             goto finish_iter;
         }
+        if (shared_gen && (shared_gen != cache->generation) &&
+                sr_shmsub_oper_poll_listen_is_cache_valid(&new_ts, oper_poll_sub->valid_ms, &invalid_in)) {
+            /* use the shared data */
+            SR_LOG_DBG("Using \"%s\" \"oper poll\" data cached by another connection.", oper_poll_sub->path);
+        } else {
+            lyd_free_siblings(new_data);
+            new_data = NULL;
+            shared_gen = 0;
 
-        /* get the data, API function */
-        get_opts = SR_OPER_NO_STORED | SR_OPER_NO_POLL_CACHED | SR_OPER_WITH_ORIGIN;
-        if (sr_get_data(ev_sess, oper_poll_sub->path, 0, 0, get_opts, &data)) {
-            err_info = ev_sess->err_info;
-            ev_sess->err_info = NULL;
-        }
-        sr_session_stop(ev_sess);
-        if (err_info) {
-            goto finish_iter;
+            /* create a session */
+            if ((err_info = sr_ev_session_start(conn, SR_DS_OPERATIONAL, SR_SUB_EV_NONE, NULL, &ev_sess))) {
+                goto finish_iter;
+            }
+
+            /* get the data, API function */
+            get_opts = SR_OPER_NO_STORED | SR_OPER_NO_POLL_CACHED | SR_OPER_WITH_ORIGIN;
+            if (sr_get_data(ev_sess, oper_poll_sub->path, 0, 0, get_opts, &data)) {
+                err_info = ev_sess->err_info;
+                ev_sess->err_info = NULL;
+            }
+            sr_ev_session_stop(ev_sess);
+            if (err_info) {
+                goto finish_iter;
+            }
+            if (data) {
+                new_data = data->tree;
+                data->tree = NULL;
+            }
+            sr_release_data(data);
+            data = NULL;
+            sr_realtime_get(&new_ts);
+            invalid_in = sr_time_ts_add(NULL, oper_poll_sub->valid_ms);
         }
 
         /* generate diff if supported */
         if (oper_poll_sub->opts & SR_SUBSCR_OPER_POLL_DIFF) {
             /* prepare mod info */
             mod_info.data = cache->data;
-            if ((err_info = sr_lyd_diff_siblings(cache->data, data->tree, LYD_DIFF_DEFAULTS, &mod_info.diff))) {
+            if ((err_info = sr_lyd_diff_siblings(cache->data, new_data, LYD_DIFF_DEFAULTS, &mod_info.diff))) {
                 goto finish_iter;
             }
 
@@ -3921,16 +4641,22 @@ sr_shmsub_oper_poll_listen_process_module_events(struct modsub_operpoll_s *oper_
 
         /* store in cache and update the timestamp */
         lyd_free_siblings(cache->data);
-        cache->data = mod_info.data = NULL;
-        if (data) {
-            cache->data = mod_info.data = data->tree;
-            data->tree = NULL;
+        cache->data = mod_info.data = new_data;
+        new_data = NULL;
+        cache->timestamp = new_ts;
+
+        if (shared_gen) {
+            /* the data are already shared */
+            cache->generation = shared_gen;
+        } else {
+            /* share the data with the other connections */
+            if ((err_info = sr_shmsub_oper_poll_cache_publish(conn, oper_poll_subs->module_name, oper_poll_sub->path,
+                    cache->data, &cache->timestamp, oper_poll_sub->valid_ms, &cache->generation))) {
+                goto finish_iter;
+            }
         }
-        sr_release_data(data);
-        sr_realtime_get(&cache->timestamp);
 
         /* update when to wake up */
-        invalid_in = sr_time_ts_add(NULL, oper_poll_sub->valid_ms);
         if (wake_up_in && (!wake_up_in->tv_sec || (sr_time_cmp(&invalid_in, wake_up_in) < 0))) {
             *wake_up_in = invalid_in;
         }
@@ -3938,6 +4664,9 @@ sr_shmsub_oper_poll_listen_process_module_events(struct modsub_operpoll_s *oper_
         SR_LOG_DBG("Successful \"%s\" \"oper poll\" cache update.", oper_poll_sub->path);
 
 finish_iter:
+        lyd_free_siblings(new_data);
+        new_data = NULL;
+
         /* CACHE DATA WRITE UNLOCK */
         sr_rwunlock(&cache->data_lock, SR_CONN_OPER_CACHE_DATA_LOCK_TIMEOUT, SR_LOCK_WRITE, conn->cid, __func__);
 
@@ -4164,11 +4893,12 @@ cleanup:
  *
  * @param[in] sub_shm SHM to read from.
  * @param[in] sub Current subscription.
+ * @param[in] slot RPC subscription SHM slot of @p sub_shm.
  * @return 0 if not.
  * @return non-zero if this is a new event for the subscription.
  */
 static int
-sr_shmsub_rpc_listen_is_new_event(sr_sub_shm_t *sub_shm, struct opsub_rpcsub_s *sub)
+sr_shmsub_rpc_listen_is_new_event(sr_sub_shm_t *sub_shm, struct opsub_rpcsub_s *sub, uint32_t slot)
 {
     sr_sub_event_t event = ATOMIC_LOAD_RELAXED(sub_shm->event);
     uint32_t request_id = ATOMIC_LOAD_RELAXED(sub_shm->request_id);
@@ -4180,11 +4910,11 @@ sr_shmsub_rpc_listen_is_new_event(sr_sub_shm_t *sub_shm, struct opsub_rpcsub_s *
     }
 
     /* new event and request ID */
-    if ((request_id == ATOMIC_LOAD_RELAXED(sub->request_id)) && (event == ATOMIC_LOAD_RELAXED(sub->event))) {
+    if ((request_id == ATOMIC_LOAD_RELAXED(sub->request_id[slot])) && (event == ATOMIC_LOAD_RELAXED(sub->event[slot]))) {
         return 0;
     }
-    if ((event == SR_SUB_EV_ABORT) && ((ATOMIC_LOAD_RELAXED(sub->event) != SR_SUB_EV_RPC) ||
-            (ATOMIC_LOAD_RELAXED(sub->request_id) != request_id))) {
+    if ((event == SR_SUB_EV_ABORT) && ((ATOMIC_LOAD_RELAXED(sub->event[slot]) != SR_SUB_EV_RPC) ||
+            (ATOMIC_LOAD_RELAXED(sub->request_id[slot]) != request_id))) {
         /* process "abort" only on subscriptions that have successfully processed "RPC" */
         return 0;
     }
@@ -4268,26 +4998,34 @@ sr_shmsub_rpc_listen_relock(sr_sub_shm_t *sub_shm, sr_lock_mode_t mode, struct i
     return 0;
 }
 
-sr_error_info_t *
-sr_shmsub_rpc_listen_process_rpc_events(struct opsub_rpc_s *rpc_subs, sr_conn_ctx_t *conn)
+/**
+ * @brief Process an RPC event in a single slot of the RPC subscription SHM.
+ *
+ * @param[in] rpc_subs RPC/action subscriptions.
+ * @param[in] slot RPC subscription SHM slot.
+ * @param[in] conn Connection to use.
+ * @return err_info, NULL on success.
+ */
+static sr_error_info_t *
+sr_shmsub_rpc_listen_process_slot(struct opsub_rpc_s *rpc_subs, uint32_t slot, sr_conn_ctx_t *conn)
 {
     sr_error_info_t *err_info = NULL;
     uint32_t i, data_len = 0, valid_subscr_count;
-    char *data = NULL, *module_name = NULL, *shm_data_ptr;
+    char *data = NULL, *module_name = NULL, *shm_data_ptr, buf[16];
     sr_lock_mode_t sub_lock = SR_LOCK_NONE;
     struct lyd_node *input = NULL, *input_op, *output = NULL;
     sr_error_t err_code = SR_ERR_OK, ret;
     struct opsub_rpcsub_s *rpc_sub = NULL;
     sr_sub_shm_t *sub_shm;
-    sr_shm_t shm_data_sub = SR_SHM_INITIALIZER;
+    sr_shm_t *shm_data_sub = &rpc_subs->sub_data_shm[slot];
     sr_session_ctx_t *ev_sess = NULL;
     struct info_sub_s sub_info;
 
-    sub_shm = (sr_sub_shm_t *)rpc_subs->sub_shm.addr;
+    sub_shm = &((sr_rpc_sub_shm_t *)rpc_subs->sub_shm.addr)->slot[slot];
 
     for (i = 0; i < rpc_subs->sub_count; ++i) {
         rpc_sub = &rpc_subs->subs[i];
-        if (!sr_shmsub_rpc_listen_is_new_event(sub_shm, rpc_sub)) {
+        if (!sr_shmsub_rpc_listen_is_new_event(sub_shm, rpc_sub, slot)) {
             /* no new event */
             continue;
         }
@@ -4302,7 +5040,7 @@ sr_shmsub_rpc_listen_process_rpc_events(struct opsub_rpc_s *rpc_subs, sr_conn_ct
         }
 
         /* recheck new event with lock */
-        if (!sr_shmsub_rpc_listen_is_new_event(sub_shm, rpc_sub)) {
+        if (!sr_shmsub_rpc_listen_is_new_event(sub_shm, rpc_sub, slot)) {
             continue;
         }
 
@@ -4310,14 +5048,14 @@ sr_shmsub_rpc_listen_process_rpc_events(struct opsub_rpc_s *rpc_subs, sr_conn_ct
         if (!ev_sess) {
             /* open sub data SHM */
             module_name = sr_get_first_ns(rpc_subs->path);
-            if ((err_info = sr_shmsub_data_open_remap(module_name, "rpc", sr_str_hash(rpc_subs->path, 0),
-                    &shm_data_sub, 0))) {
+            if ((err_info = sr_shmsub_data_open_remap(module_name, sr_shmsub_rpc_slot_suffix(slot, buf, sizeof buf),
+                    sr_str_hash(rpc_subs->path, 0), sub_shm, shm_data_sub, 0, 1))) {
                 goto cleanup;
             }
-            shm_data_ptr = shm_data_sub.addr;
+            shm_data_ptr = shm_data_sub->addr;
 
             /* parse originator name and data (while creating the event session) */
-            if ((err_info = _sr_session_start(conn, SR_DS_OPERATIONAL, SR_SUB_EV_RPC, &shm_data_ptr, &ev_sess))) {
+            if ((err_info = sr_ev_session_start(conn, SR_DS_OPERATIONAL, SR_SUB_EV_RPC, &shm_data_ptr, &ev_sess))) {
                 goto cleanup;
             }
 
@@ -4361,7 +5099,7 @@ sr_shmsub_rpc_listen_process_rpc_events(struct opsub_rpc_s *rpc_subs, sr_conn_ct
 
     for ( ; i < rpc_subs->sub_count; ++i) {
         rpc_sub = &rpc_subs->subs[i];
-        if (!sr_shmsub_rpc_listen_is_new_event(sub_shm, rpc_sub) ||
+        if (!sr_shmsub_rpc_listen_is_new_event(sub_shm, rpc_sub, slot) ||
                 !sr_shmsub_rpc_listen_filter_is_valid(input, rpc_sub->xpath)) {
             continue;
         }
@@ -4400,8 +5138,8 @@ process_event:
                 err_code = ret;
 
                 /* remember request ID and "abort" event so that we do not process it */
-                ATOMIC_STORE_RELAXED(rpc_sub->request_id, ATOMIC_LOAD_RELAXED(sub_shm->request_id));
-                ATOMIC_STORE_RELAXED(rpc_sub->event, SR_SUB_EV_ABORT);
+                ATOMIC_STORE_RELAXED(rpc_sub->request_id[slot], ATOMIC_LOAD_RELAXED(sub_shm->request_id));
+                ATOMIC_STORE_RELAXED(rpc_sub->event[slot], SR_SUB_EV_ABORT);
                 break;
             }
         }
@@ -4410,8 +5148,8 @@ process_event:
         ++valid_subscr_count;
 
         /* remember request ID and event so that we do not process it again */
-        ATOMIC_STORE_RELAXED(rpc_sub->request_id, ATOMIC_LOAD_RELAXED(sub_shm->request_id));
-        ATOMIC_STORE_RELAXED(rpc_sub->event, ATOMIC_LOAD_RELAXED(sub_shm->event));
+        ATOMIC_STORE_RELAXED(rpc_sub->request_id[slot], ATOMIC_LOAD_RELAXED(sub_shm->request_id));
+        ATOMIC_STORE_RELAXED(rpc_sub->event[slot], ATOMIC_LOAD_RELAXED(sub_shm->event));
     }
 
     /*
@@ -4439,7 +5177,7 @@ process_event:
     sub_lock = SR_LOCK_WRITE_URGE;
 
     /* finish event */
-    if ((err_info = sr_shmsub_listen_write_event(sub_shm, valid_subscr_count, err_code, &shm_data_sub, data,
+    if ((err_info = sr_shmsub_listen_write_event(sub_shm, valid_subscr_count, err_code, shm_data_sub, data,
             data_len, rpc_subs->path, err_code ? "fail" : "success"))) {
         goto cleanup;
     }
@@ -4450,12 +5188,341 @@ cleanup:
         sr_rwunlock(&sub_shm->lock, SR_SUBSHM_LOCK_TIMEOUT, sub_lock, conn->cid, __func__);
     }
 
-    sr_session_stop(ev_sess);
+    sr_ev_session_stop(ev_sess);
     free(module_name);
     free(data);
     lyd_free_all(input);
     lyd_free_all(output);
-    sr_shm_clear(&shm_data_sub);
+    return err_info;
+}
+
+/**
+ * @brief Worker threads of an RPC/action subscription processing its pipelined RPC slots.
+ *
+ * Every slot is processed by one worker at a time and the worker re-arms it when a new request was written
+ * into it meanwhile, independently of the other slots and of the listener. The workers may outlive the RPC/action
+ * subscription, the last one frees this structure after it was stopped.
+ */
+struct sr_shmsub_rpc_workers_s {
+    pthread_mutex_t lock;           /**< Lock for accessing the worker attributes. */
+    sr_cond_t cond;                 /**< Condition variable for waiting on pending slots. */
+    sr_subscription_ctx_t *subscr;  /**< Subscription structure of the RPC/action subscription. */
+    uint32_t thread_count;          /**< Running worker thread count. */
+    uint32_t idle_count;            /**< Worker threads waiting for a pending slot. */
+    int stop;                       /**< Whether the worker threads should exit. */
+    uint32_t pending;               /**< Bitmask of slots with a new request to be processed. */
+    uint32_t busy;                  /**< Bitmask of slots being processed by a worker. */
+};
+
+/**
+ * @brief Check whether there is a new event in an RPC subscription SHM slot for any of the subscriptions.
+ *
+ * @param[in] rpc_subs RPC/action subscriptions.
+ * @param[in] slot RPC subscription SHM slot.
+ * @return Whether there is a new event.
+ */
+static int
+sr_shmsub_rpc_listen_slot_is_new_event(struct opsub_rpc_s *rpc_subs, uint32_t slot)
+{
+    sr_rpc_sub_shm_t *rpc_shm = (sr_rpc_sub_shm_t *)rpc_subs->sub_shm.addr;
+    uint32_t i;
+
+    for (i = 0; i < rpc_subs->sub_count; ++i) {
+        if (sr_shmsub_rpc_listen_is_new_event(&rpc_shm->slot[slot], &rpc_subs->subs[i], slot)) {
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Process a pipelined RPC slot taken by a worker and re-arm it if there is a new request in it.
+ *
+ * @param[in] workers RPC subscription workers.
+ * @param[in] slot RPC subscription SHM slot marked busy.
+ */
+static void
+sr_shmsub_rpc_workers_process_slot(struct sr_shmsub_rpc_workers_s *workers, uint32_t slot)
+{
+    sr_error_info_t *err_info = NULL;
+    sr_subscription_ctx_t *subscr = workers->subscr;
+    struct opsub_rpc_s *rpc_subs = NULL;
+    sr_lock_mode_t subs_lock = SR_LOCK_NONE;
+    uint32_t i;
+    int stop;
+
+    /* SUBS READ LOCK */
+    if ((err_info = sr_rwlock(&subscr->subs_lock, SR_SUBSCR_LOCK_TIMEOUT, SR_LOCK_READ, subscr->conn->cid, __func__,
+            NULL, NULL))) {
+        goto cleanup;
+    }
+    subs_lock = SR_LOCK_READ;
+
+    /* WORKERS LOCK */
+    pthread_mutex_lock(&workers->lock);
+    stop = workers->stop;
+    /* WORKERS UNLOCK */
+    pthread_mutex_unlock(&workers->lock);
+
+    if (stop) {
+        /* the RPC/action subscription was removed */
+        goto cleanup;
+    }
+
+    /* find the RPC/action subscription, it may have been moved */
+    for (i = 0; i < subscr->rpc_sub_count; ++i) {
+        if (subscr->rpc_subs[i].workers == workers) {
+            rpc_subs = &subscr->rpc_subs[i];
+            break;
+        }
+    }
+    SR_CHECK_INT_GOTO(!rpc_subs, err_info, cleanup);
+
+    /* CONTEXT LOCK */
+    if ((err_info = sr_lycc_lock(subscr->conn, SR_LOCK_READ, 0, __func__))) {
+        goto cleanup;
+    }
+
+    err_info = sr_shmsub_rpc_listen_process_slot(rpc_subs, slot, subscr->conn);
+
+    /* CONTEXT UNLOCK */
+    sr_lycc_unlock(subscr->conn, SR_LOCK_READ, 0, __func__);
+
+cleanup:
+    /* WORKERS LOCK */
+    pthread_mutex_lock(&workers->lock);
+
+    workers->busy &= ~(1U << slot);
+    if (rpc_subs && !workers->stop && sr_shmsub_rpc_listen_slot_is_new_event(rpc_subs, slot)) {
+        /* a new request was written into the slot while it was being processed, the listener skipped it */
+        workers->pending |= 1U << slot;
+    }
+
+    /* WORKERS UNLOCK */
+    pthread_mutex_unlock(&workers->lock);
+
+    if (subs_lock) {
+        /* SUBS READ UNLOCK */
+        sr_rwunlock(&subscr->subs_lock, SR_SUBSCR_LOCK_TIMEOUT, SR_LOCK_READ, subscr->conn->cid, __func__);
+    }
+
+    /* errors were already printed */
+    sr_errinfo_free(&err_info);
+}
+
+/**
+ * @brief Worker thread of an RPC/action subscription processing pipelined RPC slots.
+ *
+ * @param[in] arg RPC subscription workers.
+ * @return Always NULL.
+ */
+static void *
+sr_shmsub_rpc_workers_thread(void *arg)
+{
+    struct sr_shmsub_rpc_workers_s *workers = arg;
+    sr_subscription_ctx_t *subscr = workers->subscr;
+    uint32_t slot;
+    int last;
+
+    /* only subscription callbacks are called by this thread */
+    ++sr_ev_thread_depth;
+
+    /* WORKERS LOCK */
+    pthread_mutex_lock(&workers->lock);
+
+    while (1) {
+        ++workers->idle_count;
+        while (!workers->pending && !workers->stop) {
+            /* COND WAIT */
+            sr_cond_wait(&workers->cond, &workers->lock);
+        }
+        --workers->idle_count;
+        if (workers->stop) {
+            break;
+        }
+
+        /* take a pending slot */
+        for (slot = 1; !(workers->pending & (1U << slot)); ++slot) {}
+        workers->pending &= ~(1U << slot);
+        workers->busy |= 1U << slot;
+
+        /* WORKERS UNLOCK */
+        pthread_mutex_unlock(&workers->lock);
+
+        sr_shmsub_rpc_workers_process_slot(workers, slot);
+
+        /* WORKERS LOCK */
+        pthread_mutex_lock(&workers->lock);
+    }
+
+    last = !--workers->thread_count;
+
+    /* WORKERS UNLOCK */
+    pthread_mutex_unlock(&workers->lock);
+
+    if (last) {
+        /* stopped and the RPC/action subscription no longer references the workers */
+        pthread_mutex_destroy(&workers->lock);
+        sr_cond_destroy(&workers->cond);
+        free(workers);
+    }
+
+    /* the subscription structure may be freed after this */
+    ATOMIC_DEC_RELAXED(subscr->rpc_worker_count);
+
+    --sr_ev_thread_depth;
+    return NULL;
+}
+
+/**
+ * @brief Make pipelined RPC slots pending for the workers of an RPC/action subscription, create the workers
+ * if not yet created, and start more worker threads if needed.
+ *
+ * @param[in] rpc_subs RPC/action subscriptions.
+ * @param[in] subscr Subscription structure of @p rpc_subs.
+ * @param[in,out] slots Bitmask of slots with a new request, only the slots that could not be passed to any worker
+ * thread are left in it.
+ * @return err_info, NULL on success.
+ */
+static sr_error_info_t *
+sr_shmsub_rpc_workers_dispatch(struct opsub_rpc_s *rpc_subs, sr_subscription_ctx_t *subscr, uint32_t *slots)
+{
+    sr_error_info_t *err_info = NULL;
+    struct sr_shmsub_rpc_workers_s *workers;
+    uint32_t slot, pending_count = 0;
+    pthread_t tid;
+    int r;
+
+    if (!rpc_subs->workers) {
+        workers = calloc(1, sizeof *workers);
+        SR_CHECK_MEM_RET(!workers, err_info);
+        if ((err_info = sr_mutex_init(&workers->lock, 0))) {
+            free(workers);
+            return err_info;
+        }
+        if ((err_info = sr_cond_init(&workers->cond, 0, 0))) {
+            pthread_mutex_destroy(&workers->lock);
+            free(workers);
+            return err_info;
+        }
+        workers->subscr = subscr;
+        rpc_subs->workers = workers;
+    }
+    workers = rpc_subs->workers;
+
+    /* WORKERS LOCK */
+    pthread_mutex_lock(&workers->lock);
+
+    /* slots being processed are re-armed by their worker */
+    workers->pending |= *slots & ~workers->busy;
+    *slots = 0;
+
+    for (slot = 1; slot < SR_RPC_SUB_SLOT_COUNT; ++slot) {
+        if (workers->pending & (1U << slot)) {
+            ++pending_count;
+        }
+    }
+    while ((workers->thread_count < SR_RPC_SUB_SLOT_COUNT - 1) && (workers->idle_count < pending_count)) {
+        ATOMIC_INC_RELAXED(subscr->rpc_worker_count);
+        if ((r = pthread_create(&tid, NULL, sr_shmsub_rpc_workers_thread, workers))) {
+            ATOMIC_DEC_RELAXED(subscr->rpc_worker_count);
+            SR_LOG_WRN("Creating a new thread failed (%s).", strerror(r));
+            break;
+        }
+        pthread_detach(tid);
+        ++workers->thread_count;
+
+        /* counts as idle until it takes a slot */
+        --pending_count;
+    }
+
+    if (!workers->thread_count) {
+        /* no workers, the slots must be processed by the caller */
+        *slots = workers->pending;
+        workers->pending = 0;
+    } else {
+        sr_cond_broadcast(&workers->cond);
+    }
+
+    /* WORKERS UNLOCK */
+    pthread_mutex_unlock(&workers->lock);
+
+    return NULL;
+}
+
+void
+sr_shmsub_rpc_workers_stop(struct opsub_rpc_s *rpc_subs)
+{
+    struct sr_shmsub_rpc_workers_s *workers = rpc_subs->workers;
+    int running;
+
+    if (!workers) {
+        return;
+    }
+
+    /* WORKERS LOCK */
+    pthread_mutex_lock(&workers->lock);
+
+    workers->stop = 1;
+    workers->pending = 0;
+    sr_cond_broadcast(&workers->cond);
+    running = workers->thread_count;
+
+    /* WORKERS UNLOCK */
+    pthread_mutex_unlock(&workers->lock);
+
+    if (!running) {
+        pthread_mutex_destroy(&workers->lock);
+        sr_cond_destroy(&workers->cond);
+        free(workers);
+    }
+
+    /* the running workers may be waiting for SUBS lock, they exit on their own and the last one frees them */
+    rpc_subs->workers = NULL;
+}
+
+sr_error_info_t *
+sr_shmsub_rpc_listen_process_rpc_events(struct opsub_rpc_s *rpc_subs, sr_subscription_ctx_t *subscr)
+{
+    sr_error_info_t *err_info = NULL, *tmp_err;
+    uint32_t i, slot, slots = 0;
+    int pipelined = 0;
+
+    /* standard slot */
+    if ((err_info = sr_shmsub_rpc_listen_process_slot(rpc_subs, 0, subscr->conn))) {
+        return err_info;
+    }
+
+    /* learn which pipelined slots have a new event */
+    for (i = 0; i < rpc_subs->sub_count; ++i) {
+        if (rpc_subs->subs[i].opts & SR_SUBSCR_RPC_PIPELINE) {
+            pipelined = 1;
+        }
+    }
+    for (slot = 1; slot < SR_RPC_SUB_SLOT_COUNT; ++slot) {
+        if (sr_shmsub_rpc_listen_slot_is_new_event(rpc_subs, slot)) {
+            slots |= 1U << slot;
+        }
+    }
+
+    if (pipelined && slots) {
+        /* pass the slots to the subscription workers, each processes its slot independently, no need to wait */
+        if ((err_info = sr_shmsub_rpc_workers_dispatch(rpc_subs, subscr, &slots))) {
+            return err_info;
+        }
+    }
+
+    /* process the slots no worker takes in this thread */
+    for (slot = 1; slots && (slot < SR_RPC_SUB_SLOT_COUNT); ++slot) {
+        if (!(slots & (1U << slot))) {
+            continue;
+        }
+
+        tmp_err = sr_shmsub_rpc_listen_process_slot(rpc_subs, slot, subscr->conn);
+        sr_errinfo_merge(&err_info, tmp_err);
+    }
+
     return err_info;
 }
 
@@ -4488,17 +5555,155 @@ sr_shmsub_notif_listen_filter_is_valid(const struct lyd_node *notif, const char
     return 0;
 }
 
+/**
+ * @brief Cached notification XPath filter result.
+ */
+struct sr_notif_filter_s {
+    const char *xpath;  /**< Subscription XPath filter. */
+    int valid;          /**< Whether the notification passed the filter. */
+};
+
+/**
+ * @brief Whether a notification is valid for a notif subscription, the result is cached for every distinct XPath.
+ *
+ * @param[in] notif Notification node, must be the same for all the calls with the same @p filters.
+ * @param[in] xpath Full subscription XPath.
+ * @param[in,out] filters Cached filter results.
+ * @param[in,out] filter_count Count of @p filters.
+ * @return 0 if not, non-zero is it is.
+ */
+static int
+sr_shmsub_notif_listen_filter_is_valid_cached(const struct lyd_node *notif, const char *xpath,
+        struct sr_notif_filter_s **filters, uint32_t *filter_count)
+{
+    void *mem;
+    uint32_t i;
+    int valid;
+
+    if (!xpath) {
+        return 1;
+    }
+
+    /* filter already evaluated */
+    for (i = 0; i < *filter_count; ++i) {
+        if (!strcmp((*filters)[i].xpath, xpath)) {
+            return (*filters)[i].valid;
+        }
+    }
+
+    valid = sr_shmsub_notif_listen_filter_is_valid(notif, xpath);
+
+    /* remember the result, if it fails it will just be evaluated again */
+    mem = realloc(*filters, (*filter_count + 1) * sizeof **filters);
+    if (mem) {
+        *filters = mem;
+        (*filters)[*filter_count].xpath = xpath;
+        (*filters)[*filter_count].valid = valid;
+        ++(*filter_count);
+    }
+
+    return valid;
+}
+
+/**
+ * @brief Notification processing result of a single subscription.
+ */
+struct sr_notif_stat_s {
+    int processed;          /**< Whether the notification was processed by the subscription. */
+    int delivered;          /**< Whether the notification was delivered to the callback. */
+    int filtered_out;       /**< Whether the notification was filtered out. */
+    uint32_t latency_us;    /**< Delay between generating the notification and its delivery. */
+};
+
+/**
+ * @brief Store notification processing results of subscriptions into their ext SHM statistics.
+ *
+ * @param[in] notif_subs Module notification subscriptions.
+ * @param[in] request_id Request ID of the processed notification.
+ * @param[in] stats Processing results of each subscription in @p notif_subs.
+ * @param[in] conn Connection to use.
+ * @return err_info, NULL on success.
+ */
+static sr_error_info_t *
+sr_shmsub_notif_listen_stats(struct modsub_notif_s *notif_subs, uint32_t request_id, const struct sr_notif_stat_s *stats,
+        sr_conn_ctx_t *conn)
+{
+    sr_error_info_t *err_info = NULL;
+    sr_mod_t *shm_mod;
+    sr_mod_notif_sub_t *shm_subs;
+    uint32_t i, j;
+
+    for (i = 0; i < notif_subs->sub_count; ++i) {
+        if (stats[i].processed) {
+            break;
+        }
+    }
+    if (i == notif_subs->sub_count) {
+        /* nothing to store */
+        return NULL;
+    }
+
+    shm_mod = sr_shmmod_find_module(SR_CONN_MOD_SHM(conn), notif_subs->module_name);
+    SR_CHECK_INT_RET(!shm_mod, err_info);
+
+    /* EXT READ LOCK, subscriptions in ext SHM may be moved otherwise */
+    if ((err_info = sr_shmext_conn_remap_lock(conn, SR_LOCK_READ, 0, __func__))) {
+        return err_info;
+    }
+
+    shm_subs = (sr_mod_notif_sub_t *)(conn->ext_shm.addr + shm_mod->notif_subs);
+    for (i = 0; i < notif_subs->sub_count; ++i) {
+        if (!stats[i].processed) {
+            continue;
+        }
+
+        /* find the subscription in ext SHM, its cached index changes only when other subscriptions are removed */
+        j = notif_subs->subs[i].ext_idx;
+        if ((j >= shm_mod->notif_sub_count) || (shm_subs[j].sub_id != notif_subs->subs[i].sub_id)) {
+            for (j = 0; j < shm_mod->notif_sub_count; ++j) {
+                if (shm_subs[j].sub_id == notif_subs->subs[i].sub_id) {
+                    break;
+                }
+            }
+            if (j == shm_mod->notif_sub_count) {
+                /* being removed */
+                continue;
+            }
+            notif_subs->subs[i].ext_idx = j;
+        }
+
+        if (stats[i].delivered) {
+            ATOMIC_INC_RELAXED(shm_subs[j].delivered);
+            if (stats[i].latency_us > ATOMIC_LOAD_RELAXED(shm_subs[j].max_latency_us)) {
+                /* only this thread processes the subscription */
+                ATOMIC_STORE_RELAXED(shm_subs[j].max_latency_us, stats[i].latency_us);
+            }
+        } else if (stats[i].filtered_out) {
+            ATOMIC_INC_RELAXED(shm_subs[j].filtered_out);
+        }
+        ATOMIC_STORE_RELAXED(shm_subs[j].request_id, request_id);
+    }
+
+    /* EXT READ UNLOCK */
+    sr_shmext_conn_remap_unlock(conn, SR_LOCK_READ, 0, __func__);
+
+    return NULL;
+}
+
 sr_error_info_t *
 sr_shmsub_notif_listen_process_module_events(struct modsub_notif_s *notif_subs, sr_conn_ctx_t *conn)
 {
     sr_error_info_t *err_info = NULL;
-    uint32_t i, request_id, valid_subscr_count;
-    struct lyd_node *orig_notif = NULL, *notif_dup = NULL, *notif, *notif_op;
+    uint32_t i, request_id, valid_subscr_count, filter_count = 0;
+    struct lyd_node *orig_notif = NULL, *notif_dup = NULL, *notif, *notif_op, *orig_notif_op = NULL;
+    struct sr_notif_filter_s *filters = NULL;
+    struct sr_notif_vals_s vals = {0};
+    struct sr_notif_stat_s *stats = NULL;
     struct sr_denied denied = {0};
-    struct timespec notif_ts_mono, notif_ts_real;
+    struct timespec notif_ts_mono, notif_ts_real, cur_ts, latency;
     char *shm_data_ptr;
     sr_sub_shm_t *sub_shm;
-    sr_shm_t shm_data_sub = SR_SHM_INITIALIZER;
+    sr_shm_t *shm_data_sub = &notif_subs->sub_data_shm;
     sr_session_ctx_t *ev_sess = NULL;
     struct modsub_notifsub_s *sub;
 
@@ -4524,13 +5729,13 @@ sr_shmsub_notif_listen_process_module_events(struct modsub_notif_s *notif_subs,
     request_id = ATOMIC_LOAD_RELAXED(sub_shm->request_id);
 
     /* open sub data SHM */
-    if ((err_info = sr_shmsub_data_open_remap(notif_subs->module_name, "notif", -1, &shm_data_sub, 0))) {
+    if ((err_info = sr_shmsub_data_open_remap(notif_subs->module_name, "notif", -1, sub_shm, shm_data_sub, 0, 1))) {
         goto cleanup_rdunlock;
     }
-    shm_data_ptr = shm_data_sub.addr;
+    shm_data_ptr = shm_data_sub->addr;
 
     /* parse originator name and data (while creating the event session) */
-    if ((err_info = _sr_session_start(conn, SR_DS_OPERATIONAL, SR_SUB_EV_NOTIF, &shm_data_ptr, &ev_sess))) {
+    if ((err_info = sr_ev_session_start(conn, SR_DS_OPERATIONAL, SR_SUB_EV_NOTIF, &shm_data_ptr, &ev_sess))) {
         goto cleanup_rdunlock;
     }
 
@@ -4549,6 +5754,9 @@ sr_shmsub_notif_listen_process_module_events(struct modsub_notif_s *notif_subs,
     /* SUB READ UNLOCK */
     sr_rwunlock(&sub_shm->lock, SR_SUBSHM_LOCK_TIMEOUT, SR_LOCK_READ, conn->cid, __func__);
 
+    stats = calloc(notif_subs->sub_count, sizeof *stats);
+    SR_CHECK_MEM_GOTO(!stats, err_info, cleanup);
+
     /* process event */
     valid_subscr_count = 0;
     for (i = 0; i < notif_subs->sub_count; ++i) {
@@ -4558,6 +5766,7 @@ sr_shmsub_notif_listen_process_module_events(struct modsub_notif_s *notif_subs,
             /* do not process events for suspended subscriptions */
             continue;
         }
+        stats[i].processed = 1;
 
         if (!valid_subscr_count) {
             /* Print a message only the first time we get here */
@@ -4603,21 +5812,40 @@ sr_shmsub_notif_listen_process_module_events(struct modsub_notif_s *notif_subs,
         }
 
         /* find the notification */
-        notif_op = notif;
-        if ((err_info = sr_ly_find_last_parent(&notif_op, LYS_NOTIF))) {
-            goto cleanup;
+        if ((notif == orig_notif) && orig_notif_op) {
+            notif_op = orig_notif_op;
+        } else {
+            notif_op = notif;
+            if ((err_info = sr_ly_find_last_parent(&notif_op, LYS_NOTIF))) {
+                goto cleanup;
+            }
+            if (notif == orig_notif) {
+                orig_notif_op = notif_op;
+            }
         }
 
-        /* NACM and xpath filter */
-        if (!denied.denied && sr_shmsub_notif_listen_filter_is_valid(notif_op, sub->xpath)) {
-            /* call callback */
+        /* NACM and xpath filter, the original notification is never modified so its filter results can be shared */
+        if (!denied.denied && ((notif_op == orig_notif_op) ?
+                sr_shmsub_notif_listen_filter_is_valid_cached(notif_op, sub->xpath, &filters, &filter_count) :
+                sr_shmsub_notif_listen_filter_is_valid(notif_op, sub->xpath))) {
+            /* remember the delivery latency */
+            sr_timeouttime_get(&cur_ts, 0);
+            latency = sr_time_sub(&cur_ts, &notif_ts_mono);
+            if (latency.tv_nsec > -1) {
+                stats[i].latency_us = latency.tv_sec * 1000000 + latency.tv_nsec / 1000;
+            }
+            stats[i].delivered = 1;
+
+            /* call callback, the original notification is converted for value callbacks only once */
             if ((err_info = sr_notif_call_callback(ev_sess, sub->cb, sub->tree_cb, sub->private_data,
-                    SR_EV_NOTIF_REALTIME, sub->sub_id, notif_op, &notif_ts_real))) {
+                    SR_EV_NOTIF_REALTIME, sub->sub_id, notif_op, &notif_ts_real,
+                    (notif_op == orig_notif_op) ? &vals : NULL))) {
                 goto cleanup;
             }
         } else {
             /* filtered out */
             ATOMIC_INC_RELAXED(notif_subs->subs[i].filtered_out);
+            stats[i].filtered_out = 1;
         }
 
         /* processed */
@@ -4633,21 +5861,27 @@ sr_shmsub_notif_listen_process_module_events(struct modsub_notif_s *notif_subs,
     /* remember request ID so that we do not process it again */
     ATOMIC_STORE_RELAXED(notif_subs->request_id, request_id);
 
+    /* update the subscription statistics, also lets the originators know the notification was processed */
+    if ((err_info = sr_shmsub_notif_listen_stats(notif_subs, request_id, stats, conn))) {
+        goto cleanup;
+    }
+
     /* SUB WRITE LOCK */
     if ((err_info = sr_rwlock(&sub_shm->lock, SR_SUBSHM_LOCK_TIMEOUT, SR_LOCK_WRITE, conn->cid, __func__,
             NULL, NULL))) {
         goto cleanup;
     }
 
-    /* no error/timeout should be possible */
     if ((ATOMIC_LOAD_RELAXED(sub_shm->event) != SR_SUB_EV_NOTIF) ||
             (ATOMIC_LOAD_RELAXED(sub_shm->request_id) != ATOMIC_LOAD_RELAXED(notif_subs->request_id))) {
-        SR_ERRINFO_INT(&err_info);
+        /* the originator stopped waiting for us and the notification was overwritten */
+        SR_LOG_DBG("EV LISTEN: \"%s\" \"notif\" ID %" PRIu32 " was overwritten before being finished.",
+                notif_subs->module_name, request_id);
         goto cleanup_wrunlock;
     }
 
     /* finish event */
-    if ((err_info = sr_shmsub_listen_write_event(sub_shm, valid_subscr_count, 0, &shm_data_sub, NULL, 0,
+    if ((err_info = sr_shmsub_listen_write_event(sub_shm, valid_subscr_count, 0, shm_data_sub, NULL, 0,
             notif_subs->module_name, "success"))) {
         goto cleanup_wrunlock;
     }
@@ -4663,10 +5897,12 @@ cleanup_rdunlock:
 
 cleanup:
     free(denied.rule_name);
-    sr_session_stop(ev_sess);
+    free(filters);
+    free(stats);
+    sr_notif_vals_clear(&vals);
+    sr_ev_session_stop(ev_sess);
     lyd_free_all(orig_notif);
     lyd_free_all(notif_dup);
-    sr_shm_clear(&shm_data_sub);
     return err_info;
 }
 
@@ -71,6 +71,37 @@ sr_error_info_t *sr_shmsub_open_map(const char *name, const char *suffix1, int64
  */
 sr_error_info_t *sr_shmsub_unlink(const char *name, const char *suffix1, int64_t suffix2);
 
+/**
+ * @brief Get the mappings of an existing subscription SHM for originating an event, kept ones are reused.
+ *
+ * The sub SHM is mapped, data SHMs are opened and mapped on their first use. The mappings are used exclusively
+ * by the caller until ::sr_shmsub_orig_release() is called. Nothing is done if @p orig is already set.
+ *
+ * @param[in] conn Connection to use.
+ * @param[in] name Subscription name (module name).
+ * @param[in] suffix1 First suffix, must be a static string.
+ * @param[in] suffix2 Second suffix, none if set to -1.
+ * @param[in,out] orig Subscription SHM mappings.
+ * @return err_info, NULL on success.
+ */
+sr_error_info_t *sr_shmsub_orig_open_map(sr_conn_ctx_t *conn, const char *name, const char *suffix1, int64_t suffix2,
+        struct sr_orig_shm_s **orig);
+
+/**
+ * @brief Release subscription SHM mappings of an originator, they are kept for the next events if possible.
+ *
+ * @param[in] conn Connection to use.
+ * @param[in] orig Subscription SHM mappings to release, may be NULL.
+ */
+void sr_shmsub_orig_release(sr_conn_ctx_t *conn, struct sr_orig_shm_s *orig);
+
+/**
+ * @brief Free subscription SHM mappings of an originator.
+ *
+ * @param[in] orig Subscription SHM mappings to free, may be NULL.
+ */
+void sr_shmsub_orig_free(struct sr_orig_shm_s *orig);
+
 /**
  * @brief Create a subscription data SHM.
  *
@@ -91,6 +122,59 @@ sr_error_info_t *sr_shmsub_data_create(const char *name, const char *suffix1, in
  */
 sr_error_info_t *sr_shmsub_data_unlink(const char *name, const char *suffix1, int64_t suffix2);
 
+/**
+ * @brief Create an RPC subscription SHM with all its slots and their data SHMs.
+ *
+ * @param[in] name Subscription name (module name).
+ * @param[in] suffix2 Second suffix (RPC path hash).
+ * @return err_info, NULL on success.
+ */
+sr_error_info_t *sr_shmsub_rpc_create(const char *name, int64_t suffix2);
+
+/**
+ * @brief Unlink an RPC subscription SHM with the data SHMs of all its slots.
+ *
+ * @param[in] name Subscription name (module name).
+ * @param[in] suffix2 Second suffix (RPC path hash).
+ * @return err_info, NULL on success.
+ */
+sr_error_info_t *sr_shmsub_rpc_unlink(const char *name, int64_t suffix2);
+
+/**
+ * @brief Create an operational poll cache SHM with its data SHM.
+ *
+ * @param[in] name Module name.
+ * @param[in] path Operational poll subscription path.
+ * @return err_info, NULL on success.
+ */
+sr_error_info_t *sr_shmsub_oper_poll_cache_create(const char *name, const char *path);
+
+/**
+ * @brief Unlink an operational poll cache SHM with its data SHM.
+ *
+ * @param[in] name Module name.
+ * @param[in] path Operational poll subscription path.
+ * @return err_info, NULL on success.
+ */
+sr_error_info_t *sr_shmsub_oper_poll_cache_unlink(const char *name, const char *path);
+
+/**
+ * @brief Get valid data from an operational poll cache SHM, cached by any connection.
+ *
+ * Cached data that fail to be parsed are dropped from the cache and handled as if there were no valid data.
+ *
+ * @param[in] conn Connection to use.
+ * @param[in] name Module name.
+ * @param[in] path Operational poll subscription path.
+ * @param[in] known_gen Generation of the data the caller already has, they are not returned again. Use 0 for none.
+ * @param[out] data Cached data, may be NULL even if valid.
+ * @param[out] timestamp Optional timestamp of the cached data.
+ * @param[out] generation Generation of the cached data, 0 if there are no valid data.
+ * @return err_info, NULL on success.
+ */
+sr_error_info_t *sr_shmsub_oper_poll_cache_get(sr_conn_ctx_t *conn, const char *name, const char *path,
+        uint32_t known_gen, struct lyd_node **data, struct timespec *timestamp, uint32_t *generation);
+
 /**
  * @brief Write into a subscriber event pipe to notify it there is a new event.
  *
@@ -99,6 +183,27 @@ sr_error_info_t *sr_shmsub_data_unlink(const char *name, const char *suffix1, in
  */
 sr_error_info_t *sr_shmsub_notify_evpipe(uint32_t evpipe_num);
 
+/**
+ * @brief Learn whether there is any change subscription of a module that may be notified.
+ *
+ * @param[in] conn Connection to use.
+ * @param[in] mod Mod info module to use.
+ * @param[in] ds Datastore.
+ * @return 0 if not, non-zero if there is or it could not be learned.
+ */
+int sr_shmsub_change_notify_has_any_subscription(sr_conn_ctx_t *conn, struct sr_mod_info_mod_s *mod, sr_datastore_t ds);
+
+/**
+ * @brief Learn whether all the change subscriptions of a module are coarse (::SR_SUBSCR_CHANGE_COARSE) so that
+ * a diff summary is enough for them. Also true if there are no subscriptions.
+ *
+ * @param[in] conn Connection to use.
+ * @param[in] mod Mod info module to use.
+ * @param[in] ds Datastore.
+ * @return 0 if not, non-zero if all the subscriptions are coarse.
+ */
+int sr_shmsub_change_notify_is_coarse(sr_conn_ctx_t *conn, struct sr_mod_info_mod_s *mod, sr_datastore_t ds);
+
 /**
  * @brief Notify about (generate) a change "update" event.
  *
@@ -298,11 +403,24 @@ sr_error_info_t *sr_shmsub_oper_poll_listen_process_module_events(struct modsub_
 /**
  * @brief Process all RPC/action events for one RPC/action, if any.
  *
+ * Requests in pipelined slots are passed to worker threads kept until the RPC/action subscriptions are removed,
+ * each slot is processed independently and the function does not wait for them.
+ *
  * @param[in] rpc_sub RPC/action subscriptions.
- * @param[in] conn Connection to use.
+ * @param[in] subscr Subscription structure of @p rpc_subs, SUBS READ lock is expected to be held.
  * @return err_info, NULL on success.
  */
-sr_error_info_t *sr_shmsub_rpc_listen_process_rpc_events(struct opsub_rpc_s *rpc_subs, sr_conn_ctx_t *conn);
+sr_error_info_t *sr_shmsub_rpc_listen_process_rpc_events(struct opsub_rpc_s *rpc_subs, sr_subscription_ctx_t *subscr);
+
+/**
+ * @brief Stop the worker threads processing pipelined RPC slots of an RPC/action subscription, if any.
+ *
+ * Does not wait for the threads, they may be waiting for SUBS lock held by the caller. SUBS WRITE lock is expected
+ * to be held.
+ *
+ * @param[in] rpc_subs RPC/action subscriptions.
+ */
+void sr_shmsub_rpc_workers_stop(struct opsub_rpc_s *rpc_subs);
 
 /**
  * @brief Process all module notification events, if any.
@@ -25,7 +25,7 @@
 #include "common_types.h"
 #include "sysrepo_types.h"
 
-#define SR_SHM_VER 18   /**< Main, mod, and ext SHM version of their expected content structures. */
+#define SR_SHM_VER 23   /**< Main, mod, and ext SHM version of their expected content structures. */
 #define SR_MAIN_SHM_LOCK "sr_main_lock"     /**< Main SHM file lock name. */
 
 /**
@@ -102,6 +102,12 @@ typedef struct {
     uint16_t dep_count;         /**< Number of dependencies. */
 } sr_notif_t;
 
+/** maximum number of connections with stored operational data of a module tracked in its mod SHM module */
+#define SR_MOD_OPER_CID_COUNT 16
+
+/** oper CID count of a mod SHM module if the connections with stored operational data are not known */
+#define SR_MOD_OPER_CID_UNKNOWN UINT32_MAX
+
 /**
  * @brief Mod SHM module.
  */
@@ -121,6 +127,10 @@ typedef struct {
     char rev[11];               /**< Module revision. */
     int replay_supp;            /**< Whether module supports replay. */
     uint32_t run_cache_id;      /**< Running cached data ID. */
+    uint32_t data_version[SR_DS_COUNT]; /**< Data version of each datastore, incremented whenever data are stored. */
+    sr_cid_t oper_cids[SR_MOD_OPER_CID_COUNT];  /**< Connections that may have some stored operational data (edit),
+                                                     so that it does not have to be searched for them on every load. */
+    uint32_t oper_cid_count;    /**< Number of oper CIDs, ::SR_MOD_OPER_CID_UNKNOWN if they are not known. */
     off_t plugins[SR_MOD_DS_PLUGIN_COUNT];  /**< Module plugin names (offsets in mod SHM). */
 
     off_t features;             /**< Array of enabled features (off_t *) (offset in mod SHM). */
@@ -254,10 +264,19 @@ typedef struct {
  */
 typedef struct {
     off_t xpath;                /**< XPath of the subscription (offset in ext SHM). */
+    int opts;                   /**< Subscription options. */
     uint32_t sub_id;            /**< Unique subscription ID. */
     uint32_t evpipe_num;        /**< Event pipe number. */
     ATOMIC_T suspended;         /**< Whether the subscription is suspended. */
     sr_cid_t cid;               /**< Connection ID. */
+
+    uint32_t start_request_id;  /**< Request ID of the last notification sent before the subscription was added. */
+    ATOMIC_T request_id;        /**< Request ID of the last notification processed by the subscriber. */
+    ATOMIC_T delivered;         /**< Number of notifications delivered to the subscriber. */
+    ATOMIC_T filtered_out;      /**< Number of notifications filtered out for the subscriber. */
+    ATOMIC_T dropped;           /**< Number of notifications dropped because the subscriber was lagging. */
+    ATOMIC_T blocked_ms;        /**< Total time originators were blocked waiting for the subscriber (ms). */
+    ATOMIC_T max_latency_us;    /**< Maximum delay between generating a notification and its delivery (us). */
 } sr_mod_notif_sub_t;
 
 /**
@@ -273,11 +292,18 @@ typedef struct {
     sr_cid_t cid;               /**< Connection ID. */
 } sr_mod_rpc_sub_t;
 
+/** number of ext SHM memory hole size classes, each holds holes at least twice the size of the previous one */
+#define SR_EXT_HOLE_CLASS_COUNT 16
+
 /**
  * @brief Ext SHM structure.
  */
 typedef struct {
-    uint32_t first_hole_off;    /**< Offset of the first memory hole, 0 if there is none. */
+    uint32_t first_hole_off[SR_EXT_HOLE_CLASS_COUNT];   /**< Offset of the first memory hole of every size class,
+                                                             0 if there is none. */
+    uint32_t hole_count;        /**< Number of all the memory holes. */
+    uint32_t hole_size;         /**< Size of all the memory holes. */
+    uint32_t defrag_hole_count; /**< Number of memory holes after the last defragmentation. */
 } sr_ext_shm_t;
 
 /**
@@ -285,7 +311,7 @@ typedef struct {
  */
 typedef struct {
     uint32_t size;
-    uint32_t next_hole_off;
+    uint32_t next_hole_off;     /**< Offset of the next memory hole of the same size class, 0 if there is none. */
 } sr_ext_hole_t;
 
 /*
@@ -339,6 +365,21 @@ typedef struct {
  * followed by:
  * event SR_SUB_EV_SUCCESS - char *data_lyb - RPC/action with output
  * event SR_SUB_EV_ERROR - char *error_message; char *error_xpath
+ *
+ * RPC subscription SHM consists of SR_RPC_SUB_SLOT_COUNT sub SHM structures (slots), each with its own data SHM.
+ * Slot 0 is used by all the requests unless all the subscribers are pipelined, in which case the originators
+ * spread the requests among the other slots so that several may be processed at once.
+ */
+
+/*
+ * Operational poll cache SHM
+ *
+ * data SHM contents
+ *
+ * char *data_lyb - cached operational data of a poll subscription path
+ *
+ * Created for every operational poll subscription path so that the data cached by a poll subscription of one
+ * connection can be used by all the connections while they are valid.
  */
 
 /**
@@ -353,6 +394,30 @@ typedef struct {
 
     ATOMIC_T priority;          /**< Priority of the subscriber. */
     uint32_t subscriber_count;  /**< Number of subscribers to process this event. */
+    uint32_t data_version;      /**< Module data version with the changes applied, only for change events. */
+
+    uint32_t data_size;         /**< Size of the data SHM, it only grows so any change means it must be remapped. */
+    ATOMIC_T unlinked;          /**< Set before the SHM is unlinked so that the kept mappings of it are dropped. */
 } sr_sub_shm_t;
 
+/**
+ * @brief RPC subscription SHM structure.
+ */
+typedef struct {
+    sr_sub_shm_t slot[SR_RPC_SUB_SLOT_COUNT];   /**< Request slots, slot 0 must be first (generic sub SHM access). */
+    ATOMIC_T request_id;        /**< Last request ID used in any of the slots. */
+    ATOMIC_T next_slot;         /**< Counter for assigning pipelined requests to slots. */
+} sr_rpc_sub_shm_t;
+
+/**
+ * @brief Operational poll cache SHM structure.
+ */
+typedef struct {
+    sr_sub_shm_t sub;           /**< Generic sub SHM, only the lock and the data SHM size are used. */
+    struct timespec timestamp;  /**< Realtime timestamp of the cached data, zeroed if there are none. */
+    uint32_t valid_ms;          /**< Validity period of the cached data. */
+    uint32_t generation;        /**< Generation of the cached data, incremented on every update, never 0. */
+    uint32_t data_len;          /**< Length of the cached data in the data SHM. */
+} sr_oper_poll_cache_shm_t;
+
 #endif /* _SHM_TYPES_H */
@@ -66,6 +66,7 @@ sr_subscr_change_sub_add(sr_subscription_ctx_t *subscr, uint32_t sub_id, sr_sess
         change_sub = &subscr->change_subs[i];
         memset(change_sub, 0, sizeof *change_sub);
         change_sub->sub_shm.fd = -1;
+        change_sub->sub_data_shm.fd = -1;
 
         /* set attributes */
         mem[1] = strdup(mod_name);
@@ -118,6 +119,7 @@ error:
     }
     if (change_sub) {
         sr_shm_clear(&change_sub->sub_shm);
+        sr_shm_clear(&change_sub->sub_data_shm);
     }
     if (new_sub) {
         --subscr->change_sub_count;
@@ -151,6 +153,7 @@ sr_subscr_change_sub_del(sr_subscription_ctx_t *subscr, uint32_t sub_id)
                 free(change_sub->module_name);
                 free(change_sub->subs);
                 sr_shm_clear(&change_sub->sub_shm);
+                sr_shm_clear(&change_sub->sub_data_shm);
                 if (i < subscr->change_sub_count - 1) {
                     memcpy(change_sub, &subscr->change_subs[subscr->change_sub_count - 1], sizeof *change_sub);
                 }
@@ -223,6 +226,7 @@ sr_subscr_oper_get_sub_add(sr_subscription_ctx_t *subscr, uint32_t sub_id, sr_se
     oper_get_sub->subs = mem[2];
     memset(oper_get_sub->subs + oper_get_sub->sub_count, 0, sizeof *oper_get_sub->subs);
     oper_get_sub->subs[oper_get_sub->sub_count].sub_shm.fd = -1;
+    oper_get_sub->subs[oper_get_sub->sub_count].sub_data_shm.fd = -1;
 
     /* set attributes */
     oper_get_sub->subs[oper_get_sub->sub_count].sub_id = sub_id;
@@ -274,6 +278,7 @@ sr_subscr_oper_get_sub_del(sr_subscription_ctx_t *subscr, uint32_t sub_id)
             /* found our subscription, replace it with the last */
             free(oper_get_sub->subs[j].path);
             sr_shm_clear(&oper_get_sub->subs[j].sub_shm);
+            sr_shm_clear(&oper_get_sub->subs[j].sub_data_shm);
             if (j < oper_get_sub->sub_count - 1) {
                 memcpy(&oper_get_sub->subs[j], &oper_get_sub->subs[oper_get_sub->sub_count - 1], sizeof *oper_get_sub->subs);
             }
@@ -461,6 +466,7 @@ sr_subscr_notif_sub_add(sr_subscription_ctx_t *subscr, uint32_t sub_id, sr_sessi
         notif_sub = &subscr->notif_subs[i];
         memset(notif_sub, 0, sizeof *notif_sub);
         notif_sub->sub_shm.fd = -1;
+        notif_sub->sub_data_shm.fd = -1;
 
         /* set attributes */
         mem[1] = strdup(mod_name);
@@ -521,6 +527,7 @@ error:
     if (new_sub) {
         --subscr->notif_sub_count;
         sr_shm_clear(&notif_sub->sub_shm);
+        sr_shm_clear(&notif_sub->sub_data_shm);
     }
     return err_info;
 }
@@ -569,7 +576,7 @@ sr_subscr_notif_sub_del(sr_subscription_ctx_t *subscr, uint32_t sub_id, sr_ev_no
                 /* send special last notification */
                 sr_realtime_get(&cur_time);
                 if ((err_info = sr_notif_call_callback(ev_sess, sub->cb, sub->tree_cb, sub->private_data, notif_ev,
-                        sub->sub_id, NULL, &cur_time))) {
+                        sub->sub_id, NULL, &cur_time, NULL))) {
                     sr_errinfo_free(&err_info);
                 }
             }
@@ -585,6 +592,7 @@ sr_subscr_notif_sub_del(sr_subscription_ctx_t *subscr, uint32_t sub_id, sr_ev_no
                 /* no other subscriptions for this module, replace it with the last */
                 free(notif_sub->module_name);
                 sr_shm_clear(&notif_sub->sub_shm);
+                sr_shm_clear(&notif_sub->sub_data_shm);
                 free(notif_sub->subs);
                 if (i < subscr->notif_sub_count - 1) {
                     memcpy(notif_sub, &subscr->notif_subs[subscr->notif_sub_count - 1], sizeof *notif_sub);
@@ -613,11 +621,11 @@ cleanup:
 sr_error_info_t *
 sr_subscr_rpc_sub_add(sr_subscription_ctx_t *subscr, uint32_t sub_id, sr_session_ctx_t *sess, const char *path,
         int is_ext, const char *xpath, sr_rpc_cb rpc_cb, sr_rpc_tree_cb rpc_tree_cb, void *private_data, uint32_t priority,
-        sr_lock_mode_t has_subs_lock)
+        sr_subscr_options_t sub_opts, sr_lock_mode_t has_subs_lock)
 {
     sr_error_info_t *err_info = NULL;
     struct opsub_rpc_s *rpc_sub = NULL;
-    uint32_t i;
+    uint32_t i, j;
     char *mod_name;
     void *mem[4] = {NULL};
     int new_sub = 0;
@@ -643,6 +651,9 @@ sr_subscr_rpc_sub_add(sr_subscription_ctx_t *subscr, uint32_t sub_id, sr_session
         rpc_sub = &subscr->rpc_subs[i];
         memset(rpc_sub, 0, sizeof *rpc_sub);
         rpc_sub->sub_shm.fd = -1;
+        for (j = 0; j < SR_RPC_SUB_SLOT_COUNT; ++j) {
+            rpc_sub->sub_data_shm[j].fd = -1;
+        }
 
         /* set attributes */
         mem[1] = strdup(path);
@@ -685,6 +696,7 @@ sr_subscr_rpc_sub_add(sr_subscription_ctx_t *subscr, uint32_t sub_id, sr_session
     rpc_sub->subs[rpc_sub->sub_count].tree_cb = rpc_tree_cb;
     rpc_sub->subs[rpc_sub->sub_count].private_data = private_data;
     rpc_sub->subs[rpc_sub->sub_count].sess = sess;
+    rpc_sub->subs[rpc_sub->sub_count].opts = sub_opts;
 
     ++rpc_sub->sub_count;
 
@@ -700,6 +712,9 @@ error:
     if (new_sub) {
         --subscr->rpc_sub_count;
         sr_shm_clear(&rpc_sub->sub_shm);
+        for (i = 0; i < SR_RPC_SUB_SLOT_COUNT; ++i) {
+            sr_shm_clear(&rpc_sub->sub_data_shm[i]);
+        }
     }
     return err_info;
 }
@@ -727,8 +742,12 @@ sr_subscr_rpc_sub_del(sr_subscription_ctx_t *subscr, uint32_t sub_id)
 
             if (!rpc_sub->sub_count) {
                 /* no other subscriptions for this RPC/action, replace it with the last */
+                sr_shmsub_rpc_workers_stop(rpc_sub);
                 free(rpc_sub->path);
                 sr_shm_clear(&rpc_sub->sub_shm);
+                for (j = 0; j < SR_RPC_SUB_SLOT_COUNT; ++j) {
+                    sr_shm_clear(&rpc_sub->sub_data_shm[j]);
+                }
                 free(rpc_sub->subs);
                 if (i < subscr->rpc_sub_count - 1) {
                     memcpy(rpc_sub, &subscr->rpc_subs[subscr->rpc_sub_count - 1], sizeof *rpc_sub);
@@ -1816,16 +1835,62 @@ sr_notif_find_subscriber(sr_conn_ctx_t *conn, const char *mod_name, sr_mod_notif
     return NULL;
 }
 
-sr_error_info_t *
-sr_notif_call_callback(sr_session_ctx_t *ev_sess, sr_event_notif_cb cb, sr_event_notif_tree_cb tree_cb, void *private_data,
-        const sr_ev_notif_type_t notif_type, uint32_t sub_id, const struct lyd_node *notif_op, const struct timespec *notif_ts)
+void
+sr_notif_vals_clear(struct sr_notif_vals_s *vals)
+{
+    free(vals->xpath);
+    sr_free_values(vals->vals, vals->val_count);
+    memset(vals, 0, sizeof *vals);
+}
+
+/**
+ * @brief Convert a notification for value callbacks.
+ *
+ * @param[in] notif_op Notification node.
+ * @param[out] vals Converted notification.
+ * @return err_info, NULL on success.
+ */
+static sr_error_info_t *
+sr_notif_vals_prepare(const struct lyd_node *notif_op, struct sr_notif_vals_s *vals)
 {
     sr_error_info_t *err_info = NULL;
     const struct lyd_node *elem;
     void *mem;
-    char *notif_xpath = NULL;
-    sr_val_t *vals = NULL;
-    size_t val_count = 0;
+
+    vals->notif_op = notif_op;
+
+    /* prepare XPath */
+    vals->xpath = lyd_path(notif_op, LYD_PATH_STD, NULL, 0);
+    SR_CHECK_INT_RET(!vals->xpath, err_info);
+
+    /* prepare input for sr_val CB */
+    LYD_TREE_DFS_BEGIN(notif_op, elem) {
+        /* skip op node */
+        if (elem != notif_op) {
+            mem = realloc(vals->vals, (vals->val_count + 1) * sizeof *vals->vals);
+            SR_CHECK_MEM_RET(!mem, err_info);
+            vals->vals = mem;
+
+            if ((err_info = sr_val_ly2sr(elem, &vals->vals[vals->val_count]))) {
+                return err_info;
+            }
+
+            ++vals->val_count;
+        }
+
+        LYD_TREE_DFS_END(notif_op, elem);
+    }
+
+    return NULL;
+}
+
+sr_error_info_t *
+sr_notif_call_callback(sr_session_ctx_t *ev_sess, sr_event_notif_cb cb, sr_event_notif_tree_cb tree_cb, void *private_data,
+        const sr_ev_notif_type_t notif_type, uint32_t sub_id, const struct lyd_node *notif_op, const struct timespec *notif_ts,
+        struct sr_notif_vals_s *vals_cache)
+{
+    sr_error_info_t *err_info = NULL;
+    struct sr_notif_vals_s vals = {0}, *v = &vals;
 
     assert(!notif_op || (notif_op->schema->nodetype == LYS_NOTIF));
     assert((tree_cb && !cb) || (!tree_cb && cb));
@@ -1835,39 +1900,21 @@ sr_notif_call_callback(sr_session_ctx_t *ev_sess, sr_event_notif_cb cb, sr_event
         tree_cb(ev_sess, sub_id, notif_type, notif_op, (struct timespec *)notif_ts, private_data);
     } else {
         if (notif_op) {
-            /* prepare XPath */
-            notif_xpath = lyd_path(notif_op, LYD_PATH_STD, NULL, 0);
-            SR_CHECK_INT_GOTO(!notif_xpath, err_info, cleanup);
-
-            /* prepare input for sr_val CB */
-            LYD_TREE_DFS_BEGIN(notif_op, elem) {
-                /* skip op node */
-                if (elem != notif_op) {
-                    mem = realloc(vals, (val_count + 1) * sizeof *vals);
-                    if (!mem) {
-                        SR_ERRINFO_MEM(&err_info);
-                        goto cleanup;
-                    }
-                    vals = mem;
-
-                    if ((err_info = sr_val_ly2sr(elem, &vals[val_count]))) {
-                        goto cleanup;
-                    }
-
-                    ++val_count;
-                }
-
-                LYD_TREE_DFS_END(notif_op, elem);
+            if (vals_cache && (!vals_cache->notif_op || (vals_cache->notif_op == notif_op))) {
+                /* convert the notification only once */
+                v = vals_cache;
+            }
+            if (!v->notif_op && (err_info = sr_notif_vals_prepare(notif_op, v))) {
+                goto cleanup;
             }
         }
 
         /* callback */
-        cb(ev_sess, sub_id, notif_type, notif_xpath, vals, val_count, (struct timespec *)notif_ts, private_data);
+        cb(ev_sess, sub_id, notif_type, v->xpath, v->vals, v->val_count, (struct timespec *)notif_ts, private_data);
     }
 
 cleanup:
-    free(notif_xpath);
-    sr_free_values(vals, val_count);
+    sr_notif_vals_clear(&vals);
     return err_info;
 }
 
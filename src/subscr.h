@@ -145,12 +145,13 @@ void sr_subscr_notif_sub_del(sr_subscription_ctx_t *subscr, uint32_t sub_id, sr_
  * @param[in] rpc_tree_cb Subscription tree callback.
  * @param[in] private_data Subscription callback private data.
  * @param[in] priority Subscription priority.
+ * @param[in] sub_opts Subscription options.
  * @param[in] has_subs_lock What kind of SUBS lock is held.
  * @return err_info, NULL on success.
  */
 sr_error_info_t *sr_subscr_rpc_sub_add(sr_subscription_ctx_t *subscr, uint32_t sub_id, sr_session_ctx_t *sess,
         const char *path, int is_ext, const char *xpath, sr_rpc_cb rpc_cb, sr_rpc_tree_cb rpc_tree_cb, void *private_data,
-        uint32_t priority, sr_lock_mode_t has_subs_lock);
+        uint32_t priority, sr_subscr_options_t sub_opts, sr_lock_mode_t has_subs_lock);
 
 /**
  * @brief Delete an RPC subscription from a subscription structure.
@@ -277,6 +278,23 @@ sr_error_info_t *sr_subscr_notif_del_stop_time(sr_subscription_ctx_t *subscr, ui
 sr_error_info_t *sr_notif_find_subscriber(sr_conn_ctx_t *conn, const char *mod_name, sr_mod_notif_sub_t **notif_subs,
         uint32_t *notif_sub_count, sr_cid_t *sub_cid);
 
+/**
+ * @brief Notification converted for value callbacks, may be shared by all the callbacks of a notification.
+ */
+struct sr_notif_vals_s {
+    const struct lyd_node *notif_op;    /**< Converted notification node, NULL if not converted yet. */
+    char *xpath;                        /**< Notification path. */
+    sr_val_t *vals;                     /**< Notification values. */
+    size_t val_count;                   /**< Notification value count. */
+};
+
+/**
+ * @brief Free a converted notification.
+ *
+ * @param[in] vals Converted notification to clear.
+ */
+void sr_notif_vals_clear(struct sr_notif_vals_s *vals);
+
 /**
  * @brief Call notification callback for a notification.
  *
@@ -288,11 +306,13 @@ sr_error_info_t *sr_notif_find_subscriber(sr_conn_ctx_t *conn, const char *mod_n
  * @param[in] sub_id Subscription ID.
  * @param[in] notif_op Notification node of the notification (relevant for nested notifications).
  * @param[in] notif_ts Timestamp of when the notification was generated.
+ * @param[in,out] vals_cache Optional converted notification reused by value callbacks of the same @p notif_op,
+ * is filled on the first use and must be cleared by the caller.
  * @return err_info, NULL on success.
  */
 sr_error_info_t *sr_notif_call_callback(sr_session_ctx_t *ev_sess, sr_event_notif_cb cb, sr_event_notif_tree_cb tree_cb,
         void *private_data, const sr_ev_notif_type_t notif_type, uint32_t sub_id, const struct lyd_node *notif_op,
-        const struct timespec *notif_ts);
+        const struct timespec *notif_ts, struct sr_notif_vals_s *vals_cache);
 
 /**
  * @brief Check the XPath of a change subscription.
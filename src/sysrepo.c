@@ -36,6 +36,7 @@
 
 #include <libyang/hash_table.h>
 #include <libyang/libyang.h>
+#include <libyang/plugins_types.h>
 
 #include "common.h"
 #include "config.h"
@@ -58,6 +59,7 @@
 static sr_error_info_t *sr_session_notif_buf_stop(sr_session_ctx_t *session);
 static sr_error_info_t *_sr_session_stop(sr_session_ctx_t *session);
 static sr_error_info_t *_sr_unsubscribe(sr_subscription_ctx_t *subscription);
+static sr_error_info_t *sr_bg_stop(sr_conn_ctx_t *conn);
 
 /**
  * @brief Allocate a new connection structure.
@@ -118,12 +120,47 @@ sr_conn_new(const sr_conn_options_t opts, sr_conn_ctx_t **conn_p)
     if ((err_info = sr_mutex_init(&conn->oper_push_mod_lock, 0))) {
         goto error11;
     }
+    if ((err_info = sr_mutex_init(&conn->commit.lock, 0))) {
+        goto error12;
+    }
+    if ((err_info = sr_cond_init(&conn->commit.cond, 0, 0))) {
+        goto error13;
+    }
+    if ((err_info = sr_mutex_init(&conn->bg.lock, 0))) {
+        goto error14;
+    }
+    if ((err_info = sr_cond_init(&conn->bg.cond, 0, 0))) {
+        goto error15;
+    }
+    if ((err_info = sr_mutex_init(&conn->mi_jobs.lock, 0))) {
+        goto error16;
+    }
+    if ((err_info = sr_cond_init(&conn->mi_jobs.cond, 0, 0))) {
+        goto error17;
+    }
+    if ((err_info = sr_mutex_init(&conn->orig_shm.lock, 0))) {
+        goto error18;
+    }
 
     *conn_p = conn;
     return NULL;
 
-error11:
+error18:
+    sr_cond_destroy(&conn->mi_jobs.cond);
+error17:
+    pthread_mutex_destroy(&conn->mi_jobs.lock);
+error16:
+    sr_cond_destroy(&conn->bg.cond);
+error15:
+    pthread_mutex_destroy(&conn->bg.lock);
+error14:
+    sr_cond_destroy(&conn->commit.cond);
+error13:
+    pthread_mutex_destroy(&conn->commit.lock);
+error12:
     pthread_mutex_destroy(&conn->oper_push_mod_lock);
+error11:
+    sr_rwlock_destroy(&conn->oper_cache_lock);
 error10:
     sr_ntf_handle_free(conn->ntf_handles, conn->ntf_handle_count);
 error9:
@@ -141,7 +178,7 @@ error4:
 error3:
     pthread_mutex_destroy(&conn->ptr_lock);
 error2:
-    ly_ctx_destroy(conn->ly_ctx);
+    sr_ly_ctx_destroy(conn->ly_ctx);
 error1:
     free(conn);
     return err_info;
@@ -161,6 +198,9 @@ sr_conn_free(sr_conn_ctx_t *conn)
         return;
     }
 
+    /* stop module job workers, they use DS plugin data */
+    sr_modinfo_jobs_stop(conn);
+
     /* destroy DS plugin data */
     sr_conn_ds_destroy(conn);
 
@@ -174,7 +214,7 @@ sr_conn_free(sr_conn_ctx_t *conn)
     }
 
     /* context destroy */
-    ly_ctx_destroy(conn->ly_ctx);
+    sr_ly_ctx_destroy(conn->ly_ctx);
 
     pthread_mutex_destroy(&conn->ptr_lock);
     sr_rwlock_destroy(&conn->ly_ext_data_lock);
@@ -197,6 +237,23 @@ sr_conn_free(sr_conn_ctx_t *conn)
     free(conn->oper_push_mods);
     pthread_mutex_destroy(&conn->oper_push_mod_lock);
 
+    assert(!conn->commit.active);
+    pthread_mutex_destroy(&conn->commit.lock);
+    sr_cond_destroy(&conn->commit.cond);
+
+    assert(!conn->bg.thread_count);
+    pthread_mutex_destroy(&conn->bg.lock);
+    sr_cond_destroy(&conn->bg.cond);
+
+    assert(!conn->mi_jobs.thread_count);
+    pthread_mutex_destroy(&conn->mi_jobs.lock);
+    sr_cond_destroy(&conn->mi_jobs.cond);
+
+    for (i = 0; i < conn->orig_shm.count; ++i) {
+        sr_shmsub_orig_free(conn->orig_shm.entries[i]);
+    }
+    pthread_mutex_destroy(&conn->orig_shm.lock);
+
     free(conn);
 }
 
@@ -208,7 +265,6 @@ sr_connect(const sr_conn_options_t opts, sr_conn_ctx_t **conn_p)
     struct lyd_node *sr_mods = NULL;
     int created = 0, initialized = 0;
     sr_main_shm_t *main_shm;
-    sr_ext_hole_t *hole;
     const char *rpc_path;
     sr_rpc_t *shm_rpc;
 
@@ -255,6 +311,9 @@ sr_connect(const sr_conn_options_t opts, sr_conn_ctx_t **conn_p)
     }
 
     if (created) {
+        /* any previous context image may not match the modules with the same content ID */
+        sr_ly_ctx_img_remove();
+
         /* parse SR mods */
         if ((err_info = sr_lydmods_parse(conn->ly_ctx, conn, &initialized, &sr_mods))) {
             goto cleanup_unlock;
@@ -277,18 +336,22 @@ sr_connect(const sr_conn_options_t opts, sr_conn_ctx_t **conn_p)
         sr_mods = NULL;
 
         assert((conn->ext_shm.size == SR_SHM_SIZE(sizeof(sr_ext_shm_t))) || sr_ext_hole_next(NULL, SR_CONN_EXT_SHM(conn)));
-        if ((hole = sr_ext_hole_next(NULL, SR_CONN_EXT_SHM(conn)))) {
-            /* there is something in ext SHM, is it only a single memory hole? */
-            if (conn->ext_shm.size != SR_SHM_SIZE(sizeof(sr_ext_shm_t)) + hole->size) {
+        if (sr_ext_hole_next(NULL, SR_CONN_EXT_SHM(conn))) {
+            /* there is something in ext SHM, it should be only memory holes */
+            if ((err_info = sr_ext_hole_defrag(&conn->ext_shm))) {
+                goto cleanup_unlock;
+            }
+            if (conn->ext_shm.size != SR_SHM_SIZE(sizeof(sr_ext_shm_t))) {
                 /* no, this should never happen */
                 SR_ERRINFO_INT(&err_info);
-            }
+                sr_errinfo_free(&err_info);
 
-            /* clear ext SHM */
-            if ((err_info = sr_shm_remap(&conn->ext_shm, SR_SHM_SIZE(sizeof(sr_ext_shm_t))))) {
-                goto cleanup_unlock;
+                /* clear ext SHM */
+                if ((err_info = sr_shm_remap(&conn->ext_shm, SR_SHM_SIZE(sizeof(sr_ext_shm_t))))) {
+                    goto cleanup_unlock;
+                }
+                memset(SR_CONN_EXT_SHM(conn), 0, sizeof(sr_ext_shm_t));
             }
-            SR_CONN_EXT_SHM(conn)->first_hole_off = 0;
         }
 
         /* add internal RPC subscription into ext SHM */
@@ -375,6 +438,11 @@ sr_disconnect(sr_conn_ctx_t *conn)
         return sr_api_ret(NULL, NULL);
     }
 
+    /* finish all background operations, they use the sessions */
+    if ((err_info = sr_bg_stop(conn))) {
+        return sr_api_ret(NULL, err_info);
+    }
+
     /* stop all session notification buffer threads, they use read lock so they need conn state in SHM */
     for (i = 0; i < conn->session_count; ++i) {
         if ((err_info = sr_session_notif_buf_stop(conn->sessions[i]))) {
@@ -391,7 +459,8 @@ sr_disconnect(sr_conn_ctx_t *conn)
         }
     }
 
-    /* stop all the sessions */
+    /* stop all the sessions, including the idle event sessions */
+    conn->ev_sess_pool_count = 0;
     while (conn->session_count) {
         if ((err_info = _sr_session_stop(conn->sessions[0]))) {
             return sr_api_ret(NULL, err_info);
@@ -537,6 +606,26 @@ cleanup:
     return sr_api_ret(NULL, err_info);
 }
 
+API int
+sr_compact_shm(sr_conn_ctx_t *conn)
+{
+    sr_error_info_t *err_info = NULL;
+
+    SR_CHECK_ARG_APIRET(!conn, NULL, err_info);
+
+    /* EXT WRITE LOCK */
+    if ((err_info = sr_shmext_conn_remap_lock(conn, SR_LOCK_WRITE, 1, __func__))) {
+        return sr_api_ret(NULL, err_info);
+    }
+
+    err_info = sr_ext_hole_defrag(&conn->ext_shm);
+
+    /* EXT WRITE UNLOCK */
+    sr_shmext_conn_remap_unlock(conn, SR_LOCK_WRITE, 1, __func__);
+
+    return sr_api_ret(NULL, err_info);
+}
+
 API uid_t
 sr_get_su_uid(void)
 {
@@ -742,6 +831,125 @@ error:
     return err_info;
 }
 
+sr_error_info_t *
+sr_ev_session_start(sr_conn_ctx_t *conn, const sr_datastore_t datastore, sr_sub_event_t event, char **shm_data_ptr,
+        sr_session_ctx_t **session)
+{
+    sr_error_info_t *err_info = NULL;
+
+    assert(conn && session);
+
+    *session = NULL;
+
+    /* PTR LOCK */
+    if ((err_info = sr_mlock(&conn->ptr_lock, -1, __func__, NULL, NULL))) {
+        return err_info;
+    }
+
+    /* take an idle session */
+    if (conn->ev_sess_pool_count) {
+        *session = conn->ev_sess_pool[--conn->ev_sess_pool_count];
+    }
+
+    /* PTR UNLOCK */
+    sr_munlock(&conn->ptr_lock);
+
+    if (!*session) {
+        /* create a new one */
+        return _sr_session_start(conn, datastore, event, shm_data_ptr, session);
+    }
+
+    /* new SR session ID so that the session cannot be told apart from a new one */
+    (*session)->sid = ATOMIC_INC_RELAXED(SR_CONN_MAIN_SHM(conn)->new_sr_sid);
+    (*session)->ds = datastore;
+    (*session)->ev = event;
+    if (shm_data_ptr) {
+        if ((err_info = sr_session_set_orig(*session, *shm_data_ptr, (*shm_data_ptr) + sr_strshmlen(*shm_data_ptr)))) {
+            sr_session_stop(*session);
+            *session = NULL;
+            return err_info;
+        }
+        *shm_data_ptr += sr_strshmlen(*shm_data_ptr);
+        *shm_data_ptr += SR_SHM_SIZE(sr_ev_data_size(*shm_data_ptr));
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Free the paged get cursor of a session.
+ *
+ * @param[in] session Session with the cursor.
+ */
+static void
+sr_session_page_free(sr_session_ctx_t *session)
+{
+    ly_set_free(session->page.set, NULL);
+    sr_release_data(session->page.data);
+    free(session->page.xpath);
+    free(session->page.next_path);
+    memset(&session->page, 0, sizeof session->page);
+}
+
+void
+sr_ev_session_stop(sr_session_ctx_t *session)
+{
+    sr_error_info_t *err_info = NULL;
+    sr_conn_ctx_t *conn;
+    sr_datastore_t ds;
+
+    if (!session) {
+        return;
+    }
+
+    if (session->ds_locked || session->subscription_count || session->notif_buf.tid || session->user_changed) {
+        /* the session was used for more than just handling the event or its user differs, it cannot be reused */
+        sr_session_stop(session);
+        return;
+    }
+
+    /* reset all the event attributes */
+    free(session->nacm_user);
+    session->nacm_user = NULL;
+    sr_errinfo_free(&session->err_info);
+    free(session->orig_name);
+    session->orig_name = NULL;
+    free(session->orig_data);
+    session->orig_data = NULL;
+    free(session->ev_data.orig_name);
+    session->ev_data.orig_name = NULL;
+    free(session->ev_data.orig_data);
+    session->ev_data.orig_data = NULL;
+    sr_errinfo_free(&session->ev_err_info);
+    for (ds = 0; ds < SR_DS_COUNT; ++ds) {
+        sr_release_data(session->dt[ds].edit);
+        session->dt[ds].edit = NULL;
+        lyd_free_all(session->dt[ds].diff);
+        session->dt[ds].diff = NULL;
+    }
+    sr_session_page_free(session);
+
+    conn = session->conn;
+
+    /* PTR LOCK */
+    if ((err_info = sr_mlock(&conn->ptr_lock, -1, __func__, NULL, NULL))) {
+        sr_errinfo_free(&err_info);
+    } else {
+        if (conn->ev_sess_pool_count < SR_EV_SESS_POOL_SIZE) {
+            /* keep it for reuse */
+            conn->ev_sess_pool[conn->ev_sess_pool_count++] = session;
+            session = NULL;
+        }
+
+        /* PTR UNLOCK */
+        sr_munlock(&conn->ptr_lock);
+    }
+
+    if (session) {
+        sr_session_stop(session);
+    }
+}
+
 API int
 sr_session_start(sr_conn_ctx_t *conn, const sr_datastore_t datastore, sr_session_ctx_t **session)
 {
@@ -883,6 +1091,7 @@ _sr_session_stop(sr_session_ctx_t *session)
         sr_release_data(session->dt[ds].edit);
         lyd_free_all(session->dt[ds].diff);
     }
+    sr_session_page_free(session);
     sr_rwlock_destroy(&session->notif_buf.lock);
     free(session);
 
@@ -1193,6 +1402,7 @@ sr_session_set_user(sr_session_ctx_t *session, const char *user)
     if (!session->user) {
         SR_ERRINFO_MEM(&err_info);
     }
+    session->user_changed = 1;
 
     return sr_api_ret(session, err_info);
 }
@@ -1615,7 +1825,7 @@ cleanup:
     sr_lycc_update_data_clear(&data_info);
     lyd_free_siblings(mod_data);
     lyd_free_siblings(sr_mods);
-    ly_ctx_destroy(old_ctx);
+    sr_ly_ctx_destroy(old_ctx);
     ly_ctx_destroy(new_ctx);
     free(mod_name);
 
@@ -1892,7 +2102,7 @@ cleanup:
     sr_lycc_update_data_clear(&data_info);
     lyd_free_siblings(sr_mods);
     lyd_free_siblings(sr_del_mods);
-    ly_ctx_destroy(old_ctx);
+    sr_ly_ctx_destroy(old_ctx);
     ly_ctx_destroy(new_ctx);
 
     /* CONTEXT UNLOCK */
@@ -2136,7 +2346,7 @@ sr_update_modules(sr_conn_ctx_t *conn, const char **schema_paths, const char *se
 cleanup:
     sr_lycc_update_data_clear(&data_info);
     lyd_free_siblings(sr_mods);
-    ly_ctx_destroy(old_ctx);
+    sr_ly_ctx_destroy(old_ctx);
     ly_ctx_destroy(new_ctx);
 
     /* CONTEXT UNLOCK */
@@ -2638,7 +2848,7 @@ sr_change_module_feature(sr_conn_ctx_t *conn, const char *module_name, const cha
 cleanup:
     sr_lycc_update_data_clear(&data_info);
     lyd_free_siblings(sr_mods);
-    ly_ctx_destroy(old_ctx);
+    sr_ly_ctx_destroy(old_ctx);
     ly_ctx_destroy(new_ctx);
 
     /* CONTEXT UNLOCK */
@@ -2870,111 +3080,570 @@ sr_acquire_data(sr_conn_ctx_t *conn, struct lyd_node *tree, sr_data_t **data)
     return sr_api_ret(NULL, err_info);
 }
 
-API int
-sr_get_items(sr_session_ctx_t *session, const char *xpath, uint32_t timeout_ms, const sr_get_options_t opts,
-        sr_val_t **values, size_t *value_cnt)
-{
-    sr_error_info_t *err_info = NULL;
-    struct ly_set *set = NULL;
-    struct sr_mod_info_s mod_info;
-    uint32_t i;
-
-    SR_CHECK_ARG_APIRET(!session || !xpath || !values || !value_cnt ||
-            ((session->ds != SR_DS_OPERATIONAL) && (opts & SR_OPER_MASK)), session, err_info);
-
-    if (!timeout_ms) {
-        timeout_ms = SR_OPER_CB_TIMEOUT;
+/**
+ * @brief Learn whether a schema node follows another one in the schema order of data siblings.
+ *
+ * @param[in] parent Data parent of the siblings, NULL for top-level siblings.
+ * @param[in] schema Schema node to check.
+ * @param[in] ref Reference schema node.
+ * @return Whether @p schema follows @p ref.
+ */
+static int
+sr_get_page_schema_follows(const struct lyd_node *parent, const struct lysc_node *schema, const struct lysc_node *ref)
+{
+    const struct lysc_node *iter = NULL;
+    const struct lys_module *mod;
+    uint32_t idx = 0;
+
+    if (!parent && (schema->module != ref->module)) {
+        /* top-level nodes of different modules, use the module order */
+        while ((mod = ly_ctx_get_module_iter(ref->module->ctx, &idx))) {
+            if (mod == ref->module) {
+                return 1;
+            } else if (mod == schema->module) {
+                return 0;
+            }
+        }
+        return 0;
     }
-    *values = NULL;
-    *value_cnt = 0;
-    /* for operational, use operational and running datastore */
-    SR_MODINFO_INIT(mod_info, session->conn, session->ds, session->ds == SR_DS_OPERATIONAL ? SR_DS_RUNNING : session->ds);
 
-    /* CONTEXT LOCK */
-    if ((err_info = sr_lycc_lock(session->conn, SR_LOCK_READ, 0, __func__))) {
-        return sr_api_ret(session, err_info);
+    while ((iter = lys_getnext(iter, parent ? parent->schema : NULL, parent ? NULL : ref->module->compiled, 0))) {
+        if (iter == ref) {
+            return 1;
+        } else if (iter == schema) {
+            return 0;
+        }
     }
+    return 0;
+}
 
-    /* collect all required modules */
-    if ((err_info = sr_modinfo_collect_xpath(session->conn->ly_ctx, xpath, session->ds, session,
-            MOD_INFO_XPATH_STORE_SESSION_CHANGES, &mod_info))) {
-        goto cleanup;
+/**
+ * @brief Compare 2 instances of a system-ordered list or leaf-list in their order.
+ *
+ * @param[in] node1 First instance.
+ * @param[in] node2 Second instance.
+ * @return Negative value if @p node1 precedes @p node2, 0 if they are equal, positive value otherwise.
+ */
+static int
+sr_get_page_inst_cmp(const struct lyd_node *node1, const struct lyd_node *node2)
+{
+    const struct lyd_node *key1, *key2;
+    const struct lysc_type *type;
+    int r;
+
+    if (node1->schema->nodetype == LYS_LEAFLIST) {
+        type = ((struct lysc_node_leaflist *)node1->schema)->type;
+        return type->plugin->sort(LYD_CTX(node1), &((struct lyd_node_term *)node1)->value,
+                &((struct lyd_node_term *)node2)->value);
     }
 
-    /* add modules into mod_info with deps, locking, and their data */
-    if ((err_info = sr_modinfo_consolidate(&mod_info, SR_LOCK_READ, SR_MI_DATA_RO | SR_MI_PERM_READ, session->sid,
-            session->orig_name, session->orig_data, timeout_ms, 0, opts))) {
-        goto cleanup;
+    /* list instances are ordered by their keys, which are always the first children */
+    key1 = lyd_child(node1);
+    key2 = lyd_child(node2);
+    while (key1 && key2 && lysc_is_key(key1->schema)) {
+        type = ((struct lysc_node_leaf *)key1->schema)->type;
+        r = type->plugin->sort(LYD_CTX(node1), &((struct lyd_node_term *)key1)->value,
+                &((struct lyd_node_term *)key2)->value);
+        if (r) {
+            return r;
+        }
+
+        key1 = key1->next;
+        key2 = key2->next;
     }
 
-    /* filter the required data */
-    if ((err_info = sr_modinfo_get_filter(&mod_info, (opts & SR_GET_NO_FILTER) ? "/*" : xpath, session, &set))) {
+    return 0;
+}
+
+/**
+ * @brief Find the data node that would follow a removed node in the document order.
+ *
+ * @param[in] data Data tree.
+ * @param[in] resume_path Path of the removed node.
+ * @param[out] next Following node, NULL if there is none.
+ * @return err_info, NULL on success.
+ */
+static sr_error_info_t *
+sr_get_page_resume_next(const struct lyd_node *data, const char *resume_path, const struct lyd_node **next)
+{
+    sr_error_info_t *err_info = NULL;
+    const struct ly_ctx *ly_ctx = LYD_CTX(data);
+    const struct lysc_node *schema;
+    struct lyd_node *parent = NULL, *siblings, *iter, *node = NULL, *tree = NULL, *removed;
+    const char *xp;
+    char *path = NULL;
+
+    *next = NULL;
+
+    /* find the first removed ancestor-or-self of the node */
+    xp = resume_path;
+    while (xp[0] == '/') {
+        xp = sr_xpath_next_qname(xp + 1, NULL, NULL, NULL, NULL);
+        while (xp[0] == '[') {
+            xp = sr_xpath_skip_predicate(xp);
+        }
+
+        free(path);
+        path = strndup(resume_path, xp - resume_path);
+        SR_CHECK_MEM_GOTO(!path, err_info, cleanup);
+        if ((err_info = sr_lyd_find_path(data, path, 0, &node))) {
+            goto cleanup;
+        }
+        if (!node) {
+            break;
+        }
+        parent = node;
+    }
+    if (!node) {
+        SR_ERRINFO_INT(&err_info);
         goto cleanup;
     }
-
-    /* apply NACM */
-    if ((err_info = sr_nacm_get_node_set_read_filter(session, set))) {
+    if ((err_info = sr_lys_find_path(ly_ctx, path, NULL, &schema))) {
         goto cleanup;
     }
+    siblings = parent ? lyd_child(parent) : (struct lyd_node *)data;
 
-    if (set->count) {
-        *values = calloc(set->count, sizeof **values);
-        SR_CHECK_MEM_GOTO(!*values, err_info, cleanup);
+    if ((schema->nodetype & (LYS_LIST | LYS_LEAFLIST)) && (lysc_is_userordered(schema) ||
+            lysc_is_dup_inst_list(schema))) {
+        /* the position of a removed instance is unknown, continuing from any instance could return some twice */
+        sr_errinfo_new(&err_info, SR_ERR_NOT_FOUND, "Resume instance \"%s\" was removed and its position in the "
+                "instances ordered by user is unknown.", path);
+        goto cleanup;
+    } else if (schema->nodetype & (LYS_LIST | LYS_LEAFLIST)) {
+        /* create only the removed instance and compare the existing ones with it */
+        if ((err_info = sr_lyd_new_path(NULL, ly_ctx, path, NULL, 0, &tree, &removed))) {
+            goto cleanup;
+        }
+        LYD_LIST_FOR_INST(siblings, schema, iter) {
+            if (sr_get_page_inst_cmp(iter, removed) > 0) {
+                /* first instance following the removed one */
+                *next = iter;
+                goto cleanup;
+            }
+        }
     }
 
-    for (i = 0; i < set->count; ++i) {
-        if ((err_info = sr_val_ly2sr(set->dnodes[i], (*values) + i))) {
+    /* first sibling of a following schema node */
+    LY_LIST_FOR(siblings, iter) {
+        if (iter->schema && (iter->schema != schema) && sr_get_page_schema_follows(parent, iter->schema, schema)) {
+            *next = iter;
             goto cleanup;
         }
-        ++(*value_cnt);
     }
 
-cleanup:
-    /* MODULES UNLOCK */
-    sr_shmmod_modinfo_unlock(&mod_info);
-
-    ly_set_free(set, NULL);
-    sr_modinfo_erase(&mod_info);
-
-    /* CONTEXT UNLOCK */
-    sr_lycc_unlock(session->conn, SR_LOCK_READ, 0, __func__);
-    if (err_info) {
-        sr_free_values(*values, *value_cnt);
-        *values = NULL;
-        *value_cnt = 0;
+    /* first node following the subtree of the parent */
+    for (iter = parent; iter && !iter->next; iter = lyd_parent(iter)) {}
+    if (iter) {
+        *next = iter->next;
     }
-    return sr_api_ret(session, err_info);
+
+cleanup:
+    free(path);
+    lyd_free_all(tree);
+    return err_info;
 }
 
-API int
-sr_get_subtree(sr_session_ctx_t *session, const char *path, uint32_t timeout_ms, sr_data_t **subtree)
+/**
+ * @brief Find the index of the first node of a set following the node selected by a resume path.
+ *
+ * If the node was removed, the page starts from the node that follows its original position.
+ *
+ * @param[in] data Data tree the set was created from.
+ * @param[in] set Set of selected nodes in the document order.
+ * @param[in] resume_path Path of the last node returned by the previous page, NULL to start from the beginning.
+ * @param[out] start Index of the first set node to return.
+ * @return err_info, NULL on success.
+ */
+static sr_error_info_t *
+sr_get_page_start(const struct lyd_node *data, const struct ly_set *set, const char *resume_path, uint32_t *start)
 {
     sr_error_info_t *err_info = NULL;
-    struct ly_set *set = NULL;
-    struct sr_mod_info_s mod_info;
-    int denied;
+    struct lyd_node *node = NULL, *root, *elem;
+    const struct lyd_node *next;
+    uint32_t i;
 
-    SR_CHECK_ARG_APIRET(!session || !path || !subtree, session, err_info);
+    *start = 0;
+    if (!resume_path || !data) {
+        return NULL;
+    }
 
-    if (!timeout_ms) {
-        timeout_ms = SR_OPER_CB_TIMEOUT;
+    if ((err_info = sr_lyd_find_path(data, resume_path, 0, &node))) {
+        return err_info;
     }
-    /* for operational, use operational and running datastore */
-    SR_MODINFO_INIT(mod_info, session->conn, session->ds, session->ds == SR_DS_OPERATIONAL ? SR_DS_RUNNING : session->ds);
+    if (node) {
+        for (i = 0; i < set->count; ++i) {
+            if (set->dnodes[i] == node) {
+                *start = i + 1;
+                return NULL;
+            }
+        }
 
-    /* CONTEXT LOCK */
-    if ((err_info = sr_lycc_lock(session->conn, SR_LOCK_READ, 0, __func__))) {
-        return sr_api_ret(session, err_info);
+        /* the node is not selected anymore, the page starts after it */
+        next = node;
+    } else {
+        /* the node was removed, the page starts from the node following it */
+        if ((err_info = sr_get_page_resume_next(data, resume_path, &next))) {
+            return err_info;
+        }
+        if (!next) {
+            *start = set->count;
+            return NULL;
+        }
     }
 
-    /* prepare data wrapper */
-    if ((err_info = _sr_acquire_data(session->conn, NULL, subtree))) {
-        goto cleanup;
+    /* count the selected nodes preceding the node in the document order */
+    LY_LIST_FOR((struct lyd_node *)data, root) {
+        LYD_TREE_DFS_BEGIN(root, elem) {
+            if ((elem == next) && !node) {
+                return NULL;
+            }
+            if ((*start < set->count) && (set->dnodes[*start] == elem)) {
+                ++(*start);
+            }
+            if (elem == next) {
+                return NULL;
+            }
+            LYD_TREE_DFS_END(root, elem);
+        }
     }
 
-    /* collect all the required modules, do not store xpaths if some changes will be applied (we need all the base data then) */
-    if ((err_info = sr_modinfo_collect_xpath(session->conn->ly_ctx, path, session->ds, session,
-            MOD_INFO_XPATH_STORE_SESSION_CHANGES, &mod_info))) {
+    return NULL;
+}
+
+/**
+ * @brief Select the nodes of a page into the cursor of a session.
+ *
+ * If the page continues the iteration of the cursor, its data snapshot is used. Otherwise, the data are loaded
+ * and the nodes selected into a new cursor.
+ *
+ * @param[in] session Session to use.
+ * @param[in] xpath XPath selecting the nodes.
+ * @param[in] resume_path Path of the last node returned by the previous page, NULL for the first page.
+ * @param[in] subtrees Whether to select only the subtree roots.
+ * @param[in] timeout_ms Operational callback timeout in milliseconds.
+ * @param[in] opts Get options.
+ * @param[out] start Index of the first node of the page in the cursor set.
+ * @return err_info, NULL on success.
+ */
+static sr_error_info_t *
+sr_get_page_select(sr_session_ctx_t *session, const char *xpath, const char *resume_path, int subtrees,
+        uint32_t timeout_ms, const sr_get_options_t opts, uint32_t *start)
+{
+    sr_error_info_t *err_info = NULL;
+    struct sr_sess_page_s *page = &session->page;
+    struct sr_mod_info_s mod_info;
+    struct lyd_node *data = NULL;
+    struct ly_set *set = NULL;
+
+    if (resume_path && page->next_path && !strcmp(page->next_path, resume_path) && !strcmp(page->xpath, xpath) &&
+            (page->ds == session->ds) && (page->opts == opts) && (page->subtrees == subtrees)) {
+        /* continue the iteration */
+        *start = page->next;
+        return NULL;
+    }
+
+    /* a new iteration */
+    sr_session_page_free(session);
+
+    /* for operational, use operational and running datastore */
+    SR_MODINFO_INIT(mod_info, session->conn, session->ds, session->ds == SR_DS_OPERATIONAL ? SR_DS_RUNNING : session->ds);
+
+    /* CONTEXT LOCK */
+    if ((err_info = sr_lycc_lock(session->conn, SR_LOCK_READ, 0, __func__))) {
+        return err_info;
+    }
+
+    /* collect all required modules */
+    if ((err_info = sr_modinfo_collect_xpath(session->conn->ly_ctx, xpath, session->ds, session,
+            MOD_INFO_XPATH_STORE_SESSION_CHANGES, &mod_info))) {
+        goto cleanup;
+    }
+
+    /* add modules into mod_info with deps, locking, and their data */
+    if ((err_info = sr_modinfo_consolidate(&mod_info, SR_LOCK_READ, SR_MI_DATA_RO | SR_MI_PERM_READ, session->sid,
+            session->orig_name, session->orig_data, timeout_ms, 0, opts))) {
+        goto cleanup;
+    }
+
+    if (mod_info.data_cached) {
+        /* the data are kept in the cursor, the cache cannot be used */
+        if ((err_info = sr_lyd_dup(mod_info.data, NULL, LYD_DUP_RECURSIVE | LYD_DUP_WITH_FLAGS, 1, &data))) {
+            goto cleanup;
+        }
+        mod_info.data = data;
+        data = NULL;
+        mod_info.data_cached = 0;
+
+        /* CACHE READ UNLOCK */
+        sr_rwunlock(&mod_info.conn->run_cache_lock, SR_CONN_RUN_CACHE_LOCK_TIMEOUT, SR_LOCK_READ, mod_info.conn->cid,
+                __func__);
+    }
+
+    /* filter the required data */
+    if ((err_info = sr_modinfo_get_filter(&mod_info, (opts & SR_GET_NO_FILTER) ? "/*" : xpath, session, &set))) {
+        goto cleanup;
+    }
+
+    if (subtrees) {
+        /* get rid of all redundant results that are descendants of another result */
+        if ((err_info = sr_xpath_set_filter_subtrees(set))) {
+            goto cleanup;
+        }
+    } else {
+        /* apply NACM */
+        if ((err_info = sr_nacm_get_node_set_read_filter(session, set))) {
+            goto cleanup;
+        }
+    }
+
+    /* take the data */
+    data = mod_info.data;
+    mod_info.data = NULL;
+
+    /* learn the first node of the page */
+    if ((err_info = sr_get_page_start(data, set, resume_path, start))) {
+        goto cleanup;
+    }
+
+    /* fill the cursor */
+    page->xpath = strdup(xpath);
+    SR_CHECK_MEM_GOTO(!page->xpath, err_info, cleanup);
+    page->ds = session->ds;
+    page->opts = opts;
+    page->subtrees = subtrees;
+    page->set = set;
+    set = NULL;
+
+cleanup:
+    /* MODULES UNLOCK */
+    sr_shmmod_modinfo_unlock(&mod_info);
+
+    ly_set_free(set, NULL);
+    sr_modinfo_erase(&mod_info);
+
+    if (err_info) {
+        lyd_free_all(data);
+
+        /* CONTEXT UNLOCK */
+        sr_lycc_unlock(session->conn, SR_LOCK_READ, 0, __func__);
+    } else {
+        /* the data snapshot keeps the context lock */
+        err_info = _sr_acquire_data(session->conn, data, &page->data);
+    }
+    if (err_info) {
+        sr_session_page_free(session);
+    }
+    return err_info;
+}
+
+/**
+ * @brief Move the cursor of a session after a returned page.
+ *
+ * @param[in] session Session with the cursor.
+ * @param[in] end Index of the first node of the cursor set following the page.
+ * @param[out] next_path Path of the last returned node if there are more nodes to return, NULL otherwise.
+ * @return err_info, NULL on success.
+ */
+static sr_error_info_t *
+sr_get_page_next(sr_session_ctx_t *session, uint32_t end, char **next_path)
+{
+    sr_error_info_t *err_info = NULL;
+    struct sr_sess_page_s *page = &session->page;
+
+    if (end == page->set->count) {
+        /* the iteration is finished */
+        sr_session_page_free(session);
+        return NULL;
+    }
+
+    free(page->next_path);
+    page->next_path = lyd_path(page->set->dnodes[end - 1], LYD_PATH_STD, NULL, 0);
+    SR_CHECK_MEM_RET(!page->next_path, err_info);
+    page->next = end;
+
+    *next_path = strdup(page->next_path);
+    SR_CHECK_MEM_RET(!*next_path, err_info);
+
+    return NULL;
+}
+
+/**
+ * @brief Get (a page of) data values selected by an XPath.
+ *
+ * @param[in] session Session to use.
+ * @param[in] xpath XPath of the data elements to be retrieved.
+ * @param[in] resume_path Path of the last value of the previous page, NULL for the first page.
+ * @param[in] page_size Maximum number of returned values, 0 for all the values without a cursor.
+ * @param[in] timeout_ms Operational callback timeout in milliseconds.
+ * @param[in] opts Get options.
+ * @param[out] values Array of returned values.
+ * @param[out] value_cnt Number of @p values.
+ * @param[out] next_path Path of the last returned value if there are more values to return, NULL otherwise.
+ * Required if @p page_size is set.
+ * @return err_info, NULL on success.
+ */
+static sr_error_info_t *
+_sr_get_items(sr_session_ctx_t *session, const char *xpath, const char *resume_path, uint32_t page_size,
+        uint32_t timeout_ms, const sr_get_options_t opts, sr_val_t **values, size_t *value_cnt, char **next_path)
+{
+    sr_error_info_t *err_info = NULL;
+    struct ly_set *set = NULL;
+    struct sr_mod_info_s mod_info;
+    uint32_t i, start = 0, end;
+
+    if (!timeout_ms) {
+        timeout_ms = SR_OPER_CB_TIMEOUT;
+    }
+    *values = NULL;
+    *value_cnt = 0;
+    if (next_path) {
+        *next_path = NULL;
+    }
+    /* for operational, use operational and running datastore */
+    SR_MODINFO_INIT(mod_info, session->conn, session->ds, session->ds == SR_DS_OPERATIONAL ? SR_DS_RUNNING : session->ds);
+
+    if (page_size) {
+        /* the selected nodes are kept in the cursor of the session */
+        if ((err_info = sr_get_page_select(session, xpath, resume_path, 0, timeout_ms, opts, &start))) {
+            return err_info;
+        }
+        set = session->page.set;
+        goto get_values;
+    }
+
+    /* CONTEXT LOCK */
+    if ((err_info = sr_lycc_lock(session->conn, SR_LOCK_READ, 0, __func__))) {
+        return err_info;
+    }
+
+    /* collect all required modules */
+    if ((err_info = sr_modinfo_collect_xpath(session->conn->ly_ctx, xpath, session->ds, session,
+            MOD_INFO_XPATH_STORE_SESSION_CHANGES, &mod_info))) {
+        goto cleanup;
+    }
+
+    /* add modules into mod_info with deps, locking, and their data */
+    if ((err_info = sr_modinfo_consolidate(&mod_info, SR_LOCK_READ, SR_MI_DATA_RO | SR_MI_PERM_READ, session->sid,
+            session->orig_name, session->orig_data, timeout_ms, 0, opts))) {
+        goto cleanup;
+    }
+
+    /* filter the required data */
+    if ((err_info = sr_modinfo_get_filter(&mod_info, (opts & SR_GET_NO_FILTER) ? "/*" : xpath, session, &set))) {
+        goto cleanup;
+    }
+
+    /* apply NACM */
+    if ((err_info = sr_nacm_get_node_set_read_filter(session, set))) {
+        goto cleanup;
+    }
+
+get_values:
+    /* learn the page end */
+    end = set->count;
+    if (page_size && (set->count - start > page_size)) {
+        end = start + page_size;
+    }
+
+    if (end > start) {
+        *values = calloc(end - start, sizeof **values);
+        SR_CHECK_MEM_GOTO(!*values, err_info, cleanup);
+    }
+
+    for (i = start; i < end; ++i) {
+        if ((err_info = sr_val_ly2sr(set->dnodes[i], (*values) + (i - start)))) {
+            goto cleanup;
+        }
+        ++(*value_cnt);
+    }
+
+    if (page_size) {
+        /* move the cursor */
+        err_info = sr_get_page_next(session, end, next_path);
+    }
+
+cleanup:
+    if (page_size) {
+        if (err_info) {
+            sr_session_page_free(session);
+        }
+    } else {
+        /* MODULES UNLOCK */
+        sr_shmmod_modinfo_unlock(&mod_info);
+
+        ly_set_free(set, NULL);
+        sr_modinfo_erase(&mod_info);
+
+        /* CONTEXT UNLOCK */
+        sr_lycc_unlock(session->conn, SR_LOCK_READ, 0, __func__);
+    }
+    if (err_info) {
+        sr_free_values(*values, *value_cnt);
+        *values = NULL;
+        *value_cnt = 0;
+        if (next_path) {
+            free(*next_path);
+            *next_path = NULL;
+        }
+    }
+    return err_info;
+}
+
+API int
+sr_get_items(sr_session_ctx_t *session, const char *xpath, uint32_t timeout_ms, const sr_get_options_t opts,
+        sr_val_t **values, size_t *value_cnt)
+{
+    sr_error_info_t *err_info = NULL;
+
+    SR_CHECK_ARG_APIRET(!session || !xpath || !values || !value_cnt ||
+            ((session->ds != SR_DS_OPERATIONAL) && (opts & SR_OPER_MASK)), session, err_info);
+
+    err_info = _sr_get_items(session, xpath, NULL, 0, timeout_ms, opts, values, value_cnt, NULL);
+    return sr_api_ret(session, err_info);
+}
+
+API int
+sr_get_items_page(sr_session_ctx_t *session, const char *xpath, const char *resume_path, uint32_t page_size,
+        uint32_t timeout_ms, const sr_get_options_t opts, sr_val_t **values, size_t *value_cnt, char **next_path)
+{
+    sr_error_info_t *err_info = NULL;
+
+    SR_CHECK_ARG_APIRET(!session || !xpath || !page_size || !values || !value_cnt || !next_path ||
+            ((session->ds != SR_DS_OPERATIONAL) && (opts & SR_OPER_MASK)), session, err_info);
+
+    err_info = _sr_get_items(session, xpath, resume_path, page_size, timeout_ms, opts, values, value_cnt, next_path);
+    return sr_api_ret(session, err_info);
+}
+
+API int
+sr_get_subtree(sr_session_ctx_t *session, const char *path, uint32_t timeout_ms, sr_data_t **subtree)
+{
+    sr_error_info_t *err_info = NULL;
+    struct ly_set *set = NULL;
+    struct sr_mod_info_s mod_info;
+    int denied;
+
+    SR_CHECK_ARG_APIRET(!session || !path || !subtree, session, err_info);
+
+    if (!timeout_ms) {
+        timeout_ms = SR_OPER_CB_TIMEOUT;
+    }
+    /* for operational, use operational and running datastore */
+    SR_MODINFO_INIT(mod_info, session->conn, session->ds, session->ds == SR_DS_OPERATIONAL ? SR_DS_RUNNING : session->ds);
+
+    /* CONTEXT LOCK */
+    if ((err_info = sr_lycc_lock(session->conn, SR_LOCK_READ, 0, __func__))) {
+        return sr_api_ret(session, err_info);
+    }
+
+    /* prepare data wrapper */
+    if ((err_info = _sr_acquire_data(session->conn, NULL, subtree))) {
+        goto cleanup;
+    }
+
+    /* collect all the required modules, do not store xpaths if some changes will be applied (we need all the base data then) */
+    if ((err_info = sr_modinfo_collect_xpath(session->conn->ly_ctx, path, session->ds, session,
+            MOD_INFO_XPATH_STORE_SESSION_CHANGES, &mod_info))) {
         goto cleanup;
     }
 
@@ -3048,66 +3717,34 @@ sr_lyht_value_get_data_equal_cb(void *val1_p, void *val2_p, ly_bool UNUSED(mod),
     return val1->input_parent == val2->input_parent;
 }
 
-API int
-sr_get_data(sr_session_ctx_t *session, const char *xpath, uint32_t max_depth, uint32_t timeout_ms,
-        const sr_get_options_t opts, sr_data_t **data)
+/**
+ * @brief Duplicate selected subtrees into a result data tree.
+ *
+ * @param[in] session Session to use for NACM filtering.
+ * @param[in] set Set of selected nodes with redundant descendant results removed.
+ * @param[in] start Index of the first set node to process.
+ * @param[in] limit Maximum number of subtrees to add into the result, 0 for unlimited.
+ * @param[in] max_depth Maximum depth of the selected subtrees.
+ * @param[in,out] tree Result data tree to add to.
+ * @param[out] next Index of the first unprocessed set node, set count if all were processed.
+ * @return err_info, NULL on success.
+ */
+static sr_error_info_t *
+sr_get_data_dup_set(sr_session_ctx_t *session, const struct ly_set *set, uint32_t start, uint32_t limit,
+        uint32_t max_depth, struct lyd_node **tree, uint32_t *next)
 {
     sr_error_info_t *err_info = NULL;
-    uint32_t i, hash;
+    uint32_t i, hash, count = 0;
     int dup_opts, denied;
-    struct sr_mod_info_s mod_info;
-    struct ly_set *set = NULL;
     struct lyd_node *node, *parent, *node_parent, *input_node;
     struct ly_ht *ht = NULL;
     struct sr_lyht_get_data_rec rec, *rec_p;
 
-    SR_CHECK_ARG_APIRET(!session || !xpath || !data || ((session->ds != SR_DS_OPERATIONAL) && (opts & SR_OPER_MASK)),
-            session, err_info);
-
-    if (!timeout_ms) {
-        timeout_ms = SR_OPER_CB_TIMEOUT;
-    }
-
-    /* for operational, use operational and running datastore */
-    SR_MODINFO_INIT(mod_info, session->conn, session->ds, session->ds == SR_DS_OPERATIONAL ? SR_DS_RUNNING : session->ds);
-
-    /* CONTEXT LOCK */
-    if ((err_info = sr_lycc_lock(session->conn, SR_LOCK_READ, 0, __func__))) {
-        return sr_api_ret(session, err_info);
-    }
-
-    /* prepare data wrapper */
-    if ((err_info = _sr_acquire_data(session->conn, NULL, data))) {
-        goto cleanup;
-    }
-
-    /* collect all required modules */
-    if ((err_info = sr_modinfo_collect_xpath(session->conn->ly_ctx, xpath, session->ds, session,
-            MOD_INFO_XPATH_STORE_SESSION_CHANGES, &mod_info))) {
-        goto cleanup;
-    }
-
-    /* add modules into mod_info with deps, locking, and their data */
-    if ((err_info = sr_modinfo_consolidate(&mod_info, SR_LOCK_READ, SR_MI_DATA_RO | SR_MI_PERM_READ, session->sid,
-            session->orig_name, session->orig_data, timeout_ms, 0, opts))) {
-        goto cleanup;
-    }
-
-    /* filter the required data */
-    if ((err_info = sr_modinfo_get_filter(&mod_info, (opts & SR_GET_NO_FILTER) ? "/*" : xpath, session, &set))) {
-        goto cleanup;
-    }
-
-    /* get rid of all redundant results that are descendants of another result */
-    if ((err_info = sr_xpath_set_filter_subtrees(set))) {
-        goto cleanup;
-    }
-
     /* create a hash table for finding existing parents */
     ht = lyht_new(1, sizeof rec, sr_lyht_value_get_data_equal_cb, NULL, 1);
     SR_CHECK_MEM_GOTO(!ht, err_info, cleanup);
 
-    for (i = 0; i < set->count; ++i) {
+    for (i = start; (i < set->count) && (!limit || (count < limit)); ++i) {
         /* check whether a parent does not exist yet in the result */
         for (parent = lyd_parent(set->dnodes[i]); parent; parent = lyd_parent(parent)) {
             hash = lyht_hash((void *)&parent, sizeof parent);
@@ -3146,7 +3783,7 @@ sr_get_data(sr_session_ctx_t *session, const char *xpath, uint32_t max_depth, ui
 
         if (!parent) {
             /* connect to the result */
-            if ((err_info = sr_lyd_insert_sibling((*data)->tree, node_parent, &(*data)->tree))) {
+            if ((err_info = sr_lyd_insert_sibling(*tree, node_parent, tree))) {
                 lyd_free_tree(node);
                 goto cleanup;
             }
@@ -3166,20 +3803,152 @@ sr_get_data(sr_session_ctx_t *session, const char *xpath, uint32_t max_depth, ui
             /* move input */
             input_node = lyd_parent(input_node);
         }
+
+        ++count;
     }
 
-cleanup:
-    /* MODULES UNLOCK */
-    sr_shmmod_modinfo_unlock(&mod_info);
+    if (next) {
+        *next = i;
+    }
 
-    ly_set_free(set, NULL);
-    sr_modinfo_erase(&mod_info);
+cleanup:
     lyht_free(ht, NULL);
+    return err_info;
+}
+
+/**
+ * @brief Get a page of data subtrees selected by an XPath.
+ *
+ * @param[in] session Session to use.
+ * @param[in] xpath XPath selecting root nodes of subtrees to be retrieved.
+ * @param[in] resume_path Path of the last subtree root of the previous page, NULL for the first page.
+ * @param[in] page_size Maximum number of returned subtrees, 0 for unlimited.
+ * @param[in] max_depth Maximum depth of the selected subtrees.
+ * @param[in] timeout_ms Operational callback timeout in milliseconds.
+ * @param[in] opts Get options.
+ * @param[out] data SR data with the selected subtrees, NULL if none found.
+ * @param[out] next_path Optional path of the last returned subtree root if there are more subtrees to return,
+ * NULL otherwise.
+ * @return err_info, NULL on success.
+ */
+static sr_error_info_t *
+_sr_get_data(sr_session_ctx_t *session, const char *xpath, const char *resume_path, uint32_t page_size,
+        uint32_t max_depth, uint32_t timeout_ms, const sr_get_options_t opts, sr_data_t **data, char **next_path)
+{
+    sr_error_info_t *err_info = NULL;
+    uint32_t start = 0, next;
+    struct sr_mod_info_s mod_info;
+    struct ly_set *set = NULL;
+
+    if (!timeout_ms) {
+        timeout_ms = SR_OPER_CB_TIMEOUT;
+    }
+    if (next_path) {
+        *next_path = NULL;
+    }
+
+    /* for operational, use operational and running datastore */
+    SR_MODINFO_INIT(mod_info, session->conn, session->ds, session->ds == SR_DS_OPERATIONAL ? SR_DS_RUNNING : session->ds);
+
+    /* CONTEXT LOCK */
+    if ((err_info = sr_lycc_lock(session->conn, SR_LOCK_READ, 0, __func__))) {
+        return err_info;
+    }
+
+    /* prepare data wrapper */
+    if ((err_info = _sr_acquire_data(session->conn, NULL, data))) {
+        goto cleanup;
+    }
+
+    if (page_size) {
+        /* the selected subtrees are kept in the cursor of the session */
+        if ((err_info = sr_get_page_select(session, xpath, resume_path, 1, timeout_ms, opts, &start))) {
+            goto cleanup;
+        }
+        set = session->page.set;
+        goto dup_subtrees;
+    }
+
+    /* collect all required modules */
+    if ((err_info = sr_modinfo_collect_xpath(session->conn->ly_ctx, xpath, session->ds, session,
+            MOD_INFO_XPATH_STORE_SESSION_CHANGES, &mod_info))) {
+        goto cleanup;
+    }
+
+    /* add modules into mod_info with deps, locking, and their data */
+    if ((err_info = sr_modinfo_consolidate(&mod_info, SR_LOCK_READ, SR_MI_DATA_RO | SR_MI_PERM_READ, session->sid,
+            session->orig_name, session->orig_data, timeout_ms, 0, opts))) {
+        goto cleanup;
+    }
+
+    /* filter the required data */
+    if ((err_info = sr_modinfo_get_filter(&mod_info, (opts & SR_GET_NO_FILTER) ? "/*" : xpath, session, &set))) {
+        goto cleanup;
+    }
+
+    /* get rid of all redundant results that are descendants of another result */
+    if ((err_info = sr_xpath_set_filter_subtrees(set))) {
+        goto cleanup;
+    }
+
+dup_subtrees:
+    /* duplicate the selected subtrees */
+    if ((err_info = sr_get_data_dup_set(session, set, start, page_size, max_depth, &(*data)->tree, &next))) {
+        goto cleanup;
+    }
+
+    if (page_size) {
+        /* move the cursor */
+        err_info = sr_get_page_next(session, next, next_path);
+    }
+
+cleanup:
+    if (page_size) {
+        if (err_info) {
+            sr_session_page_free(session);
+        }
+    } else {
+        /* MODULES UNLOCK */
+        sr_shmmod_modinfo_unlock(&mod_info);
+
+        ly_set_free(set, NULL);
+        sr_modinfo_erase(&mod_info);
+    }
 
     if (err_info || !(*data)->tree) {
         sr_release_data(*data);
         *data = NULL;
     }
+    if (err_info && next_path) {
+        free(*next_path);
+        *next_path = NULL;
+    }
+    return err_info;
+}
+
+API int
+sr_get_data(sr_session_ctx_t *session, const char *xpath, uint32_t max_depth, uint32_t timeout_ms,
+        const sr_get_options_t opts, sr_data_t **data)
+{
+    sr_error_info_t *err_info = NULL;
+
+    SR_CHECK_ARG_APIRET(!session || !xpath || !data || ((session->ds != SR_DS_OPERATIONAL) && (opts & SR_OPER_MASK)),
+            session, err_info);
+
+    err_info = _sr_get_data(session, xpath, NULL, 0, max_depth, timeout_ms, opts, data, NULL);
+    return sr_api_ret(session, err_info);
+}
+
+API int
+sr_get_data_page(sr_session_ctx_t *session, const char *xpath, const char *resume_path, uint32_t page_size,
+        uint32_t max_depth, uint32_t timeout_ms, const sr_get_options_t opts, sr_data_t **data, char **next_path)
+{
+    sr_error_info_t *err_info = NULL;
+
+    SR_CHECK_ARG_APIRET(!session || !xpath || !page_size || !data || !next_path ||
+            ((session->ds != SR_DS_OPERATIONAL) && (opts & SR_OPER_MASK)), session, err_info);
+
+    err_info = _sr_get_data(session, xpath, resume_path, page_size, max_depth, timeout_ms, opts, data, next_path);
     return sr_api_ret(session, err_info);
 }
 
@@ -3553,45 +4322,29 @@ cleanup:
     return sr_api_ret(session, err_info);
 }
 
-API int
-sr_edit_batch(sr_session_ctx_t *session, const struct lyd_node *edit, const char *default_operation)
+/**
+ * @brief Finish a batch edit before storing it in a session.
+ *
+ * @param[in] session Session of the edit.
+ * @param[in] edit Edit to finish.
+ * @param[in] default_operation Default operation for nodes without any operation.
+ * @return err_info, NULL on success.
+ */
+static sr_error_info_t *
+sr_edit_batch_finish(sr_session_ctx_t *session, struct lyd_node *edit, const char *default_operation)
 {
     sr_error_info_t *err_info = NULL;
-    struct lyd_node *dup_edit = NULL, *root, *elem;
+    struct lyd_node *root, *elem;
     enum edit_op op;
 
-    SR_CHECK_ARG_APIRET(!session || !edit || !default_operation || !SR_IS_STANDARD_DS(session->ds), session, err_info);
-    SR_CHECK_ARG_APIRET(strcmp(default_operation, "merge") && strcmp(default_operation, "replace") &&
-            strcmp(default_operation, "none"), session, err_info);
-
-    if (session->dt[session->ds].edit) {
-        /* do not allow merging NETCONF edits into sysrepo ones, it can cause some unexpected results */
-        sr_errinfo_new(&err_info, SR_ERR_UNSUPPORTED, "There are already some session changes.");
-        goto cleanup;
-    }
-
-    /* CONTEXT LOCK */
-    if ((err_info = sr_lycc_lock(session->conn, SR_LOCK_READ, 0, __func__))) {
-        goto cleanup;
-    }
-
-    if (session->conn->ly_ctx != LYD_CTX(edit)) {
-        sr_errinfo_new(&err_info, SR_ERR_INVAL_ARG, "Data trees must be created using the session connection libyang context.");
-        goto cleanup_unlock;
-    }
-
-    if ((err_info = sr_lyd_dup(edit, NULL, LYD_DUP_RECURSIVE, 1, &dup_edit))) {
-        goto cleanup_unlock;
-    }
-
     /* add default operation and default origin */
-    LY_LIST_FOR(dup_edit, root) {
+    LY_LIST_FOR(edit, root) {
         if (!sr_edit_diff_find_oper(root, 0, NULL) && (err_info = sr_edit_set_oper(root, default_operation))) {
-            goto cleanup_unlock;
+            return err_info;
         }
         if (session->ds == SR_DS_OPERATIONAL) {
             if ((err_info = sr_edit_diff_set_origin(root, SR_OPER_ORIGIN, 0))) {
-                goto cleanup_unlock;
+                return err_info;
             }
 
             /* check that no forbidden data/operations are set */
@@ -3600,12 +4353,12 @@ sr_edit_batch(sr_session_ctx_t *session, const struct lyd_node *edit, const char
                         strcmp(lyd_node_module(elem)->name, "sysrepo") || strcmp(LYD_NAME(elem), "discard-items"))) {
                     sr_errinfo_new(&err_info, SR_ERR_UNSUPPORTED, "Opaque node \"%s\" is not allowed for operational "
                             "datastore changes.", LYD_NAME(elem));
-                    goto cleanup_unlock;
+                    return err_info;
                 } else if (lysc_is_dup_inst_list(elem->schema) &&
                         !lyd_find_meta(elem->meta, NULL, "sysrepo:dup-inst-list-position")) {
                     /* fine, just create the metadata with empty value so that the instance is created */
                     if ((err_info = sr_lyd_new_meta(elem, NULL, "sysrepo:dup-inst-list-position", ""))) {
-                        goto cleanup_unlock;
+                        return err_info;
                     }
                 }
 
@@ -3613,7 +4366,7 @@ sr_edit_batch(sr_session_ctx_t *session, const struct lyd_node *edit, const char
                 if (op && (op != EDIT_MERGE) && (op != EDIT_REMOVE) && (op != EDIT_PURGE) && (op != EDIT_ETHER)) {
                     sr_errinfo_new(&err_info, SR_ERR_UNSUPPORTED, "Operation \"%s\" is not allowed for operational "
                             "datastore changes.", sr_edit_op2str(op));
-                    goto cleanup_unlock;
+                    return err_info;
                 }
 
                 LYD_TREE_DFS_END(root, elem);
@@ -3621,11 +4374,99 @@ sr_edit_batch(sr_session_ctx_t *session, const struct lyd_node *edit, const char
         }
     }
 
+    return NULL;
+}
+
+API int
+sr_edit_batch(sr_session_ctx_t *session, const struct lyd_node *edit, const char *default_operation)
+{
+    sr_error_info_t *err_info = NULL;
+    struct lyd_node *dup_edit = NULL;
+
+    SR_CHECK_ARG_APIRET(!session || !edit || !default_operation || !SR_IS_STANDARD_DS(session->ds), session, err_info);
+    SR_CHECK_ARG_APIRET(strcmp(default_operation, "merge") && strcmp(default_operation, "replace") &&
+            strcmp(default_operation, "none"), session, err_info);
+
+    if (session->dt[session->ds].edit) {
+        /* do not allow merging NETCONF edits into sysrepo ones, it can cause some unexpected results */
+        sr_errinfo_new(&err_info, SR_ERR_UNSUPPORTED, "There are already some session changes.");
+        goto cleanup;
+    }
+
+    /* CONTEXT LOCK */
+    if ((err_info = sr_lycc_lock(session->conn, SR_LOCK_READ, 0, __func__))) {
+        goto cleanup;
+    }
+
+    if (session->conn->ly_ctx != LYD_CTX(edit)) {
+        sr_errinfo_new(&err_info, SR_ERR_INVAL_ARG, "Data trees must be created using the session connection libyang context.");
+        goto cleanup_unlock;
+    }
+
+    if ((err_info = sr_lyd_dup(edit, NULL, LYD_DUP_RECURSIVE, 1, &dup_edit))) {
+        goto cleanup_unlock;
+    }
+
+    if ((err_info = sr_edit_batch_finish(session, dup_edit, default_operation))) {
+        goto cleanup_unlock;
+    }
+
     /* store edit in the session, keep context lock */
     if ((err_info = _sr_acquire_data(session->conn, dup_edit, &session->dt[session->ds].edit))) {
         goto cleanup;
     }
-    dup_edit = NULL;
+    dup_edit = NULL;
+    goto cleanup;
+
+cleanup_unlock:
+    /* CONTEXT UNLOCK */
+    sr_lycc_unlock(session->conn, SR_LOCK_READ, 0, __func__);
+
+cleanup:
+    lyd_free_siblings(dup_edit);
+    return sr_api_ret(session, err_info);
+}
+
+API int
+sr_edit_bulk(sr_session_ctx_t *session, const sr_edit_item_t *items, uint32_t item_count,
+        const char *default_operation)
+{
+    sr_error_info_t *err_info = NULL;
+    struct lyd_node *edit = NULL;
+
+    SR_CHECK_ARG_APIRET(!session || (!items && item_count) || !default_operation || !SR_IS_STANDARD_DS(session->ds),
+            session, err_info);
+    SR_CHECK_ARG_APIRET(strcmp(default_operation, "merge") && strcmp(default_operation, "replace") &&
+            strcmp(default_operation, "none"), session, err_info);
+
+    if (session->dt[session->ds].edit) {
+        /* the items are not matched against existing changes */
+        sr_errinfo_new(&err_info, SR_ERR_UNSUPPORTED, "There are already some session changes.");
+        goto cleanup;
+    }
+    if (!item_count) {
+        goto cleanup;
+    }
+
+    /* CONTEXT LOCK */
+    if ((err_info = sr_lycc_lock(session->conn, SR_LOCK_READ, 0, __func__))) {
+        goto cleanup;
+    }
+
+    /* create the whole edit at once */
+    if ((err_info = sr_edit_bulk_create(session->conn->ly_ctx, items, item_count, &edit))) {
+        goto cleanup_unlock;
+    }
+
+    if ((err_info = sr_edit_batch_finish(session, edit, default_operation))) {
+        goto cleanup_unlock;
+    }
+
+    /* store edit in the session, keep context lock */
+    if ((err_info = _sr_acquire_data(session->conn, edit, &session->dt[session->ds].edit))) {
+        goto cleanup;
+    }
+    edit = NULL;
     goto cleanup;
 
 cleanup_unlock:
@@ -3633,7 +4474,7 @@ cleanup_unlock:
     sr_lycc_unlock(session->conn, SR_LOCK_READ, 0, __func__);
 
 cleanup:
-    lyd_free_siblings(dup_edit);
+    lyd_free_siblings(edit);
     return sr_api_ret(session, err_info);
 }
 
@@ -3864,73 +4705,478 @@ sr_changes_notify_store(struct sr_mod_info_s *mod_info, sr_session_ctx_t *sessio
         goto cleanup;
     }
 
-    /* CHANGE SUB READ LOCK */
-    if ((err_info = sr_modinfo_changesub_rdlock(mod_info))) {
-        goto cleanup;
+    /* CHANGE SUB READ LOCK */
+    if ((err_info = sr_modinfo_changesub_rdlock(mod_info))) {
+        goto cleanup;
+    }
+    change_sub_lock = SR_LOCK_READ;
+
+    /* first publish "update" event for the diff to be updated */
+    if ((err_info = sr_modinfo_change_notify_update(mod_info, session, timeout_ms, &change_sub_lock, cb_err_info)) ||
+            *cb_err_info) {
+        goto cleanup;
+    }
+
+    if (!mod_info->diff) {
+        SR_LOG_INF("No \"%s\" datastore changes to apply.", sr_ds2str(mod_info->ds));
+        goto store;
+    }
+
+    /* publish final diff in a "change" event for any subscribers and wait for them */
+    if ((err_info = sr_shmsub_change_notify_change(mod_info, orig_name, orig_data, timeout_ms, cb_err_info))) {
+        goto cleanup;
+    }
+    if (*cb_err_info) {
+        /* "change" event failed, publish "abort" event and finish */
+        err_info = sr_shmsub_change_notify_change_abort(mod_info, orig_name, orig_data, timeout_ms);
+        goto cleanup;
+    }
+
+store:
+    if (!mod_info->diff && !sr_modinfo_is_changed(mod_info)) {
+        /* there is no diff and no changed modules, nothing to store */
+        goto cleanup;
+    }
+
+    /* MODULES WRITE LOCK (upgrade) */
+    if ((err_info = sr_shmmod_modinfo_rdlock_upgrade(mod_info, sid, timeout_ms, timeout_ms))) {
+        goto cleanup;
+    }
+
+    /* store updated datastore */
+    if ((err_info = sr_modinfo_data_store(mod_info))) {
+        goto cleanup;
+    }
+
+    /* MODULES READ LOCK (downgrade) */
+    if ((err_info = sr_shmmod_modinfo_wrlock_downgrade(mod_info, sid, timeout_ms))) {
+        goto cleanup;
+    }
+
+    /* publish "done" event, all changes were applied */
+    if ((err_info = sr_shmsub_change_notify_change_done(mod_info, orig_name, orig_data, timeout_ms))) {
+        goto cleanup;
+    }
+
+    /* generate netconf-config-change notification */
+    if (session && (err_info = sr_modinfo_generate_config_change_notif(mod_info, session))) {
+        goto cleanup;
+    }
+
+cleanup:
+    if (change_sub_lock) {
+        assert(change_sub_lock == SR_LOCK_READ);
+
+        /* CHANGE SUB READ UNLOCK */
+        sr_modinfo_changesub_rdunlock(mod_info);
+    }
+
+    free(denied.rule_name);
+    return err_info;
+}
+
+/**
+ * @brief Validate and store changed data without any diff, when there is no one to notify.
+ *
+ * @param[in] mod_info Mod info with the changed data.
+ * @param[in] session Session to use.
+ * @param[in] timeout_ms Module lock timeout in milliseconds.
+ * @return err_info, NULL on success.
+ */
+static sr_error_info_t *
+sr_changes_store_no_diff(struct sr_mod_info_s *mod_info, sr_session_ctx_t *session, uint32_t timeout_ms)
+{
+    sr_error_info_t *err_info = NULL;
+
+    assert(!mod_info->diff);
+
+    if (!sr_modinfo_is_changed(mod_info)) {
+        SR_LOG_INF("No \"%s\" datastore changes to apply.", sr_ds2str(mod_info->ds));
+        return NULL;
+    }
+
+    if (mod_info->ds != SR_DS_OPERATIONAL) {
+        /* collect validation dependencies and add those to mod_info as well */
+        if ((err_info = sr_modinfo_collect_deps(mod_info))) {
+            return err_info;
+        }
+        if ((err_info = sr_modinfo_consolidate(mod_info, SR_LOCK_READ, SR_MI_NEW_DEPS | SR_MI_PERM_NO, session->sid,
+                session->orig_name, session->orig_data, 0, 0, 0))) {
+            return err_info;
+        }
+
+        /* validate new data trees, there is no diff to finish */
+        if ((err_info = sr_modinfo_validate(mod_info, MOD_INFO_CHANGED | MOD_INFO_INV_DEP, 0))) {
+            return err_info;
+        }
+    } /* else stored oper edit is not validated */
+
+    /* check write perm */
+    if ((err_info = sr_modinfo_perm_check(mod_info, 1, 1))) {
+        return err_info;
+    }
+
+    /* MODULES WRITE LOCK (upgrade) */
+    if ((err_info = sr_shmmod_modinfo_rdlock_upgrade(mod_info, session->sid, timeout_ms, timeout_ms))) {
+        return err_info;
+    }
+
+    /* store the new data */
+    if ((err_info = sr_modinfo_data_store(mod_info))) {
+        return err_info;
+    }
+
+    /* MODULES READ LOCK (downgrade) */
+    if ((err_info = sr_shmmod_modinfo_wrlock_downgrade(mod_info, session->sid, timeout_ms))) {
+        return err_info;
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Queued request to apply changes of a session.
+ */
+struct sr_commit_req_s {
+    sr_session_ctx_t *session;      /**< Session with the changes. */
+    uint32_t timeout_ms;            /**< Change callback timeout in milliseconds. */
+    sr_error_info_t *err_info;      /**< Error info of applying the changes. */
+    sr_error_info_t *cb_err_info;   /**< Callback error info of applying the changes. */
+    int applied;                    /**< Whether the changes were applied (or failed to be). */
+    int taken;                      /**< Whether the request was taken from the queue to be applied. */
+    int done;                       /**< Whether the request is finished and its session can be used again. */
+    int leader;                     /**< Whether the request was chosen to apply the next queued requests. */
+    struct sr_commit_req_s *next;   /**< Next queued request. */
+};
+
+/**
+ * @brief Learn whether edits of sessions are large enough for skipping an unneeded diff to pay off. Diff of small
+ * edits is cheap and may allow skipping validation of bounded changes.
+ *
+ * @param[in] sessions Sessions with the changes.
+ * @param[in] session_count Count of @p sessions.
+ * @return Whether the edits are large.
+ */
+static int
+sr_changes_edit_is_large(sr_session_ctx_t **sessions, uint32_t session_count)
+{
+    const struct lyd_node *root, *elem;
+    uint32_t i, count = 0;
+
+    for (i = 0; i < session_count; ++i) {
+        LY_LIST_FOR(sessions[i]->dt[sessions[0]->ds].edit->tree, root) {
+            LYD_TREE_DFS_BEGIN(root, elem) {
+                if (++count >= SR_EDIT_NO_DIFF_NODE_COUNT) {
+                    return 1;
+                }
+                LYD_TREE_DFS_END(root, elem);
+            }
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Apply changes of one or more sessions in a single transaction.
+ *
+ * @param[in] sessions Sessions with the changes, the first one is used as the originator of all the changes.
+ * @param[in] session_count Count of @p sessions.
+ * @param[in] timeout_ms Change callback timeout in milliseconds.
+ * @param[out] cb_err_info Callback error info in case an operation callback failed.
+ * @return err_info, NULL on success.
+ */
+static sr_error_info_t *
+_sr_apply_changes(sr_session_ctx_t **sessions, uint32_t session_count, uint32_t timeout_ms,
+        sr_error_info_t **cb_err_info)
+{
+    sr_error_info_t *err_info = NULL;
+    sr_session_ctx_t *session = sessions[0];
+    struct sr_mod_info_s mod_info;
+    uint32_t i, mi_opts;
+    int create_diff = 1;
+
+    /* even for operational datastore, we do not need any running data */
+    SR_MODINFO_INIT(mod_info, session->conn, session->ds, session->ds);
+
+    mi_opts = SR_MI_LOCK_UPGRADEABLE | SR_MI_PERM_NO;
+    if ((session->ds != SR_DS_OPERATIONAL) && (session->ds != SR_DS_CANDIDATE)) {
+        mi_opts |= SR_MI_INV_DEPS;
+    } /* else stored oper edit or candidate data are not validated so we do not need data from other modules */
+
+    /* collect all required modules */
+    for (i = 0; i < session_count; ++i) {
+        if ((err_info = sr_modinfo_collect_edit(sessions[i]->dt[session->ds].edit->tree, &mod_info))) {
+            goto cleanup;
+        }
+    }
+
+    /* add modules into mod_info with deps, locking, and their data */
+    if ((err_info = sr_modinfo_consolidate(&mod_info, SR_LOCK_READ, mi_opts, session->sid, session->orig_name,
+            session->orig_data, 0, 0, 0))) {
+        goto cleanup;
+    }
+
+    if (!session->nacm_user &&
+            ((mod_info.ds == SR_DS_OPERATIONAL) || sr_changes_edit_is_large(sessions, session_count))) {
+        /* build the diff only if there is anyone to use it, NACM is checked on it; stored oper edit is never
+         * validated so even small oper edits, such as frequent counter updates, skip it */
+        if ((err_info = sr_modinfo_diff_is_needed(&mod_info, &create_diff))) {
+            goto cleanup;
+        }
+    }
+
+    /* create diff, the edits are applied in order */
+    for (i = 0; i < session_count; ++i) {
+        if (mod_info.ds == SR_DS_OPERATIONAL) {
+            err_info = sr_modinfo_edit_merge(&mod_info, sessions[i]->dt[session->ds].edit->tree, create_diff);
+        } else {
+            err_info = sr_modinfo_edit_apply(&mod_info, sessions[i]->dt[session->ds].edit->tree, create_diff);
+        }
+        if (err_info) {
+            goto cleanup;
+        }
+    }
+
+    if (create_diff) {
+        /* notify all the subscribers and store the changes */
+        err_info = sr_changes_notify_store(&mod_info, session, timeout_ms, cb_err_info);
+    } else {
+        /* nobody to notify, just store the changes */
+        err_info = sr_changes_store_no_diff(&mod_info, session, timeout_ms);
+    }
+
+cleanup:
+    /* MODULES UNLOCK */
+    sr_shmmod_modinfo_unlock(&mod_info);
+    sr_modinfo_erase(&mod_info);
+    return err_info;
+}
+
+/**
+ * @brief Learn whether changes of 2 sessions can be applied in a single transaction.
+ *
+ * @param[in] sess1 First session.
+ * @param[in] sess2 Second session.
+ * @return Whether the changes can be applied together.
+ */
+static int
+sr_apply_changes_compatible(const sr_session_ctx_t *sess1, const sr_session_ctx_t *sess2)
+{
+    if (sess1->ds != sess2->ds) {
+        return 0;
+    }
+
+    /* the changes are checked and published as if made by a single originator */
+    if (sess1->orig_name || sess2->orig_name) {
+        return 0;
+    }
+    if ((!sess1->nacm_user != !sess2->nacm_user) || (sess1->nacm_user && strcmp(sess1->nacm_user, sess2->nacm_user))) {
+        return 0;
+    }
+
+    return 1;
+}
+
+/**
+ * @brief Apply changes of queued requests, in a single transaction whenever possible.
+ *
+ * @param[in] batch First queued request.
+ */
+static void
+sr_apply_changes_batch(struct sr_commit_req_s *batch)
+{
+    sr_error_info_t *err_info, *cb_err_info;
+    struct sr_commit_req_s *req, *iter, **reqs = NULL;
+    sr_session_ctx_t **sessions = NULL;
+    uint32_t i, count, timeout_ms;
+
+    for (count = 0, iter = batch; iter; iter = iter->next) {
+        ++count;
+    }
+    if (count > 1) {
+        reqs = malloc(count * sizeof *reqs);
+        sessions = malloc(count * sizeof *sessions);
+    }
+
+    for (req = batch; req; req = req->next) {
+        if (req->applied) {
+            continue;
+        }
+
+        if (reqs && sessions) {
+            /* collect all the requests that can be applied together with this one */
+            count = 0;
+            timeout_ms = 0;
+            for (iter = req; iter; iter = iter->next) {
+                if (!iter->applied && sr_apply_changes_compatible(req->session, iter->session)) {
+                    reqs[count] = iter;
+                    sessions[count] = iter->session;
+                    ++count;
+                    if (iter->timeout_ms > timeout_ms) {
+                        timeout_ms = iter->timeout_ms;
+                    }
+                }
+            }
+
+            if (count > 1) {
+                cb_err_info = NULL;
+                err_info = _sr_apply_changes(sessions, count, timeout_ms, &cb_err_info);
+                if (!err_info && !cb_err_info) {
+                    for (i = 0; i < count; ++i) {
+                        reqs[i]->applied = 1;
+                    }
+                    continue;
+                }
+
+                /* apply the changes one by one for each of them to get its own result */
+                sr_errinfo_free(&err_info);
+                sr_errinfo_free(&cb_err_info);
+            }
+        }
+
+        for (iter = req; iter; iter = iter->next) {
+            if (!iter->applied && sr_apply_changes_compatible(req->session, iter->session)) {
+                iter->err_info = _sr_apply_changes(&iter->session, 1, iter->timeout_ms, &iter->cb_err_info);
+                iter->applied = 1;
+            }
+        }
+    }
+
+    free(reqs);
+    free(sessions);
+}
+
+/**
+ * @brief Apply changes of a session, possibly together with changes of other sessions of the connection.
+ *
+ * If no changes are being applied, they are applied right away and then also all the changes queued in the meantime.
+ * Otherwise, they are queued and applied by the thread currently applying changes. If they are not taken from
+ * the queue until the timeout elapses, they are dequeued and the wait fails.
+ *
+ * @param[in] session Session with the changes.
+ * @param[in] timeout_ms Change callback timeout in milliseconds.
+ * @param[out] cb_err_info Callback error info in case an operation callback failed.
+ * @return err_info, NULL on success.
+ */
+static sr_error_info_t *
+sr_apply_changes_group(sr_session_ctx_t *session, uint32_t timeout_ms, sr_error_info_t **cb_err_info)
+{
+    sr_error_info_t *err_info = NULL;
+    sr_conn_ctx_t *conn = session->conn;
+    struct sr_commit_req_s req = {0}, *batch, *iter, *next;
+    struct timespec timeout_abs;
+    int r;
+
+    req.session = session;
+    req.timeout_ms = timeout_ms;
+
+    /* COMMIT LOCK */
+    if ((r = pthread_mutex_lock(&conn->commit.lock))) {
+        SR_ERRINFO_LOCK(&err_info, __func__, r);
+        return err_info;
+    }
+
+    if (conn->commit.active) {
+        /* queue the request */
+        if (conn->commit.last) {
+            conn->commit.last->next = &req;
+        } else {
+            conn->commit.first = &req;
+        }
+        conn->commit.last = &req;
+
+        /* wait until it is applied, once taken from the queue it must not be left so any errors are ignored */
+        sr_timeouttime_get(&timeout_abs, timeout_ms);
+        r = 0;
+        while (!req.done && !req.leader) {
+            if (req.taken) {
+                /* COND WAIT */
+                sr_cond_wait(&conn->commit.cond, &conn->commit.lock);
+            } else if (r == ETIMEDOUT) {
+                /* still queued, dequeue it */
+                for (iter = conn->commit.first, next = NULL; iter != &req; next = iter, iter = iter->next) {}
+                if (next) {
+                    next->next = req.next;
+                } else {
+                    conn->commit.first = req.next;
+                }
+                if (conn->commit.last == &req) {
+                    conn->commit.last = next;
+                }
+
+                /* COMMIT UNLOCK */
+                pthread_mutex_unlock(&conn->commit.lock);
+
+                sr_errinfo_new(&err_info, SR_ERR_TIME_OUT, "Waiting for other changes to be applied timed out.");
+                return err_info;
+            } else {
+                /* COND TIMED WAIT */
+                r = sr_cond_clockwait(&conn->commit.cond, &conn->commit.lock, COMPAT_CLOCK_ID, &timeout_abs);
+            }
+        }
+
+        if (req.done) {
+            /* COMMIT UNLOCK */
+            pthread_mutex_unlock(&conn->commit.lock);
+
+            *cb_err_info = req.cb_err_info;
+            return req.err_info;
+        }
+
+        /* chosen as the next leader, already removed from the queue */
+    } else {
+        conn->commit.active = 1;
     }
-    change_sub_lock = SR_LOCK_READ;
 
-    /* first publish "update" event for the diff to be updated */
-    if ((err_info = sr_modinfo_change_notify_update(mod_info, session, timeout_ms, &change_sub_lock, cb_err_info)) ||
-            *cb_err_info) {
-        goto cleanup;
-    }
+    /* COMMIT UNLOCK */
+    pthread_mutex_unlock(&conn->commit.lock);
 
-    if (!mod_info->diff) {
-        SR_LOG_INF("No \"%s\" datastore changes to apply.", sr_ds2str(mod_info->ds));
-        goto store;
-    }
+    /* apply our changes */
+    err_info = _sr_apply_changes(&session, 1, timeout_ms, cb_err_info);
 
-    /* publish final diff in a "change" event for any subscribers and wait for them */
-    if ((err_info = sr_shmsub_change_notify_change(mod_info, orig_name, orig_data, timeout_ms, cb_err_info))) {
-        goto cleanup;
-    }
-    if (*cb_err_info) {
-        /* "change" event failed, publish "abort" event and finish */
-        err_info = sr_shmsub_change_notify_change_abort(mod_info, orig_name, orig_data, timeout_ms);
-        goto cleanup;
-    }
+    /* COMMIT LOCK */
+    pthread_mutex_lock(&conn->commit.lock);
 
-store:
-    if (!mod_info->diff && !sr_modinfo_is_changed(mod_info)) {
-        /* there is no diff and no changed modules, nothing to store */
-        goto cleanup;
+    /* take all the requests queued in the meantime */
+    batch = conn->commit.first;
+    conn->commit.first = NULL;
+    conn->commit.last = NULL;
+    for (iter = batch; iter; iter = iter->next) {
+        iter->taken = 1;
     }
 
-    /* MODULES WRITE LOCK (upgrade) */
-    if ((err_info = sr_shmmod_modinfo_rdlock_upgrade(mod_info, sid, timeout_ms, timeout_ms))) {
-        goto cleanup;
-    }
+    /* COMMIT UNLOCK */
+    pthread_mutex_unlock(&conn->commit.lock);
 
-    /* store updated datastore */
-    if ((err_info = sr_modinfo_data_store(mod_info))) {
-        goto cleanup;
+    if (batch) {
+        sr_apply_changes_batch(batch);
     }
 
-    /* MODULES READ LOCK (downgrade) */
-    if ((err_info = sr_shmmod_modinfo_wrlock_downgrade(mod_info, sid, timeout_ms))) {
-        goto cleanup;
-    }
+    /* COMMIT LOCK */
+    pthread_mutex_lock(&conn->commit.lock);
 
-    /* publish "done" event, all changes were applied */
-    if ((err_info = sr_shmsub_change_notify_change_done(mod_info, orig_name, orig_data, timeout_ms))) {
-        goto cleanup;
+    for (iter = batch; iter; iter = next) {
+        /* the request may be gone once done */
+        next = iter->next;
+        iter->done = 1;
     }
 
-    /* generate netconf-config-change notification */
-    if (session && (err_info = sr_modinfo_generate_config_change_notif(mod_info, session))) {
-        goto cleanup;
+    if (conn->commit.first) {
+        /* let the first request queued in the meantime apply the next batch */
+        conn->commit.first->leader = 1;
+        conn->commit.first = conn->commit.first->next;
+        if (!conn->commit.first) {
+            conn->commit.last = NULL;
+        }
+    } else {
+        conn->commit.active = 0;
     }
+    sr_cond_broadcast(&conn->commit.cond);
 
-cleanup:
-    if (change_sub_lock) {
-        assert(change_sub_lock == SR_LOCK_READ);
-
-        /* CHANGE SUB READ UNLOCK */
-        sr_modinfo_changesub_rdunlock(mod_info);
-    }
+    /* COMMIT UNLOCK */
+    pthread_mutex_unlock(&conn->commit.lock);
 
-    free(denied.rule_name);
     return err_info;
 }
 
@@ -3938,8 +5184,6 @@ API int
 sr_apply_changes(sr_session_ctx_t *session, uint32_t timeout_ms)
 {
     sr_error_info_t *err_info = NULL, *cb_err_info = NULL;
-    struct sr_mod_info_s mod_info;
-    uint32_t mi_opts;
 
     SR_CHECK_ARG_APIRET(!session || !SR_IS_STANDARD_DS(session->ds), session, err_info);
 
@@ -3950,42 +5194,15 @@ sr_apply_changes(sr_session_ctx_t *session, uint32_t timeout_ms)
     if (!timeout_ms) {
         timeout_ms = SR_CHANGE_CB_TIMEOUT;
     }
-    /* even for operational datastore, we do not need any running data */
-    SR_MODINFO_INIT(mod_info, session->conn, session->ds, session->ds);
-
-    mi_opts = SR_MI_LOCK_UPGRADEABLE | SR_MI_PERM_NO;
-    if ((session->ds != SR_DS_OPERATIONAL) && (session->ds != SR_DS_CANDIDATE)) {
-        mi_opts |= SR_MI_INV_DEPS;
-    } /* else stored oper edit or candidate data are not validated so we do not need data from other modules */
-
-    /* collect all required modules */
-    if ((err_info = sr_modinfo_collect_edit(session->dt[session->ds].edit->tree, &mod_info))) {
-        goto cleanup;
-    }
-
-    /* add modules into mod_info with deps, locking, and their data */
-    if ((err_info = sr_modinfo_consolidate(&mod_info, SR_LOCK_READ, mi_opts, session->sid, session->orig_name,
-            session->orig_data, 0, 0, 0))) {
-        goto cleanup;
-    }
 
-    /* create diff */
-    if (mod_info.ds == SR_DS_OPERATIONAL) {
-        err_info = sr_modinfo_edit_merge(&mod_info, session->dt[session->ds].edit->tree, 1);
+    if ((session->conn->opts & SR_CONN_GROUP_COMMIT) && ((session->ds == SR_DS_RUNNING) ||
+            (session->ds == SR_DS_STARTUP)) && !session->ev && !sr_ev_thread_depth) {
+        /* may be applied together with changes of other sessions, but not from a callback because the thread
+         * applying the changes may be waiting for it */
+        err_info = sr_apply_changes_group(session, timeout_ms, &cb_err_info);
     } else {
-        err_info = sr_modinfo_edit_apply(&mod_info, session->dt[session->ds].edit->tree, 1);
+        err_info = _sr_apply_changes(&session, 1, timeout_ms, &cb_err_info);
     }
-    if (err_info) {
-        goto cleanup;
-    }
-
-    /* notify all the subscribers and store the changes */
-    err_info = sr_changes_notify_store(&mod_info, session, timeout_ms, &cb_err_info);
-
-cleanup:
-    /* MODULES UNLOCK */
-    sr_shmmod_modinfo_unlock(&mod_info);
-    sr_modinfo_erase(&mod_info);
 
     if (!err_info && !cb_err_info) {
         /* free applied edit */
@@ -4000,6 +5217,212 @@ cleanup:
     return sr_api_ret(session, err_info);
 }
 
+/**
+ * @brief Background operation.
+ */
+struct sr_bg_op_s {
+    sr_session_ctx_t *session;  /**< Session of the operation. */
+    struct lyd_node *input;     /**< RPC/action input to send, apply changes of the session if not set. */
+    uint32_t timeout_ms;        /**< Callback timeout in milliseconds. */
+    sr_bg_cb callback;          /**< Completion callback. */
+    void *private_data;         /**< Completion callback private data. */
+    struct sr_bg_op_s *next;    /**< Next queued operation. */
+};
+
+/**
+ * @brief Worker thread executing queued background operations of a connection.
+ *
+ * @param[in] arg Connection.
+ * @return Always NULL.
+ */
+static void *
+sr_bg_thread(void *arg)
+{
+    sr_conn_ctx_t *conn = arg;
+    struct sr_bg_op_s *op;
+    struct lyd_node *input_top;
+    sr_data_t *output;
+    int rc;
+
+    /* BG LOCK */
+    pthread_mutex_lock(&conn->bg.lock);
+
+    while (1) {
+        while (!conn->bg.first && !conn->bg.stop) {
+            /* COND WAIT */
+            ++conn->bg.idle_count;
+            sr_cond_wait(&conn->bg.cond, &conn->bg.lock);
+            --conn->bg.idle_count;
+        }
+        if (!conn->bg.first) {
+            /* stopped and there are no more operations */
+            break;
+        }
+
+        /* dequeue an operation */
+        op = conn->bg.first;
+        conn->bg.first = op->next;
+        if (!conn->bg.first) {
+            conn->bg.last = NULL;
+        }
+
+        /* BG UNLOCK */
+        pthread_mutex_unlock(&conn->bg.lock);
+
+        /* execute it */
+        output = NULL;
+        if (op->input) {
+            rc = sr_rpc_send_tree(op->session, op->input, op->timeout_ms, &output);
+            for (input_top = op->input; input_top->parent; input_top = lyd_parent(input_top)) {}
+            lyd_free_all(input_top);
+        } else {
+            rc = sr_apply_changes(op->session, op->timeout_ms);
+        }
+
+        /* report the result */
+        op->callback(op->session, rc, output, op->private_data);
+        free(op);
+
+        /* BG LOCK */
+        pthread_mutex_lock(&conn->bg.lock);
+    }
+
+    /* BG UNLOCK */
+    pthread_mutex_unlock(&conn->bg.lock);
+
+    return NULL;
+}
+
+/**
+ * @brief Queue a background operation, start a new worker thread if all are busy.
+ *
+ * @param[in] session Session of the operation.
+ * @param[in] input Optional RPC/action input to send, is spent.
+ * @param[in] timeout_ms Callback timeout in milliseconds.
+ * @param[in] callback Completion callback.
+ * @param[in] private_data Completion callback private data.
+ * @return err_info, NULL on success.
+ */
+static sr_error_info_t *
+sr_bg_op_add(sr_session_ctx_t *session, struct lyd_node *input, uint32_t timeout_ms, sr_bg_cb callback,
+        void *private_data)
+{
+    sr_error_info_t *err_info = NULL;
+    sr_conn_ctx_t *conn = session->conn;
+    struct sr_bg_op_s *op;
+    int r;
+
+    op = calloc(1, sizeof *op);
+    SR_CHECK_MEM_RET(!op, err_info);
+    op->session = session;
+    op->input = input;
+    op->timeout_ms = timeout_ms;
+    op->callback = callback;
+    op->private_data = private_data;
+
+    /* BG LOCK */
+    if ((r = pthread_mutex_lock(&conn->bg.lock))) {
+        SR_ERRINFO_LOCK(&err_info, __func__, r);
+        free(op);
+        return err_info;
+    }
+
+    if (!conn->bg.idle_count && (conn->bg.thread_count < SR_BG_THREAD_COUNT)) {
+        /* start another worker */
+        if ((r = pthread_create(&conn->bg.tids[conn->bg.thread_count], NULL, sr_bg_thread, conn))) {
+            if (!conn->bg.thread_count) {
+                /* BG UNLOCK */
+                pthread_mutex_unlock(&conn->bg.lock);
+
+                sr_errinfo_new(&err_info, SR_ERR_SYS, "Creating a new thread failed (%s).", strerror(r));
+                free(op);
+                return err_info;
+            }
+
+            /* the operation will wait for a running worker */
+        } else {
+            ++conn->bg.thread_count;
+        }
+    }
+
+    /* queue the operation */
+    if (conn->bg.last) {
+        conn->bg.last->next = op;
+    } else {
+        conn->bg.first = op;
+    }
+    conn->bg.last = op;
+    sr_cond_broadcast(&conn->bg.cond);
+
+    /* BG UNLOCK */
+    pthread_mutex_unlock(&conn->bg.lock);
+
+    return NULL;
+}
+
+/**
+ * @brief Finish all the background operations of a connection and stop its worker threads.
+ *
+ * @param[in] conn Connection to use.
+ * @return err_info, NULL on success.
+ */
+static sr_error_info_t *
+sr_bg_stop(sr_conn_ctx_t *conn)
+{
+    sr_error_info_t *err_info = NULL;
+    pthread_t tids[SR_BG_THREAD_COUNT];
+    uint32_t i, count, joined = 0;
+
+    /* BG LOCK */
+    pthread_mutex_lock(&conn->bg.lock);
+
+    for (i = 0; i < conn->bg.thread_count; ++i) {
+        if (pthread_equal(pthread_self(), conn->bg.tids[i])) {
+            /* would wait for itself */
+            sr_errinfo_new(&err_info, SR_ERR_INVAL_ARG, "Cannot disconnect from a background operation callback.");
+            goto cleanup_unlock;
+        }
+    }
+
+    conn->bg.stop = 1;
+    sr_cond_broadcast(&conn->bg.cond);
+
+    /* wait for the workers to finish the queued operations, including any workers started meanwhile */
+    while (joined < conn->bg.thread_count) {
+        count = conn->bg.thread_count;
+        memcpy(tids + joined, conn->bg.tids + joined, (count - joined) * sizeof *tids);
+
+        /* BG UNLOCK */
+        pthread_mutex_unlock(&conn->bg.lock);
+
+        for (i = joined; i < count; ++i) {
+            pthread_join(tids[i], NULL);
+        }
+        joined = count;
+
+        /* BG LOCK */
+        pthread_mutex_lock(&conn->bg.lock);
+    }
+    conn->bg.thread_count = 0;
+    conn->bg.stop = 0;
+
+cleanup_unlock:
+    /* BG UNLOCK */
+    pthread_mutex_unlock(&conn->bg.lock);
+    return err_info;
+}
+
+API int
+sr_apply_changes_bg(sr_session_ctx_t *session, uint32_t timeout_ms, sr_bg_cb callback, void *private_data)
+{
+    sr_error_info_t *err_info = NULL;
+
+    SR_CHECK_ARG_APIRET(!session || !SR_IS_STANDARD_DS(session->ds) || !callback, session, err_info);
+
+    err_info = sr_bg_op_add(session, NULL, timeout_ms, callback, private_data);
+    return sr_api_ret(session, err_info);
+}
+
 API int
 sr_has_changes(sr_session_ctx_t *session)
 {
@@ -4048,19 +5471,26 @@ sr_discard_changes(sr_session_ctx_t *session)
  * @param[in] ly_mod Optional specific module.
  * @param[in,out] src_config Source data for the replace, they are spent.
  * @param[in] timeout_ms Change callback timeout in milliseconds.
+ * @param[in] bulk Whether to replace the data without a diff, if possible.
  * @return err_info, NULL on success.
  */
 static sr_error_info_t *
 _sr_replace_config(sr_session_ctx_t *session, const struct lys_module *ly_mod, struct lyd_node **src_config,
-        uint32_t timeout_ms)
+        uint32_t timeout_ms, int bulk)
 {
     sr_error_info_t *err_info = NULL, *cb_err_info = NULL;
     struct sr_mod_info_s mod_info;
+    int mi_opts;
 
     assert(!*src_config || !(*src_config)->prev->next);
     assert(session->ds != SR_DS_OPERATIONAL);
     SR_MODINFO_INIT(mod_info, session->conn, session->ds, session->ds);
 
+    if (session->nacm_user) {
+        /* NACM is checked on the diff */
+        bulk = 0;
+    }
+
     /* single module/all modules */
     if (ly_mod) {
         if ((err_info = sr_modinfo_add(ly_mod, NULL, 0, 0, &mod_info))) {
@@ -4072,19 +5502,32 @@ _sr_replace_config(sr_session_ctx_t *session, const struct lys_module *ly_mod, s
         }
     }
 
-    /* add modules with dependencies into mod_info */
-    if ((err_info = sr_modinfo_consolidate(&mod_info, SR_LOCK_READ, SR_MI_INV_DEPS | SR_MI_LOCK_UPGRADEABLE | SR_MI_PERM_NO,
-            session->sid, session->orig_name, session->orig_data, 0, 0, 0))) {
+    /* add modules with dependencies into mod_info, the current data are not needed for bulk replace */
+    mi_opts = SR_MI_INV_DEPS | SR_MI_LOCK_UPGRADEABLE | SR_MI_PERM_NO;
+    if (bulk) {
+        mi_opts |= SR_MI_DATA_NO;
+    }
+    if ((err_info = sr_modinfo_consolidate(&mod_info, SR_LOCK_READ, mi_opts, session->sid, session->orig_name,
+            session->orig_data, 0, 0, 0))) {
         goto cleanup;
     }
 
-    /* update affected data and create corresponding diff, src_config is spent */
-    if ((err_info = sr_modinfo_replace(&mod_info, src_config))) {
+    /* update affected data and create corresponding diff unless replaced in bulk, src_config is spent */
+    if (bulk) {
+        if ((err_info = sr_modinfo_replace_bulk(&mod_info, src_config, session->orig_name, session->orig_data, &bulk))) {
+            goto cleanup;
+        }
+    } else if ((err_info = sr_modinfo_replace(&mod_info, src_config, !session->nacm_user))) {
         goto cleanup;
     }
 
-    /* notify all the subscribers and store the changes */
-    err_info = sr_changes_notify_store(&mod_info, session, timeout_ms, &cb_err_info);
+    if (bulk) {
+        /* nobody to notify, just store the data */
+        err_info = sr_changes_store_no_diff(&mod_info, session, timeout_ms);
+    } else {
+        /* notify all the subscribers and store the changes */
+        err_info = sr_changes_notify_store(&mod_info, session, timeout_ms, &cb_err_info);
+    }
 
 cleanup:
     /* MODULES UNLOCK */
@@ -4099,18 +5542,23 @@ cleanup:
     return err_info;
 }
 
-API int
-sr_replace_config(sr_session_ctx_t *session, const char *module_name, struct lyd_node *src_config, uint32_t timeout_ms)
+/**
+ * @brief Replace config data of all or some modules.
+ *
+ * @param[in] session Session to use.
+ * @param[in] module_name Optional specific module name.
+ * @param[in] src_config Source data for the replace, are always spent.
+ * @param[in] timeout_ms Change callback timeout in milliseconds.
+ * @param[in] bulk Whether to replace the data without a diff, if possible.
+ * @return err_info, NULL on success.
+ */
+static sr_error_info_t *
+sr_replace_config_common(sr_session_ctx_t *session, const char *module_name, struct lyd_node *src_config,
+        uint32_t timeout_ms, int bulk)
 {
     sr_error_info_t *err_info = NULL;
     const struct lys_module *ly_mod = NULL;
 
-    /* SR_CHECK_ARG_APIRET but we need to free src_config */
-    if (!session || !SR_IS_CONVENTIONAL_DS(session->ds)) {
-        sr_errinfo_new(&(err_info), SR_ERR_INVAL_ARG, "Invalid arguments for function \"%s\".", __func__);
-        goto cleanup;
-    }
-
     /* CONTEXT LOCK */
     if ((err_info = sr_lycc_lock(session->conn, SR_LOCK_READ, 0, __func__))) {
         goto cleanup;
@@ -4141,7 +5589,7 @@ sr_replace_config(sr_session_ctx_t *session, const char *module_name, struct lyd
     }
 
     /* replace the data */
-    if ((err_info = _sr_replace_config(session, ly_mod, &src_config, timeout_ms))) {
+    if ((err_info = _sr_replace_config(session, ly_mod, &src_config, timeout_ms, bulk))) {
         goto cleanup_unlock;
     }
 
@@ -4151,6 +5599,39 @@ cleanup_unlock:
 
 cleanup:
     lyd_free_all(src_config);
+    return err_info;
+}
+
+API int
+sr_replace_config(sr_session_ctx_t *session, const char *module_name, struct lyd_node *src_config, uint32_t timeout_ms)
+{
+    sr_error_info_t *err_info = NULL;
+
+    /* SR_CHECK_ARG_APIRET but we need to free src_config */
+    if (!session || !SR_IS_CONVENTIONAL_DS(session->ds)) {
+        sr_errinfo_new(&(err_info), SR_ERR_INVAL_ARG, "Invalid arguments for function \"%s\".", __func__);
+        lyd_free_all(src_config);
+        return sr_api_ret(session, err_info);
+    }
+
+    err_info = sr_replace_config_common(session, module_name, src_config, timeout_ms, 0);
+    return sr_api_ret(session, err_info);
+}
+
+API int
+sr_replace_config_bulk(sr_session_ctx_t *session, const char *module_name, struct lyd_node *src_config,
+        uint32_t timeout_ms)
+{
+    sr_error_info_t *err_info = NULL;
+
+    /* SR_CHECK_ARG_APIRET but we need to free src_config */
+    if (!session || !SR_IS_CONVENTIONAL_DS(session->ds)) {
+        sr_errinfo_new(&(err_info), SR_ERR_INVAL_ARG, "Invalid arguments for function \"%s\".", __func__);
+        lyd_free_all(src_config);
+        return sr_api_ret(session, err_info);
+    }
+
+    err_info = sr_replace_config_common(session, module_name, src_config, timeout_ms, 1);
     return sr_api_ret(session, err_info);
 }
 
@@ -4227,7 +5708,7 @@ sr_copy_config(sr_session_ctx_t *session, const char *module_name, sr_datastore_
         }
 
         /* replace the data */
-        if ((err_info = _sr_replace_config(session, ly_mod, &mod_info.data, timeout_ms))) {
+        if ((err_info = _sr_replace_config(session, ly_mod, &mod_info.data, timeout_ms, 0))) {
             goto cleanup;
         }
 
@@ -4246,7 +5727,7 @@ sr_copy_config(sr_session_ctx_t *session, const char *module_name, sr_datastore_
         sr_shmmod_modinfo_unlock(&mod_info);
 
         /* replace the data */
-        if ((err_info = _sr_replace_config(session, ly_mod, &mod_info.data, timeout_ms))) {
+        if ((err_info = _sr_replace_config(session, ly_mod, &mod_info.data, timeout_ms, 0))) {
             goto cleanup;
         }
     }
@@ -4416,6 +5897,9 @@ _sr_un_lock(sr_session_ctx_t *session, const char *module_name, int lock, uint32
     if ((err_info = sr_change_dslock(&mod_info, session->sid, lock))) {
         goto cleanup;
     }
+    if (lock) {
+        session->ds_locked = 1;
+    }
 
     /* candidate datastore unlocked, reset its state */
     if (!lock && (mod_info.ds == SR_DS_CANDIDATE)) {
@@ -4605,6 +6089,9 @@ sr_subscription_process_events(sr_subscription_ctx_t *subscription, sr_session_c
     }
     ctx_mode = SR_LOCK_READ;
 
+    /* callbacks of this thread must not wait for group commits */
+    ++sr_ev_thread_depth;
+
     /* change subscriptions */
     for (i = 0; i < subscription->change_sub_count; ++i) {
         if ((err_info = sr_shmsub_change_listen_process_module_events(&subscription->change_subs[i], subscription->conn))) {
@@ -4629,7 +6116,7 @@ sr_subscription_process_events(sr_subscription_ctx_t *subscription, sr_session_c
 
     /* RPC/action subscriptions */
     for (i = 0; i < subscription->rpc_sub_count; ++i) {
-        if ((err_info = sr_shmsub_rpc_listen_process_rpc_events(&subscription->rpc_subs[i], subscription->conn))) {
+        if ((err_info = sr_shmsub_rpc_listen_process_rpc_events(&subscription->rpc_subs[i], subscription))) {
             goto cleanup_unlock;
         }
     }
@@ -4667,6 +6154,8 @@ sr_subscription_process_events(sr_subscription_ctx_t *subscription, sr_session_c
 
 cleanup_unlock:
     if (ctx_mode) {
+        --sr_ev_thread_depth;
+
         /* CONTEXT UNLOCK */
         sr_lycc_unlock(subscription->conn, ctx_mode, 0, __func__);
     }
@@ -4819,7 +6308,7 @@ _sr_subscription_suspend_change(sr_subscription_ctx_t *subscription, uint32_t su
         /* send the special notification */
         sr_realtime_get(&cur_time);
         if ((err_info = sr_notif_call_callback(ev_sess, notif_sub->cb, notif_sub->tree_cb, notif_sub->private_data,
-                suspend ? SR_EV_NOTIF_SUSPENDED : SR_EV_NOTIF_RESUMED, sub_id, NULL, &cur_time))) {
+                suspend ? SR_EV_NOTIF_SUSPENDED : SR_EV_NOTIF_RESUMED, sub_id, NULL, &cur_time, NULL))) {
             goto cleanup;
         }
         /* mark this as suspended in the subscription context as well to prevent stealing events */
@@ -5023,6 +6512,11 @@ _sr_unsubscribe(sr_subscription_ctx_t *subscription)
         }
     }
 
+    /* wait for the RPC slot workers of the removed RPC/action subscriptions, they are exiting */
+    while (ATOMIC_LOAD_RELAXED(subscription->rpc_worker_count)) {
+        sr_msleep(1);
+    }
+
     /* unlink event pipe */
     if ((tmp_err = sr_path_evpipe(subscription->evpipe_num, &path))) {
         /* continue */
@@ -5178,6 +6672,7 @@ sr_module_change_subscribe_enable(sr_session_ctx_t *session, struct sr_mod_info_
         goto cleanup;
     }
     ev_sess->dt[ev_sess->ds].diff = enabled_data;
+    ev_sess->ev_data.data_version = mod_info->mods[0].shm_mod->data_version[mod_info->ds];
     enabled_data = NULL;
 
     if (!(opts & SR_SUBSCR_DONE_ONLY)) {
@@ -5300,12 +6795,14 @@ sr_module_change_subscribe(sr_session_ctx_t *session, const char *module_name, c
 
     SR_CHECK_ARG_APIRET(!session || !SR_IS_STANDARD_DS(session->ds) || SR_IS_EVENT_SESS(session) || !module_name ||
             !callback || !subscription, session, err_info);
+    SR_CHECK_ARG_APIRET((opts & SR_SUBSCR_CHANGE_COARSE) && (xpath || (opts & SR_SUBSCR_UPDATE)), session, err_info);
 
     SR_MODINFO_INIT(mod_info, session->conn, SR_DS_RUNNING, SR_DS_RUNNING);
 
     conn = session->conn;
     /* only these options are relevant outside this function and will be stored */
-    sub_opts = opts & (SR_SUBSCR_DONE_ONLY | SR_SUBSCR_PASSIVE | SR_SUBSCR_UPDATE | SR_SUBSCR_FILTER_ORIG);
+    sub_opts = opts & (SR_SUBSCR_DONE_ONLY | SR_SUBSCR_PASSIVE | SR_SUBSCR_UPDATE | SR_SUBSCR_FILTER_ORIG |
+            SR_SUBSCR_CHANGE_COARSE);
 
     /* CONTEXT LOCK */
     if ((err_info = sr_lycc_lock(conn, SR_LOCK_READ, 0, __func__))) {
@@ -5882,6 +7379,19 @@ sr_get_change_diff(sr_session_ctx_t *session)
     return session->dt[session->ds].diff;
 }
 
+API int
+sr_session_get_event_data_version(sr_session_ctx_t *session, uint32_t *data_version)
+{
+    sr_error_info_t *err_info = NULL;
+
+    SR_CHECK_ARG_APIRET(!session || !data_version || ((session->ev != SR_SUB_EV_ENABLED) &&
+            (session->ev != SR_SUB_EV_UPDATE) && (session->ev != SR_SUB_EV_CHANGE) && (session->ev != SR_SUB_EV_DONE) &&
+            (session->ev != SR_SUB_EV_ABORT)), session, err_info);
+
+    *data_version = session->ev_data.data_version;
+    return sr_api_ret(session, NULL);
+}
+
 /**
  * @brief Subscribe to an RPC/action.
  *
@@ -5986,22 +7496,22 @@ _sr_rpc_subscribe(sr_session_ctx_t *session, const char *xpath, sr_rpc_cb callba
     if (is_ext) {
         /* Remove any dead subscriptions */
         sr_shmext_rpc_sub_remove_dead(conn, &shm_mod->rpc_ext_subs, &shm_mod->rpc_ext_sub_count);
-        if ((err_info = sr_shmext_rpc_sub_add(conn, &shm_mod->rpc_ext_subs,
-                &shm_mod->rpc_ext_sub_count, path, sub_id, xpath, priority, 0, (*subscription)->evpipe_num, conn->cid))) {
+        if ((err_info = sr_shmext_rpc_sub_add(conn, &shm_mod->rpc_ext_subs, &shm_mod->rpc_ext_sub_count, path, sub_id,
+                xpath, priority, opts & SR_SUBSCR_RPC_PIPELINE, (*subscription)->evpipe_num, conn->cid))) {
             goto cleanup_unlock2;
         }
     } else {
         /* Remove any dead subscriptions */
         sr_shmext_rpc_sub_remove_dead(conn, &shm_rpc->subs, &shm_rpc->sub_count);
         if ((err_info = sr_shmext_rpc_sub_add(conn, &shm_rpc->subs, &shm_rpc->sub_count, path, sub_id,
-                xpath, priority, 0, (*subscription)->evpipe_num, conn->cid))) {
+                xpath, priority, opts & SR_SUBSCR_RPC_PIPELINE, (*subscription)->evpipe_num, conn->cid))) {
             goto cleanup_unlock2;
         }
     }
 
     /* add subscription into structure */
     if ((err_info = sr_subscr_rpc_sub_add(*subscription, sub_id, session, path, is_ext, xpath, callback, tree_callback,
-            private_data, priority, SR_LOCK_WRITE))) {
+            private_data, priority, opts, SR_LOCK_WRITE))) {
         goto error1;
     }
 
@@ -6552,6 +8062,30 @@ cleanup:
     return sr_api_ret(session, err_info);
 }
 
+API int
+sr_rpc_send_tree_bg(sr_session_ctx_t *session, const struct lyd_node *input, uint32_t timeout_ms,
+        sr_bg_cb callback, void *private_data)
+{
+    sr_error_info_t *err_info = NULL;
+    struct lyd_node *dup = NULL, *dup_top;
+
+    SR_CHECK_ARG_APIRET(!session || !input || !callback, session, err_info);
+
+    /* the input is validated, use a copy */
+    if ((err_info = sr_lyd_dup(input, NULL, LYD_DUP_RECURSIVE | LYD_DUP_WITH_PARENTS, 0, &dup))) {
+        goto cleanup;
+    }
+
+    if ((err_info = sr_bg_op_add(session, dup, timeout_ms, callback, private_data))) {
+        for (dup_top = dup; dup_top->parent; dup_top = lyd_parent(dup_top)) {}
+        lyd_free_all(dup_top);
+        goto cleanup;
+    }
+
+cleanup:
+    return sr_api_ret(session, err_info);
+}
+
 /**
  * @brief Subscribe to a notification.
  *
@@ -6647,7 +8181,8 @@ _sr_notif_subscribe(sr_session_ctx_t *session, const char *mod_name, const char
     sr_realtime_get(&listen_since_real);
 
     /* add notification subscription into ext SHM and create separate specific SHM segment */
-    if ((err_info = sr_shmext_notif_sub_add(conn, shm_mod, sub_id, xpath, (*subscription)->evpipe_num))) {
+    if ((err_info = sr_shmext_notif_sub_add(conn, shm_mod, sub_id, xpath, opts & SR_SUBSCR_NOTIF_BOUNDED_LAG,
+            (*subscription)->evpipe_num))) {
         goto cleanup_unlock2;
     }
 
@@ -6994,7 +8529,7 @@ sr_notif_sub_modify_xpath(sr_subscription_ctx_t *subscription, uint32_t sub_id,
     /* send the special notification */
     sr_realtime_get(&cur_time);
     if ((err_info = sr_notif_call_callback(ev_sess, notif_sub->cb, notif_sub->tree_cb, notif_sub->private_data,
-            SR_EV_NOTIF_MODIFIED, sub_id, NULL, &cur_time))) {
+            SR_EV_NOTIF_MODIFIED, sub_id, NULL, &cur_time, NULL))) {
         goto cleanup_unlock;
     }
 
@@ -7055,7 +8590,7 @@ sr_notif_sub_modify_stop_time(sr_subscription_ctx_t *subscription, uint32_t sub_
     /* send the special notification */
     sr_realtime_get(&cur_time);
     if ((err_info = sr_notif_call_callback(ev_sess, notif_sub->cb, notif_sub->tree_cb, notif_sub->private_data,
-            SR_EV_NOTIF_MODIFIED, sub_id, NULL, &cur_time))) {
+            SR_EV_NOTIF_MODIFIED, sub_id, NULL, &cur_time, NULL))) {
         goto cleanup_unlock;
     }
 
@@ -130,6 +130,8 @@ int sr_connect(const sr_conn_options_t opts, sr_conn_ctx_t **conn);
  * started within the connection will be automatically stopped and cleaned up too.
  *
  * @note On error the function should be retried and must eventually succeed.
+ * It must not be called from a background operation callback (::sr_bg_cb) of the same connection,
+ * ::SR_ERR_INVAL_ARG is returned in that case.
  *
  * @param[in] conn Connection acquired with ::sr_connect call to free.
  * @return Error code (::SR_ERR_OK on success).
@@ -197,6 +199,15 @@ uint32_t sr_get_content_id(sr_conn_ctx_t *conn);
  */
 int sr_get_plugins(sr_conn_ctx_t *conn, const char ***ds_plugins, const char ***ntf_plugins);
 
+/**
+ * @brief Compact the shared memory with subscriptions. All the adjacent free memory is merged and any free memory
+ * at its end released. It is also performed automatically once the free memory is too fragmented.
+ *
+ * @param[in] conn Connection to use.
+ * @return Error code (::SR_ERR_OK on success).
+ */
+int sr_compact_shm(sr_conn_ctx_t *conn);
+
 /**
  * @brief Get the sysrepo SUPERUSER UID.
  *
@@ -762,6 +773,47 @@ int sr_get_item(sr_session_ctx_t *session, const char *path, uint32_t timeout_ms
 int sr_get_items(sr_session_ctx_t *session, const char *xpath, uint32_t timeout_ms, const sr_get_options_t opts,
         sr_val_t **values, size_t *value_cnt);
 
+/**
+ * @brief Retrieve a page of data elements selected by the provided XPath.
+ * Data are represented as ::sr_val_t structures.
+ *
+ * Same as ::sr_get_items() but at most @p page_size values following the value with the path @p resume_path
+ * are returned. Values are returned in the document order so all the values of system-ordered lists follow
+ * their key order. Iterating over all the values is then performed by passing the returned @p next_path
+ * as @p resume_path of the following call until it is NULL.
+ *
+ * The data are retrieved only for the first page and the session keeps them as a snapshot together with
+ * the selected nodes. Every following page of the same iteration, meaning the same @p xpath, @p opts, and
+ * datastore with the @p resume_path returned by the previous page, continues from the snapshot without retrieving
+ * the data again. Changes made in the meantime are thus not returned by these pages. Only the returned page
+ * is converted into values, but the snapshot holds all the data selected by @p xpath so with large data it is
+ * beneficial to use an @p xpath selecting only the required list instances. The snapshot keeps the context locked
+ * (as ::sr_acquire_context()) until the last page is returned, another paged get is started on the session,
+ * or the session is stopped.
+ *
+ * If @p resume_path is not the one returned by the previous page of the session, the data are retrieved again.
+ * If the node selected by @p resume_path is removed in the meantime, the iteration continues from the value that
+ * follows it in the document order. The position of a removed user-ordered list or leaf-list instance is unknown
+ * so ::SR_ERR_NOT_FOUND is returned rather than returning some values again.
+ *
+ * Required READ access, but if the access check fails, the module data are simply ignored without an error.
+ *
+ * @param[in] session Session ([DS](@ref sr_datastore_t)-specific) to use.
+ * @param[in] xpath [XPath](@ref paths) of the data elements to be retrieved.
+ * @param[in] resume_path [Path](@ref paths) of the last value of the previous page, NULL for the first page.
+ * @param[in] page_size Maximum number of returned values, must not be 0.
+ * @param[in] timeout_ms Operational callback timeout in milliseconds. If 0, default is used.
+ * @param[in] opts Options overriding default get behaviour.
+ * @param[out] values Array of requested nodes, if any, allocated dynamically (free using ::sr_free_values).
+ * @param[out] value_cnt Number of returned elements in the values array.
+ * @param[out] next_path Path to use as @p resume_path to get the next page, NULL if there are no more values.
+ * Needs to be freed.
+ * @return Error code (::SR_ERR_OK on success, ::SR_ERR_NOT_FOUND if the removed node of @p resume_path was
+ * a user-ordered instance).
+ */
+int sr_get_items_page(sr_session_ctx_t *session, const char *xpath, const char *resume_path, uint32_t page_size,
+        uint32_t timeout_ms, const sr_get_options_t opts, sr_val_t **values, size_t *value_cnt, char **next_path);
+
 /**
  * @brief Acquire libyang data tree together with its context lock in a SR data structure.
  *
@@ -835,6 +887,38 @@ int sr_get_subtree(sr_session_ctx_t *session, const char *path, uint32_t timeout
 int sr_get_data(sr_session_ctx_t *session, const char *xpath, uint32_t max_depth, uint32_t timeout_ms,
         const sr_get_options_t opts, sr_data_t **data);
 
+/**
+ * @brief Retrieve a page of trees whose root nodes match the provided XPath.
+ * Data are represented as _libyang_ subtrees.
+ *
+ * Same as ::sr_get_data() but at most @p page_size selected subtrees following the subtree with the root
+ * @p resume_path are returned. Subtrees are returned in the document order so the instances of system-ordered
+ * lists follow their key order. Iterating over all the subtrees is then performed by passing the returned
+ * @p next_path as @p resume_path of the following call until it is NULL.
+ *
+ * Only the returned page is duplicated into the result. The data snapshot of the iteration and the handling
+ * of a removed node selected by @p resume_path are the same as in ::sr_get_items_page(), a session keeps a single
+ * snapshot for both functions.
+ *
+ * Required READ access, but if the access check fails, the module data are simply ignored without an error.
+ *
+ * @param[in] session Session ([DS](@ref sr_datastore_t)-specific) to use.
+ * @param[in] xpath [XPath](@ref paths) selecting root nodes of subtrees to be retrieved.
+ * @param[in] resume_path [Path](@ref paths) of the last subtree root of the previous page, NULL for the first page.
+ * @param[in] page_size Maximum number of returned subtrees, must not be 0.
+ * @param[in] max_depth Maximum depth of the selected subtrees. 0 is unlimited, 1 will not return any
+ * descendant nodes. If a list should be returned, its keys are always returned as well.
+ * @param[in] timeout_ms Operational callback timeout in milliseconds. If 0, default is used.
+ * @param[in] opts Options overriding default get behaviour.
+ * @param[out] data SR data with connected top-level data trees of the requested page. NULL if none found.
+ * @param[out] next_path Path to use as @p resume_path to get the next page, NULL if there are no more subtrees.
+ * Needs to be freed.
+ * @return Error code (::SR_ERR_OK on success, ::SR_ERR_NOT_FOUND if xpath is invalid - no nodes will ever match it
+ * or the removed node of @p resume_path was a user-ordered instance).
+ */
+int sr_get_data_page(sr_session_ctx_t *session, const char *xpath, const char *resume_path, uint32_t page_size,
+        uint32_t max_depth, uint32_t timeout_ms, const sr_get_options_t opts, sr_data_t **data, char **next_path);
+
 /**
  * @brief Retrieve a single value matching the provided XPath.
  * Data are represented as a single _libyang_ node.
@@ -1020,6 +1104,29 @@ int sr_move_item(sr_session_ctx_t *session, const char *path, const sr_move_posi
  */
 int sr_edit_batch(sr_session_ctx_t *session, const struct lyd_node *edit, const char *default_operation);
 
+/**
+ * @brief Provide a whole edit as an array of items to be applied.
+ * These changes are applied only after calling ::sr_apply_changes().
+ *
+ * Unlike repeated ::sr_set_item_str() calls, the paths are not matched against the current session changes, all
+ * the items are created into a new edit at once. Nodes created for the path of an item are reused for the following
+ * item sharing a prefix with it so, ideally, the items should be sorted by their paths with every parent preceding
+ * its descendants. An item of a parent following its descendant is still accepted and its operation is added to
+ * the node created for the descendant, it is only slower. Each data node can appear in @p items only once, another
+ * item with the same path is an error.
+ *
+ * Only operations `merge` and `remove` are allowed for ::SR_DS_OPERATIONAL.
+ *
+ * @param[in] session Session ([DS](@ref sr_datastore_t)-specific) to use.
+ * @param[in] items Array of edit items.
+ * @param[in] item_count Count of @p items.
+ * @param[in] default_operation Default operation for nodes without operation on themselves or any parent.
+ * Possible values are `merge`, `replace`, or `none` (see [NETCONF RFC](https://tools.ietf.org/html/rfc6241#page-39)).
+ * @return Error code (::SR_ERR_OK on success).
+ */
+int sr_edit_bulk(sr_session_ctx_t *session, const sr_edit_item_t *items, uint32_t item_count,
+        const char *default_operation);
+
 /**
  * @brief Perform the validation a datastore and any changes made in the current session, but do not
  * apply nor discard them.
@@ -1051,6 +1158,24 @@ int sr_validate(sr_session_ctx_t *session, const char *module_name, uint32_t tim
  */
 int sr_apply_changes(sr_session_ctx_t *session, uint32_t timeout_ms);
 
+/**
+ * @brief Apply changes made in the current session in a background thread without waiting for the result.
+ *
+ * The changes are applied the same way as by ::sr_apply_changes(), the whole blocking call is only moved
+ * to one of at most 4 worker threads of the connection. Operations started while all the workers are busy
+ * are queued and executed in order, so at most 4 background operations of a connection are in progress at a time.
+ *
+ * Required WRITE access.
+ *
+ * @param[in] session Session ([DS](@ref sr_datastore_t)-specific) to apply changes of. Must not be used until
+ * @p callback is called.
+ * @param[in] timeout_ms Change callback timeout in milliseconds. If 0, default is used.
+ * @param[in] callback Callback called with the result.
+ * @param[in] private_data Private data passed to @p callback.
+ * @return Error code (::SR_ERR_OK if the operation was started, @p callback is then always called).
+ */
+int sr_apply_changes_bg(sr_session_ctx_t *session, uint32_t timeout_ms, sr_bg_cb callback, void *private_data);
+
 /**
  * @brief Learn whether there are any prepared non-applied changes in the session.
  *
@@ -1093,6 +1218,24 @@ int sr_discard_changes(sr_session_ctx_t *session);
 int sr_replace_config(sr_session_ctx_t *session, const char *module_name, struct lyd_node *src_config,
         uint32_t timeout_ms);
 
+/**
+ * @brief Replace a datastore with the contents of a data tree in bulk, meant for large imports. Works the same as
+ * ::sr_replace_config() but if there are no change subscriptions for the affected modules, no one subscribed to
+ * the netconf-config-change notification, and the datastore plugin does not require it, the current data are not
+ * loaded and no diff is generated. Otherwise, a standard replace is performed.
+ *
+ * Required WRITE access.
+ *
+ * @param[in] session Session ([DS](@ref sr_datastore_t)-specific - target datastore) to use.
+ * @param[in] module_name If specified, limits the replace operation only to this module.
+ * @param[in] src_config Source data to replace the datastore in @p session connection _libyang_ context.
+ * Is ALWAYS spent and cannot be further used by the application!
+ * @param[in] timeout_ms Configuration callback timeout in milliseconds. If 0, default is used.
+ * @return Error code (::SR_ERR_OK on success).
+ */
+int sr_replace_config_bulk(sr_session_ctx_t *session, const char *module_name, struct lyd_node *src_config,
+        uint32_t timeout_ms);
+
 /**
  * @brief Replaces a conventional datastore with the contents of
  * another conventional datastore. If the module is specified, limits
@@ -1482,6 +1625,17 @@ void sr_free_change_iter(sr_change_iter_t *iter);
  */
 const struct lyd_node *sr_get_change_diff(sr_session_ctx_t *session);
 
+/**
+ * @brief Get the version of the changed module data in module-change callbacks. The version is incremented
+ * whenever the module data in a datastore are stored so it is the version the data will have once the changes
+ * are applied. Meant mainly for subscriptions with ::SR_SUBSCR_CHANGE_COARSE.
+ *
+ * @param[in] session Implicit session provided in the callbacks (::sr_module_change_cb). Will not work with other sessions.
+ * @param[out] data_version Module data version.
+ * @return Error code (::SR_ERR_OK on success).
+ */
+int sr_session_get_event_data_version(sr_session_ctx_t *session, uint32_t *data_version);
+
 /** @} datasubs */
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1566,6 +1720,26 @@ int sr_rpc_send(sr_session_ctx_t *session, const char *path, const sr_val_t *inp
  */
 int sr_rpc_send_tree(sr_session_ctx_t *session, struct lyd_node *input, uint32_t timeout_ms, sr_data_t **output);
 
+/**
+ * @brief Send an RPC/action in a background thread without waiting for the result.
+ *
+ * It is sent the same way as by ::sr_rpc_send_tree(), the whole blocking call is only moved to one of at most
+ * 4 worker threads of the connection, shared with ::sr_apply_changes_bg(). Operations started while all
+ * the workers are busy are queued and executed in order.
+ *
+ * Required READ access.
+ *
+ * @param[in] session Session (not [DS](@ref sr_datastore_t)-specific) to use. Must not be used until @p callback
+ * is called.
+ * @param[in] input Input data tree in @p session connection _libyang_ context, is duplicated.
+ * @param[in] timeout_ms RPC/action callback timeout in milliseconds. If 0, default is used.
+ * @param[in] callback Callback called with the result and output.
+ * @param[in] private_data Private data passed to @p callback.
+ * @return Error code (::SR_ERR_OK if the operation was started, @p callback is then always called).
+ */
+int sr_rpc_send_tree_bg(sr_session_ctx_t *session, const struct lyd_node *input, uint32_t timeout_ms,
+        sr_bg_cb callback, void *private_data);
+
 /** @} rpcsubs */
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1793,6 +1967,14 @@ int sr_oper_poll_subscribe(sr_session_ctx_t *session, const char *module_name, c
  */
 #define SRP_CLEANUP_CB  "sr_plugin_cleanup_cb"
 
+/**
+ * @brief sysrepo-plugind plugin dependencies variable name that may optionally exist in a plugin.
+ *
+ * The variable must be a NULL-terminated array of plugin names (`const char *[]`), which may or may not include
+ * the extension. These plugins are always initialized before this plugin even if plugins are initialized in parallel.
+ */
+#define SRP_DEPS        "sr_plugin_deps"
+
 /**
  * @brief Log a plugin error message and add the error into an error info structure.
  *
@@ -105,7 +105,13 @@ typedef enum {
     SR_CONN_DEFAULT = 0x0,              /**< No special behaviour. */
     SR_CONN_CACHE_RUNNING = 0x1,        /**< Always cache running datastore data which makes mainly repeated retrieval
                                              of data much faster. Affects all sessions created on this connection. */
-    SR_CONN_CTX_SET_PRIV_PARSED = 0x2   /**< Use LY_CTX_SET_PRIV_PARSED option for the connection libyang context. */
+    SR_CONN_CTX_SET_PRIV_PARSED = 0x2,  /**< Use LY_CTX_SET_PRIV_PARSED option for the connection libyang context. */
+    SR_CONN_GROUP_COMMIT = 0x4          /**< Changes of ::SR_DS_RUNNING or ::SR_DS_STARTUP applied by sessions of this
+                                             connection while another ::sr_apply_changes() is in progress are queued and
+                                             then applied together, in a single transaction. If that fails, they are
+                                             applied one by one so that each gets its own result. Queued changes not
+                                             started within the timeout fail with ::SR_ERR_TIME_OUT. Changes applied
+                                             from subscription callbacks are never queued. */
 } sr_conn_flag_t;
 
 /**
@@ -365,6 +371,30 @@ typedef enum {
     SR_MOVE_LAST = 3       /**< Move the specified item to the position of the last child. */
 } sr_move_position_t;
 
+/**
+ * @brief Single item of an edit created by ::sr_edit_bulk call.
+ */
+typedef struct {
+    const char *xpath;      /**< [Path](@ref paths) identifier of the data element. */
+    const char *value;      /**< String value of the data element, NULL for elements without a value. */
+    const char *operation;  /**< Operation of the data element, `merge`, `replace`, `create`, `delete`, `remove`,
+                                 or `none`. NULL if the element has no operation of its own. */
+} sr_edit_item_t;
+
+/**
+ * @brief Callback to be called when a background operation finishes.
+ *
+ * Called from a connection worker thread. The session must not be used by the application while the operation
+ * is in progress, once this callback is called any error information can be retrieved from it.
+ *
+ * @param[in] session Session the operation was started on.
+ * @param[in] err_code Error code of the operation (::SR_ERR_OK on success).
+ * @param[in] output SR data with the output of an RPC/action, NULL otherwise or on error. Is owned by the callee
+ * and must be freed using ::sr_release_data().
+ * @param[in] private_data Private context opaque to sysrepo, as passed to the operation call.
+ */
+typedef void (*sr_bg_cb)(sr_session_ctx_t *session, int err_code, sr_data_t *output, void *private_data);
+
 /** @} editdata */
 
 /**
@@ -454,7 +484,35 @@ typedef enum {
      * event handling but results in 0 filtered-out changes returned by ::sr_module_change_sub_get_info(). Accepted
      * only for ::sr_module_change_subscribe().
      */
-    SR_SUBSCR_FILTER_ORIG = 0x100
+    SR_SUBSCR_FILTER_ORIG = 0x100,
+
+    /**
+     * @brief Allow several RPCs/actions to be in flight at once. If all the subscribers of an RPC/action use this
+     * option, originators spread their requests into separate subscription SHM slots so that they do not wait for
+     * each other and the handler thread processes the requests found in different slots in parallel, meaning
+     * the callback may be called concurrently from several threads. Accepted only for ::sr_rpc_subscribe() and
+     * ::sr_rpc_subscribe_tree().
+     */
+    SR_SUBSCR_RPC_PIPELINE = 0x200,
+
+    /**
+     * @brief Bound the lag of the subscriber instead of throttling notification originators. Normally, an originator
+     * waits until all the subscribers process the previous notification. If only subscribers with this option have not
+     * processed it yet, the originator waits for a short time at most and then overwrites the notification, which is
+     * dropped for these subscribers and counted in sysrepo-monitoring. Accepted only for ::sr_notif_subscribe() and
+     * ::sr_notif_subscribe_tree().
+     */
+    SR_SUBSCR_NOTIF_BOUNDED_LAG = 0x400,
+
+    /**
+     * @brief The subscriber does not need the individual changes, it re-reads the module data on any change.
+     * It learns the new module data version using ::sr_session_get_event_data_version() and only a summary of the changes
+     * may be provided by ::sr_get_change_diff(), which includes just the changed top-level subtrees, as childless nodes
+     * with the "none" operation. If all the subscribers of a module use this option, the originator of a replace
+     * (::sr_replace_config() or ::sr_copy_config()) does not generate the full diff. Accepted only for
+     * ::sr_module_change_subscribe() without an XPath filter and not with ::SR_SUBSCR_UPDATE.
+     */
+    SR_SUBSCR_CHANGE_COARSE = 0x800
 
 } sr_subscr_flag_t;
 
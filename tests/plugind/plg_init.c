@@ -0,0 +1,89 @@
+/**
+ * @file plg_init.c
+ * @brief sysrepo-plugind test plugin logging the start and end of its initialization
+ *
+ * @copyright
+ * Copyright (c) 2018 - 2024 Deutsche Telekom AG.
+ * Copyright (c) 2018 - 2024 CESNET, z.s.p.o.
+ *
+ * This source code is licensed under BSD 3-Clause License (the "License").
+ * You may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://opensource.org/licenses/BSD-3-Clause
+ */
+
+#define _GNU_SOURCE
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "sysrepo.h"
+
+#ifndef PLG_NAME
+# error "PLG_NAME must be defined"
+#endif
+
+#ifdef PLG_DEP
+const char *sr_plugin_deps[] = {PLG_DEP, NULL};
+#endif
+
+/**
+ * @brief Append an event of this plugin into the log file from $SRPD_TEST_INIT_LOG.
+ *
+ * @param[in] event Event to log.
+ * @return 0 on success, -1 on error.
+ */
+static int
+plg_log(const char *event)
+{
+    const char *path;
+    char line[64];
+    int fd, len, rc = 0;
+
+    path = getenv("SRPD_TEST_INIT_LOG");
+    if (!path) {
+        return -1;
+    }
+
+    fd = open(path, O_WRONLY | O_APPEND | O_CREAT, 0600);
+    if (fd == -1) {
+        return -1;
+    }
+
+    /* single write so that the lines of concurrently initialized plugins are not mixed */
+    len = snprintf(line, sizeof line, "%s %s\n", event, PLG_NAME);
+    if (write(fd, line, len) != len) {
+        rc = -1;
+    }
+    close(fd);
+    return rc;
+}
+
+int
+sr_plugin_init_cb(sr_session_ctx_t *session, void **private_data)
+{
+    (void)session;
+    (void)private_data;
+
+    if (plg_log("start")) {
+        return SR_ERR_SYS;
+    }
+
+    /* long enough for other plugins to start meanwhile if they were allowed to */
+    usleep(200000);
+
+    if (plg_log("end")) {
+        return SR_ERR_SYS;
+    }
+    return SR_ERR_OK;
+}
+
+void
+sr_plugin_cleanup_cb(sr_session_ctx_t *session, void *private_data)
+{
+    (void)session;
+    (void)private_data;
+}
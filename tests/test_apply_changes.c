@@ -7946,6 +7946,89 @@ test_list_replace(void **state)
     pthread_join(tid[1], NULL);
 }
 
+/* TEST */
+static int
+module_bg_cb(sr_session_ctx_t *session, uint32_t sub_id, const char *module_name, const char *xpath,
+        sr_event_t event, uint32_t request_id, void *private_data)
+{
+    struct state *st = (struct state *)private_data;
+
+    (void)session;
+    (void)sub_id;
+    (void)xpath;
+    (void)request_id;
+
+    assert_string_equal(module_name, "test");
+    if (event == SR_EV_CHANGE) {
+        ATOMIC_INC_RELAXED(st->cb_called);
+    } else if (event == SR_EV_DONE) {
+        ATOMIC_INC_RELAXED(st->cb_called2);
+    }
+    return SR_ERR_OK;
+}
+
+static void
+apply_bg_cb(sr_session_ctx_t *session, int err_code, sr_data_t *output, void *private_data)
+{
+    struct state *st = (struct state *)private_data;
+
+    assert_non_null(session);
+    assert_int_equal(err_code, SR_ERR_OK);
+    assert_null(output);
+
+    /* the edit was applied */
+    assert_int_equal(sr_has_changes(session), 0);
+
+    /* the connection cannot be disconnected from its worker thread */
+    assert_int_equal(sr_disconnect(sr_session_get_connection(session)), SR_ERR_INVAL_ARG);
+    ATOMIC_INC_RELAXED(st->cb_called3);
+
+    pthread_barrier_wait(&st->barrier);
+}
+
+static void
+test_apply_bg(void **state)
+{
+    struct state *st = (struct state *)*state;
+    sr_session_ctx_t *sess;
+    sr_subscription_ctx_t *subscr = NULL;
+    sr_val_t *val;
+    int ret;
+
+    ret = sr_session_start(st->conn, SR_DS_RUNNING, &sess);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    ret = sr_module_change_subscribe(sess, "test", NULL, module_bg_cb, st, 0, 0, &subscr);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    /* apply the changes in the background */
+    ret = sr_set_item_str(sess, "/test:test-leaf", "42", NULL, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_apply_changes_bg(sess, 0, apply_bg_cb, st);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    /* wait for the completion */
+    pthread_barrier_wait(&st->barrier);
+    assert_int_equal(ATOMIC_LOAD_RELAXED(st->cb_called), 1);
+    assert_int_equal(ATOMIC_LOAD_RELAXED(st->cb_called2), 1);
+    assert_int_equal(ATOMIC_LOAD_RELAXED(st->cb_called3), 1);
+
+    ret = sr_get_item(sess, "/test:test-leaf", 0, &val);
+    assert_int_equal(ret, SR_ERR_OK);
+    assert_int_equal(val->data.uint8_val, 42);
+    sr_free_val(val);
+
+    sr_unsubscribe(subscr);
+
+    /* cleanup */
+    ret = sr_delete_item(sess, "/test:test-leaf", 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_apply_changes(sess, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    sr_session_stop(sess);
+}
+
 /* MAIN */
 int
 main(void)
@@ -7979,6 +8062,7 @@ main(void)
         cmocka_unit_test_setup_teardown(test_mult_update, setup_f, teardown_f),
         cmocka_unit_test_setup_teardown(test_done_timeout_priority, setup_f, teardown_f),
         cmocka_unit_test_setup_teardown(test_list_replace, setup_f, teardown_f),
+        cmocka_unit_test_setup_teardown(test_apply_bg, setup_f, teardown_f),
     };
 
     setenv("CMOCKA_TEST_ABORT", "1", 1);
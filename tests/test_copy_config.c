@@ -36,6 +36,7 @@ struct state {
     sr_conn_ctx_t *conn;
     const struct ly_ctx *ly_ctx;
     ATOMIC_T cb_called;
+    uint32_t data_version;
     pthread_barrier_t barrier;
 };
 
@@ -2463,6 +2464,187 @@ test_replace_when(void **state)
     pthread_join(tid[1], NULL);
 }
 
+/* TEST */
+static void
+test_replace_bulk(void **state)
+{
+    struct state *st = (struct state *)*state;
+    sr_session_ctx_t *sess;
+    struct lyd_node *config;
+    sr_data_t *data;
+    char *str1;
+    const char *str2;
+    int ret;
+
+    ret = sr_session_start(st->conn, SR_DS_RUNNING, &sess);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    /* prepare some when1/when2 config, must be validated for when to autodelete */
+    str2 =
+            "<cont xmlns=\"urn:when1\">"
+            "  <l4>sri</l4>"
+            "  <cont2 xmlns=\"urn:when2\">"
+            "    <bl>sri</bl>"
+            "  </cont2>"
+            "</cont>";
+    assert_int_equal(LY_SUCCESS, lyd_parse_data_mem(st->ly_ctx, str2, LYD_XML,
+            LYD_PARSE_STRICT, LYD_VALIDATE_NO_STATE | LYD_VALIDATE_PRESENT, &config));
+    ret = lyd_change_term(lyd_child(config), "ri");
+    assert_int_equal(ret, 0);
+
+    /* perform bulk replace-config, there are no subscribers */
+    ret = sr_replace_config_bulk(sess, "when1", config, 0);
+    config = NULL;
+    assert_int_equal(ret, SR_ERR_OK);
+
+    /* check current data tree */
+    ret = sr_get_data(sess, "/when1:*", 0, 0, 0, &data);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    ret = lyd_print_mem(&str1, data->tree, LYD_XML, LYD_PRINT_WITHSIBLINGS);
+    assert_int_equal(ret, 0);
+    sr_release_data(data);
+
+    str2 =
+            "<cont xmlns=\"urn:when1\">\n"
+            "  <l4>ri</l4>\n"
+            "</cont>\n";
+
+    assert_string_equal(str1, str2);
+    free(str1);
+
+    /* invalid data must still be refused */
+    str2 =
+            "<interfaces xmlns=\"urn:ietf:params:xml:ns:yang:ietf-interfaces\">"
+            "  <interface>"
+            "    <name>eth1</name>"
+            "  </interface>"
+            "</interfaces>";
+    assert_int_equal(LY_SUCCESS, lyd_parse_data_mem(st->ly_ctx, str2, LYD_XML,
+            LYD_PARSE_STRICT | LYD_PARSE_ONLY, 0, &config));
+    ret = sr_replace_config_bulk(sess, "ietf-interfaces", config, 0);
+    config = NULL;
+    assert_int_equal(ret, SR_ERR_VALIDATION_FAILED);
+
+    /* remove all the data in bulk */
+    ret = sr_replace_config_bulk(sess, "when1", NULL, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    ret = sr_get_data(sess, "/when1:*", 0, 0, 0, &data);
+    assert_int_equal(ret, SR_ERR_OK);
+    assert_null(data->tree);
+    sr_release_data(data);
+
+    sr_session_stop(sess);
+}
+
+/* TEST */
+static int
+module_replace_coarse_cb(sr_session_ctx_t *session, uint32_t sub_id, const char *module_name, const char *xpath,
+        sr_event_t event, uint32_t request_id, void *private_ctx)
+{
+    struct state *st = (struct state *)private_ctx;
+    const struct lyd_node *diff;
+    struct lyd_meta *meta;
+    uint32_t data_version;
+    int ret;
+
+    (void)sub_id;
+    (void)request_id;
+
+    assert_string_equal(module_name, "when1");
+    assert_null(xpath);
+
+    ret = sr_session_get_event_data_version(session, &data_version);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    switch (ATOMIC_LOAD_RELAXED(st->cb_called)) {
+    case 0:
+        assert_int_equal(event, SR_EV_CHANGE);
+        st->data_version = data_version;
+        break;
+    case 1:
+        assert_int_equal(event, SR_EV_DONE);
+
+        /* the same version, the data were stored */
+        assert_int_equal(data_version, st->data_version);
+
+        /* only the changed top-level subtree */
+        diff = sr_get_change_diff(session);
+        assert_non_null(diff);
+        assert_string_equal(LYD_NAME(diff), "cont");
+        assert_null(diff->next);
+        assert_null(lyd_child(diff));
+        meta = lyd_find_meta(diff->meta, NULL, "yang:operation");
+        assert_non_null(meta);
+        assert_string_equal(lyd_get_meta_value(meta), "none");
+        break;
+    default:
+        fail();
+    }
+
+    ATOMIC_INC_RELAXED(st->cb_called);
+    return SR_ERR_OK;
+}
+
+static void
+test_replace_coarse(void **state)
+{
+    struct state *st = (struct state *)*state;
+    sr_session_ctx_t *sess;
+    sr_subscription_ctx_t *subscr = NULL;
+    struct lyd_node *config;
+    sr_data_t *data;
+    const char *str;
+    int count, ret;
+
+    ret = sr_session_start(st->conn, SR_DS_RUNNING, &sess);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    /* coarse subscriptions cannot be filtered */
+    ret = sr_module_change_subscribe(sess, "when1", "/when1:cont", module_replace_coarse_cb, st, 0,
+            SR_SUBSCR_CHANGE_COARSE, &subscr);
+    assert_int_equal(ret, SR_ERR_INVAL_ARG);
+
+    ret = sr_module_change_subscribe(sess, "when1", NULL, module_replace_coarse_cb, st, 0, SR_SUBSCR_CHANGE_COARSE,
+            &subscr);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    /* replace with some data */
+    str =
+            "<cont xmlns=\"urn:when1\">"
+            "  <l4>ri</l4>"
+            "</cont>";
+    assert_int_equal(LY_SUCCESS, lyd_parse_data_mem(st->ly_ctx, str, LYD_XML,
+            LYD_PARSE_STRICT | LYD_PARSE_ONLY, 0, &config));
+    ret = sr_replace_config(sess, "when1", config, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    count = 0;
+    while ((ATOMIC_LOAD_RELAXED(st->cb_called) < 2) && (count < 1500)) {
+        usleep(10000);
+        ++count;
+    }
+    assert_int_equal(ATOMIC_LOAD_RELAXED(st->cb_called), 2);
+
+    /* the data were stored */
+    ret = sr_get_data(sess, "/when1:*", 0, 0, 0, &data);
+    assert_int_equal(ret, SR_ERR_OK);
+    assert_non_null(data->tree);
+    assert_string_equal(lyd_get_value(lyd_child(data->tree)), "ri");
+    sr_release_data(data);
+
+    /* the same data, no changes */
+    assert_int_equal(LY_SUCCESS, lyd_parse_data_mem(st->ly_ctx, str, LYD_XML,
+            LYD_PARSE_STRICT | LYD_PARSE_ONLY, 0, &config));
+    ret = sr_replace_config(sess, "when1", config, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    assert_int_equal(ATOMIC_LOAD_RELAXED(st->cb_called), 2);
+
+    sr_unsubscribe(subscr);
+    sr_session_stop(sess);
+}
+
 /* MAIN */
 int
 main(void)
@@ -2477,6 +2659,8 @@ main(void)
         cmocka_unit_test_setup_teardown(test_replace_dflt, setup_f, teardown_f),
         cmocka_unit_test_setup_teardown(test_replace_case, setup_f, teardown_f),
         cmocka_unit_test_setup_teardown(test_replace_when, setup_f, teardown_f),
+        cmocka_unit_test_setup_teardown(test_replace_bulk, setup_f, teardown_f),
+        cmocka_unit_test_setup_teardown(test_replace_coarse, setup_f, teardown_f),
     };
 
     setenv("CMOCKA_TEST_ABORT", "1", 1);
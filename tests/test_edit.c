@@ -19,6 +19,7 @@
 #include <setjmp.h>
 #include <stdarg.h>
 #include <stdint.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <unistd.h>
@@ -393,6 +394,156 @@ test_create_np_cont(void **state)
     assert_int_equal(ret, SR_ERR_OK);
 }
 
+static void
+test_create_large(void **state)
+{
+    struct state *st = (struct state *)*state;
+    sr_val_t *values;
+    size_t count;
+    char path[128];
+    int ret, i;
+
+    /* large edit without any subscriptions, stored without a diff */
+    for (i = 0; i < 40; ++i) {
+        sprintf(path, "/ietf-interfaces:interfaces/interface[name='eth%d']/type", i);
+        ret = sr_set_item_str(st->sess, path, "iana-if-type:ethernetCsmacd", NULL, 0);
+        assert_int_equal(ret, SR_ERR_OK);
+    }
+    ret = sr_apply_changes(st->sess, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    ret = sr_get_items(st->sess, "/ietf-interfaces:interfaces/interface", 0, 0, &values, &count);
+    assert_int_equal(ret, SR_ERR_OK);
+    assert_int_equal(count, 40);
+    sr_free_values(values, count);
+
+    /* the edit is still applied strictly */
+    for (i = 0; i < 40; ++i) {
+        sprintf(path, "/ietf-interfaces:interfaces/interface[name='eth%d']/description", i);
+        ret = sr_set_item_str(st->sess, path, "desc", NULL, 0);
+        assert_int_equal(ret, SR_ERR_OK);
+    }
+    ret = sr_set_item_str(st->sess, "/ietf-interfaces:interfaces/interface[name='eth0']", NULL, NULL, SR_EDIT_STRICT);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_apply_changes(st->sess, 0);
+    assert_int_equal(ret, SR_ERR_EXISTS);
+    ret = sr_discard_changes(st->sess);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    /* and the data are still validated, mandatory type is missing */
+    for (i = 40; i < 80; ++i) {
+        sprintf(path, "/ietf-interfaces:interfaces/interface[name='eth%d']/description", i);
+        ret = sr_set_item_str(st->sess, path, "desc", NULL, 0);
+        assert_int_equal(ret, SR_ERR_OK);
+    }
+    ret = sr_apply_changes(st->sess, 0);
+    assert_int_equal(ret, SR_ERR_VALIDATION_FAILED);
+    ret = sr_discard_changes(st->sess);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    ret = sr_get_items(st->sess, "/ietf-interfaces:interfaces/interface/description", 0, 0, &values, &count);
+    assert_int_equal(ret, SR_ERR_OK);
+    assert_int_equal(count, 0);
+    sr_free_values(values, count);
+}
+
+static void
+test_edit_bulk(void **state)
+{
+    struct state *st = (struct state *)*state;
+    sr_val_t *values;
+    size_t count;
+    int ret;
+    sr_edit_item_t items[] = {
+        {"/ietf-interfaces:interfaces/interface[name='eth1']/type", "iana-if-type:ethernetCsmacd", NULL},
+        {"/ietf-interfaces:interfaces/interface[name='eth1']/description", "first", NULL},
+        {"/ietf-interfaces:interfaces/interface[name='eth10']/type", "iana-if-type:ethernetCsmacd", NULL},
+        {"/ietf-interfaces:interfaces/interface[name='eth2']", NULL, "create"},
+        {"/ietf-interfaces:interfaces/interface[name='eth2']/type", "iana-if-type:softwareLoopback", NULL},
+        {"/ietf-interfaces:interfaces/interface[name='eth2']/enabled", "false", NULL}
+    };
+    sr_edit_item_t del_items[] = {
+        {"/ietf-interfaces:interfaces/interface[name='eth1']/description", NULL, "delete"},
+        {"/ietf-interfaces:interfaces/interface[name='eth10']", NULL, "remove"}
+    };
+    sr_edit_item_t bad_items[] = {
+        {"/ietf-interfaces:interfaces/interface[name='eth1']/type", "iana-if-type:ethernetCsmacd", "insert"},
+        {"/ietf-interfaces:interfaces/interface[name='eth1']/name", "eth1", NULL},
+        {"/ietf-interfaces:interfaces/interface[name='eth1']/type", "iana-if-type:ethernetCsmacd", NULL},
+        {"/ietf-interfaces:interfaces/interface[name='eth1']/type", "iana-if-type:ethernetCsmacd", NULL}
+    };
+    sr_edit_item_t unsorted_items[] = {
+        {"/ietf-interfaces:interfaces/interface[name='eth3']/type", "iana-if-type:ethernetCsmacd", NULL},
+        {"/ietf-interfaces:interfaces/interface[name='eth3']", NULL, "create"}
+    };
+
+    /* create the whole edit at once */
+    ret = sr_edit_bulk(st->sess, items, 6, "merge");
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_edit_bulk(st->sess, items, 6, "merge");
+    assert_int_equal(ret, SR_ERR_UNSUPPORTED);
+    ret = sr_apply_changes(st->sess, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    ret = sr_get_items(st->sess, "/ietf-interfaces:interfaces/interface", 0, 0, &values, &count);
+    assert_int_equal(ret, SR_ERR_OK);
+    assert_int_equal(count, 3);
+    sr_free_values(values, count);
+    ret = sr_get_items(st->sess, "/ietf-interfaces:interfaces/interface[name='eth2']/enabled", 0, 0, &values, &count);
+    assert_int_equal(ret, SR_ERR_OK);
+    assert_int_equal(count, 1);
+    assert_false(values[0].data.bool_val);
+    sr_free_values(values, count);
+
+    /* operation of an item is applied */
+    ret = sr_edit_bulk(st->sess, items + 3, 1, "merge");
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_apply_changes(st->sess, 0);
+    assert_int_equal(ret, SR_ERR_EXISTS);
+    ret = sr_discard_changes(st->sess);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    ret = sr_edit_bulk(st->sess, del_items, 2, "none");
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_apply_changes(st->sess, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    ret = sr_get_items(st->sess, "/ietf-interfaces:interfaces/interface", 0, 0, &values, &count);
+    assert_int_equal(ret, SR_ERR_OK);
+    assert_int_equal(count, 2);
+    sr_free_values(values, count);
+    ret = sr_get_items(st->sess, "/ietf-interfaces:interfaces/interface/description", 0, 0, &values, &count);
+    assert_int_equal(ret, SR_ERR_OK);
+    assert_int_equal(count, 0);
+    sr_free_values(values, count);
+
+    /* operation of a parent following its descendant is added to the created node */
+    ret = sr_edit_bulk(st->sess, unsorted_items, 2, "merge");
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_apply_changes(st->sess, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_edit_bulk(st->sess, unsorted_items, 2, "merge");
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_apply_changes(st->sess, 0);
+    assert_int_equal(ret, SR_ERR_EXISTS);
+    ret = sr_discard_changes(st->sess);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    ret = sr_get_items(st->sess, "/ietf-interfaces:interfaces/interface", 0, 0, &values, &count);
+    assert_int_equal(ret, SR_ERR_OK);
+    assert_int_equal(count, 3);
+    sr_free_values(values, count);
+
+    /* invalid items, nothing is stored */
+    ret = sr_edit_bulk(st->sess, bad_items, 1, "merge");
+    assert_int_equal(ret, SR_ERR_INVAL_ARG);
+    ret = sr_edit_bulk(st->sess, bad_items + 1, 1, "merge");
+    assert_int_equal(ret, SR_ERR_INVAL_ARG);
+    ret = sr_edit_bulk(st->sess, bad_items + 2, 2, "merge");
+    assert_int_equal(ret, SR_ERR_INVAL_ARG);
+    assert_null(sr_get_changes(st->sess));
+}
+
 static void
 test_move(void **state)
 {
@@ -516,6 +667,98 @@ test_move(void **state)
     sr_release_data(data);
 }
 
+static void
+test_move_many(void **state)
+{
+    struct state *st = (struct state *)*state;
+    sr_val_t *values;
+    size_t count;
+    char path[64], val[16];
+    int ret, i;
+
+    /* create many top-level instances, each one first */
+    for (i = 0; i < 100; ++i) {
+        sprintf(path, "/test:l1[k='key%d']", i);
+        ret = sr_move_item(st->sess, path, SR_MOVE_FIRST, NULL, NULL, NULL, 0);
+        assert_int_equal(ret, SR_ERR_OK);
+        sprintf(val, "%d", i);
+        ret = sr_set_item_str(st->sess, "/test:ll1", val, NULL, 0);
+        assert_int_equal(ret, SR_ERR_OK);
+    }
+    ret = sr_apply_changes(st->sess, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    ret = sr_get_items(st->sess, "/test:l1/k", 0, 0, &values, &count);
+    assert_int_equal(ret, SR_ERR_OK);
+    assert_int_equal(count, 100);
+    for (i = 0; i < 100; ++i) {
+        sprintf(val, "key%d", 99 - i);
+        assert_string_equal(values[i].data.string_val, val);
+    }
+    sr_free_values(values, count);
+
+    ret = sr_get_items(st->sess, "/test:ll1", 0, 0, &values, &count);
+    assert_int_equal(ret, SR_ERR_OK);
+    assert_int_equal(count, 100);
+    for (i = 0; i < 100; ++i) {
+        assert_int_equal(values[i].data.int16_val, i);
+    }
+    sr_free_values(values, count);
+
+    /* reverse the order by moving each instance last */
+    for (i = 0; i < 100; ++i) {
+        sprintf(path, "/test:l1[k='key%d']", i);
+        ret = sr_move_item(st->sess, path, SR_MOVE_LAST, NULL, NULL, NULL, 0);
+        assert_int_equal(ret, SR_ERR_OK);
+    }
+    ret = sr_apply_changes(st->sess, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    ret = sr_get_items(st->sess, "/test:l1/k", 0, 0, &values, &count);
+    assert_int_equal(ret, SR_ERR_OK);
+    assert_int_equal(count, 100);
+    for (i = 0; i < 100; ++i) {
+        sprintf(val, "key%d", i);
+        assert_string_equal(values[i].data.string_val, val);
+    }
+    sr_free_values(values, count);
+
+    /* reverse the order again by moving each instance before the previous one, remove some */
+    for (i = 1; i < 100; ++i) {
+        sprintf(path, "/test:l1[k='key%d']", i);
+        sprintf(val, "[k='key%d']", i - 1);
+        ret = sr_move_item(st->sess, path, SR_MOVE_BEFORE, val, NULL, NULL, 0);
+        assert_int_equal(ret, SR_ERR_OK);
+    }
+    for (i = 0; i < 100; i += 2) {
+        sprintf(path, "/test:ll1[.='%d']", i);
+        ret = sr_move_item(st->sess, path, SR_MOVE_FIRST, NULL, NULL, NULL, 0);
+        assert_int_equal(ret, SR_ERR_OK);
+        sprintf(path, "/test:ll1[.='%d']", i + 1);
+        ret = sr_delete_item(st->sess, path, 0);
+        assert_int_equal(ret, SR_ERR_OK);
+    }
+    ret = sr_apply_changes(st->sess, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    ret = sr_get_items(st->sess, "/test:l1/k", 0, 0, &values, &count);
+    assert_int_equal(ret, SR_ERR_OK);
+    assert_int_equal(count, 100);
+    for (i = 0; i < 100; ++i) {
+        sprintf(val, "key%d", 99 - i);
+        assert_string_equal(values[i].data.string_val, val);
+    }
+    sr_free_values(values, count);
+
+    ret = sr_get_items(st->sess, "/test:ll1", 0, 0, &values, &count);
+    assert_int_equal(ret, SR_ERR_OK);
+    assert_int_equal(count, 50);
+    for (i = 0; i < 50; ++i) {
+        assert_int_equal(values[i].data.int16_val, 98 - 2 * i);
+    }
+    sr_free_values(values, count);
+}
+
 static void
 test_replace(void **state)
 {
@@ -1549,7 +1792,10 @@ main(void)
         cmocka_unit_test_teardown(test_create1, clear_interfaces),
         cmocka_unit_test_teardown(test_create2, clear_interfaces),
         cmocka_unit_test_teardown(test_create_np_cont, clear_interfaces),
+        cmocka_unit_test_teardown(test_create_large, clear_interfaces),
+        cmocka_unit_test_teardown(test_edit_bulk, clear_interfaces),
         cmocka_unit_test_teardown(test_move, clear_test),
+        cmocka_unit_test_teardown(test_move_many, clear_test),
         cmocka_unit_test_teardown(test_replace, clear_interfaces),
         cmocka_unit_test_teardown(test_replace_userord, clear_test),
         cmocka_unit_test_teardown(test_none, clear_interfaces),
@@ -707,6 +707,177 @@ test_subtree2xpath(void **state)
     lyd_free_all(edit_tree);
 }
 
+/* TEST */
+static void
+test_page(void **state)
+{
+    struct state *st = (struct state *)*state;
+    sr_session_ctx_t *sess;
+    sr_val_t *values;
+    sr_data_t *data;
+    size_t value_cnt;
+    char *next, *resume;
+    struct lyd_node *node;
+    int ret;
+
+    /* set some list instances */
+    ret = sr_set_item_str(st->sess, "/defaults:l1[k='a']", NULL, NULL, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_set_item_str(st->sess, "/defaults:l1[k='b']", NULL, NULL, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_set_item_str(st->sess, "/defaults:l1[k='c']", NULL, NULL, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_set_item_str(st->sess, "/defaults:l1[k='d']", NULL, NULL, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_set_item_str(st->sess, "/defaults:l1[k='e']", NULL, NULL, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_apply_changes(st->sess, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    /* invalid page size */
+    ret = sr_get_items_page(st->sess, "/defaults:l1/k", NULL, 0, 0, 0, &values, &value_cnt, &next);
+    assert_int_equal(ret, SR_ERR_INVAL_ARG);
+
+    /* first values page */
+    ret = sr_get_items_page(st->sess, "/defaults:l1/k", NULL, 2, 0, 0, &values, &value_cnt, &next);
+    assert_int_equal(ret, SR_ERR_OK);
+    assert_int_equal(value_cnt, 2);
+    assert_string_equal(values[0].data.string_val, "a");
+    assert_string_equal(values[1].data.string_val, "b");
+    assert_string_equal(next, "/defaults:l1[k='b']/k");
+    sr_free_values(values, value_cnt);
+
+    /* second values page */
+    resume = next;
+    ret = sr_get_items_page(st->sess, "/defaults:l1/k", resume, 2, 0, 0, &values, &value_cnt, &next);
+    free(resume);
+    assert_int_equal(ret, SR_ERR_OK);
+    assert_int_equal(value_cnt, 2);
+    assert_string_equal(values[0].data.string_val, "c");
+    assert_string_equal(values[1].data.string_val, "d");
+    assert_non_null(next);
+    sr_free_values(values, value_cnt);
+
+    /* last values page */
+    resume = next;
+    ret = sr_get_items_page(st->sess, "/defaults:l1/k", resume, 2, 0, 0, &values, &value_cnt, &next);
+    free(resume);
+    assert_int_equal(ret, SR_ERR_OK);
+    assert_int_equal(value_cnt, 1);
+    assert_string_equal(values[0].data.string_val, "e");
+    assert_null(next);
+    sr_free_values(values, value_cnt);
+
+    /* first data page */
+    ret = sr_get_data_page(st->sess, "/defaults:l1", NULL, 3, 0, 0, 0, &data, &next);
+    assert_int_equal(ret, SR_ERR_OK);
+    assert_string_equal(next, "/defaults:l1[k='c']");
+    node = data->tree;
+    assert_string_equal(lyd_get_value(lyd_child(node)), "a");
+    node = node->next;
+    assert_string_equal(lyd_get_value(lyd_child(node)), "b");
+    node = node->next;
+    assert_string_equal(lyd_get_value(lyd_child(node)), "c");
+    assert_null(node->next);
+    sr_release_data(data);
+
+    /* last data page */
+    resume = next;
+    ret = sr_get_data_page(st->sess, "/defaults:l1", resume, 3, 0, 0, 0, &data, &next);
+    assert_int_equal(ret, SR_ERR_OK);
+    assert_null(next);
+    node = data->tree;
+    assert_string_equal(lyd_get_value(lyd_child(node)), "d");
+    node = node->next;
+    assert_string_equal(lyd_get_value(lyd_child(node)), "e");
+    assert_null(node->next);
+    sr_release_data(data);
+
+    /* resume node removed */
+    ret = sr_delete_item(st->sess, "/defaults:l1[k='c']", 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_apply_changes(st->sess, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_get_data_page(st->sess, "/defaults:l1", resume, 3, 0, 0, 0, &data, &next);
+    free(resume);
+    assert_int_equal(ret, SR_ERR_OK);
+    assert_null(next);
+    node = data->tree;
+    assert_string_equal(lyd_get_value(lyd_child(node)), "d");
+    node = node->next;
+    assert_string_equal(lyd_get_value(lyd_child(node)), "e");
+    assert_null(node->next);
+    sr_release_data(data);
+
+    /* parent of the resume node removed */
+    ret = sr_delete_item(st->sess, "/defaults:l1[k='a']", 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_apply_changes(st->sess, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_get_items_page(st->sess, "/defaults:l1/k", "/defaults:l1[k='a']/k", 2, 0, 0, &values, &value_cnt, &next);
+    assert_int_equal(ret, SR_ERR_OK);
+    assert_int_equal(value_cnt, 2);
+    assert_string_equal(values[0].data.string_val, "b");
+    assert_string_equal(values[1].data.string_val, "d");
+    assert_string_equal(next, "/defaults:l1[k='d']/k");
+    sr_free_values(values, value_cnt);
+    free(next);
+
+    /* last node removed */
+    ret = sr_delete_item(st->sess, "/defaults:l1[k='e']", 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_apply_changes(st->sess, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_get_items_page(st->sess, "/defaults:l1/k", "/defaults:l1[k='e']/k", 2, 0, 0, &values, &value_cnt, &next);
+    assert_int_equal(ret, SR_ERR_OK);
+    assert_int_equal(value_cnt, 0);
+    assert_null(next);
+
+    /* user-ordered instances */
+    ret = sr_set_item_str(st->sess, "/defaults:pcont/ll2", "10", NULL, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_set_item_str(st->sess, "/defaults:pcont/ll2", "20", NULL, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_set_item_str(st->sess, "/defaults:pcont/ll2", "30", NULL, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_apply_changes(st->sess, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_get_items_page(st->sess, "/defaults:pcont/ll2", "/defaults:pcont/ll2[.='10']", 1, 0, 0, &values,
+            &value_cnt, &next);
+    assert_int_equal(ret, SR_ERR_OK);
+    assert_int_equal(value_cnt, 1);
+    assert_int_equal(values[0].data.uint16_val, 20);
+    assert_string_equal(next, "/defaults:pcont/ll2[.='20']");
+    sr_free_values(values, value_cnt);
+    free(next);
+
+    /* the next page of the session is returned from its snapshot */
+    ret = sr_delete_item(st->sess, "/defaults:pcont/ll2[.='20']", 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_apply_changes(st->sess, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_get_items_page(st->sess, "/defaults:pcont/ll2", "/defaults:pcont/ll2[.='20']", 1, 0, 0, &values,
+            &value_cnt, &next);
+    assert_int_equal(ret, SR_ERR_OK);
+    assert_int_equal(value_cnt, 1);
+    assert_int_equal(values[0].data.uint16_val, 30);
+    assert_null(next);
+    sr_free_values(values, value_cnt);
+
+    /* removed user-ordered resume instance has no known position in new data, nothing is returned twice */
+    ret = sr_session_start(st->conn, SR_DS_RUNNING, &sess);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_get_items_page(sess, "/defaults:pcont/ll2", "/defaults:pcont/ll2[.='20']", 1, 0, 0, &values,
+            &value_cnt, &next);
+    assert_int_equal(ret, SR_ERR_NOT_FOUND);
+    sr_session_stop(sess);
+
+    /* cleanup */
+    sr_delete_item(st->sess, "/defaults:l1", 0);
+    sr_delete_item(st->sess, "/defaults:pcont", 0);
+    sr_apply_changes(st->sess, 0);
+}
+
 int
 main(void)
 {
@@ -721,6 +892,7 @@ main(void)
         cmocka_unit_test(test_key),
         cmocka_unit_test(test_factory_default),
         cmocka_unit_test(test_subtree2xpath),
+        cmocka_unit_test(test_page),
     };
 
     setenv("CMOCKA_TEST_ABORT", "1", 1);
@@ -1573,6 +1573,69 @@ test_running_disabled(void **state)
     assert_int_equal(ret, SR_ERR_OK);
 }
 
+static void
+test_lyb_ds(void **state)
+{
+    struct state *st = (struct state *)*state;
+    const sr_module_ds_t mod_ds = {{"JSON DS file", "LYB DS shm", "LYB DS shm", "LYB DS shm", "JSON DS file", "JSON notif"}};
+    sr_session_ctx_t *sess;
+    sr_data_t *data;
+    int ret;
+
+    /* install a module with volatile datastores in LYB */
+    ret = sr_install_module2(st->conn, TESTS_SRC_DIR "/files/simple.yang", TESTS_SRC_DIR "/files", NULL, &mod_ds, NULL,
+            NULL, 0, NULL, NULL, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    /* start a session */
+    ret = sr_session_start(st->conn, SR_DS_RUNNING, &sess);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    /* store some 'running' data */
+    ret = sr_set_item_str(sess, "/simple:ac1/acd1", "false", NULL, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_set_item_str(sess, "/simple:ac1/acl1[acs1='a']", NULL, NULL, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_apply_changes(sess, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    /* read them back */
+    ret = sr_get_data(sess, "/simple:ac1/acl1", 0, 0, 0, &data);
+    assert_int_equal(ret, SR_ERR_OK);
+    assert_string_equal(lyd_get_value(lyd_child(lyd_child(data->tree))), "a");
+    sr_release_data(data);
+
+    /* modify candidate and reset it */
+    sr_session_switch_ds(sess, SR_DS_CANDIDATE);
+    ret = sr_delete_item(sess, "/simple:ac1/acl1[acs1='a']", 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_apply_changes(sess, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_get_data(sess, "/simple:ac1/acl1", 0, 0, 0, &data);
+    assert_int_equal(ret, SR_ERR_OK);
+    assert_null(data);
+    ret = sr_copy_config(sess, "simple", SR_DS_RUNNING, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_get_data(sess, "/simple:ac1/acl1", 0, 0, 0, &data);
+    assert_int_equal(ret, SR_ERR_OK);
+    assert_non_null(data);
+    sr_release_data(data);
+
+    /* copy running into the JSON startup */
+    sr_session_switch_ds(sess, SR_DS_STARTUP);
+    ret = sr_copy_config(sess, "simple", SR_DS_RUNNING, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_get_data(sess, "/simple:ac1/acd1", 0, 0, 0, &data);
+    assert_int_equal(ret, SR_ERR_OK);
+    assert_string_equal(lyd_get_value(lyd_child(data->tree)), "false");
+    sr_release_data(data);
+
+    /* cleanup */
+    sr_session_stop(sess);
+    ret = sr_remove_module(st->conn, "simple", 0);
+    assert_int_equal(ret, SR_ERR_OK);
+}
+
 int
 main(void)
 {
@@ -1596,6 +1659,7 @@ main(void)
         cmocka_unit_test_setup_teardown(test_update_data_deviation, setup_f, teardown_f),
         cmocka_unit_test_setup_teardown(test_update_data_no_write_perm, setup_f, teardown_f),
         cmocka_unit_test_setup_teardown(test_running_disabled, setup_f, teardown_f),
+        cmocka_unit_test_setup_teardown(test_lyb_ds, setup_f, teardown_f),
     };
 
     test_log_init();
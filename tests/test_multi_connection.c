@@ -420,6 +420,282 @@ test_sub_suspend(void **state)
     assert_int_equal(ret, SR_ERR_OK);
 }
 
+static void
+test_sub_churn(void **state)
+{
+    struct state *st = (struct state *)*state;
+    int i, ret;
+    sr_subscription_ctx_t *subscr = NULL, *subscr2;
+    struct cb_data pvt_data = {0};
+    sr_val_t input, *output;
+    size_t output_count;
+
+    /* long-lived subscriptions */
+    ret = sr_module_change_subscribe(st->sess1, "ietf-interfaces", NULL, module_change_cb, &pvt_data, 0, 0, &subscr);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_rpc_subscribe(st->sess1, "/ops:rpc3", suspend_rpc_cb, &pvt_data, 0, 0, &subscr);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    /* short-lived subscriptions of another connection */
+    for (i = 0; i < 200; ++i) {
+        subscr2 = NULL;
+        ret = sr_module_change_subscribe(st->sess2, "ietf-interfaces", "/ietf-interfaces:interfaces/interface",
+                module_change_cb, &pvt_data, i, 0, &subscr2);
+        assert_int_equal(ret, SR_ERR_OK);
+        ret = sr_notif_subscribe(st->sess2, "ops", NULL, 0, 0, suspend_notif_cb, &pvt_data, 0, &subscr2);
+        assert_int_equal(ret, SR_ERR_OK);
+        ret = sr_rpc_subscribe(st->sess2, "/ops:rpc2", suspend_rpc_cb, &pvt_data, i, 0, &subscr2);
+        assert_int_equal(ret, SR_ERR_OK);
+        sr_unsubscribe(subscr2);
+    }
+
+    /* compact explicitly as well */
+    ret = sr_compact_shm(st->conn3);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    /* the long-lived subscriptions still work */
+    ret = sr_set_item_str(st->sess3, "/ietf-interfaces:interfaces/interface[name='eth0']/type",
+            "iana-if-type:ethernetCsmacd", NULL, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_apply_changes(st->sess3, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    input.xpath = "/ops:rpc3/l4";
+    input.type = SR_STRING_T;
+    input.data.string_val = "dummy";
+    input.dflt = 0;
+    ret = sr_rpc_send(st->sess3, "/ops:rpc3", &input, 1, 0, &output, &output_count);
+    assert_int_equal(ret, SR_ERR_OK);
+    sr_free_values(output, output_count);
+
+    sr_unsubscribe(subscr);
+
+    /* all the subscriptions removed */
+    ret = sr_compact_shm(st->conn3);
+    assert_int_equal(ret, SR_ERR_OK);
+}
+
+struct group_commit_arg {
+    struct state *st;
+    sr_conn_ctx_t *conn;
+    const char *name;
+    int ret;
+};
+
+static void *
+group_commit_thread(void *arg)
+{
+    struct group_commit_arg *gc_arg = arg;
+    sr_session_ctx_t *sess;
+    char path[128];
+    int ret;
+
+    ret = sr_session_start(gc_arg->conn, SR_DS_RUNNING, &sess);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    sprintf(path, "/ietf-interfaces:interfaces/interface[name='%s']/type", gc_arg->name);
+    ret = sr_set_item_str(sess, path, "iana-if-type:ethernetCsmacd", NULL, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    sprintf(path, "/ietf-interfaces:interfaces/interface[name='%s']/description", gc_arg->name);
+    ret = sr_set_item_str(sess, path, "group", NULL, SR_EDIT_STRICT);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    pthread_barrier_wait(&gc_arg->st->barrier);
+
+    gc_arg->ret = sr_apply_changes(sess, 0);
+
+    sr_session_stop(sess);
+    return NULL;
+}
+
+static void
+test_group_commit(void **state)
+{
+    struct state *st = (struct state *)*state;
+    const char *names[] = {"ethG0", "ethG1", "ethG2", "ethG3", "ethG4", "ethG5", "ethDup", "ethDup"};
+    const int thread_count = sizeof names / sizeof *names;
+    struct group_commit_arg args[sizeof names / sizeof *names];
+    pthread_t tid[sizeof names / sizeof *names];
+    sr_conn_ctx_t *conn;
+    sr_data_t *data;
+    char path[128];
+    int i, ret, ok_count = 0, exists_count = 0;
+
+    ret = sr_connect(SR_CONN_GROUP_COMMIT, &conn);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    /* apply changes concurrently, they are grouped */
+    pthread_barrier_init(&st->barrier, NULL, thread_count);
+    for (i = 0; i < thread_count; ++i) {
+        args[i].st = st;
+        args[i].conn = conn;
+        args[i].name = names[i];
+        pthread_create(&tid[i], NULL, group_commit_thread, &args[i]);
+    }
+    for (i = 0; i < thread_count; ++i) {
+        pthread_join(tid[i], NULL);
+    }
+    pthread_barrier_destroy(&st->barrier);
+
+    /* each request got its own result, the duplicate strict create failed */
+    for (i = 0; i < thread_count; ++i) {
+        if (args[i].ret == SR_ERR_OK) {
+            ++ok_count;
+        } else if (args[i].ret == SR_ERR_EXISTS) {
+            ++exists_count;
+        }
+    }
+    assert_int_equal(ok_count, thread_count - 1);
+    assert_int_equal(exists_count, 1);
+
+    /* all the changes were stored */
+    for (i = 0; i < thread_count; ++i) {
+        sprintf(path, "/ietf-interfaces:interfaces/interface[name='%s']/description", names[i]);
+        ret = sr_get_node(st->sess3, path, 0, &data);
+        assert_int_equal(ret, SR_ERR_OK);
+        assert_string_equal(lyd_get_value(data->tree), "group");
+        sr_release_data(data);
+    }
+
+    sr_disconnect(conn);
+}
+
+static int
+group_commit_nested_cb(sr_session_ctx_t *session, uint32_t sub_id, const char *module_name, const char *xpath,
+        sr_event_t event, uint32_t request_id, void *private_data)
+{
+    sr_session_ctx_t *sess = private_data;
+    int ret;
+
+    (void)session;
+    (void)sub_id;
+    (void)module_name;
+    (void)xpath;
+    (void)request_id;
+
+    if (event == SR_EV_CHANGE) {
+        /* the thread applying the changes waits for us, must not be queued behind it */
+        ret = sr_set_item_str(sess, "/test:test-leaf", "5", NULL, 0);
+        assert_int_equal(ret, SR_ERR_OK);
+        ret = sr_apply_changes(sess, 0);
+        assert_int_equal(ret, SR_ERR_OK);
+    }
+
+    return SR_ERR_OK;
+}
+
+static int
+group_commit_slow_cb(sr_session_ctx_t *session, uint32_t sub_id, const char *module_name, const char *xpath,
+        sr_event_t event, uint32_t request_id, void *private_data)
+{
+    struct state *st = private_data;
+
+    (void)session;
+    (void)sub_id;
+    (void)module_name;
+    (void)xpath;
+    (void)request_id;
+
+    if (event == SR_EV_CHANGE) {
+        /* let the other commit be queued and time out */
+        pthread_barrier_wait(&st->barrier);
+        pthread_barrier_wait(&st->barrier);
+    }
+
+    return SR_ERR_OK;
+}
+
+static void *
+group_commit_queued_thread(void *arg)
+{
+    struct group_commit_arg *gc_arg = arg;
+    sr_session_ctx_t *sess;
+    int ret;
+
+    ret = sr_session_start(gc_arg->conn, SR_DS_RUNNING, &sess);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_set_item_str(sess, "/test:test-leaf", "7", NULL, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    /* wait until the other changes are being applied */
+    pthread_barrier_wait(&gc_arg->st->barrier);
+
+    gc_arg->ret = sr_apply_changes(sess, 100);
+
+    /* let the other changes finish */
+    pthread_barrier_wait(&gc_arg->st->barrier);
+
+    sr_session_stop(sess);
+    return NULL;
+}
+
+static void
+test_group_commit_wait(void **state)
+{
+    struct state *st = (struct state *)*state;
+    struct group_commit_arg arg = {0};
+    sr_subscription_ctx_t *subscr = NULL;
+    sr_session_ctx_t *sess, *cb_sess;
+    sr_conn_ctx_t *conn;
+    sr_data_t *data;
+    pthread_t tid;
+    int ret;
+
+    ret = sr_connect(SR_CONN_GROUP_COMMIT, &conn);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_session_start(conn, SR_DS_RUNNING, &sess);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_session_start(conn, SR_DS_RUNNING, &cb_sess);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    /* changes applied from a callback of the same connection are not grouped */
+    ret = sr_module_change_subscribe(sess, "ietf-interfaces", NULL, group_commit_nested_cb, cb_sess, 0, 0, &subscr);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_set_item_str(sess, "/ietf-interfaces:interfaces/interface[name='ethN']/type",
+            "iana-if-type:ethernetCsmacd", NULL, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_apply_changes(sess, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    sr_unsubscribe(subscr);
+    subscr = NULL;
+
+    ret = sr_get_node(st->sess3, "/test:test-leaf", 0, &data);
+    assert_int_equal(ret, SR_ERR_OK);
+    assert_string_equal(lyd_get_value(data->tree), "5");
+    sr_release_data(data);
+
+    /* queued changes not taken in time are dequeued */
+    ret = sr_module_change_subscribe(st->sess3, "ietf-interfaces", NULL, group_commit_slow_cb, st, 0, 0, &subscr);
+    assert_int_equal(ret, SR_ERR_OK);
+    pthread_barrier_init(&st->barrier, NULL, 2);
+    arg.st = st;
+    arg.conn = conn;
+    pthread_create(&tid, NULL, group_commit_queued_thread, &arg);
+
+    ret = sr_set_item_str(sess, "/ietf-interfaces:interfaces/interface[name='ethN']/description", "slow", NULL, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_apply_changes(sess, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    pthread_join(tid, NULL);
+    pthread_barrier_destroy(&st->barrier);
+    sr_unsubscribe(subscr);
+    assert_int_equal(arg.ret, SR_ERR_TIME_OUT);
+
+    /* the dequeued changes were not applied */
+    ret = sr_get_node(st->sess3, "/test:test-leaf", 0, &data);
+    assert_int_equal(ret, SR_ERR_OK);
+    assert_string_equal(lyd_get_value(data->tree), "5");
+    sr_release_data(data);
+
+    ret = sr_delete_item(st->sess3, "/test:test-leaf", 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_apply_changes(st->sess3, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    sr_disconnect(conn);
+}
+
 int
 main(void)
 {
@@ -427,6 +703,9 @@ main(void)
         cmocka_unit_test_teardown(test_create1, clear_interfaces),
         cmocka_unit_test(test_new),
         cmocka_unit_test_teardown(test_sub_suspend, clear_interfaces),
+        cmocka_unit_test_teardown(test_sub_churn, clear_interfaces),
+        cmocka_unit_test_teardown(test_group_commit, clear_interfaces),
+        cmocka_unit_test_teardown(test_group_commit_wait, clear_interfaces),
     };
 
     setenv("CMOCKA_TEST_ABORT", "1", 1);
@@ -1445,6 +1445,133 @@ test_params(void **state)
     sr_unsubscribe(subscr);
 }
 
+/* TEST */
+static void
+notif_shared_cb(sr_session_ctx_t *session, uint32_t sub_id, const sr_ev_notif_type_t notif_type, const char *xpath,
+        const sr_val_t *values, const size_t values_cnt, struct timespec *timestamp, void *private_data)
+{
+    struct state *st = (struct state *)private_data;
+
+    (void)session;
+    (void)sub_id;
+    (void)timestamp;
+
+    if (notif_type == SR_EV_NOTIF_TERMINATED) {
+        /* ignore */
+        return;
+    }
+
+    assert_int_equal(notif_type, SR_EV_NOTIF_REALTIME);
+    assert_string_equal(xpath, "/ops:notif4");
+    assert_int_equal(values_cnt, 1);
+    assert_string_equal(values[0].xpath, "/ops:notif4/l");
+    assert_string_equal(values[0].data.string_val, "right");
+
+    /* signal that we were called */
+    ATOMIC_INC_RELAXED(st->cb_called);
+}
+
+static void
+test_shared_filter(void **state)
+{
+    struct state *st = (struct state *)*state;
+    sr_subscription_ctx_t *subscr = NULL;
+    int ret;
+    uint32_t sub_id, filtered_out;
+    struct lyd_node *notif;
+
+    ATOMIC_STORE_RELAXED(st->cb_called, 0);
+
+    /* subscribe several times with the same filter and once with a different one */
+    ret = sr_notif_subscribe(st->sess, "ops", "/ops:notif4[l='right']", NULL, NULL, notif_shared_cb, st,
+            SR_SUBSCR_NO_THREAD, &subscr);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_notif_subscribe(st->sess, "ops", "/ops:notif4[l='right']", NULL, NULL, notif_shared_cb, st,
+            SR_SUBSCR_NO_THREAD, &subscr);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_notif_subscribe(st->sess, "ops", "/ops:notif4[l='wrong']", NULL, NULL, notif_shared_cb, st,
+            SR_SUBSCR_NO_THREAD, &subscr);
+    assert_int_equal(ret, SR_ERR_OK);
+    sub_id = sr_subscription_get_last_sub_id(subscr);
+    ret = sr_notif_subscribe(st->sess, "ops", NULL, NULL, NULL, notif_shared_cb, st, SR_SUBSCR_NO_THREAD, &subscr);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    /* send the notif */
+    assert_int_equal(LY_SUCCESS, lyd_new_path(NULL, st->ly_ctx, "/ops:notif4/l", "right", 0, &notif));
+    ret = sr_notif_send_tree(st->sess, notif, 0, 0);
+    lyd_free_tree(notif);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    /* process the notification, all the callbacks get the same values */
+    ret = sr_subscription_process_events(subscr, NULL, NULL);
+    assert_int_equal(ret, SR_ERR_OK);
+    assert_int_equal(ATOMIC_LOAD_RELAXED(st->cb_called), 3);
+
+    /* only the subscription with a different filter filtered it out */
+    ret = sr_notif_sub_get_info(subscr, sub_id, NULL, NULL, NULL, NULL, &filtered_out);
+    assert_int_equal(ret, SR_ERR_OK);
+    assert_int_equal(filtered_out, 1);
+
+    sr_unsubscribe(subscr);
+}
+
+/* TEST */
+static void
+test_bounded_lag(void **state)
+{
+    struct state *st = (struct state *)*state;
+    sr_subscription_ctx_t *subscr = NULL;
+    sr_session_ctx_t *sess;
+    sr_data_t *data;
+    struct lyd_node *notif, *sub, *node;
+    struct timespec start, end;
+    int ret, i;
+
+    ATOMIC_STORE_RELAXED(st->cb_called, 0);
+
+    /* subscribe with bounded lag, events are not processed so the subscriber is stuck */
+    ret = sr_notif_subscribe(st->sess, "ops", "/ops:notif4", NULL, NULL, notif_shared_cb, st,
+            SR_SUBSCR_NO_THREAD | SR_SUBSCR_NOTIF_BOUNDED_LAG, &subscr);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    /* send several notifications, the originator must not wait for the stuck subscriber */
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (i = 0; i < 3; ++i) {
+        assert_int_equal(LY_SUCCESS, lyd_new_path(NULL, st->ly_ctx, "/ops:notif4/l", "right", 0, &notif));
+        ret = sr_notif_send_tree(st->sess, notif, 0, 0);
+        lyd_free_tree(notif);
+        assert_int_equal(ret, SR_ERR_OK);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    assert_true(end.tv_sec - start.tv_sec < 5);
+
+    /* only the last notification is delivered */
+    ret = sr_subscription_process_events(subscr, NULL, NULL);
+    assert_int_equal(ret, SR_ERR_OK);
+    assert_int_equal(ATOMIC_LOAD_RELAXED(st->cb_called), 1);
+
+    /* check the statistics */
+    ret = sr_session_start(st->conn, SR_DS_OPERATIONAL, &sess);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_get_data(sess, "/sysrepo-monitoring:sysrepo-state/module[name='ops']/subscriptions", 0, 0, 0, &data);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    assert_int_equal(LY_SUCCESS, lyd_find_path(data->tree, "module[name='ops']/subscriptions/notification-sub", 0,
+            &sub));
+    assert_int_equal(LY_SUCCESS, lyd_find_path(sub, "bounded-lag", 0, &node));
+    assert_string_equal(lyd_get_value(node), "true");
+    assert_int_equal(LY_SUCCESS, lyd_find_path(sub, "delivered", 0, &node));
+    assert_string_equal(lyd_get_value(node), "1");
+    assert_int_equal(LY_SUCCESS, lyd_find_path(sub, "dropped", 0, &node));
+    assert_string_equal(lyd_get_value(node), "2");
+    assert_int_equal(LY_SUCCESS, lyd_find_path(sub, "blocked-time", 0, &node));
+    assert_string_not_equal(lyd_get_value(node), "0");
+
+    sr_release_data(data);
+    sr_session_stop(sess);
+    sr_unsubscribe(subscr);
+}
+
 /* TEST */
 static void
 notif_dup_inst_cb(sr_session_ctx_t *session, uint32_t sub_id, const sr_ev_notif_type_t notif_type,
@@ -1847,6 +1974,8 @@ main(void)
         cmocka_unit_test_teardown(test_notif_buffer, clear_session),
         cmocka_unit_test(test_suspend),
         cmocka_unit_test(test_params),
+        cmocka_unit_test(test_shared_filter),
+        cmocka_unit_test(test_bounded_lag),
         cmocka_unit_test(test_dup_inst),
         cmocka_unit_test(test_wait),
         cmocka_unit_test(test_send_nowait),
@@ -861,10 +861,22 @@ test_sr_mon(void **state)
             "      <notification-sub>\n"
             "        <cid></cid>\n"
             "        <suspended>false</suspended>\n"
+            "        <bounded-lag>false</bounded-lag>\n"
+            "        <delivered>0</delivered>\n"
+            "        <filtered-out>0</filtered-out>\n"
+            "        <dropped>0</dropped>\n"
+            "        <blocked-time>0</blocked-time>\n"
+            "        <max-latency>0</max-latency>\n"
             "      </notification-sub>\n"
             "      <notification-sub>\n"
             "        <cid></cid>\n"
             "        <suspended>false</suspended>\n"
+            "        <bounded-lag>false</bounded-lag>\n"
+            "        <delivered>0</delivered>\n"
+            "        <filtered-out>0</filtered-out>\n"
+            "        <dropped>0</dropped>\n"
+            "        <blocked-time>0</blocked-time>\n"
+            "        <max-latency>0</max-latency>\n"
             "      </notification-sub>\n"
             "    </subscriptions>\n"
             "  </module>\n"
@@ -3392,6 +3404,79 @@ test_cache(void **state)
     assert_int_equal(ATOMIC_LOAD_RELAXED(st->cb_called), 1);
 }
 
+/* TEST */
+static void
+test_cache_shared(void **state)
+{
+    struct state *st = (struct state *)*state;
+    sr_conn_ctx_t *conn;
+    sr_session_ctx_t *sess;
+    sr_data_t *data;
+    sr_subscription_ctx_t *subscr1 = NULL, *subscr2 = NULL;
+    char *str1;
+    const char *str2;
+    int ret;
+
+    ATOMIC_STORE_RELAXED(st->cb_called, 0);
+
+    /* subscribe as state data provider */
+    ret = sr_oper_get_subscribe(st->sess, "ietf-interfaces", "/ietf-interfaces:interfaces-state", cache_oper_cb,
+            st, 0, &subscr1);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    /* subscribe for oper poll */
+    ret = sr_oper_poll_subscribe(st->sess, "ietf-interfaces", "/ietf-interfaces:interfaces-state", 3000, 0, &subscr2);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    /* another connection */
+    ret = sr_connect(0, &conn);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_session_start(conn, SR_DS_OPERATIONAL, &sess);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    /* read the data from operational of the other connection, twice */
+    ret = sr_get_data(sess, "/ietf-interfaces:*", 0, 0, 0, &data);
+    assert_int_equal(ret, SR_ERR_OK);
+    sr_release_data(data);
+    ret = sr_get_data(sess, "/ietf-interfaces:*", 0, 0, 0, &data);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    ret = lyd_print_mem(&str1, data->tree, LYD_XML, LYD_PRINT_WITHSIBLINGS);
+    assert_int_equal(ret, 0);
+
+    sr_release_data(data);
+
+    str2 =
+            "<interfaces-state xmlns=\"urn:ietf:params:xml:ns:yang:ietf-interfaces\">\n"
+            "  <interface>\n"
+            "    <name>eth5</name>\n"
+            "    <type xmlns:ianaift=\"urn:ietf:params:xml:ns:yang:iana-if-type\">ianaift:ethernetCsmacd</type>\n"
+            "    <oper-status>testing</oper-status>\n"
+            "    <statistics>\n"
+            "      <discontinuity-time>2000-01-01T02:00:00-00:00</discontinuity-time>\n"
+            "    </statistics>\n"
+            "  </interface>\n"
+            "</interfaces-state>\n";
+
+    assert_string_equal(str1, str2);
+    free(str1);
+
+    /* only the single poll callback call expected, shared cache used by the other connection */
+    assert_int_equal(ATOMIC_LOAD_RELAXED(st->cb_called), 1);
+
+    sr_disconnect(conn);
+    sr_unsubscribe(subscr2);
+
+    /* cache removed, callback called */
+    sr_session_switch_ds(st->sess, SR_DS_OPERATIONAL);
+    ret = sr_get_data(st->sess, "/ietf-interfaces:*", 0, 0, 0, &data);
+    assert_int_equal(ret, SR_ERR_OK);
+    sr_release_data(data);
+    assert_int_equal(ATOMIC_LOAD_RELAXED(st->cb_called), 2);
+
+    sr_unsubscribe(subscr1);
+}
+
 /* TEST */
 static void
 test_cache_no_sub(void **state)
@@ -3775,6 +3860,7 @@ main(void)
         cmocka_unit_test_teardown(test_same_xpath_parallel, clear_up),
         cmocka_unit_test_teardown(test_same_xpath_fail, clear_up),
         cmocka_unit_test_teardown(test_cache, clear_up),
+        cmocka_unit_test_teardown(test_cache_shared, clear_up),
         cmocka_unit_test_teardown(test_cache_no_sub, clear_up),
         cmocka_unit_test_teardown(test_cache_diff, clear_up),
     };
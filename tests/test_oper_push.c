@@ -23,6 +23,8 @@
 #include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/types.h>
+#include <sys/wait.h>
 #include <unistd.h>
 
 #include <cmocka.h>
@@ -353,6 +355,177 @@ test_conn_owner2(void **state)
     free(str1);
 }
 
+/**
+ * @brief Push operational data from a new connection in a child process that then exits without disconnecting.
+ *
+ * @param[in] second Whether this is the second connection, which pushes into the data of the first one.
+ * @param[in] ready_fd Pipe to write the push result into.
+ * @param[in] exit_fd Pipe closed when the child process should exit.
+ */
+static void
+conn_dead_push(int second, int ready_fd, int exit_fd)
+{
+    sr_conn_ctx_t *conn;
+    sr_session_ctx_t *sess;
+    char rc = 1;
+
+    if (sr_connect(0, &conn) || sr_session_start(conn, SR_DS_OPERATIONAL, &sess)) {
+        goto exit;
+    }
+
+    if (!second) {
+        /* create the list instance */
+        if (sr_set_item_str(sess, "/ietf-interfaces:interfaces-state/interface[name='eth1']/type",
+                "iana-if-type:ethernetCsmacd", NULL, 0)) {
+            goto exit;
+        }
+        if (sr_set_item_str(sess, "/ietf-interfaces:interfaces-state/interface[name='eth1']/oper-status", "up",
+                NULL, 0)) {
+            goto exit;
+        }
+    } else {
+        /* push into the list instance of the first connection */
+        if (sr_set_item_str(sess, "/ietf-interfaces:interfaces-state/interface[name='eth1']/speed", "1024", NULL, 0)) {
+            goto exit;
+        }
+
+        /* opaque node with its own CID in the list instance of the parent process connection */
+        if (sr_delete_item(sess, "/ietf-interfaces:interfaces/interface[name='eth1']/description", 0)) {
+            goto exit;
+        }
+    }
+    if (sr_apply_changes(sess, 0)) {
+        goto exit;
+    }
+    rc = 0;
+
+exit:
+    if (write(ready_fd, &rc, 1) != 1) {
+        rc = 1;
+    }
+
+    /* wait for the parent to read the data, then die without disconnecting */
+    while (read(exit_fd, &rc, 1) == 1) {}
+    _exit(rc);
+}
+
+/* TEST */
+static void
+test_conn_dead(void **state)
+{
+    struct state *st = (struct state *)*state;
+    sr_data_t *data;
+    sr_subscription_ctx_t *subscr = NULL;
+    int ready_fds[2], exit_fds[2], status, ret;
+    pid_t pids[2];
+    char *str1, rc;
+    const char *str2;
+    uint32_t i;
+
+    /* set some configuration data */
+    ret = sr_set_item_str(st->sess, "/ietf-interfaces:interfaces/interface[name='eth1']/type",
+            "iana-if-type:ethernetCsmacd", NULL, SR_EDIT_STRICT);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_set_item_str(st->sess, "/ietf-interfaces:interfaces/interface[name='eth1']/description",
+            "config-description", NULL, SR_EDIT_STRICT);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_apply_changes(st->sess, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    /* push oper data into the configuration list instance from this connection */
+    ret = sr_session_switch_ds(st->sess, SR_DS_OPERATIONAL);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_set_item_str(st->sess, "/ietf-interfaces:interfaces/interface[name='eth1']/enabled", "false", NULL, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_apply_changes(st->sess, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    /* push oper data from 2 connections of other processes, one after another */
+    assert_int_equal(pipe(ready_fds), 0);
+    assert_int_equal(pipe(exit_fds), 0);
+    for (i = 0; i < 2; ++i) {
+        pids[i] = fork();
+        if (!pids[i]) {
+            close(ready_fds[0]);
+            close(exit_fds[1]);
+            conn_dead_push(i, ready_fds[1], exit_fds[0]);
+        }
+        assert_int_not_equal(pids[i], -1);
+
+        assert_int_equal(read(ready_fds[0], &rc, 1), 1);
+        assert_int_equal(rc, 0);
+    }
+    close(ready_fds[0]);
+    close(ready_fds[1]);
+    close(exit_fds[0]);
+
+    /* subscribe to all configuration data just to enable them */
+    ret = sr_module_change_subscribe(st->sess, "ietf-interfaces", "/ietf-interfaces:interfaces", dummy_change_cb, NULL,
+            0, 0, &subscr);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    /* read the data of all the connections */
+    ret = sr_get_data(st->sess, "/ietf-interfaces:*", 0, 0, 0, &data);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    ret = lyd_print_mem(&str1, data->tree, LYD_XML, LYD_PRINT_WITHSIBLINGS);
+    assert_int_equal(ret, 0);
+
+    sr_release_data(data);
+
+    str2 =
+            "<interfaces xmlns=\"urn:ietf:params:xml:ns:yang:ietf-interfaces\">\n"
+            "  <interface>\n"
+            "    <name>eth1</name>\n"
+            "    <type xmlns:ianaift=\"urn:ietf:params:xml:ns:yang:iana-if-type\">ianaift:ethernetCsmacd</type>\n"
+            "    <enabled>false</enabled>\n"
+            "  </interface>\n"
+            "</interfaces>\n"
+            "<interfaces-state xmlns=\"urn:ietf:params:xml:ns:yang:ietf-interfaces\">\n"
+            "  <interface>\n"
+            "    <name>eth1</name>\n"
+            "    <type xmlns:ianaift=\"urn:ietf:params:xml:ns:yang:iana-if-type\">ianaift:ethernetCsmacd</type>\n"
+            "    <oper-status>up</oper-status>\n"
+            "    <speed>1024</speed>\n"
+            "  </interface>\n"
+            "</interfaces-state>\n";
+
+    assert_string_equal(str1, str2);
+    free(str1);
+
+    /* both the other connections die */
+    close(exit_fds[1]);
+    for (i = 0; i < 2; ++i) {
+        assert_int_equal(waitpid(pids[i], &status, 0), pids[i]);
+        assert_true(WIFEXITED(status));
+        assert_int_equal(WEXITSTATUS(status), 0);
+    }
+
+    /* a single read recovers the data of both, including the removed description, and keeps the data of this one */
+    ret = sr_get_data(st->sess, "/ietf-interfaces:*", 0, 0, 0, &data);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    ret = lyd_print_mem(&str1, data->tree, LYD_XML, LYD_PRINT_WITHSIBLINGS);
+    assert_int_equal(ret, 0);
+
+    sr_release_data(data);
+
+    str2 =
+            "<interfaces xmlns=\"urn:ietf:params:xml:ns:yang:ietf-interfaces\">\n"
+            "  <interface>\n"
+            "    <name>eth1</name>\n"
+            "    <description>config-description</description>\n"
+            "    <type xmlns:ianaift=\"urn:ietf:params:xml:ns:yang:iana-if-type\">ianaift:ethernetCsmacd</type>\n"
+            "    <enabled>false</enabled>\n"
+            "  </interface>\n"
+            "</interfaces>\n";
+
+    assert_string_equal(str1, str2);
+    free(str1);
+
+    sr_unsubscribe(subscr);
+}
+
 /* TEST */
 static void
 test_conn_owner_same_data(void **state)
@@ -3408,6 +3581,122 @@ test_edit_merge_leaf(void **state)
     assert_null(str1);
 }
 
+/* TEST */
+static int
+merge_counter_change_cb(sr_session_ctx_t *session, uint32_t sub_id, const char *module_name, const char *xpath,
+        sr_event_t event, uint32_t request_id, void *private_data)
+{
+    struct state *st = (struct state *)private_data;
+    sr_change_oper_t op;
+    sr_change_iter_t *iter;
+    const struct lyd_node *node;
+    const char *prev_value;
+    int ret;
+
+    (void)sub_id;
+    (void)xpath;
+    (void)request_id;
+
+    assert_string_equal(module_name, "ietf-interfaces");
+
+    if (event == SR_EV_CHANGE) {
+        ret = sr_get_changes_iter(session, "/ietf-interfaces:interfaces-state/interface/statistics/in-octets", &iter);
+        assert_int_equal(ret, SR_ERR_OK);
+
+        /* only the last value is reported as changed */
+        ret = sr_get_change_tree_next(session, iter, &op, &node, &prev_value, NULL, NULL);
+        assert_int_equal(ret, SR_ERR_OK);
+        assert_int_equal(op, SR_OP_MODIFIED);
+        assert_string_equal(lyd_get_value(node), "1000");
+        assert_string_equal(prev_value, "100");
+
+        ret = sr_get_change_tree_next(session, iter, &op, &node, &prev_value, NULL, NULL);
+        assert_int_equal(ret, SR_ERR_NOT_FOUND);
+        sr_free_change_iter(iter);
+    }
+
+    ATOMIC_INC_RELAXED(st->cb_called);
+    return SR_ERR_OK;
+}
+
+static void
+test_edit_merge_counter(void **state)
+{
+    struct state *st = (struct state *)*state;
+    sr_subscription_ctx_t *subscr = NULL;
+    sr_val_t *val;
+    char buf[16];
+    int ret, i;
+
+    /* switch to operational DS */
+    ret = sr_session_switch_ds(st->sess, SR_DS_OPERATIONAL);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    ret = sr_set_item_str(st->sess, "/ietf-interfaces:interfaces-state/interface[name='eth1']/type",
+            "iana-if-type:ethernetCsmacd", NULL, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_apply_changes(st->sess, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    /* update a counter repeatedly, nobody is subscribed */
+    for (i = 0; i < 100; ++i) {
+        sprintf(buf, "%d", i);
+        ret = sr_set_item_str(st->sess, "/ietf-interfaces:interfaces-state/interface[name='eth1']/statistics/in-octets",
+                buf, NULL, 0);
+        assert_int_equal(ret, SR_ERR_OK);
+        ret = sr_apply_changes(st->sess, 0);
+        assert_int_equal(ret, SR_ERR_OK);
+    }
+
+    ret = sr_get_item(st->sess, "/ietf-interfaces:interfaces-state/interface[name='eth1']/statistics/in-octets", 0,
+            &val);
+    assert_int_equal(ret, SR_ERR_OK);
+    assert_int_equal(val->data.uint64_val, 99);
+    sr_free_val(val);
+
+    /* new leaf with an updated value, the whole edit is stored */
+    ret = sr_set_item_str(st->sess, "/ietf-interfaces:interfaces-state/interface[name='eth1']/statistics/in-octets",
+            "100", NULL, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_set_item_str(st->sess, "/ietf-interfaces:interfaces-state/interface[name='eth1']/statistics/out-octets",
+            "50", NULL, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_apply_changes(st->sess, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    /* only values changed again */
+    ret = sr_set_item_str(st->sess, "/ietf-interfaces:interfaces-state/interface[name='eth1']/statistics/out-octets",
+            "51", NULL, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_apply_changes(st->sess, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    ret = sr_get_item(st->sess, "/ietf-interfaces:interfaces-state/interface[name='eth1']/statistics/in-octets", 0,
+            &val);
+    assert_int_equal(ret, SR_ERR_OK);
+    assert_int_equal(val->data.uint64_val, 100);
+    sr_free_val(val);
+    ret = sr_get_item(st->sess, "/ietf-interfaces:interfaces-state/interface[name='eth1']/statistics/out-octets", 0,
+            &val);
+    assert_int_equal(ret, SR_ERR_OK);
+    assert_int_equal(val->data.uint64_val, 51);
+    sr_free_val(val);
+
+    /* subscribe, the change is reported */
+    ATOMIC_STORE_RELAXED(st->cb_called, 0);
+    ret = sr_module_change_subscribe(st->sess, "ietf-interfaces", NULL, merge_counter_change_cb, st, 0, 0, &subscr);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    ret = sr_set_item_str(st->sess, "/ietf-interfaces:interfaces-state/interface[name='eth1']/statistics/in-octets",
+            "1000", NULL, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_apply_changes(st->sess, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    assert_int_equal(ATOMIC_LOAD_RELAXED(st->cb_called), 2);
+
+    sr_unsubscribe(subscr);
+}
+
 /* TEST */
 static void
 test_diff_merge_userord(void **state)
@@ -4213,6 +4502,7 @@ main(void)
     const struct CMUnitTest tests[] = {
         cmocka_unit_test_teardown(test_conn_owner1, clear_up),
         cmocka_unit_test_teardown(test_conn_owner2, clear_up),
+        cmocka_unit_test_teardown(test_conn_dead, clear_up),
         cmocka_unit_test_teardown(test_conn_owner_same_data, clear_up),
         cmocka_unit_test_teardown(test_delete, clear_up),
         cmocka_unit_test_teardown(test_delete2, clear_up),
@@ -4231,6 +4521,7 @@ main(void)
         cmocka_unit_test_teardown(test_np_cont1, clear_up),
         cmocka_unit_test_teardown(test_np_cont2, clear_up),
         cmocka_unit_test_teardown(test_edit_merge_leaf, clear_up),
+        cmocka_unit_test_teardown(test_edit_merge_counter, clear_up),
         cmocka_unit_test_teardown(test_diff_merge_userord, clear_up),
         cmocka_unit_test_teardown(test_purge, clear_up),
         cmocka_unit_test_teardown(test_schema_mount, clear_up),
@@ -0,0 +1,262 @@
+/**
+ * @file test_plugind.c
+ * @brief tests for sysrepo-plugind plugin initialization
+ *
+ * @copyright
+ * Copyright (c) 2018 - 2024 Deutsche Telekom AG.
+ * Copyright (c) 2018 - 2024 CESNET, z.s.p.o.
+ *
+ * This source code is licensed under BSD 3-Clause License (the "License").
+ * You may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://opensource.org/licenses/BSD-3-Clause
+ */
+
+#define _GNU_SOURCE
+
+#include <errno.h>
+#include <setjmp.h>
+#include <signal.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <cmocka.h>
+#include <libyang/libyang.h>
+
+#include "sysrepo.h"
+#include "tests/tcommon.h"
+
+#define TIMEOUT_STEP_US 100000
+#define SRPD_START_TIMEOUT 10
+#define LOG_LINE_COUNT 8
+
+/*
+ * Test plugins plg_a, plg_b, plg_c, and plg_d, each logging the start and end of its initialization.
+ * Plugin order is configured to plg_b, plg_a and plg_d depends on plg_c.
+ */
+
+struct state {
+    sr_conn_ctx_t *conn;
+    sr_session_ctx_t *sess;
+    char *pidfile;
+    char *logfile;
+    char *lines[LOG_LINE_COUNT];
+    uint32_t line_count;
+    pid_t pid;
+};
+
+static char *
+get_test_path(const char *append_name)
+{
+    char *path;
+
+    if (asprintf(&path, "%s/data/%s", sr_get_repo_path(), append_name) == -1) {
+        path = NULL;
+    }
+
+    return path;
+}
+
+static int
+read_log(struct state *st)
+{
+    FILE *fp;
+    char *line = NULL;
+    size_t n = 0;
+    ssize_t len;
+
+    fp = fopen(st->logfile, "r");
+    if (!fp) {
+        print_error("Opening the plugin log %s failed (%s)\n", st->logfile, strerror(errno));
+        return 1;
+    }
+
+    while ((len = getline(&line, &n, fp)) != -1) {
+        if (st->line_count == LOG_LINE_COUNT) {
+            print_error("Unexpected plugin log line \"%s\"\n", line);
+            break;
+        }
+        if (len && (line[len - 1] == '\n')) {
+            line[len - 1] = '\0';
+        }
+        st->lines[st->line_count] = strdup(line);
+        ++st->line_count;
+    }
+    free(line);
+    fclose(fp);
+
+    return 0;
+}
+
+static int
+teardown(void **state)
+{
+    struct state *st = (struct state *)*state;
+    uint32_t i;
+    int ret;
+
+    if (!st) {
+        return 0;
+    }
+
+    if (st->pid > 0) {
+        kill(st->pid, SIGINT);
+        waitpid(st->pid, &ret, 0);
+    }
+
+    if (st->sess) {
+        sr_delete_item(st->sess, "/sysrepo-plugind:sysrepo-plugind/plugin-order", 0);
+        sr_apply_changes(st->sess, 0);
+    }
+    sr_disconnect(st->conn);
+
+    if (st->logfile) {
+        unlink(st->logfile);
+    }
+    for (i = 0; i < st->line_count; ++i) {
+        free(st->lines[i]);
+    }
+    free(st->pidfile);
+    free(st->logfile);
+    free(st);
+    *state = NULL;
+    return 0;
+}
+
+static int
+setup(void **state)
+{
+    struct state *st;
+    struct stat sb;
+    time_t start;
+    int rc = 1;
+
+    st = calloc(1, sizeof *st);
+    *state = st;
+    if (!st) {
+        return 1;
+    }
+
+    if (sr_connect(0, &st->conn) != SR_ERR_OK) {
+        goto cleanup;
+    }
+    if (sr_session_start(st->conn, SR_DS_RUNNING, &st->sess) != SR_ERR_OK) {
+        goto cleanup;
+    }
+
+    /* configure the plugin order */
+    if (sr_set_item_str(st->sess, "/sysrepo-plugind:sysrepo-plugind/plugin-order/plugin", "plg_b", NULL, 0)) {
+        goto cleanup;
+    }
+    if (sr_set_item_str(st->sess, "/sysrepo-plugind:sysrepo-plugind/plugin-order/plugin", "plg_a.so", NULL, 0)) {
+        goto cleanup;
+    }
+    if (sr_apply_changes(st->sess, 0)) {
+        goto cleanup;
+    }
+
+    /* the plugins log into this file */
+    if (!(st->logfile = get_test_path("plugind_init.log")) || !(st->pidfile = get_test_path("plugind_pidfile"))) {
+        goto cleanup;
+    }
+    unlink(st->logfile);
+    unlink(st->pidfile);
+    setenv("SRPD_TEST_INIT_LOG", st->logfile, 1);
+
+    /* initialize the plugins in parallel */
+    st->pid = fork();
+    if (st->pid == 0) {
+        execl(SR_BINARY_DIR "/sysrepo-plugind", SR_BINARY_DIR "/sysrepo-plugind", "-v3", "-d", "-f", "-j", "4", "-p",
+                st->pidfile, NULL);
+        print_error("Execl failed\n");
+        exit(1);
+    } else if (st->pid == -1) {
+        print_error("Forking failed\n");
+        goto cleanup;
+    }
+
+    /* the PID is written into the PID file only once all the plugins are initialized */
+    time(&start);
+    while (time(NULL) < (start + SRPD_START_TIMEOUT)) {
+        if (!stat(st->pidfile, &sb) && sb.st_size) {
+            break;
+        }
+        usleep(TIMEOUT_STEP_US);
+    }
+    if (stat(st->pidfile, &sb) || !sb.st_size) {
+        print_error("Timeout elapsed.\n");
+        goto cleanup;
+    }
+
+    if (read_log(st)) {
+        goto cleanup;
+    }
+    rc = 0;
+
+cleanup:
+    if (rc) {
+        teardown(state);
+    }
+    return rc;
+}
+
+static uint32_t
+log_idx(struct state *st, const char *line)
+{
+    uint32_t i;
+
+    for (i = 0; i < st->line_count; ++i) {
+        if (!strcmp(st->lines[i], line)) {
+            return i;
+        }
+    }
+
+    fail_msg("Plugin log line \"%s\" not found.", line);
+    return 0;
+}
+
+static void
+test_order(void **state)
+{
+    struct state *st = (struct state *)*state;
+
+    /* all the plugins initialized */
+    assert_int_equal(st->line_count, LOG_LINE_COUNT);
+
+    /* plugins in the plugin order initialized one after another */
+    assert_true(log_idx(st, "end plg_b") < log_idx(st, "start plg_a"));
+
+    /* plugins not in the plugin order initialized only after all the ordered ones */
+    assert_true(log_idx(st, "end plg_a") < log_idx(st, "start plg_c"));
+    assert_true(log_idx(st, "end plg_a") < log_idx(st, "start plg_d"));
+}
+
+static void
+test_deps(void **state)
+{
+    struct state *st = (struct state *)*state;
+
+    /* plg_d is initialized only after its dependency even though there are enough threads */
+    assert_true(log_idx(st, "end plg_c") < log_idx(st, "start plg_d"));
+}
+
+int
+main(void)
+{
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_order),
+        cmocka_unit_test(test_deps),
+    };
+
+    test_log_init();
+    return cmocka_run_group_tests(tests, setup, teardown);
+}
@@ -39,6 +39,10 @@
 #include "sysrepo_types.h"
 #include "tests/tcommon.h"
 
+#ifdef SR_HAVE_ZLIB
+# include <zlib.h>
+#endif
+
 #define TIMEOUT_STEP_US 100000
 #define SRPD_START_TIMEOUT 10
 #define NUM_OF_FILES 30
@@ -188,6 +192,28 @@ wait_for_archivation(void **state, uint64_t archived_expected)
     return 0;
 }
 
+static uint64_t
+get_counter(void **state, const char *name)
+{
+    test_data_t *data = (test_data_t *)(*state);
+    sr_data_t *sr_data;
+    char *xpath;
+    uint64_t num = 0;
+
+    if (asprintf(&xpath, "/sysrepo-plugind:sysrepo-plugind/notif-datastore/rotation/%s", name) == -1) {
+        return 0;
+    }
+    sr_session_switch_ds(data->sess, SR_DS_OPERATIONAL);
+    if ((sr_get_data(data->sess, xpath, 0, 0, 0, &sr_data) == SR_ERR_OK) && sr_data) {
+        num = strtoul(lyd_get_value(lyd_child(lyd_child(lyd_child(sr_data->tree)))), NULL, 10);
+        sr_release_data(sr_data);
+    }
+    sr_session_switch_ds(data->sess, SR_DS_RUNNING);
+    free(xpath);
+
+    return num;
+}
+
 static int
 find_file(void **state, const char *search, int *found)
 {
@@ -363,7 +389,7 @@ compress_config(void **state)
     if (asprintf(&data->path_to_file, "%smy_test.notif.100-200", data->n_path) == -1) {
         return EXIT_FAILURE;
     }
-    if (create_file(data->path_to_file, NULL)) {
+    if (create_file(data->path_to_file, "notif")) {
         return EXIT_FAILURE;
     }
     free(data->path_to_file);
@@ -386,6 +412,10 @@ test_compress(void **state)
     }
     assert_int_equal(found, 1);
     remove_file(state, "my_test.notif.100-200", 0);
+
+    /* file only moved */
+    assert_int_equal(get_counter(state, "rotated-bytes"), 5);
+    assert_int_equal(get_counter(state, "archived-bytes"), 5);
 }
 
 static int
@@ -534,6 +564,79 @@ cleanup:
     assert_true(0);
 }
 
+static int
+compress_gz_config(void **state)
+{
+    test_data_t *data = (test_data_t *)(*state);
+
+    /* Create some config with true compress */
+    create_config(data->sess, "3m", data->a_path, "true");
+
+    /* Generate some data */
+    if (asprintf(&data->path_to_file, "%smy_test.notif.300-400", data->n_path) == -1) {
+        return EXIT_FAILURE;
+    }
+    if (create_file(data->path_to_file, "notif")) {
+        return EXIT_FAILURE;
+    }
+    free(data->path_to_file);
+    data->path_to_file = NULL;
+
+    /* Wait till archivation loop archives the files */
+    if (wait_for_archivation(state, 1 + 1 + NUM_OF_FILES / 2 + 1)) {
+        return EXIT_FAILURE;
+    }
+    return 0;
+}
+
+static void
+test_compress_gz(void **state)
+{
+    int found = 0;
+
+#ifdef SR_HAVE_ZLIB
+    test_data_t *data = (test_data_t *)(*state);
+    char block[512], content[8], *path;
+    uint32_t chksum, i;
+    gzFile gz;
+#endif
+
+    if (find_file(state, "my_test.notif.300-400.tar.gz", &found)) {
+        assert_true(0);
+    }
+    assert_int_equal(found, 1);
+
+#ifdef SR_HAVE_ZLIB
+    /* read the archive back */
+    assert_int_not_equal(asprintf(&path, "%smy_test.notif.300-400.tar.gz", data->a_path), -1);
+    gz = gzopen(path, "rb");
+    free(path);
+    assert_non_null(gz);
+
+    /* ustar header of the single member */
+    assert_int_equal(gzread(gz, block, sizeof block), sizeof block);
+    assert_memory_equal(block + 257, "ustar", 6);
+    assert_string_equal(block, "my_test.notif.300-400");
+    assert_int_equal(strncmp(block + 345, data->n_path + 1, data->len_npath - 2), 0);
+    assert_int_equal(block[345 + data->len_npath - 2], '\0');
+    assert_int_equal(strtoul(block + 124, NULL, 8), 5);
+    assert_int_equal(block[156], '0');
+
+    chksum = 0;
+    for (i = 0; i < sizeof block; ++i) {
+        chksum += ((i >= 148) && (i < 156)) ? ' ' : (unsigned char)block[i];
+    }
+    assert_int_equal(strtoul(block + 148, NULL, 8), chksum);
+
+    /* member content */
+    assert_int_equal(gzread(gz, content, 5), 5);
+    assert_memory_equal(content, "notif", 5);
+    assert_int_equal(gzclose(gz), Z_OK);
+#endif
+
+    remove_file(state, "my_test.notif.300-400.tar.gz", 0);
+}
+
 int
 main(void)
 {
@@ -542,6 +645,7 @@ main(void)
         cmocka_unit_test_setup(test_compress, compress_config),
         cmocka_unit_test_setup(test_check_format, format_config),
         cmocka_unit_test_setup(test_aging, basic_config),
+        cmocka_unit_test_setup(test_compress_gz, compress_gz_config),
     };
 
     test_log_init();
@@ -16,10 +16,13 @@
 
 #define _GNU_SOURCE
 
+#include <inttypes.h>
 #include <pthread.h>
+#include <pwd.h>
 #include <setjmp.h>
 #include <stdarg.h>
 #include <stdint.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <sys/types.h>
@@ -39,6 +42,8 @@ struct state {
     sr_session_ctx_t *sess;
     ATOMIC_T cb_called;
     ATOMIC_T cb2_called;
+    ATOMIC_T cb_in_flight;
+    ATOMIC_T cb_overlapped;
     pthread_barrier_t barrier;
 };
 
@@ -238,6 +243,149 @@ test_fail(void **state)
     sr_unsubscribe(subscr);
 }
 
+/* TEST */
+static int
+rpc_reuse_cb(sr_session_ctx_t *session, uint32_t sub_id, const char *xpath, const struct lyd_node *input,
+        sr_event_t event, uint32_t request_id, struct lyd_node *output, void *private_data)
+{
+    uint32_t *sids = private_data;
+    const sr_error_info_t *err_info = NULL;
+
+    (void)sub_id;
+    (void)xpath;
+    (void)input;
+    (void)event;
+    (void)request_id;
+    (void)output;
+
+    /* nothing may be left from the previous event */
+    assert_string_equal(sr_session_get_orig_name(session), "test_rpc_action");
+    assert_int_equal(sr_session_get_error(session, &err_info), SR_ERR_OK);
+    assert_null(err_info);
+
+    if (!sids[0]) {
+        sids[0] = sr_session_get_id(session);
+
+        /* error on the first event */
+        sr_session_set_error(session, NULL, SR_ERR_SYS, "RPC FAIL");
+        return SR_ERR_SYS;
+    }
+
+    sids[1] = sr_session_get_id(session);
+    return SR_ERR_OK;
+}
+
+static void
+test_ev_sess_reuse(void **state)
+{
+    struct state *st = (struct state *)*state;
+    sr_subscription_ctx_t *subscr = NULL;
+    struct lyd_node *input;
+    sr_data_t *output;
+    uint32_t sids[2] = {0};
+    int ret;
+
+    /* subscribe */
+    ret = sr_rpc_subscribe_tree(st->sess, "/ops:rpc1", rpc_reuse_cb, sids, 0, 0, &subscr);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    assert_int_equal(LY_SUCCESS, lyd_new_path(NULL, st->ly_ctx, "/ops:rpc1", NULL, 0, &input));
+
+    /* first RPC fails */
+    ret = sr_rpc_send_tree(st->sess, input, 0, &output);
+    assert_int_equal(ret, SR_ERR_CALLBACK_FAILED);
+    assert_null(output);
+
+    /* second RPC succeeds, the error of the first event is not carried over */
+    ret = sr_rpc_send_tree(st->sess, input, 0, &output);
+    lyd_free_all(input);
+    assert_int_equal(ret, SR_ERR_OK);
+    sr_release_data(output);
+
+    /* every event is processed by a session with a new ID */
+    assert_int_not_equal(sids[0], 0);
+    assert_int_not_equal(sids[1], 0);
+    assert_int_not_equal(sids[0], sids[1]);
+
+    sr_unsubscribe(subscr);
+}
+
+/* TEST */
+struct ev_sess_user {
+    const char *proc_user;
+    const char *user;
+    int count;
+};
+
+static int
+rpc_user_cb(sr_session_ctx_t *session, uint32_t sub_id, const char *xpath, const struct lyd_node *input,
+        sr_event_t event, uint32_t request_id, struct lyd_node *output, void *private_data)
+{
+    struct ev_sess_user *eu = private_data;
+
+    (void)sub_id;
+    (void)xpath;
+    (void)input;
+    (void)event;
+    (void)request_id;
+    (void)output;
+
+    /* the user set in the previous event may not be used */
+    assert_string_equal(sr_session_get_user(session), eu->proc_user);
+
+    if (!eu->count) {
+        /* change the user of the first event */
+        assert_int_equal(sr_session_set_user(session, eu->user), SR_ERR_OK);
+        assert_string_equal(sr_session_get_user(session), eu->user);
+    }
+
+    ++eu->count;
+    return SR_ERR_OK;
+}
+
+static void
+test_ev_sess_user(void **state)
+{
+    struct state *st = (struct state *)*state;
+    sr_subscription_ctx_t *subscr = NULL;
+    struct lyd_node *input;
+    sr_data_t *output;
+    struct ev_sess_user eu = {0};
+    struct passwd *pwd;
+    int ret;
+
+    if (geteuid()) {
+        /* test works only for root */
+        return;
+    }
+
+    /* another existing user */
+    if (!getpwnam("nobody")) {
+        return;
+    }
+    eu.user = "nobody";
+    pwd = getpwuid(getuid());
+    eu.proc_user = pwd->pw_name;
+
+    /* subscribe */
+    ret = sr_rpc_subscribe_tree(st->sess, "/ops:rpc1", rpc_user_cb, &eu, 0, 0, &subscr);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    assert_int_equal(LY_SUCCESS, lyd_new_path(NULL, st->ly_ctx, "/ops:rpc1", NULL, 0, &input));
+
+    /* the user is changed in the first event and checked in the second one */
+    ret = sr_rpc_send_tree(st->sess, input, 0, &output);
+    assert_int_equal(ret, SR_ERR_OK);
+    sr_release_data(output);
+    ret = sr_rpc_send_tree(st->sess, input, 0, &output);
+    lyd_free_all(input);
+    assert_int_equal(ret, SR_ERR_OK);
+    sr_release_data(output);
+    assert_int_equal(eu.count, 2);
+
+    sr_unsubscribe(subscr);
+}
+
 /* TEST */
 static int
 rpc_rpc_cb(sr_session_ctx_t *session, uint32_t sub_id, const char *xpath, const sr_val_t *input, const size_t input_cnt,
@@ -1026,6 +1174,279 @@ test_multi_fail(void **state)
     sr_unsubscribe(subscr);
 }
 
+/* TEST */
+static int
+rpc_pipeline_cb(sr_session_ctx_t *session, uint32_t sub_id, const char *op_path, const struct lyd_node *input,
+        sr_event_t event, uint32_t request_id, struct lyd_node *output, void *private_data)
+{
+    struct state *st = (struct state *)private_data;
+
+    (void)session;
+    (void)sub_id;
+    (void)event;
+    (void)request_id;
+
+    assert_string_equal(op_path, "/ops:rpc3");
+    ATOMIC_INC_RELAXED(st->cb_called);
+
+    /* take some time so that the requests overlap */
+    usleep(1000);
+
+    /* echo the input */
+    assert_string_equal(lyd_child(input)->schema->name, "l4");
+    assert_int_equal(LY_SUCCESS, lyd_new_path(output, NULL, "l5", lyd_get_value(lyd_child(input)),
+            LYD_NEW_VAL_OUTPUT, NULL));
+    return SR_ERR_OK;
+}
+
+static int
+rpc_pipeline_parallel_cb(sr_session_ctx_t *session, uint32_t sub_id, const char *op_path, const struct lyd_node *input,
+        sr_event_t event, uint32_t request_id, struct lyd_node *output, void *private_data)
+{
+    struct state *st = (struct state *)private_data;
+    uint32_t i;
+    int rc;
+
+    if (ATOMIC_INC_RELAXED(st->cb_in_flight)) {
+        /* another request is being processed right now */
+        ATOMIC_STORE_RELAXED(st->cb_overlapped, 1);
+    } else {
+        /* give another request a chance to be processed meanwhile */
+        for (i = 0; (i < 100) && !ATOMIC_LOAD_RELAXED(st->cb_overlapped); ++i) {
+            usleep(1000);
+        }
+    }
+
+    rc = rpc_pipeline_cb(session, sub_id, op_path, input, event, request_id, output, private_data);
+
+    ATOMIC_DEC_RELAXED(st->cb_in_flight);
+    return rc;
+}
+
+static void *
+send_rpc_pipeline_thread(void *arg)
+{
+    struct state *st = (struct state *)arg;
+    sr_session_ctx_t *sess;
+    struct lyd_node *input_op;
+    sr_data_t *output_op;
+    char val[16];
+    uint32_t i;
+    static ATOMIC_T thread_idx = 0;
+    uint32_t idx = ATOMIC_INC_RELAXED(thread_idx);
+
+    assert_int_equal(sr_session_start(st->conn, SR_DS_RUNNING, &sess), SR_ERR_OK);
+
+    for (i = 0; i < 20; ++i) {
+        sprintf(val, "%" PRIu32, idx * 100 + i);
+        assert_int_equal(LY_SUCCESS, lyd_new_path(NULL, st->ly_ctx, "/ops:rpc3/l4", val, 0, &input_op));
+        assert_int_equal(sr_rpc_send_tree(sess, input_op, 0, &output_op), SR_ERR_OK);
+        lyd_free_all(input_op);
+
+        /* every caller gets its own output */
+        assert_string_equal(lyd_child(output_op->tree)->schema->name, "l5");
+        assert_string_equal(lyd_get_value(lyd_child(output_op->tree)), val);
+        sr_release_data(output_op);
+    }
+
+    sr_session_stop(sess);
+    return NULL;
+}
+
+static void
+test_rpc_pipeline(void **state)
+{
+    struct state *st = (struct state *)*state;
+    sr_subscription_ctx_t *subscr = NULL;
+    pthread_t tid[4];
+    uint32_t i;
+    int ret;
+
+    /* subscribe */
+    ret = sr_rpc_subscribe_tree(st->sess, "/ops:rpc3", rpc_pipeline_parallel_cb, st, 0, SR_SUBSCR_RPC_PIPELINE,
+            &subscr);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    /* send RPCs concurrently */
+    ATOMIC_STORE_RELAXED(st->cb_called, 0);
+    ATOMIC_STORE_RELAXED(st->cb_in_flight, 0);
+    ATOMIC_STORE_RELAXED(st->cb_overlapped, 0);
+    for (i = 0; i < 4; ++i) {
+        pthread_create(&tid[i], NULL, send_rpc_pipeline_thread, st);
+    }
+    for (i = 0; i < 4; ++i) {
+        pthread_join(tid[i], NULL);
+    }
+    assert_int_equal(ATOMIC_LOAD_RELAXED(st->cb_called), 80);
+
+    /* some requests were processed in parallel */
+    assert_int_equal(ATOMIC_LOAD_RELAXED(st->cb_overlapped), 1);
+
+    sr_unsubscribe(subscr);
+}
+
+/* TEST */
+static int
+rpc_pipeline_slow_cb(sr_session_ctx_t *session, uint32_t sub_id, const char *op_path, const struct lyd_node *input,
+        sr_event_t event, uint32_t request_id, struct lyd_node *output, void *private_data)
+{
+    struct state *st = (struct state *)private_data;
+    const char *val = lyd_get_value(lyd_child(input));
+    uint32_t i;
+
+    (void)session;
+    (void)sub_id;
+    (void)op_path;
+    (void)event;
+    (void)request_id;
+
+    if (!strcmp(val, "1")) {
+        ATOMIC_STORE_RELAXED(st->cb_in_flight, 1);
+
+        /* the other requests must be processed while this one is */
+        for (i = 0; (i < 3000) && (ATOMIC_LOAD_RELAXED(st->cb_called) < 3); ++i) {
+            usleep(1000);
+        }
+        if (ATOMIC_LOAD_RELAXED(st->cb_called) < 3) {
+            return SR_ERR_OPERATION_FAILED;
+        }
+    } else {
+        ATOMIC_INC_RELAXED(st->cb_called);
+    }
+
+    assert_int_equal(LY_SUCCESS, lyd_new_path(output, NULL, "l5", val, LYD_NEW_VAL_OUTPUT, NULL));
+    return SR_ERR_OK;
+}
+
+static void *
+send_rpc_pipeline_slow_thread(void *arg)
+{
+    struct state *st = (struct state *)arg;
+    sr_session_ctx_t *sess;
+    struct lyd_node *input_op;
+    sr_data_t *output_op;
+
+    assert_int_equal(sr_session_start(st->conn, SR_DS_RUNNING, &sess), SR_ERR_OK);
+
+    assert_int_equal(LY_SUCCESS, lyd_new_path(NULL, st->ly_ctx, "/ops:rpc3/l4", "1", 0, &input_op));
+    assert_int_equal(sr_rpc_send_tree(sess, input_op, 0, &output_op), SR_ERR_OK);
+    lyd_free_all(input_op);
+    sr_release_data(output_op);
+
+    sr_session_stop(sess);
+    return NULL;
+}
+
+static void
+test_rpc_pipeline_slow(void **state)
+{
+    struct state *st = (struct state *)*state;
+    sr_subscription_ctx_t *subscr = NULL;
+    struct lyd_node *input_op;
+    sr_data_t *output_op;
+    pthread_t tid;
+    char val[16];
+    uint32_t i;
+    int ret;
+
+    /* subscribe */
+    ret = sr_rpc_subscribe_tree(st->sess, "/ops:rpc3", rpc_pipeline_slow_cb, st, 0, SR_SUBSCR_RPC_PIPELINE, &subscr);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    /* send a slow RPC */
+    ATOMIC_STORE_RELAXED(st->cb_called, 0);
+    ATOMIC_STORE_RELAXED(st->cb_in_flight, 0);
+    pthread_create(&tid, NULL, send_rpc_pipeline_slow_thread, st);
+    for (i = 0; (i < 3000) && !ATOMIC_LOAD_RELAXED(st->cb_in_flight); ++i) {
+        usleep(1000);
+    }
+    assert_int_equal(ATOMIC_LOAD_RELAXED(st->cb_in_flight), 1);
+
+    /* the next RPCs are processed one after another in other slots while the slow one is still being processed */
+    for (i = 2; i < 5; ++i) {
+        sprintf(val, "%" PRIu32, i);
+        assert_int_equal(LY_SUCCESS, lyd_new_path(NULL, st->ly_ctx, "/ops:rpc3/l4", val, 0, &input_op));
+        assert_int_equal(sr_rpc_send_tree(st->sess, input_op, 0, &output_op), SR_ERR_OK);
+        lyd_free_all(input_op);
+        assert_string_equal(lyd_get_value(lyd_child(output_op->tree)), val);
+        sr_release_data(output_op);
+    }
+
+    pthread_join(tid, NULL);
+    assert_int_equal(ATOMIC_LOAD_RELAXED(st->cb_called), 3);
+
+    sr_unsubscribe(subscr);
+}
+
+/* TEST */
+struct rpc_bg_op {
+    struct state *st;
+    uint32_t idx;
+};
+
+static void
+rpc_bg_cb(sr_session_ctx_t *session, int err_code, sr_data_t *output, void *private_data)
+{
+    struct rpc_bg_op *op = (struct rpc_bg_op *)private_data;
+    char val[16];
+
+    assert_non_null(session);
+    assert_int_equal(err_code, SR_ERR_OK);
+    assert_non_null(output);
+
+    /* the output matches the request of this operation */
+    sprintf(val, "%" PRIu32, op->idx);
+    assert_string_equal(lyd_child(output->tree)->schema->name, "l5");
+    assert_string_equal(lyd_get_value(lyd_child(output->tree)), val);
+    sr_release_data(output);
+
+    ATOMIC_INC_RELAXED(op->st->cb2_called);
+}
+
+static void
+test_rpc_bg(void **state)
+{
+    struct state *st = (struct state *)*state;
+    sr_subscription_ctx_t *subscr = NULL;
+    sr_session_ctx_t *sess[8];
+    struct rpc_bg_op ops[8];
+    struct lyd_node *input_op;
+    char val[16];
+    uint32_t i;
+    int ret;
+
+    /* subscribe */
+    ret = sr_rpc_subscribe_tree(st->sess, "/ops:rpc3", rpc_pipeline_cb, st, 0, 0, &subscr);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    /* send all the RPCs without waiting */
+    ATOMIC_STORE_RELAXED(st->cb_called, 0);
+    ATOMIC_STORE_RELAXED(st->cb2_called, 0);
+    for (i = 0; i < 8; ++i) {
+        assert_int_equal(sr_session_start(st->conn, SR_DS_RUNNING, &sess[i]), SR_ERR_OK);
+
+        ops[i].st = st;
+        ops[i].idx = i;
+        sprintf(val, "%" PRIu32, i);
+        assert_int_equal(LY_SUCCESS, lyd_new_path(NULL, st->ly_ctx, "/ops:rpc3/l4", val, 0, &input_op));
+        ret = sr_rpc_send_tree_bg(sess[i], input_op, 0, rpc_bg_cb, &ops[i]);
+        lyd_free_all(input_op);
+        assert_int_equal(ret, SR_ERR_OK);
+    }
+
+    /* wait for all the completions */
+    for (i = 0; (i < 500) && (ATOMIC_LOAD_RELAXED(st->cb2_called) < 8); ++i) {
+        usleep(10000);
+    }
+    assert_int_equal(ATOMIC_LOAD_RELAXED(st->cb2_called), 8);
+    assert_int_equal(ATOMIC_LOAD_RELAXED(st->cb_called), 8);
+
+    for (i = 0; i < 8; ++i) {
+        sr_session_stop(sess[i]);
+    }
+    sr_unsubscribe(subscr);
+}
+
 /* TEST */
 static int
 action_deps_cb(sr_session_ctx_t *session, uint32_t sub_id, const char *op_path, const struct lyd_node *input,
@@ -1996,11 +2417,16 @@ main(void)
 {
     const struct CMUnitTest tests[] = {
         cmocka_unit_test(test_fail),
+        cmocka_unit_test(test_ev_sess_reuse),
+        cmocka_unit_test(test_ev_sess_user),
         cmocka_unit_test_teardown(test_rpc, clear_ops),
         cmocka_unit_test_teardown(test_action, clear_ops),
         cmocka_unit_test_teardown(test_action_pred, clear_ops),
         cmocka_unit_test_teardown(test_multi, clear_ops),
         cmocka_unit_test(test_multi_fail),
+        cmocka_unit_test(test_rpc_pipeline),
+        cmocka_unit_test(test_rpc_pipeline_slow),
+        cmocka_unit_test(test_rpc_bg),
         cmocka_unit_test(test_action_deps),
         cmocka_unit_test_teardown(test_action_change_config, clear_ops),
         cmocka_unit_test(test_rpc_shelve),
@@ -95,8 +95,10 @@ clear_test_refs(void **state)
 
     sr_delete_item(st->sess, "/test:test-leaf", 0);
     sr_delete_item(st->sess, "/test:ll1[.='-3000']", 0);
+    sr_delete_item(st->sess, "/test:cont", 0);
 
     sr_delete_item(st->sess, "/refs:cont", 0);
+    sr_delete_item(st->sess, "/refs:str-cont", 0);
     sr_delete_item(st->sess, "/refs:inst-id", 0);
     sr_delete_item(st->sess, "/refs:lref", 0);
     sr_delete_item(st->sess, "/refs:l", 0);
@@ -219,6 +221,144 @@ test_instid(void **state)
     assert_int_equal(ret, SR_ERR_OK);
 }
 
+static void
+test_value_change(void **state)
+{
+    struct state *st = (struct state *)*state;
+    sr_data_t *data;
+    struct lyd_node *node;
+    int ret;
+
+    /* create valid data */
+    ret = sr_set_item_str(st->sess, "/test:test-leaf", "10", NULL, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_set_item_str(st->sess, "/test:cont/dflt-leaf", "a", NULL, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_set_item_str(st->sess, "/refs:lref", "10", NULL, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_set_item_str(st->sess, "/simple:ac1/acd1", "false", NULL, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_set_item_str(st->sess, "/refs:l", NULL, NULL, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_apply_changes(st->sess, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    /* value change of a leaf referenced by a foreign leafref */
+    ret = sr_set_item_str(st->sess, "/test:test-leaf", "8", NULL, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_apply_changes(st->sess, 0);
+    assert_int_equal(ret, SR_ERR_VALIDATION_FAILED);
+    ret = sr_discard_changes(st->sess);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    /* value change of a leaf referenced by a foreign must */
+    ret = sr_set_item_str(st->sess, "/simple:ac1/acd1", "true", NULL, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_apply_changes(st->sess, 0);
+    assert_int_equal(ret, SR_ERR_VALIDATION_FAILED);
+    ret = sr_discard_changes(st->sess);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    /* value change of a leaf whose ancestor string value is used by a must */
+    ret = sr_set_item_str(st->sess, "/refs:str-cont/str", "allowed", NULL, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_apply_changes(st->sess, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_set_item_str(st->sess, "/refs:str-cont/str", "forbidden", NULL, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_apply_changes(st->sess, 0);
+    assert_int_equal(ret, SR_ERR_VALIDATION_FAILED);
+    ret = sr_discard_changes(st->sess);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    /* unreferenced value change */
+    ret = sr_set_item_str(st->sess, "/test:cont/dflt-leaf", "b", NULL, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_apply_changes(st->sess, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    /* check final datastore contents */
+    ret = sr_get_data(st->sess, "/test:test-leaf | /test:cont/dflt-leaf | /simple:ac1/acd1", 0, 0, 0, &data);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    assert_int_equal(LY_SUCCESS, lyd_find_path(data->tree, "/test:test-leaf", 0, &node));
+    assert_string_equal(lyd_get_value(node), "10");
+    assert_int_equal(LY_SUCCESS, lyd_find_path(data->tree, "/test:cont/dflt-leaf", 0, &node));
+    assert_string_equal(lyd_get_value(node), "b");
+    assert_int_equal(LY_SUCCESS, lyd_find_path(data->tree, "/simple:ac1/acd1", 0, &node));
+    assert_string_equal(lyd_get_value(node), "false");
+
+    sr_release_data(data);
+}
+
+static int val_skipped;
+
+static void
+test_val_skipped_log_cb(sr_log_level_t level, const char *message)
+{
+    if ((level == SR_LL_DBG) && strstr(message, "validation skipped")) {
+        ++val_skipped;
+    }
+}
+
+static void
+test_bounded_validation(void **state)
+{
+    struct state *st = (struct state *)*state;
+    int ret;
+
+    sr_log_set_cb(test_val_skipped_log_cb);
+
+    /* create valid data, validated */
+    val_skipped = 0;
+    ret = sr_set_item_str(st->sess, "/test:test-leaf", "10", NULL, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_set_item_str(st->sess, "/test:cont/dflt-leaf", "a", NULL, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_set_item_str(st->sess, "/refs:lref", "10", NULL, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_apply_changes(st->sess, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    assert_int_equal(val_skipped, 0);
+
+    /* bounded value change, validation skipped */
+    ret = sr_set_item_str(st->sess, "/test:cont/dflt-leaf", "b", NULL, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_apply_changes(st->sess, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    assert_int_equal(val_skipped, 1);
+
+    /* bounded value change together with a change breaking a leafref, validated */
+    val_skipped = 0;
+    ret = sr_set_item_str(st->sess, "/test:cont/dflt-leaf", "c", NULL, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_set_item_str(st->sess, "/test:test-leaf", "8", NULL, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_apply_changes(st->sess, 0);
+    assert_int_equal(ret, SR_ERR_VALIDATION_FAILED);
+    assert_int_equal(val_skipped, 0);
+    ret = sr_discard_changes(st->sess);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    /* valid created node, validated */
+    ret = sr_set_item_str(st->sess, "/refs:ll", "y", NULL, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_apply_changes(st->sess, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    assert_int_equal(val_skipped, 0);
+
+    /* removed leafref target, validated */
+    ret = sr_delete_item(st->sess, "/test:test-leaf", 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_apply_changes(st->sess, 0);
+    assert_int_equal(ret, SR_ERR_VALIDATION_FAILED);
+    assert_int_equal(val_skipped, 0);
+    ret = sr_discard_changes(st->sess);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    test_log_init();
+}
+
 static void
 test_operational(void **state)
 {
@@ -278,6 +418,8 @@ main(void)
     const struct CMUnitTest tests[] = {
         cmocka_unit_test_teardown(test_leafref, clear_test_refs),
         cmocka_unit_test_teardown(test_instid, clear_test_refs),
+        cmocka_unit_test_teardown(test_value_change, clear_test_refs),
+        cmocka_unit_test_teardown(test_bounded_validation, clear_test_refs),
         cmocka_unit_test(test_operational),
     };
 